@@ -53,7 +53,8 @@ void
 	
 	// Prepare to run...
 	c64->cpu.clearErrorState();
-	c64->floppy.cpu.clearErrorState();
+	for (unsigned i = 0; i < IEC::maxDrives; i++)
+		c64->floppy[i].cpu.clearErrorState();
 	c64->restartTimer();
     
 	while (1) {		
@@ -82,6 +83,10 @@ C64::C64()
     warp = false;
     alwaysWarp = false;
     warpLoad = false;
+    audioPacing = false;
+    audioStalled = false;
+    audioReadCount = 0;
+    scheduleAllEvents();
 	
     // Register sub components
     VirtualComponent *subcomponents[] = {
@@ -93,8 +98,9 @@ C64::C64()
         &cia1, &cia2,
         &iec,
         &expansionport,
-        &floppy,
+        &floppy[0], &floppy[1], &floppy[2], &floppy[3],
         &datasette,
+        &recorder,
         &keyboard,
         &joystickA,
         &joystickB,
@@ -103,6 +109,13 @@ C64::C64()
     registerSubComponents(subcomponents, sizeof(subcomponents));
     setC64(this);
     
+    // All CPUs are clocked by the cycle counter of the C64
+    cpu.clock = &cycle;
+    for (unsigned i = 0; i < IEC::maxDrives; i++) {
+        floppy[i].cpu.clock = &cycle;
+        floppy[i].setDeviceNr(8 + i);
+    }
+    
     // Register snapshot items
     SnapshotItem items[] = {
  
@@ -120,9 +133,6 @@ C64::C64()
     // Configure machine type and reset
     setPAL();
     reset();
-			
-    // Initialie mach timer info
-    mach_timebase_info(&timebase);
 
 	// Initialize snapshot ringbuffer (BackInTime feature)
 	for (unsigned i = 0; i < BACK_IN_TIME_BUFFER_SIZE; i++)
@@ -149,6 +159,7 @@ C64::reset()
     cpu.setPC(0xFCE2);
 	rasterlineCycle = 1;
     nanoTargetTime = 0UL;
+    scheduleAllEvents();
     
     ping();
 	resume();
@@ -233,13 +244,14 @@ C64::run() {
 void
 C64::threadCleanup()
 {
+    floppy[0].attach();
     p = NULL;
     debug(1, "Execution thread cleanup\n");
 }
 
 bool
 C64::isRunnable() {
-    return mem.basicRomIsLoaded() && mem.charRomIsLoaded() && mem.kernelRomIsLoaded() && floppy.mem.romIsLoaded();
+    return mem.basicRomIsLoaded() && mem.charRomIsLoaded() && mem.kernelRomIsLoaded() && floppy[0].mem.romIsLoaded();
 }
 
 bool
@@ -261,6 +273,9 @@ C64::halt()
         step();
         // Shut down sub components
         sid.halt();
+    } else {
+        // Take back the drive if it has been executed without an execution thread
+        floppy[0].attach();
     }
 }
 
@@ -300,7 +315,8 @@ C64::step()
 {
     // Clear error states
     cpu.clearErrorState();
-    floppy.cpu.clearErrorState();
+    for (unsigned i = 0; i < IEC::maxDrives; i++)
+        floppy[i].cpu.clearErrorState();
     
     // Execute next command
     do {
@@ -310,6 +326,14 @@ C64::step()
     // We are now at cycle 0 of the next command
     // Execute one more cycle (and stop in cycle 1)
     executeOneCycle();
+    
+    // Bring sleeping components up to date (the debugger shows their state)
+    cia1.wakeUp();
+    cia2.wakeUp();
+    for (unsigned i = 0; i < IEC::maxDrives; i++) {
+        floppy[i].wakeUp();
+        floppy[i].syncRotation();
+    }
 }
 
 // From Wolfgang Lorenz: Clock.txt
@@ -323,14 +347,48 @@ C64::step()
 // '---------------------------------------------------------------'
 
 #define EXECUTE(x) \
-cia1.executeOneCycle(); \
-cia2.executeOneCycle(); \
+if (cycle >= nextEventCycle) executeCIAs(); \
 if (!cpu.executeOneCycle()) result = false; \
-if (!floppy.executeOneCycle()) result = false; \
-datasette.execute(); \
+if (cycle >= nextEventCycle && !executePeripherals()) result = false; \
 cycle++; \
 rasterlineCycle++;
 
+inline void
+C64::executeCIAs()
+{
+    if (cycle >= eventCycle[CIA1_SLOT])
+        cia1.executeOneCycle();
+    if (cycle >= eventCycle[CIA2_SLOT])
+        cia2.executeOneCycle();
+}
+
+bool
+C64::executePeripherals()
+{
+    bool result = true;
+    
+    if (cycle >= eventCycle[DRIVE_SLOT] && !iec.executeDrives(cycle))
+        result = false;
+    if (cycle >= eventCycle[DATASETTE_SLOT])
+        datasette.execute(cycle);
+    
+    // Components may have been rescheduled by the CPU or by each other
+    nextEventCycle = UINT64_MAX;
+    for (unsigned i = 0; i < EVENT_SLOTS; i++)
+        if (eventCycle[i] < nextEventCycle)
+            nextEventCycle = eventCycle[i];
+    
+    return result;
+}
+
+void
+C64::scheduleAllEvents()
+{
+    for (unsigned i = 0; i < EVENT_SLOTS; i++)
+        eventCycle[i] = 0;
+    nextEventCycle = 0;
+}
+
 inline bool
 C64::executeOneCycle()
 {
@@ -613,15 +671,87 @@ C64::executeOneCycle()
     return result;
 }
 
-inline bool
+// Executes a single cycle inside the rasterline sequencer. Stops the sequencer if the CPU reports an error state
+#define SEQUENCE(vicCycle) \
+vicCycle; \
+EXECUTE(); \
+if (!result) return false;
+
+template <unsigned cyclesPerRasterline> bool
+C64::executeRasterline()
+{
+    bool result = true;
+
+    assert(rasterlineCycle == 1);
+    
+    beginOfRasterline();
+    SEQUENCE(vic.cycle1());
+    SEQUENCE(vic.cycle2());
+    SEQUENCE(vic.cycle3());
+    SEQUENCE(vic.cycle4());
+    SEQUENCE(vic.cycle5());
+    SEQUENCE(vic.cycle6());
+    SEQUENCE(vic.cycle7());
+    SEQUENCE(vic.cycle8());
+    SEQUENCE(vic.cycle9());
+    SEQUENCE(vic.cycle10());
+    SEQUENCE(vic.cycle11());
+    SEQUENCE(vic.cycle12());
+    SEQUENCE(vic.cycle13());
+    SEQUENCE(vic.cycle14());
+    SEQUENCE(vic.cycle15());
+    SEQUENCE(vic.cycle16());
+    SEQUENCE(vic.cycle17());
+    SEQUENCE(vic.cycle18());
+    for (unsigned i = 19; i <= 54; i++) {
+        SEQUENCE(vic.cycle19to54());
+    }
+    SEQUENCE(vic.cycle55());
+    SEQUENCE(vic.cycle56());
+    SEQUENCE(vic.cycle57());
+    SEQUENCE(vic.cycle58());
+    SEQUENCE(vic.cycle59());
+    SEQUENCE(vic.cycle60());
+    SEQUENCE(vic.cycle61());
+    SEQUENCE(vic.cycle62());
+    if (cyclesPerRasterline == NTSC_CYCLES_PER_RASTERLINE) {
+        SEQUENCE(vic.cycle63());
+        SEQUENCE(vic.cycle64());
+        vic.cycle65();
+    } else {
+        vic.cycle63();
+    }
+    
+    // The last cycle always completes the rasterline, even if the CPU has stopped in it
+    EXECUTE();
+    endOfRasterline();
+    
+    return result;
+}
+
+bool
 C64::executeOneLine()
 {
-    uint8_t lastCycle = vic.getCyclesPerRasterline();
-    for (unsigned i = rasterlineCycle; i <= lastCycle; i++) {
-        if (!executeOneCycle())
-            return false;
+    // Hand the drive over to its own thread if requested (only possible if it is alone on the bus)
+    if (floppy[0].getThreaded() && !floppy[0].isDetached() &&
+        iec.numConnectedDrives() == 1 && iec.driveIsConnected(8))
+        floppy[0].detach();
+    
+    // Finish a partially executed rasterline (e.g., after the debugger has stepped into it) cycle by cycle
+    if (rasterlineCycle != 1) {
+        uint8_t lastCycle = vic.getCyclesPerRasterline();
+        for (unsigned i = rasterlineCycle; i <= lastCycle; i++) {
+            if (!executeOneCycle())
+                return false;
+        }
+        return true;
     }
-    return true;
+    
+    // Run the whole rasterline in one go
+    if (vic.isPAL())
+        return executeRasterline<PAL_CYCLES_PER_RASTERLINE>();
+    else
+        return executeRasterline<NTSC_CYCLES_PER_RASTERLINE>();
 }
 
 void
@@ -641,6 +771,9 @@ C64::endOfRasterline()
     rasterlineCycle = 1;
     rasterline++;
     
+    // Let the drive thread know how far we are
+    floppy[0].reportProgress(cycle);
+    
     if (rasterline >= vic.getRasterlinesPerFrame()) {
         
         // Last rasterline of frame
@@ -722,10 +855,15 @@ C64::setWarpLoad(bool b)
 void
 C64::restartTimer()
 {
-    uint64_t kernelNow = mach_absolute_time();
-    uint64_t nanoNow = abs_to_nanos(kernelNow);
-    
-    nanoTargetTime = nanoNow + vic.getFrameDelay();
+    nanoTargetTime = monotonicNanos() + vic.getFrameDelay();
+}
+
+void
+C64::setAudioPacing(bool b)
+{
+    audioPacing = b;
+    audioStalled = false;
+    restartTimer();
 }
 
 void
@@ -733,11 +871,26 @@ C64::synchronizeTiming()
 {
     const uint64_t earlyWakeup = 1500000; /* 1.5 milliseconds */
     
-    // Convert usec into kernel unit
-    int64_t kernelTargetTime = nanos_to_abs(nanoTargetTime);
+    // Let the audio device drive the emulator if possible
+    if (audioPacing) {
+        
+        if (audioStalled && sid.resid->readDataCnt.load(std::memory_order_relaxed) != audioReadCount) {
+            debug(2, "Audio device is consuming samples again. Resuming audio pacing.\n");
+            audioStalled = false;
+        }
+        if (!audioStalled) {
+            if (synchronizeWithAudio()) {
+                nanoTargetTime = monotonicNanos() + vic.getFrameDelay();
+                return;
+            }
+            debug(2, "Audio device does not consume samples. Falling back to timer pacing.\n");
+            audioStalled = true;
+            restartTimer();
+        }
+    }
     
     // Check how long we're supposed to sleep
-    int64_t timediff = kernelTargetTime - (int64_t)mach_absolute_time();
+    int64_t timediff = (int64_t)nanoTargetTime - (int64_t)monotonicNanos();
     if (timediff > 200000000 /* 0.2 sec */) {
         
         // The emulator seems to be out of sync, so we better reset the synchronization timer
@@ -748,8 +901,8 @@ C64::synchronizeTiming()
     }
     
     // Sleep and update target timer
-    // debug(2, "%p Sleeping for %lld\n", this, kernelTargetTime - mach_absolute_time());
-    int64_t jitter = sleepUntil(kernelTargetTime, earlyWakeup);
+    // debug(2, "%p Sleeping for %lld\n", this, nanoTargetTime - monotonicNanos());
+    int64_t jitter = sleepUntil(nanoTargetTime, earlyWakeup);
     nanoTargetTime += vic.getFrameDelay();
     
     // debug(2, "Jitter = %d", jitter);
@@ -764,6 +917,34 @@ C64::synchronizeTiming()
 }
 
 
+bool
+C64::synchronizeWithAudio()
+{
+    uint64_t timeout = monotonicNanos() + 2 * vic.getFrameDelay();
+    unsigned watermark = sid.resid->getTargetFill();
+    unsigned fill;
+    
+    // Samples still queued in the SID thread will end up in the ringbuffer, too
+    while ((fill = sid.resid->samplesInBuffer() + sid.pendingSamples()) >= watermark) {
+        
+        // Give up if the audio device hasn't picked up any samples for a while
+        uint64_t count = sid.resid->readDataCnt.load(std::memory_order_relaxed);
+        if (count != audioReadCount) {
+            audioReadCount = count;
+            timeout = monotonicNanos() + 2 * vic.getFrameDelay();
+        } else if (monotonicNanos() > timeout) {
+            return false;
+        }
+        
+        // Sleep until the surplus samples should have been played (but check back regularly)
+        uint64_t surplus = (uint64_t)(fill - watermark + 1) * 1000000 / sid.getSampleRate();
+        sleepMicrosec(MIN(MAX(surplus, 500), 10000));
+    }
+    audioReadCount = sid.resid->readDataCnt.load(std::memory_order_relaxed);
+    return true;
+}
+
+
 //
 //! @functiongroup Loading ROM images
 //
@@ -776,7 +957,7 @@ C64::getMissingRoms() {
     if (!mem.basicRomIsLoaded()) missingRoms |= BASIC_ROM;
     if (!mem.charRomIsLoaded()) missingRoms |= CHAR_ROM;
     if (!mem.kernelRomIsLoaded()) missingRoms |= KERNEL_ROM;
-    if (!floppy.mem.romIsLoaded()) missingRoms |= VC1541_ROM;
+    if (!floppy[0].mem.romIsLoaded()) missingRoms |= VC1541_ROM;
     return missingRoms;
 }
 
@@ -806,10 +987,16 @@ C64::loadRom(const char *filename)
     }
     
     if (VC1541Memory::is1541Rom(filename)) {
-        result = floppy.mem.loadRom(filename);
+        for (unsigned i = 0; i < IEC::maxDrives; i++)
+            result = floppy[i].mem.loadRom(filename);
         if (result) putMessage(MSG_ROM_LOADED, VC1541_ROM);
     }
     
+    // Translations of the old ROM contents are no longer valid
+    cpu.flushTranslationCache();
+    for (unsigned i = 0; i < IEC::maxDrives; i++)
+        floppy[i].cpu.flushTranslationCache();
+    
     bool isNowRunnable = isRunnable();
     
     if (!wasRunnable && isNowRunnable) { // Good news! All ROMs are in place
@@ -830,8 +1017,10 @@ void C64::loadFromSnapshot(Snapshot *snapshot)
     if (snapshot == NULL)
         return;
     
+    floppy[0].attach();
     uint8_t *ptr = snapshot->getData();
     loadFromBuffer(&ptr);
+    scheduleAllEvents();
     ping();
 }
 
@@ -841,12 +1030,22 @@ C64::saveToSnapshot(Snapshot *snapshot)
     if (snapshot == NULL)
         return;
     
+    uint32_t palette[16];
+    for (unsigned i = 0; i < 16; i++)
+        palette[i] = vic.getColor(i);
+
     snapshot->setTimestamp(time(NULL));
-    snapshot->takeScreenshot((uint32_t *)vic.screenBuffer(), isPAL());
+    snapshot->takeScreenshot(vic.completedIndexBuffer(), palette, isPAL());
+    
+    // The drive state must be up to date
+    bool detached = floppy[0].attach();
     
     snapshot->alloc(stateSize());
     uint8_t *ptr = snapshot->getData();
     saveToBuffer(&ptr);
+    
+    if (detached)
+        floppy[0].detach();
 }
 
 
@@ -922,8 +1121,32 @@ C64::mountArchive(Archive *a)
 {	
 	if (a == NULL)
 		return false;
-		
-	floppy.insertDisk(a);
+    
+    switch (a->getType()) {
+            
+        case D64_CONTAINER:
+        case G64_CONTAINER:
+        case NIB_CONTAINER:
+            
+            floppy[0].insertDisk(a);
+            break;
+            
+        case T64_CONTAINER:
+        case PRG_CONTAINER:
+        case P00_CONTAINER:
+        case FILE_CONTAINER:
+        {
+            // Convert file archives into a disk
+            D64Archive *d64 = D64Archive::archiveFromArchive(a);
+            floppy[0].insertDisk(d64);
+            delete d64;
+            break;
+        }
+        default:
+            
+            warn("%s archives can't be mounted as virtual disk.\n", a->getTypeAsString());
+            return false;
+    }
 	return true;
 }
 
@@ -952,6 +1175,7 @@ void
 C64::detachCartridge()
 {
     expansionport.detachCartridge();
+    mem.updatePeekPokeLookupTables();
 }
 
 bool
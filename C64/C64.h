@@ -44,7 +44,9 @@
 #ifndef _C64_INC
 #define _C64_INC
 
+#ifndef NDEBUG
 #define NDEBUG      // RELEASE
+#endif
 
 // General
 #include "Message.h"
@@ -77,6 +79,7 @@
 // Peripherals
 #include "VC1541.h"
 #include "Datasette.h"
+#include "Recorder.h"
 #include "Cartridge.h"
 #include "ExpansionPort.h"
 
@@ -180,6 +183,17 @@ class C64 : public VirtualComponent {
 
 public:
     
+    /*! @brief    Components that are executed on demand
+     *  @details  Each component owns a slot in the event table (see scheduleEvent).
+     */
+    enum EventSlot {
+        CIA1_SLOT,
+        CIA2_SLOT,
+        DRIVE_SLOT,
+        DATASETTE_SLOT,
+        EVENT_SLOTS
+    };
+    
     //
     // Sub components
     //
@@ -211,18 +225,24 @@ public:
     //! @brief    The C64s second virtual joystick (plugged into CONTROL PORT 2)
     Joystick joystickB;
 
-	//! @brief    The C64s interface bus connecting the VC1541 drive
+	//! @brief    The C64s interface bus connecting the VC1541 drives
 	IEC iec;
 
     //! @brief    The C64s virtual expansion port (cartdrige slot)
     ExpansionPort expansionport;
 
-    //! @brief    A virtual VC1541 floppy drive
-	VC1541 floppy;
+    /*! @brief    Virtual VC1541 floppy drives
+     *  @details  floppy[i] listens to device number 8 + i. Only drive 8 is connected to the IEC bus
+     *            by default (see IEC::connectDrive).
+     */
+	VC1541 floppy[IEC::maxDrives];
 
     //! @brief    A virtual datasette
     Datasette datasette;
 
+    //! @brief    Video and audio recorder
+    Recorder recorder;
+
     
 private:
 
@@ -233,11 +253,6 @@ private:
     //! @brief    The emulators execution thread
     pthread_t p;
     
-    /*! @brief    System timer information
-     *  @details  Used to put the emulation thread to sleep for the proper amount of time
-     */
-    mach_timebase_info_data_t timebase;
-    
     /*! @brief    Wake-up time of the synchronization timer in nanoseconds
      *  @details  This value is recomputed each time the emulator thread is put to sleep
      */
@@ -252,6 +267,23 @@ private:
     //! Indicates that we should run as fast as possible at least during disk operations
     bool warpLoad;
     
+    /*! @brief    Indicates if the emulator is paced by the audio device
+     *  @details  In this mode, the emulator thread does not sleep until a precomputed point in time.
+     *            Instead, it computes the next frame as soon as the audio device has consumed enough
+     *            samples to let the SID ringbuffer drop below its target fill level. Hence, the
+     *            emulator speed is driven by the audio clock and audio playback never drifts.
+     */
+    bool audioPacing;
+    
+    /*! @brief    Indicates that the audio device has stopped consuming samples
+     *  @details  In this case, the emulator falls back to sleep-based synchronization until the
+     *            audio device starts consuming samples again.
+     */
+    bool audioStalled;
+    
+    //! @brief    Number of samples the audio device had consumed when it was checked last
+    uint64_t audioReadCount;
+    
     
     //
     // Executed cycle, rasterline, and frame
@@ -272,6 +304,26 @@ private:
     uint8_t rasterlineCycle;
 
     
+    //
+    // Event scheduler
+    //
+    
+    /*! @brief    Cycle in which a component needs to be executed next
+     *  @details  Components that have nothing to do most of the time (sleeping CIAs, parked drives, and
+     *            the datasette) are not executed in each cycle. Instead, they register the cycle of their
+     *            next event in their slot. Zero means that the component is executed in each cycle,
+     *            UINT64_MAX means that it is not executed at all.
+     */
+    uint64_t eventCycle[EVENT_SLOTS];
+    
+    /*! @brief    First cycle in which one of the components needs to be executed
+     *  @details  Apart from the CPU, nothing is executed in cycles before this one. Hence, the event table
+     *            is only looked at if something happens. The value may be smaller than the minimum of the
+     *            event table. It is recomputed in each cycle in which it is reached.
+     */
+    uint64_t nextEventCycle;
+    
+    
     //
     // Time travel ring buffer
     //
@@ -403,7 +455,10 @@ public:
      */
 	void step(); 
 	
-	//! @brief    Executes until the end of the rasterline
+	/*! @brief    Executes until the end of the rasterline
+     *  @details  If the current rasterline has not been started yet, the whole line is executed by the
+     *            rasterline sequencer. Otherwise, the remaining cycles are executed one by one.
+     */
 	bool executeOneLine();
     
 private:
@@ -411,23 +466,39 @@ private:
     //! @brief    Executes virtual C64 for one cycle
     inline bool executeOneCycle();
     
+    /*! @brief    Rasterline sequencer
+     *  @details  Executes a complete rasterline as straight-line code. The function is specialized for the
+     *            number of cycles per rasterline (63 for PAL machines, 65 for NTSC machines). Execution stops
+     *            early if the CPU reaches a breakpoint or an illegal instruction.
+     */
+    template <unsigned cyclesPerRasterline> bool executeRasterline();
+    
 	//! @brief    Invoked before executing the first cycle of rasterline
 	void beginOfRasterline();
 	
     //! @brief    Invoked after executing the last cycle of rasterline
 	void endOfRasterline();
+    
+    //! @brief    Executes the CIAs that are due in the current cycle (invoked before the CPU is executed)
+    inline void executeCIAs();
+    
+    /*! @brief    Executes the drives and the datasette if they are due in the current cycle
+     *  @details  Invoked after the CPU has been executed. The function also determines the next event cycle.
+     *            Returns false if one of the drives has hit a breakpoint or an illegal instruction.
+     */
+    bool executePeripherals();
+    
+    /*! @brief    Executes all scheduled components in the next cycle
+     *  @details  Invoked after a reset and after a snapshot has been loaded. The components register their
+     *            next event by themselves once they have been executed.
+     */
+    void scheduleAllEvents();
 		
     
     //
     //! @functiongroup Managing the execution thread
     //
     
-    //! @brief    Converts kernel time to nanoseconds
-    uint64_t abs_to_nanos(uint64_t abs) { return abs * timebase.numer / timebase.denom; }
-    
-    //! @brief    Converts nanoseconds to kernel time
-    uint64_t nanos_to_abs(uint64_t nanos) { return nanos * timebase.denom / timebase.numer; }
-    
 public:
     
     //! @brief    Returns true iff cpu runs at maximum speed (timing sychronization is disabled).
@@ -454,9 +525,24 @@ public:
      */
     void restartTimer();
     
-    //! @brief    Waits until target_time has been reached and then updates target_time.
+    //! @brief    Returns true iff the emulator is paced by the audio device.
+    inline bool getAudioPacing() { return audioPacing; }
+    
+    //! @brief    Enables or disables audio-driven pacing.
+    void setAudioPacing(bool b);
+    
+    /*! @brief    Waits until the next frame is due.
+     *  @details  Depending on the pacing mode, the function either waits until target_time has been
+     *            reached and updates target_time, or it waits for the audio device.
+     */
     void synchronizeTiming();
     
+    /*! @brief    Waits until the SID ringbuffer drops below its target fill level.
+     *  @details  Samples that are still queued in the SID thread count as buffered.
+     *  @return   false, if the audio device hasn't consumed any samples for two frames.
+     */
+    bool synchronizeWithAudio();
+    
     
     //
     //! @functiongroup Accessing cycle, rasterline, and frame information
@@ -475,6 +561,20 @@ public:
     inline uint8_t getRasterlineCycle() { return rasterlineCycle; }
 
     
+    //
+    //! @functiongroup Scheduling events
+    //
+    
+    /*! @brief    Sets the cycle in which a component needs to be executed next
+     *  @details  Invoked by the component whenever its next event changes. Zero means that the component
+     *            is executed in each cycle. The CIAs are executed before the CPU, the drives and the
+     *            datasette are executed after the CPU. Hence, a drive can still be scheduled for the
+     *            current cycle in the CPU phase.
+     */
+    inline void scheduleEvent(EventSlot slot, uint64_t cycle) {
+        eventCycle[slot] = cycle; if (cycle < nextEventCycle) nextEventCycle = cycle; }
+
+    
     //
     //! @functiongroup Loading ROM images
     //
@@ -523,7 +623,8 @@ public:
 	bool flushArchive(Archive *a, int item);
 	
 	/*! @brief    Inserts an archive as a virtual floppy disk.
-     *  @details  Only D64 and G64 archives are supported.
+     *  @details  D64, G64, and NIB archives are inserted as they are. All other archives are
+     *            converted into a D64 archive first.
      */
 	bool mountArchive(Archive *a);
 
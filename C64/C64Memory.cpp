@@ -88,6 +88,13 @@ void C64Memory::reset()
 	poke(0x0001, 0x1F);	// IO port, set default memory layout
 }	
 
+void
+C64Memory::loadFromBuffer(uint8_t **buffer)
+{
+    VirtualComponent::loadFromBuffer(buffer);
+    updatePlainPages();
+}
+
 // --------------------------------------------------------------------------------
 //                                      Input / Output
 // --------------------------------------------------------------------------------
@@ -276,6 +283,64 @@ C64Memory::updatePeekPokeLookupTables()
     target = BankMap[index][4];
     assert(target == M_IO || target == M_CHAR || target == M_RAM);
     pokeTarget[0xD] = (target == M_IO ? M_IO : M_RAM);
+    
+    updatePlainPages();
+}
+
+void
+C64Memory::updatePlainPages()
+{
+    for (unsigned page = 0; page < 256; page++) {
+        
+        updatePlainPeekPage(page);
+        
+        switch (pokeTarget[page >> 4]) {
+            case M_RAM:
+            case M_PP:
+                plainPokePage[page] = &ram[page << 8];
+                break;
+            default:
+                plainPokePage[page] = NULL;
+        }
+    }
+    
+    // Skip the processor port registers
+    firstPlainAddr = 0x0002;
+}
+
+void
+C64Memory::bankSwitched(uint16_t addr, uint16_t size)
+{
+    for (unsigned page = addr >> 8; page < (unsigned)(addr + size) >> 8; page++) {
+        
+        // Code that has been translated from the old bank is outdated now
+        codeModified(page << 8);
+        updatePlainPeekPage(page);
+    }
+}
+
+void
+C64Memory::updatePlainPeekPage(unsigned page)
+{
+    switch (peekSrc[page >> 4]) {
+        case M_RAM:
+        case M_PP:
+        case M_NONE:
+            plainPeekPage[page] = &ram[page << 8];
+            break;
+        case M_ROM:
+            plainPeekPage[page] = &rom[page << 8];
+            break;
+        case M_CRTLO:
+        case M_CRTHI:
+            if (c64->expansionport.romIsBlendedIn(page << 8))
+                plainPeekPage[page] = c64->expansionport.getRomPage(page);
+            else
+                plainPeekPage[page] = &ram[page << 8];
+            break;
+        default:
+            plainPeekPage[page] = NULL;
+    }
 }
 
 
@@ -325,7 +390,8 @@ uint8_t C64Memory::peekIO(uint16_t addr)
             Lesen von offenen Adressen liefert nämlich auf vielen C64 das zuletzt vom
             VIC gelesene Byte zurück!)" [C.B.] */
         
-		return c64->vic.getDataBus();
+        // Some cartridges place additional memory here. So we ask the expansion port...
+		return c64->expansionport.peekIO(addr);
 	}
 
 	assert(false);
@@ -334,52 +400,24 @@ uint8_t C64Memory::peekIO(uint16_t addr)
 
 uint8_t C64Memory::peek(uint16_t addr)
 {	
-    MemorySource src = peekSrc[addr >> 12];
-
-    switch(src) {
-            
-        case M_RAM:
-            return ram[addr];
-            
-        case M_ROM:
-            return rom[addr];
-            
-        case M_IO:
-            return peekIO(addr);
-            
-        case M_CRTLO:
-        case M_CRTHI:
-
-            if (c64->expansionport.romIsBlendedIn(addr))
-                return c64->expansionport.peek(addr);
-            else
-                return ram[addr];
-            
-        case M_PP:
-            
-            uint8_t dir, ext, result;
-            
-            if (addr > 0x0001)
-                return ram[addr];
-            
-            // Processor port
-            dir = cpu->getPortDirection();
-            ext = cpu->getExternalPortBits();
-            
-            // Datasette (move to getExternalPortBits(?) after cleanup)
-            if (c64->datasette.getPlayKey()) ext &= 0xEF; else ext |= 0x10;
-            
-            result = (addr == 0x0000) ? dir : (dir & cpu->getPort()) | (~dir & ext);
-            return result;
-
-        case M_NONE:
-            // what happens if RAM is unmapped?
-            return ram[addr];
-
-        default:
-            assert(0);
-            return 0;
+    // RAM, ROM, and cartridge ROM (unmapped RAM reads as RAM)
+    if (isPlainPeekAddr(addr))
+        return peekPlain(addr);
+    
+    // I/O space
+    if (addr > 0x0001) {
+        assert(peekSrc[addr >> 12] == M_IO);
+        return peekIO(addr);
     }
+    
+    // Processor port
+    uint8_t dir = cpu->getPortDirection();
+    uint8_t ext = cpu->getExternalPortBits();
+    
+    // Datasette (move to getExternalPortBits(?) after cleanup)
+    if (c64->datasette.getPlayKey()) ext &= 0xEF; else ext |= 0x10;
+    
+    return (addr == 0x0000) ? dir : (dir & cpu->getPort()) | (~dir & ext);
 }
 
 
@@ -443,40 +481,27 @@ void C64Memory::pokeIO(uint16_t addr, uint8_t value)
 
 void C64Memory::poke(uint16_t addr, uint8_t value)
 {	
-
-	MemorySource target = pokeTarget[addr >> 12];
-	
-	switch(target) {
-			
-		case M_RAM:
-			ram[addr] = value;
-			return;
-			
-		case M_IO:
-			pokeIO(addr, value);
-			return;
-			
-		case M_PP:
-			
-			if (addr > 0x0001) {
-				ram[addr] = value;
-				return;
-			}
-			
-			// Processor port
-			if (addr == 0x0000) {
-				cpu->setPortDirection(value);
-                updatePeekPokeLookupTables();
-			} else {
-				cpu->setPort(value);
-                updatePeekPokeLookupTables();
-			}
-			return;
-
-		default:
-			assert(0);
-			return;
-	}
+    // RAM (writes into ROM and cartridge ROM areas end up in RAM, too)
+    if (isPlainPokeAddr(addr)) {
+        pokePlain(addr, value);
+        return;
+    }
+    
+    // I/O space
+    if (addr > 0x0001) {
+        assert(pokeTarget[addr >> 12] == M_IO);
+        pokeIO(addr, value);
+        return;
+    }
+    
+    // Processor port
+    if (addr == 0x0000) {
+        cpu->setPortDirection(value);
+        updatePeekPokeLookupTables();
+    } else {
+        cpu->setPort(value);
+        updatePeekPokeLookupTables();
+    }
 }
 
 
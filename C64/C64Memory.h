@@ -194,6 +194,9 @@ public:
 	//! @brief    Restores the initial state
 	void reset();
 	
+	//! @brief    Reads the internal state from a buffer.
+	void loadFromBuffer(uint8_t **buffer);
+
 	//! @brief    Prints debug information
 	void dumpState();
 		
@@ -224,6 +227,9 @@ private:
     //! @brief    Lookup table for poke()
     MemorySource pokeTarget[16];
     
+    //! @brief    Updates the plain read pointer of a single page
+    void updatePlainPeekPage(unsigned page);
+    
 public:
     
     /*! @brief    Updates the peek and poke lookup tables.
@@ -231,9 +237,26 @@ public:
      */
     void updatePeekPokeLookupTables();
 
+    /*! @brief    Updates the plain page tables.
+     *  @details  RAM, ROM, and cartridge ROM pages are plain. The I/O space and the processor
+     *            port are not. The function needs to be called whenever the memory
+     *            configuration changes. Cartridge bank switches call bankSwitched() instead.
+     */
+    void updatePlainPages();
+
+    /*! @brief    Notifies memory that the cartridge has switched the ROM of a memory area
+     *  @details  Updates the plain read pointers of the affected pages and invalidates the code
+     *            translated from them. The rest of the address space is left untouched, which
+     *            makes bank switches independent of the size of the address space.
+     */
+    void bankSwitched(uint16_t addr, uint16_t size);
+
     //! @brief    Returns true iff the provided address is a valid address of the specified type
 	bool isValidAddr(uint16_t addr, MemoryType type);
 
+    //! @brief    Returns true iff the Kernel ROM is currently visible to the CPU
+    inline bool kernelIsVisible() { return peekSrc[0xE] == M_KERNEL; }
+
     //! @brief    Reads a byte from RAM.
     inline uint8_t peekRam(uint16_t addr) { return ram[addr]; }
 
@@ -249,10 +272,10 @@ public:
     uint8_t peek(uint16_t addr);
 
     //! @brief    Write a byte into RAM.
-    void pokeRam(uint16_t addr, uint8_t value) { ram[addr] = value; }
+    void pokeRam(uint16_t addr, uint8_t value) { codeModified(addr); ram[addr] = value; }
 
     //! @brief    Write a byte into ROM.
-    void pokeRom(uint16_t addr, uint8_t value) { rom[addr] = value; }
+    void pokeRom(uint16_t addr, uint8_t value) { codeModified(addr); rom[addr] = value; }
 
     //! @brief    Write a byte into I/O space.
     void pokeIO(uint16_t addr, uint8_t value);
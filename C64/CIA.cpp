@@ -74,6 +74,28 @@ CIA::reset()
 	
 	latchA = 0xFFFF;
 	latchB = 0xFFFF;
+
+    tiredness = 0;
+    sleeping = false;
+    sleepCycle = 0;
+}
+
+void
+CIA::loadFromBuffer(uint8_t **buffer)
+{
+    VirtualComponent::loadFromBuffer(buffer);
+    
+    // Sleep state is not part of the snapshot (the C64 executes the CIA in the next cycle)
+    tiredness = 0;
+    sleeping = false;
+    sleepCycle = 0;
+}
+
+void
+CIA::saveToBuffer(uint8_t **buffer)
+{
+    wakeUp();
+    VirtualComponent::saveToBuffer(buffer);
 }
 
 void
@@ -85,6 +107,9 @@ CIA::triggerRisingEdgeOnFlagPin()
 void
 CIA::triggerFallingEdgeOnFlagPin()
 {
+    // Invoked by the datasette after the CIA has been executed in the current cycle
+    wakeUp(c64->getCycles() + 1);
+    
     ICR |= 0x10; // Note: FLAG pin is inverted
         
     // Trigger interrupt, if enabled
@@ -440,6 +465,8 @@ void CIA::poke(uint16_t addr, uint8_t value)
 void 
 CIA::incrementTOD()
 {
+    wakeUp();
+    
 	if (tod.increment()) {
 		// Set interrupt source
 		ICR |= 0x04; 
@@ -494,6 +521,8 @@ void CIA::dumpTrace()
 
 void CIA::dumpState()
 {
+    wakeUp();
+    
 	msg("              Counter A : %02X\n", getCounterA());
 	msg("                Latch A : %02X\n", getLatchA());
 	msg("            Data port A : %02X\n", getDataPortA());
@@ -516,6 +545,9 @@ void CIA::dumpState()
 
 void CIA::executeOneCycle()
 {	
+    wakeUp();
+    uint32_t oldDelay = delay;
+    
 	//
 	// Layout of timer (A and B)
 	//
@@ -745,6 +777,72 @@ void CIA::executeOneCycle()
 
 	// move delay flags left and feed in new bits
 	delay = ((delay << 1) & DelayMask) | feed;
+    
+    // Go to sleep if the internal state has settled
+    if (delay == oldDelay) {
+        if (++tiredness > 8) {
+            sleep();
+        }
+    } else {
+        tiredness = 0;
+    }
+}
+
+void
+CIA::sleep()
+{
+    // The CIA is executed in cycle 'now' and skipped afterwards
+    uint64_t now = c64->getCycles();
+    uint64_t wakeUpCycle;
+    uint64_t sleepA = UINT64_MAX;
+    uint64_t sleepB = UINT64_MAX;
+    
+    // Determine the cycle in which timer A underflows
+    if (delay & CountA3) {
+        if (counterA < 2)
+            return;
+        sleepA = now + counterA;
+    }
+
+    // Determine the cycle in which timer B underflows
+    if (delay & CountB3) {
+        if (counterB < 2)
+            return;
+        sleepB = now + counterB;
+    }
+    
+    wakeUpCycle = (sleepA < sleepB) ? sleepA : sleepB;
+    sleepCycle = now + 1;
+    sleeping = true;
+    scheduleWakeUp(wakeUpCycle);
+}
+
+void
+CIA::wakeUp()
+{
+    wakeUp(c64->getCycles());
+}
+
+void
+CIA::_wakeUp(uint64_t cycle)
+{
+    assert(sleeping);
+    assert(cycle >= sleepCycle);
+    
+    // Catch up with the skipped cycles
+    uint64_t idleCycles = cycle - sleepCycle;
+    if (delay & CountA3) {
+        assert(counterA > idleCycles);
+        counterA -= idleCycles;
+    }
+    if (delay & CountB3) {
+        assert(counterB > idleCycles);
+        counterB -= idleCycles;
+    }
+    
+    tiredness = 0;
+    sleeping = false;
+    scheduleWakeUp(0);
 }
 
 
@@ -791,6 +889,12 @@ CIA1::clearInterruptLine()
 	c64->cpu.clearIRQLineCIA();
 }
 
+void
+CIA1::scheduleWakeUp(uint64_t cycle)
+{
+    c64->scheduleEvent(C64::CIA1_SLOT, cycle);
+}
+
 void 
 CIA1::pollJoystick(Joystick *joy, int joyDevNo)
 {
@@ -838,6 +942,9 @@ CIA1::pollJoystick(Joystick *joy, int joyDevNo)
 uint8_t 
 CIA1::peek(uint16_t addr)
 {
+    // The CPU accesses the registers after the CIA has been executed in the current cycle
+    wakeUp(c64->getCycles() + 1);
+    
 	uint8_t result;
 	
 	assert(addr <= CIA1_END_ADDR - CIA1_START_ADDR);
@@ -885,6 +992,8 @@ CIA1::peek(uint16_t addr)
 void 
 CIA1::poke(uint16_t addr, uint8_t value)
 {
+    wakeUp(c64->getCycles() + 1);
+    
     uint8_t PBold;
     
 	assert(addr <= CIA1_END_ADDR - CIA1_START_ADDR);
@@ -995,9 +1104,17 @@ CIA2::clearInterruptLine()
 	c64->cpu.clearNMILineCIA();
 }
 
+void
+CIA2::scheduleWakeUp(uint64_t cycle)
+{
+    c64->scheduleEvent(C64::CIA2_SLOT, cycle);
+}
+
 uint8_t 
 CIA2::peek(uint16_t addr)
 {
+    wakeUp(c64->getCycles() + 1);
+    
 	uint8_t result;
 	
 	assert(addr <= CIA_END_ADDR - CIA_START_ADDR);
@@ -1009,8 +1126,8 @@ CIA2::peek(uint16_t addr)
 			
 			// The two upper bits are connected to the clock line and the data line
 			result &= 0x3F;
-			result |= (c64->iec.getClockLine() ? 0x40 : 0x00);
-			result |= (c64->iec.getDataLine() ? 0x80 : 0x00);
+			result |= (c64->iec.getCiaClockLine() ? 0x40 : 0x00);
+			result |= (c64->iec.getCiaDataLine() ? 0x80 : 0x00);
 
 			// The external port lines can pull down any bit, even if it configured as output.
 			// Note that bits 0 and 1 are not connected to the bus and determine the memory bank seen by the VIC chip
@@ -1031,6 +1148,8 @@ CIA2::peek(uint16_t addr)
 void 
 CIA2::poke(uint16_t addr, uint8_t value)
 {
+    wakeUp(c64->getCycles() + 1);
+    
 	assert(addr <= CIA2_END_ADDR - CIA2_START_ADDR);
 	
 	switch(addr) {
@@ -158,6 +158,26 @@ public:
     //! @brief    Indicates if ICR register is currently read
 	bool readICR;
 
+    //
+    // Sleep logic
+    //
+    
+    /*! @brief    Counts the number of cycles without a state change
+     *  @details  If the internal state stays the same for several cycles in a row, the CIA goes to sleep.
+     */
+    uint8_t tiredness;
+    
+    /*! @brief    Indicates whether the CIA is currently sleeping
+     *  @details  While the CIA is sleeping, the C64 doesn't execute it until the cycle registered with
+     *            scheduleWakeUp is reached. If nothing happens in the meantime, this is the cycle in which
+     *            the next timer underflow occurs.
+     */
+    bool sleeping;
+    
+    //! @brief    First cycle in which the CIA has been skipped
+    uint64_t sleepCycle;
+    
+
 	/*! @brief    Activates the interrupt line
 	 *  @details  The function is abstract and will be implemented differently by the CIA 1 and CIA 2 class.
      *            Whereas the CIA 1 activates the IRQ line, the CIA 2 activates clears the NMI line.
@@ -170,6 +190,13 @@ public:
      */
 	virtual void clearInterruptLine() = 0;	
 	
+    /*! @brief    Tells the C64 in which cycle the CIA needs to be executed next
+     *  @details  The function is abstract and will be implemented differently by the CIA 1 and CIA 2 class,
+     *            because both chips occupy different slots in the C64 event table. Zero means that the CIA
+     *            is executed in each cycle.
+     */
+    virtual void scheduleWakeUp(uint64_t cycle) = 0;
+    
     
     // -----------------------------------------------------------------------------------------------
     //                                             Methods
@@ -189,6 +216,12 @@ public:
 	//! @brief    Bring the CIA back to its initial state
 	void reset();
     	
+    //! @brief    Custom implementation of loadFromBuffer (the CIA always wakes up after loading)
+    void loadFromBuffer(uint8_t **buffer);
+    
+    //! @brief    Custom implementation of saveToBuffer (puts a sleeping CIA back in sync first)
+    void saveToBuffer(uint8_t **buffer);
+    
 	//! @brief    Dump internal state
 	void dumpState();	
 
@@ -481,8 +514,26 @@ public:
 	//! @brief    Executes the CIA for one cycle
 	void executeOneCycle();
 
+    /*! @brief    Puts the CIA back in sync
+     *  @details  The function needs to be called whenever the CIA state is accessed from outside while the
+     *            CIA might be sleeping. It catches up with the skipped cycles and cancels the sleep period.
+     *  @param    cycle  Next cycle in which the CIA is executed. All cycles before have been skipped.
+     */
+    inline void wakeUp(uint64_t cycle) { if (sleeping) _wakeUp(cycle); }
+    
+    //! @brief    Puts the CIA back in sync in between two cycles
+    void wakeUp();
+    
 	//! Increments the TOD clock by one tenth of a second
 	void incrementTOD();
+
+private:
+    
+    //! @brief    Sends the CIA to sleep until the next timer underflow
+    void sleep();
+    
+    //! @brief    Helper function for wakeUp
+    void _wakeUp(uint64_t cycle);
 };
 
 
@@ -517,6 +568,9 @@ private:
      *  @details  Note that CIA 1 is connected to the IRQ line
      */    void clearInterruptLine();
 
+    //! @brief    Registers the next wake-up cycle in the CIA 1 slot of the C64 event table
+    void scheduleWakeUp(uint64_t cycle);
+
 	
 public:
 
@@ -580,6 +634,9 @@ private:
      */
     void clearInterruptLine();
 
+    //! @brief    Registers the next wake-up cycle in the CIA 2 slot of the C64 event table
+    void scheduleWakeUp(uint64_t cycle);
+
 		
 public:
 
@@ -28,6 +28,16 @@ CPU::CPU()
 
 	// Establish callback for each instruction
 	registerInstructions();
+    registerFastPath();
+    registerTranslation();
+    fastPath = true;
+    fastPathCycles = 0;
+    nextInterruptCycle = 0;
+    interruptGating = true;
+    translation = false;
+    translationCache = NULL;
+    clock = NULL;
+    floppy = NULL;
 		
 	// Clear all breakpoint tags
 	for (int i = 0; i <  65536; i++) {
@@ -69,7 +79,6 @@ CPU::CPU()
         { &irqLine,                 sizeof(irqLine),                CLEAR_ON_RESET },
         { &nmiLine,                 sizeof(nmiLine),                CLEAR_ON_RESET },
         { &nmiEdge,                 sizeof(nmiEdge),                CLEAR_ON_RESET },
-        { &interruptsPending,       sizeof(interruptsPending),      CLEAR_ON_RESET },
         { &nextPossibleIrqCycle,    sizeof(nextPossibleIrqCycle),   CLEAR_ON_RESET },
         { &nextPossibleNmiCycle,    sizeof(nextPossibleNmiCycle),   CLEAR_ON_RESET },
         { &errorState,              sizeof(errorState),             CLEAR_ON_RESET },
@@ -84,6 +93,7 @@ CPU::CPU()
 CPU::~CPU()
 {
 	debug(3, "  Releasing CPU...\n");
+    delete[] translationCache;
 }
 
 void
@@ -94,7 +104,10 @@ CPU::reset()
     B = 1; 
 	external_port_bits = 0x1F;
 	rdyLine = true;
-	next = &CPU::fetch;
+	next = MC_fetch;
+    nextInterruptCycle = 0;
+    fastPathCycles = 0;
+    flushTranslationCache();
 }
 
 uint32_t
@@ -107,22 +120,31 @@ void
 CPU::loadFromBuffer(uint8_t **buffer) 
 {
     VirtualComponent::loadFromBuffer(buffer);
-	next = CPU::callbacks[read16(buffer)];
+	next = (MicroInstruction)read16(buffer);
+    if (next >= MC_COUNT) {
+        warn("Snapshot contains an unknown microcode state (%d)\n", next);
+        next = MC_fetch;
+    }
+    nextInterruptCycle = 0;
+    fastPathCycles = 0;
+    flushTranslationCache();
 }
 
 void
 CPU::saveToBuffer(uint8_t **buffer) 
 {
+    // Pending fast path instructions are stored in microcode format. The idle cycles
+    // of a translated block are skipped.
+    if (next == MC_translatedBlockDone) {
+        fastPathCycles = 0;
+        next = MC_fetch;
+    } else if (fastPathCycles) {
+        leaveFastPath();
+    }
+    
     VirtualComponent::saveToBuffer(buffer);
-	for (uint16_t i = 0;; i++) {
-		if (callbacks[i] == NULL) {
-			panic("ERROR while saving state: Callback pointer not found!\n");
-		}
-		if (callbacks[i] == next) {
-			write16(buffer, i);
-			break;
-		}
-	}
+    assert(next != MC_fastPathExecute && next != MC_translatedBlockDone);
+	write16(buffer, next);
 }
 
 void 
@@ -183,16 +205,33 @@ CPU::setIRQLine(uint8_t bit)
 	assert(bit != 0);
     
 	if (irqLine == 0) {
-		nextPossibleIrqCycle = c64->getCycles() + 2;
+		nextPossibleIrqCycle = *clock + 2;
 	}
 	irqLine |= bit; 
-    interruptsPending = true;
+    if (nextInterruptCycle > nextPossibleIrqCycle)
+        nextInterruptCycle = nextPossibleIrqCycle;
 }
 
 bool 
 CPU::IRQLineRaisedLongEnough() 
 { 
-	return c64->getCycles() >= nextPossibleIrqCycle;
+	return *clock >= nextPossibleIrqCycle;
+}
+
+void
+CPU::updateNextInterruptCycle()
+{
+    if (!interruptGating) {
+        nextInterruptCycle = 0;
+        return;
+    }
+    
+    nextInterruptCycle = UINT64_MAX;
+    
+    if (nmiEdge)
+        nextInterruptCycle = nextPossibleNmiCycle;
+    if (irqLine && nextPossibleIrqCycle < nextInterruptCycle)
+        nextInterruptCycle = nextPossibleIrqCycle;
 }
 
 bool
@@ -220,21 +259,21 @@ void
 CPU::setNMIEdge()
 {
     nmiEdge = true;
-    interruptsPending = true;
-    nextPossibleNmiCycle = c64->getCycles() + 2;
+    nextPossibleNmiCycle = *clock + 2;
+    if (nextInterruptCycle > nextPossibleNmiCycle)
+        nextInterruptCycle = nextPossibleNmiCycle;
 }
 
 void
 CPU::clearNMIEdge()
 {
     nmiEdge = false;
-    interruptsPending = irqLine;
 }
 
 bool
 CPU::NMILineRaisedLongEnough()
 { 
-	return c64->getCycles() >= nextPossibleNmiCycle;
+	return *clock >= nextPossibleNmiCycle;
 }
 
 
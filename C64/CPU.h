@@ -22,6 +22,10 @@
 #define _CPU_INC
 
 #include "Memory.h"
+#include "Microcode.h"
+
+// Forward declarations
+class VC1541;
 
 /*! @class  The virtual 6510 processor
  */
@@ -51,6 +55,17 @@ public:
 		ADDR_DIRECT,
 		ADDR_INDIRECT
 	};
+
+    #define MICROCODE_ENUM(name) MC_##name,
+
+    /*! @brief    Microcode states
+     *  @details  Each state refers to an entry in the callbacks table. The current state is
+     *            stored in snapshots as is, which makes its value independent of the build.
+     */
+    enum MicroInstruction : uint16_t {
+        MICRO_INSTRUCTIONS(MICROCODE_ENUM)
+        MC_COUNT
+    };
 	
 	/*! @brief    Error states of the virtual CPU
 	 *  @details  CPU_OK indicates normal operation. When a (soft or hard) breakpoint is reached, 
@@ -72,11 +87,17 @@ public:
      *
      *            HARD_BREAKPOINT: execution is halted
      *            SOFT_BREAKPOINT: execution is halted and the tag is deleted
+     *
+     *            In addition, a memory cell can be tagged with TRAP. When the CPU is about to fetch
+     *            an instruction from such a cell, the trap handler of the IEC bus is invoked which
+     *            may execute the subroutine natively (see IEC::executeTrap). Trap tags are invisible
+     *            to the breakpoint accessors.
      */
 	enum Breakpoint {
 		NO_BREAKPOINT   = 0x00,
 		HARD_BREAKPOINT = 0x01,
-		SOFT_BREAKPOINT = 0x02
+		SOFT_BREAKPOINT = 0x02,
+		TRAP            = 0x80
 	};
 
 	//! @brief    Clock frequency of the original C64 (NTSC version) in Hz
@@ -111,6 +132,15 @@ public:
 	//! @brief    Reference to the connected virtual memory
 	Memory *mem;
 
+    //! @brief    Reference to the drive this CPU belongs to (NULL for the C64 CPU)
+    VC1541 *floppy;
+
+    /*! @brief    Reference to the clock the interrupt timing is based on
+     *  @details  Points to the cycle counter of the C64. The drive CPU is redirected to the cycle
+     *            counter of the drive while the drive runs on its own thread.
+     */
+    uint64_t *clock;
+
     /*! @brief    Selected chip model
      *  @abstract Right now, this atrribute is only used to distinguish the C64 CPU (MOS6510) from the
      *            VC1541 CPU (MOS6502). Hardware differences between the two processors are not emulated.
@@ -237,11 +267,20 @@ private:
      */
 	bool nmiEdge;
 	
-    /*! @brief    Indicates if the CPU has to check for pending interrupts in its fetch phase
-     *  @details  This variable has beed introduced for speedup. At all times, it is equivalent
-     *            to "(irqLine || nmiEdge)".
+    /*! @brief    First cycle in which the CPU has to check for pending interrupts
+     *  @details  This variable has been introduced for speedup. It is never larger than the first
+     *            cycle in which an interrupt could be triggered, i.e., nextPossibleNmiCycle if an
+     *            NMI edge is pending and nextPossibleIrqCycle if the IRQ line is set. If neither
+     *            is the case, it may be UINT64_MAX. The fetch phase skips all interrupt checks
+     *            before this cycle and recomputes the value when no interrupt can be triggered.
+     */
+    uint64_t nextInterruptCycle;
+    
+    /*! @brief    Indicates if interrupt checks are skipped before nextInterruptCycle
+     *  @details  If disabled, nextInterruptCycle is kept at 0 and the fetch phase checks for
+     *            interrupts in every instruction. This reference mode is used to verify the timing.
      */
-    bool interruptsPending;
+    bool interruptGating;
     
 	/*! @brief    Indicates when the next IRQ can occurr. 
      *  @details  This variable is set when a negative edge occurs on the irq line and stores the
@@ -261,12 +300,13 @@ private:
 	ErrorState errorState;
     
 	/*! @brief    Next function to be executed
-	 *  @details  Each function performs the actions of a single cycle 
+	 *  @details  Each function performs the actions of a single cycle. The function is looked
+     *            up in the callbacks table.
      */
-	void (CPU::*next)(void);
+	MicroInstruction next;
 	 
-	//! @brief    Callback function array pointing to the execution function of each instruction
-	void (CPU::*actionFunc[256])(void);
+	//! @brief    First microcode state of each instruction
+	MicroInstruction actionFunc[256];
 	
 	//! @brief    Breakpoint tag for each memory cell
 	uint8_t breakpoint[65536];
@@ -282,6 +322,109 @@ private:
 
 	//! @brief    Value of the I flag before it got changed with the SEI command.
 	uint8_t oldI;
+
+    //! @brief    Instruction classes handled by the fast path
+    enum FastPathKind {
+        FP_NONE = 0,
+        FP_READ,
+        FP_WRITE,
+        FP_MODIFY,
+        FP_OTHER
+    };
+
+    /*! @brief    Indicates if the instruction-granular fast path is enabled
+     *  @details  If enabled, the CPU decodes the complete instruction in its fetch phase. If all
+     *            memory locations touched by the instruction are plain (see Memory::plainPeekPage),
+     *            the CPU lets the following cycles pass idly and executes the instruction as a
+     *            whole in the cycle in which the original CPU performs its last memory access.
+     *            Because plain memory can't be changed by anybody else, the result is identical
+     *            to the microcode execution. Cycles with the RDY line pulled down don't count,
+     *            because all of them are read cycles in which the original CPU would freeze.
+     */
+    bool fastPath;
+
+    /*! @brief    Decoder function of each opcode
+     *  @details  NULL, if the instruction is always executed cycle by cycle.
+     */
+    void (CPU::*fastPathPrepare[256])(void);
+
+    /*! @brief    Number of cycles until the pending fast path instruction has been executed
+     *  @details  0, if no fast path instruction is pending. 
+     */
+    uint8_t fastPathCycles;
+
+    //! @brief    Initial value of fastPathCycles (used to reconstruct the microcode state)
+    uint8_t fastPathLength;
+
+    //! @brief    Effective address of the pending fast path instruction
+    uint16_t fastPathAddr;
+
+    //! @brief    Indicates if the last cycle of the pending fast path instruction is a read cycle
+    bool fastPathRead;
+
+    //! @brief    Maximum number of instructions in a translated block
+    static const unsigned MAX_BLOCK_LENGTH = 16;
+
+    //! @brief    Number of blocks in the translation cache (must be a power of two)
+    static const unsigned TRANSLATION_CACHE_SIZE = 512;
+
+    //! @brief    A single decoded instruction of a translated block
+    struct TranslatedInstruction {
+
+        //! @brief    Executes the instruction and returns the number of elapsed cycles
+        uint8_t (CPU::*handler)(const TranslatedInstruction *);
+
+        //! @brief    Immediate value, address, or branch offset
+        uint16_t operand;
+
+        //! @brief    Address of the next instruction
+        uint16_t next;
+
+        //! @brief    Opcode
+        uint8_t opcode;
+    };
+
+    /*! @brief    A translated basic block
+     *  @details  A block ends with the first control transfer instruction or with the first
+     *            instruction that can't be translated. It never crosses a page boundary.
+     */
+    struct TranslatedBlock {
+
+        //! @brief    Start address
+        uint16_t pc;
+
+        //! @brief    Number of instructions
+        uint8_t length;
+
+        //! @brief    Memory page the block has been translated from
+        uint8_t *code;
+
+        //! @brief    Version number of the page at translation time (see Memory::pageVersion)
+        uint32_t version;
+
+        TranslatedInstruction instr[MAX_BLOCK_LENGTH];
+    };
+
+    /*! @brief    Indicates if guest code is executed in translated blocks
+     *  @details  If enabled, the fetch phase looks up the basic block starting at the program
+     *            counter in the translation cache and executes all of its instructions at once.
+     *            The following cycles pass idly until the next instruction of the original CPU
+     *            would be fetched. As a result, the cycle count stays intact, but memory accesses
+     *            happen earlier than they should and interrupts are only taken between blocks.
+     *            Hence, this mode is not cycle exact and meant to be used in warp mode.
+     */
+    bool translation;
+
+    /*! @brief    Translated basic blocks
+     *  @details  Direct mapped by the start address of the block. NULL, if translation is
+     *            disabled.
+     */
+    TranslatedBlock *translationCache;
+
+    /*! @brief    Handler function of each opcode
+     *  @details  NULL, if the instruction terminates a block without being part of it.
+     */
+    uint8_t (CPU::*translatedHandler[256])(const TranslatedInstruction *);
 			
 #include "Instructions.h"
 		
@@ -410,7 +553,7 @@ public:
 	inline void setPC(uint16_t pc) { PC = pc; }
     
 	//! @brief    Writes value to the freezend program counter.
-	inline void setPC_at_cycle_0(uint16_t pc) { PC_at_cycle_0 = PC = pc; next = &CPU::fetch;}
+	inline void setPC_at_cycle_0(uint16_t pc) { PC_at_cycle_0 = PC = pc; next = MC_fetch; fastPathCycles = 0; }
     
 	//! @brief    Changes low byte of the program counter only.
 	inline void setPCL(uint8_t lo) { PC = (PC & 0xff00) | lo; }
@@ -492,13 +635,16 @@ public:
 	void setIRQLine(uint8_t bit);
 	
 	//! @brief    Clears a bit of the IRQ line.
-    inline void clearIRQLine(uint8_t bit) { irqLine &= ~bit; interruptsPending = irqLine || nmiEdge; }
+    inline void clearIRQLine(uint8_t bit) { irqLine &= ~bit; }
 		
 	//! @brief    Returns bit of IRQ line.
 	inline uint8_t getIRQLine(uint8_t bit) { return irqLine & bit; }
 	
 	//! @brief    Checks if IRQ line has been activated for at least 2 cycles.
 	bool IRQLineRaisedLongEnough();
+
+    //! @brief    Computes the first cycle in which an interrupt could be triggered.
+    void updateNextInterruptCycle();
 	
 	//! @brief    Sets bit of NMI line.
 	void setNMILine(uint8_t bit);
@@ -595,7 +741,7 @@ public:
 	char *disassemble();
 				
 	//! @brief    Returns true, iff the next cycle is the first cycle of a command.
-	inline bool atBeginningOfNewCommand() { return next == &CPU::fetch; }
+	inline bool atBeginningOfNewCommand() { return next == MC_fetch; }
 	
     
     //
@@ -603,9 +749,35 @@ public:
     //
     
 	/*! @brief    Executes the device for one cycle.
-	 *  @details  This is the normal operation mode. Interrupt requests are handled. 
+	 *  @details  This is the normal operation mode. Interrupt requests are handled. While a fast
+     *            path instruction is pending, the cycle passes idly.
      */
-	inline bool executeOneCycle() { (*this.*next)(); return errorState == CPU::OK; }
+	inline bool executeOneCycle() {
+        if (fastPathCycles > 1) { if (rdyLine) fastPathCycles--; } else callbacks[next](this);
+        return errorState == CPU::OK; }
+
+    //! @brief    Returns true, iff the instruction-granular fast path is enabled.
+    inline bool getFastPath() { return fastPath; }
+
+    //! @brief    Enables or disables the instruction-granular fast path.
+    void setFastPath(bool enable) { fastPath = enable; }
+
+    //! @brief    Returns true, iff interrupt checks are skipped while no interrupt can occur.
+    inline bool getInterruptGating() { return interruptGating; }
+
+    //! @brief    Enables or disables skipping interrupt checks.
+    void setInterruptGating(bool enable) { interruptGating = enable; updateNextInterruptCycle(); }
+
+    //! @brief    Returns true, iff guest code is executed in translated blocks.
+    inline bool getTranslation() { return translation; }
+
+    /*! @brief    Enables or disables the execution of translated blocks
+     *  @details  Disabling translation brings back cycle exact execution.
+     */
+    void setTranslation(bool enable);
+
+    //! @brief    Discards all translated blocks.
+    void flushTranslationCache();
 
 	//! @brief    Returns the current error state.
     inline ErrorState getErrorState() { return errorState; }
@@ -622,13 +794,13 @@ public:
     //
     
 	//! @brief    Returns breakpoint tag for the specified address.
-	inline uint8_t getBreakpointTag(uint16_t addr) { return breakpoint[addr]; }
+	inline uint8_t getBreakpointTag(uint16_t addr) { return breakpoint[addr] & ~TRAP; }
 	
 	//! @brief    Returns the breakpoint tag for the specified address.
-	uint8_t getBreakpoint(uint16_t addr) { return breakpoint[addr]; }
+	uint8_t getBreakpoint(uint16_t addr) { return breakpoint[addr] & ~TRAP; }
 
 	//! @brief    Sets a breakpoint tag at the specified address.
-	void setBreakpoint(uint16_t addr, uint8_t tag) { breakpoint[addr] = tag; }
+	void setBreakpoint(uint16_t addr, uint8_t tag) { breakpoint[addr] = (breakpoint[addr] & TRAP) | (tag & ~TRAP); }
 	
 	//! @brief    Sets a hard breakpoint at the specified address.
     void setHardBreakpoint(uint16_t addr) { breakpoint[addr] |= HARD_BREAKPOINT; }
@@ -648,6 +820,12 @@ public:
 	//! @brief    Sets or deletes a hard breakpoint at the specified address.
 	void toggleSoftBreakpoint(uint16_t addr) { breakpoint[addr] ^= SOFT_BREAKPOINT; }
 
+    //! @brief    Installs a trap at the specified address.
+    void setTrap(uint16_t addr) { breakpoint[addr] |= TRAP; }
+    
+    //! @brief    Removes a trap from the specified address.
+    void deleteTrap(uint16_t addr) { breakpoint[addr] &= ~TRAP; }
+
     
     //
     //! @functiongroup Querying the callstack
@@ -39,7 +39,7 @@ Cartridge::dealloc()
         data = NULL;
     }
     
-    for (unsigned i = 0; i < 64; i++)
+    for (unsigned i = 0; i < MAX_CHIPS; i++)
         chips[i] = NULL;
     
     numberOfChips = 0;
@@ -115,6 +115,11 @@ Cartridge::readFromBuffer(const uint8_t *buffer, unsigned length)
             return false;
         }
         
+        if (numberOfChips == MAX_CHIPS) {
+            warn("Cartridge contains more than %d chips\n", MAX_CHIPS);
+            return false;
+        }
+        
         // Remember start address of each chip section
         chips[numberOfChips] = ptr;
         
@@ -42,6 +42,14 @@
  */
 class Cartridge : public Container {
 
+public:
+    
+    /*! @brief    Maximum number of chips in a cartridge
+     *  @details  Large cartridges such as EasyFlash (64 banks of 2 x 8 KB) or Magic Desk
+     *            (up to 128 banks of 8 KB) contain up to 1 MB of ROM.
+     */
+    static const unsigned MAX_CHIPS = 128;
+
 private:
     
     //! @brief    Raw data of CRT container file
@@ -51,7 +59,7 @@ private:
     unsigned int numberOfChips;
     
     //! @brief    Indicates where each chip section starts
-    uint8_t *chips[64];
+    uint8_t *chips[MAX_CHIPS];
 
 public:
     
@@ -918,6 +918,170 @@ D64Archive::writeDirectoryEntry(unsigned nr, const char *name, uint8_t startTrac
 }
 
 
+unsigned
+D64Archive::numberOfFreeBlocks()
+{
+    int bam = offset(18, 0);
+    unsigned result = 0;
+    
+    // The directory track doesn't count
+    for (unsigned track = 1; track <= 35; track++) {
+        if (track != 18)
+            result += data[bam + 4 * track];
+    }
+    return result;
+}
+
+bool
+D64Archive::sectorIsFree(uint8_t track, uint8_t sector)
+{
+    int bam = offset(18, 0) + 4 * track;
+    
+    return data[bam + 1 + (sector >> 3)] & (0x01 << (sector & 0x07));
+}
+
+void
+D64Archive::markSectorAsFree(uint8_t track, uint8_t sector)
+{
+    int bam = offset(18, 0) + 4 * track;
+    uint8_t bitmask = 0x01 << (sector & 0x07);
+    
+    if (!(data[bam + 1 + (sector >> 3)] & bitmask)) {
+        data[bam + 1 + (sector >> 3)] |= bitmask;
+        data[bam]++;
+    }
+}
+
+bool
+D64Archive::findFreeSector(uint8_t *track, uint8_t *sector)
+{
+    int bam = offset(18, 0);
+    
+    for (int distance = 1; distance < 18; distance++) {
+        for (int t = 18 - distance; t <= 18 + distance; t += 2 * distance) {
+            
+            if (t < 1 || t > 35 || data[bam + 4 * t] == 0)
+                continue;
+            
+            for (int s = 0; s < D64Map[t].numberOfSectors; s++) {
+                if (sectorIsFree(t, s)) {
+                    *track = t;
+                    *sector = s;
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+int
+D64Archive::findFreeDirectoryEntry()
+{
+    uint8_t track = 18, sector = 1;
+    int pos = offset(track, sector);
+    
+    for (unsigned i = 0; i < 18; i++) {
+        
+        // Each directory sector holds eight entries
+        for (unsigned k = 0; k < 8; k++) {
+            if (data[pos + 0x20 * k + 2] == 0x00)
+                return pos + 0x20 * k + 2;
+        }
+        
+        // Continue with the next directory sector
+        if (data[pos] == 18 && data[pos + 1] < D64Map[18].numberOfSectors) {
+            pos = offset(18, data[pos + 1]);
+            continue;
+        }
+        
+        // Extend the directory if there is a free sector left on the directory track
+        for (uint8_t s = 1; s < D64Map[18].numberOfSectors; s++) {
+            if (sectorIsFree(18, s)) {
+                markSectorAsUsed(18, s);
+                data[pos] = 18;
+                data[pos + 1] = s;
+                pos = offset(18, s);
+                memset(data + pos, 0, 256);
+                data[pos + 1] = 0xFF;
+                return pos + 2;
+            }
+        }
+        break;
+    }
+    return -1;
+}
+
+bool
+D64Archive::writeItem(const char *name, const uint8_t *buffer, unsigned length)
+{
+    unsigned blocks = MAX(1, (length + 253) / 254);
+    uint8_t track, sector;
+    int entry, pos;
+    
+    if (blocks > numberOfFreeBlocks() || (entry = findFreeDirectoryEntry()) < 0)
+        return false;
+    if (!findFreeSector(&track, &sector))
+        return false;
+    
+    // Write directory entry
+    memset(data + entry, 0, 0x1E);
+    data[entry] = 0x82; // PRG
+    data[entry + 0x01] = track;
+    data[entry + 0x02] = sector;
+    for (unsigned i = 0; i < 16; i++)
+        data[entry + 0x03 + i] = (i < strlen(name)) ? name[i] : 0xA0;
+    data[entry + 0x1C] = LO_BYTE(blocks);
+    data[entry + 0x1D] = HI_BYTE(blocks);
+    
+    // Write data blocks
+    for (unsigned i = 0; i < blocks; i++) {
+        
+        unsigned chunk = MIN(254, length - 254 * i);
+        markSectorAsUsed(track, sector);
+        pos = offset(track, sector);
+        memset(data + pos, 0, 256);
+        memcpy(data + pos + 2, buffer + 254 * i, chunk);
+        
+        if (i == blocks - 1) {
+            data[pos] = 0x00;
+            data[pos + 1] = chunk + 1; // Position of the last data byte
+        } else {
+            (void)findFreeSector(&track, &sector);
+            data[pos] = track;
+            data[pos + 1] = sector;
+        }
+    }
+    
+    return true;
+}
+
+void
+D64Archive::deleteItem(int n)
+{
+    int entry = findDirectoryEntry(n);
+    if (entry <= 0)
+        return;
+    
+    // Release all sectors of the file (the chain is at most as long as the disk)
+    uint8_t track = data[entry + 0x01];
+    uint8_t sector = data[entry + 0x02];
+    for (unsigned i = 0; i < 683 && track >= 1 && track <= 35; i++) {
+        
+        if (sector >= D64Map[track].numberOfSectors || sectorIsFree(track, sector))
+            break;
+        
+        markSectorAsFree(track, sector);
+        int pos = offset(track, sector);
+        track = data[pos];
+        sector = data[pos + 1];
+    }
+    
+    // Mark directory entry as deleted
+    data[entry] = 0x00;
+}
+
+
 //
 // Debugging
 //
@@ -170,6 +170,9 @@ public:
 	//! @brief    Returns the high byte of the disk ID
 	uint8_t diskIdHi() { return data[offset(18, 0) + 0xA3]; }
 
+    //! @brief    Returns the number of free blocks as reported in directory listings
+    unsigned numberOfFreeBlocks();
+
  
     //
     //! @functiongroup Accessing tracks and sectors
@@ -269,6 +272,44 @@ private:
      */
     bool writeDirectoryEntry(unsigned nr, const char *name, uint8_t startTrack, uint8_t startSector, unsigned filesize);
     
+    //! @brief    Returns true iff the specified sector is marked as free in the BAM
+    bool sectorIsFree(uint8_t track, uint8_t sector);
+    
+    /*! @brief    Marks a single sector as "free"
+     */
+    void markSectorAsFree(uint8_t track, uint8_t sector);
+
+    /*! @brief    Searches the BAM for a free sector
+     *  @details  Like the VC1541 DOS, the search starts next to the directory track and moves
+     *            outwards.
+     *  @result   false, if the disk is full.
+     */
+    bool findFreeSector(uint8_t *track, uint8_t *sector);
+    
+    /*! @brief    Searches the directory for an unused directory entry
+     *  @details  If all entries are in use, the directory is extended by another sector.
+     *  @result   Offset of the file type byte of the entry or -1, if the directory is full.
+     */
+    int findFreeDirectoryEntry();
+    
+public:
+    
+    /*! @brief    Adds a program file to the archive
+     *  @details  The file is stored in sectors that are marked as free in the BAM and a new
+     *            directory entry of type PRG is created.
+     *  @param    name    Name of the file in PET format (up to 16 characters)
+     *  @param    buffer  File contents including the two byte load address
+     *  @param    length  Number of bytes in buffer
+     *  @result   false, if the disk or the directory is full.
+     */
+    bool writeItem(const char *name, const uint8_t *buffer, unsigned length);
+    
+    /*! @brief    Deletes an item (scratch)
+     *  @details  The sectors of the item are released in the BAM and the directory entry is
+     *            marked as deleted.
+     */
+    void deleteItem(int n);
+    
 
     //
     //! @functiongroup Debugging
@@ -52,6 +52,7 @@ Datasette::Datasette()
     size = 0;
     type = 0;
     durationInCycles = 0;
+    syncCycle = UINT64_MAX;
 }
 
 Datasette::~Datasette()
@@ -67,6 +68,7 @@ Datasette::reset()
 {
     VirtualComponent::reset();
     rewind();
+    syncCycle = UINT64_MAX;
 }
 
 void
@@ -96,6 +98,7 @@ Datasette::loadFromBuffer(uint8_t **buffer)
             data = (uint8_t *)malloc(size);
         readBlock(buffer, (uint8_t *)data, size);
     }
+    syncCycle = UINT64_MAX;
     
     if (*buffer - old != stateSize())
         assert(0);
@@ -106,6 +109,7 @@ Datasette::saveToBuffer(uint8_t **buffer)
 {
     uint8_t *old = *buffer;
     
+    sync(c64->getCycles());
     VirtualComponent::saveToBuffer(buffer);
     if (size) {
         assert(data != NULL);
@@ -230,19 +234,33 @@ Datasette::pressPlay()
         return;
     
     debug("Datasette::pressPlay\n");
+    c64->suspend();
+    sync(c64->getCycles());
     playKey = true;
 
     // Schedule first pulse
     uint64_t length = pulseLength();
     nextRisingEdge = length / 2;
     nextFallingEdge = length;
+    schedule();
+    c64->resume();
 }
 
 void
 Datasette::pressStop()
 {
     debug("Datasette::pressStop\n");
-    setMotor(false);
+    c64->suspend();
+    sync(c64->getCycles());
+    stop();
+    schedule();
+    c64->resume();
+}
+
+void
+Datasette::stop()
+{
+    motor = false;
     playKey = false;
 }
 
@@ -252,31 +270,63 @@ Datasette::setMotor(bool value)
     if (motor == value)
         return;
     
+    // Invoked by the CPU. The new value takes effect in the current cycle.
+    sync(c64->getCycles());
     motor = value;
+    schedule();
 }
 
 void
-Datasette::_execute()
+Datasette::sync(uint64_t cycle)
 {
-    if (!hasTape() || !playKey || !motor)
-        return;
+    if (syncCycle == UINT64_MAX)
+        syncCycle = c64->getCycles();
     
-    nextRisingEdge--;
-    nextFallingEdge--;
-    
-    if (nextRisingEdge == 0) {
-        _executeRising();
-        return;
+    assert(cycle >= syncCycle);
+    if (tapeIsMoving()) {
+        nextRisingEdge -= cycle - syncCycle;
+        nextFallingEdge -= cycle - syncCycle;
     }
+    syncCycle = cycle;
+}
 
-    if (nextFallingEdge == 0 && head < size) {
-        _executeFalling();
-        return;
+void
+Datasette::schedule()
+{
+    uint64_t next = UINT64_MAX;
+    
+    if (tapeIsMoving()) {
+        
+        // The tape stops in the next cycle without an edge
+        if (head >= size)
+            next = syncCycle;
+        
+        // An edge occurs in the cycle in which its counter reaches zero
+        if (nextRisingEdge > 0 && syncCycle + nextRisingEdge - 1 < next)
+            next = syncCycle + nextRisingEdge - 1;
+        if (nextFallingEdge > 0 && head < size && syncCycle + nextFallingEdge - 1 < next)
+            next = syncCycle + nextFallingEdge - 1;
     }
     
-    if (head >= size) {
-        pressStop();
+    c64->scheduleEvent(C64::DATASETTE_SLOT, next);
+}
+
+void
+Datasette::execute(uint64_t cycle)
+{
+    sync(cycle + 1);
+    
+    if (tapeIsMoving()) {
+        if (nextRisingEdge == 0) {
+            _executeRising();
+        } else if (nextFallingEdge == 0 && head < size) {
+            _executeFalling();
+        } else if (head >= size) {
+            stop();
+        }
     }
+    
+    schedule();
 }
 
 void
@@ -123,6 +123,13 @@ private:
      */
     bool motor;
     
+    /*! @brief    First cycle that is not yet reflected in nextRisingEdge and nextFallingEdge
+     *  @details  The datasette is only executed in cycles with an edge. In between, the edge counters are
+     *            advanced by the number of elapsed cycles at once. UINT64_MAX, if the value is unknown
+     *            (after a reset or after a snapshot has been loaded).
+     */
+    uint64_t syncCycle;
+    
     // ---------------------------------------------------------------------------------------------
     //                                    Methods
     // ---------------------------------------------------------------------------------------------
@@ -196,10 +203,12 @@ public:
     bool getPlayKey() { return playKey; }
 
     /*! @brief    Press play on tape 
+     *  @details  The function is invoked by the GUI and suspends the emulator.
      */
     void pressPlay(); 
 
     /*! @brief    Press stop key 
+     *  @details  The function is invoked by the GUI and suspends the emulator.
      */
     void pressStop();
 
@@ -211,14 +220,24 @@ public:
      */
     void setMotor(bool value);
 
-    /*! @brief  Executes the virtual datasette
+    /*! @brief    Executes the virtual datasette
+     *  @details  Invoked by the C64 in all cycles in which an edge occurs on the data line.
      */
-    inline void execute() { if (playKey && motor) _execute(); }
+    void execute(uint64_t cycle);
 
 private:
 
-    //! @brief    Internal execution function
-    void _execute();
+    //! @brief    Returns true if the tape is moving
+    inline bool tapeIsMoving() { return playKey && motor && hasTape(); }
+    
+    //! @brief    Advances the edge counters up to the specified cycle (exclusive)
+    void sync(uint64_t cycle);
+    
+    //! @brief    Tells the C64 in which cycle the datasette needs to be executed next
+    void schedule();
+    
+    //! @brief    Stops the tape (called by pressStop and when the end of the tape has been reached)
+    void stop();
 
     //! @brief    Simulates the falling edge of a pulse
     void _executeFalling();
@@ -40,14 +40,17 @@ ExpansionPort::resetCartridge()
     gameLine = true;
     exromLine = true;
     
-    memset(rom, 0, sizeof(rom));
     memset(blendedIn, 0, sizeof(blendedIn));
+    memset(ioRam, 0, sizeof(ioRam));
+    bank = 0;
     
-    for (unsigned i = 0; i < 64; i++) {
+    for (unsigned i = 0; i < Cartridge::MAX_CHIPS; i++) {
         chip[i] = NULL;
         chipStartAddress[i] = 0;
         chipSize[i] = 0;
+        chipBank[i] = 0;
     }
+    updateBankTables();
 }
 
 void
@@ -68,13 +71,13 @@ ExpansionPort::ping()
 uint32_t
 ExpansionPort::stateSize()
 {
-    uint32_t size = 3;
+    uint32_t size = 4;
     
-    for (unsigned i = 0; i < 64; i++)
-        size += 4 + chipSize[i];
+    for (unsigned i = 0; i < Cartridge::MAX_CHIPS; i++)
+        size += 6 + chipSize[i];
 
-    size += sizeof(rom);
-    size += sizeof(blendedIn);
+    size += 3 * 16; /* Blended in chips */
+    size += sizeof(ioRam);
     
     return size;
 }
@@ -87,11 +90,16 @@ ExpansionPort::loadFromBuffer(uint8_t **buffer)
     type = read8(buffer);
     gameLine = (bool)read8(buffer);
     exromLine = (bool)read8(buffer);
+    bank = read8(buffer);
 
-    for (unsigned i = 0; i < 64; i++) {
+    for (unsigned i = 0; i < Cartridge::MAX_CHIPS; i++) {
         chipStartAddress[i] = read16(buffer);
         chipSize[i] = read16(buffer);
+        chipBank[i] = read16(buffer);
         
+        if (chip[i]) {
+            free(chip[i]);
+        }
         if (chipSize[i] > 0) {
             chip[i] = (uint8_t *)malloc(chipSize[i]);
             readBlock(buffer, chip[i], chipSize[i]);
@@ -99,9 +107,16 @@ ExpansionPort::loadFromBuffer(uint8_t **buffer)
             chip[i] = NULL;
         }
     }
+    updateBankTables();
 
-    readBlock(buffer, rom, sizeof(rom));
-    readBlock(buffer, blendedIn, sizeof(blendedIn));
+    // Blended in chips are stored as chip number and offset
+    for (unsigned i = 0; i < 16; i++) {
+        uint8_t nr = read8(buffer);
+        uint16_t offset = read16(buffer);
+        blendedIn[i] = (nr == NO_CHIP || chip[nr] == NULL) ? NULL : chip[nr] + offset;
+    }
+    readBlock(buffer, ioRam, sizeof(ioRam));
+    c64->mem.updatePlainPages();
     
     debug(2, "  Expansion port state loaded (%d bytes)\n", *buffer - old);
     assert(*buffer - old == stateSize());
@@ -115,18 +130,32 @@ ExpansionPort::saveToBuffer(uint8_t **buffer)
     write8(buffer, type);
     write8(buffer, (uint8_t)gameLine);
     write8(buffer, (uint8_t)exromLine);
+    write8(buffer, bank);
     
-    for (unsigned i = 0; i < 64; i++) {
+    for (unsigned i = 0; i < Cartridge::MAX_CHIPS; i++) {
         write16(buffer, chipStartAddress[i]);
         write16(buffer, chipSize[i]);
+        write16(buffer, chipBank[i]);
         
         if (chipSize[i] > 0) {
             writeBlock(buffer, chip[i], chipSize[i]);
         }
     }
     
-    writeBlock(buffer, rom, sizeof(rom));
-    writeBlock(buffer, blendedIn, sizeof(blendedIn));
+    for (unsigned i = 0; i < 16; i++) {
+        uint8_t nr = NO_CHIP;
+        uint16_t offset = 0;
+        for (unsigned j = 0; blendedIn[i] && j < Cartridge::MAX_CHIPS; j++) {
+            if (chip[j] && blendedIn[i] >= chip[j] && blendedIn[i] < chip[j] + chipSize[j]) {
+                nr = j;
+                offset = blendedIn[i] - chip[j];
+                break;
+            }
+        }
+        write8(buffer, nr);
+        write16(buffer, offset);
+    }
+    writeBlock(buffer, ioRam, sizeof(ioRam));
 
     debug(4, "  Expansion port state saved (%d bytes)\n", *buffer - old);
     assert(*buffer - old == stateSize());
@@ -147,9 +176,9 @@ ExpansionPort::dumpState()
     msg("Game line:      %d\n", getGameLine());
     msg("Exrom line:     %d\n", getExromLine());
     
-    for (unsigned i = 0; i < 64; i++) {
+    for (unsigned i = 0; i < Cartridge::MAX_CHIPS; i++) {
         if (chip[i] != NULL) {
-            msg("Chip %2d:        %d KB starting at $%04X\n", i, chipSize[i] / 1024, chipStartAddress[i]);
+            msg("Chip %3d:       %d KB starting at $%04X (bank %d)\n", i, chipSize[i] / 1024, chipStartAddress[i], chipBank[i]);
         }
     }
 }
@@ -159,7 +188,7 @@ ExpansionPort::numberOfChips()
 {
     unsigned result = 0;
     
-    for (unsigned i = 0; i < 64; i++)
+    for (unsigned i = 0; i < Cartridge::MAX_CHIPS; i++)
         if (chip[i] != NULL)
             result++;
 
@@ -171,13 +200,25 @@ ExpansionPort::numberOfBytes()
 {
     unsigned result = 0;
     
-    for (unsigned i = 0; i < 64; i++)
+    for (unsigned i = 0; i < Cartridge::MAX_CHIPS; i++)
         if (chip[i] != NULL)
             result += chipSize[i];
     
     return result;
 }
 
+uint8_t ExpansionPort::peekIO(uint16_t addr)
+{
+    assert(addr >= 0xDE00 && addr <= 0xDFFF);
+    
+    // EasyFlash provides 256 bytes of RAM in I/O area 2
+    if (type == CRT_EASYFLASH && addr >= 0xDF00)
+        return ioRam[addr & 0xFF];
+    
+    // Reading from an open address returns the last byte read by the VIC
+    return c64->vic.getDataBus();
+}
+
 void ExpansionPort::poke(uint16_t addr, uint8_t value)
 {
     uint8_t bankNumber;
@@ -190,9 +231,6 @@ void ExpansionPort::poke(uint16_t addr, uint8_t value)
     // For some cartridges like Simons basic, bank switching is triggered by writing
     // into I/O area 1 (0xDE00 - 0xDEFF) or I/O area 2 (0xDF00 - 0xDFFF)
     
-    // Why do we need to store the written value here?
-    rom[addr & 0x7FFF] = value;
-    
     switch (type) {
         case CRT_NORMAL:
             break;
@@ -221,6 +259,29 @@ void ExpansionPort::poke(uint16_t addr, uint8_t value)
             switchBank(bankNumber);
             break;
             
+        case CRT_MAGIC_DESK_DOMARK_HES_AUSTRALIA:
+            if (addr == 0xDE00) {
+                // Bits 0 - 6 select the bank, bit 7 disables the cartridge
+                selectBank(value & 0x7F);
+                setExromLine(value & 0x80);
+            }
+            break;
+            
+        case CRT_EASYFLASH:
+            if (addr == 0xDE00) {
+                selectBank(value & 0x3F);
+            } else if (addr == 0xDE02) {
+                // Bit 2 selects whether the game line is controlled by bit 0 or
+                // by the boot jumper (which pulls the line low)
+                exromLine = !(value & 0x02);
+                gameLine = (value & 0x04) ? !(value & 0x01) : false;
+                selectBank(bank);
+                c64->mem.updatePeekPokeLookupTables();
+            } else if (addr >= 0xDF00) {
+                ioRam[addr & 0xFF] = value;
+            }
+            break;
+            
 #if 0
         case CRT_FUN_PLAY_POWER_PLAY:
             // TODO
@@ -249,31 +310,87 @@ ExpansionPort::setExromLine(bool value)
 void
 ExpansionPort::switchBank(unsigned nr)
 {
-    if (chip[nr] == NULL) {
+    if (nr >= Cartridge::MAX_CHIPS || chip[nr] == NULL) {
         warn("Chip %d does not exist (cannot switch)", nr);
         return;
     }
     
-    uint16_t loadAddr = chipStartAddress[nr];
+    mapChip(nr, chipStartAddress[nr]);
+}
+
+void
+ExpansionPort::mapChip(unsigned nr, uint16_t addr)
+{
+    if (blendInChip(nr, addr))
+        c64->mem.bankSwitched(addr, chipSize[nr]);
+}
+
+bool
+ExpansionPort::blendInChip(unsigned nr, uint16_t addr)
+{
+    assert(nr < Cartridge::MAX_CHIPS && chip[nr] != NULL);
+    
     uint16_t size = chipSize[nr];
     
-    if (0xFFFF - loadAddr < size) {
-        warn("Chip %d covers an invalid memory area (start: %04X size: %d KB)", nr, loadAddr, size / 1024);
-        return;
+    if (addr < 0x8000 || 0xFFFF - addr < size - 1 || (addr | size) & 0x0FFF) {
+        warn("Chip %d covers an invalid memory area (start: %04X size: %d KB)", nr, addr, size / 1024);
+        return false;
     }
     
-    debug(2, "Switching to bank %d (start: %04X size: %d KB)\n", nr, loadAddr, size / 1024);
-    memcpy(rom + loadAddr - 0x8000, chip[nr], size);
-    for (unsigned i = loadAddr >> 12; i < (loadAddr + size) >> 12; i++) {
-        assert (i < 16);
-        blendedIn[i] = 1;
+    debug(3, "Blending in chip %d at %04X (size: %d KB)\n", nr, addr, size / 1024);
+    for (unsigned i = 0; i < size >> 12; i++)
+        blendedIn[(addr >> 12) + i] = chip[nr] + (i << 12);
+    return true;
+}
+
+void
+ExpansionPort::selectBank(uint8_t nr)
+{
+    bank = nr;
+    
+    uint8_t roml = romlChip[nr];
+    uint8_t romh = romhChip[nr];
+    bool ultimax = exromLine && !gameLine;
+    uint8_t *old[16];
+    
+    // Areas without a chip show RAM
+    memcpy(old, blendedIn, sizeof(blendedIn));
+    memset(blendedIn, 0, sizeof(blendedIn));
+    
+    if (roml != NO_CHIP)
+        blendInChip(roml, 0x8000);
+    if (romh != NO_CHIP)
+        blendInChip(romh, ultimax ? 0xE000 : 0xA000);
+    
+    // Only the areas that show a different chip now need to be updated
+    for (unsigned i = 0x8; i <= 0xF; i++) {
+        if (blendedIn[i] != old[i])
+            c64->mem.bankSwitched(i << 12, 0x1000);
+    }
+}
+
+void
+ExpansionPort::updateBankTables()
+{
+    memset(romlChip, NO_CHIP, sizeof(romlChip));
+    memset(romhChip, NO_CHIP, sizeof(romhChip));
+    
+    for (unsigned i = 0; i < Cartridge::MAX_CHIPS; i++) {
+        
+        if (chip[i] == NULL || chipBank[i] >= Cartridge::MAX_CHIPS)
+            continue;
+        
+        if (chipStartAddress[i] == 0x8000 && chipSize[i] <= 0x2000)
+            romlChip[chipBank[i]] = i;
+        else if (chipStartAddress[i] == 0xA000 || chipStartAddress[i] == 0xE000)
+            romhChip[chipBank[i]] = i;
     }
 }
 
 void
 ExpansionPort::attachChip(unsigned nr, Cartridge *c)
 {
-    assert(nr < 64);
+    assert(nr < Cartridge::MAX_CHIPS);
     
     if (chip[nr])
         free(chip[nr]);
@@ -283,6 +400,7 @@ ExpansionPort::attachChip(unsigned nr, Cartridge *c)
     
     chipStartAddress[nr] = c->getChipAddr(nr);
     chipSize[nr] = c->getChipSize(nr);
+    chipBank[nr] = c->getChipBank(nr);
     memcpy(chip[nr], c->getChipData(nr), c->getChipSize(nr));
     
     debug(1, "Chip %d is in place: %d KB starting at $%04X (type: %d bank:%X)\n",
@@ -302,6 +420,7 @@ ExpansionPort::attachCartridge(Cartridge *c)
     for (unsigned i = 0; i < c->getNumberOfChips(); i++) {
         attachChip(i, c);
     }
+    updateBankTables();
     
     // Hopefully, we got at least one chip
     if(chip[0] == NULL) {
@@ -309,8 +428,11 @@ ExpansionPort::attachCartridge(Cartridge *c)
         return false;
     }
 
-    // Blend in chip 0
-    switchBank(0);
+    // Blend in chip 0 (or bank 0 if banks are selected by number)
+    if (type == CRT_MAGIC_DESK_DOMARK_HES_AUSTRALIA || type == CRT_EASYFLASH)
+        selectBank(0);
+    else
+        switchBank(0);
     c64->mem.updatePeekPokeLookupTables();
     // dumpState();
 
@@ -322,7 +444,7 @@ void
 ExpansionPort::detachCartridge()
 {
     // Deallocate chip memory
-    for (unsigned i = 0; i < 64; i++) if (chip[i]) free(chip[i]);
+    for (unsigned i = 0; i < Cartridge::MAX_CHIPS; i++) if (chip[i]) free(chip[i]);
     
     resetCartridge();
     if (c64) c64->putMessage(MSG_CARTRIDGE, 0);
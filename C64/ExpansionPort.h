@@ -37,6 +37,7 @@
 #define _EXPANSIONPORT_H
 
 #include "VirtualComponent.h"
+#include "Cartridge.h"
 
 class ExpansionPort : public VirtualComponent {
  
@@ -72,6 +73,7 @@ public:
         CRT_DELA_EP7x8 = 25,
         CRT_DELA_EP256 = 26,
         CRT_REX_EP256 = 27,
+        CRT_EASYFLASH = 32,
         CRT_NONE = 255
     };
 
@@ -93,23 +95,42 @@ private:
     bool exromLine;
     
     /*! @brief    ROM chips contained in the attached cartridge
-     *  @details  A cartridge can contain up to 64 chips
+     *  @details  A cartridge can contain up to Cartridge::MAX_CHIPS chips
      */
-    uint8_t *chip[64];
+    uint8_t *chip[Cartridge::MAX_CHIPS];
 
     //! @brief    Array containing the load addresses of all chips
-    uint16_t chipStartAddress[64];
+    uint16_t chipStartAddress[Cartridge::MAX_CHIPS];
 
     //! @brief    Array containing the chip sizes of all chips
-    uint16_t chipSize[64];
+    uint16_t chipSize[Cartridge::MAX_CHIPS];
 
-    //! @brief    Virtual cartridge ROM (32 kb starting at $8000)
-    uint8_t rom[0x8000];
+    //! @brief    Array containing the bank numbers of all chips
+    uint16_t chipBank[Cartridge::MAX_CHIPS];
+
+    /*! @brief    Chip numbers of the ROML and ROMH chip of each bank
+     *  @details  ROML chips are loaded at $8000, ROMH chips at $A000 or $E000. The tables are
+     *            used by cartridges that select their banks by number. NO_CHIP indicates that
+     *            the bank has no such chip.
+     */
+    uint8_t romlChip[Cartridge::MAX_CHIPS];
+    uint8_t romhChip[Cartridge::MAX_CHIPS];
     
-    /*! @brief    Indicates whether ROM is blended in (0x01) or or out (0x00)
-     *  @details  Each array item represents a 4k block above $8000 
+    //! @brief    Marks a missing chip in the bank tables
+    static const uint8_t NO_CHIP = 0xFF;
+
+    /*! @brief    ROM that is blended in
+     *  @details  Each array item represents a 4k block and points into the chip that is
+     *            visible in this block. The value is NULL if no ROM is blended in. Chips are
+     *            never copied, so switching banks only replaces pointers.
      */
-    uint8_t blendedIn[16];
+    uint8_t *blendedIn[16];
+    
+    //! @brief    Currently selected bank (Magic Desk, EasyFlash)
+    uint8_t bank;
+    
+    //! @brief    RAM in I/O area 2 (EasyFlash)
+    uint8_t ioRam[256];
     
 public:
     
@@ -144,10 +165,16 @@ public:
     void dumpState();	
     
     //! @brief    Returns true if cartride ROM is blended in at the specified location
-    bool romIsBlendedIn(uint16_t addr) { return blendedIn[addr >> 12]; }
+    bool romIsBlendedIn(uint16_t addr) { return blendedIn[addr >> 12] != NULL; }
     
     //! @brief    Peek fallthrough
-    uint8_t peek(uint16_t addr) { return rom[addr & 0x7FFF]; }
+    uint8_t peek(uint16_t addr) { return blendedIn[addr >> 12][addr & 0x0FFF]; }
+    
+    //! @brief    Returns a pointer to the cartridge ROM page that is visible at the specified page
+    uint8_t *getRomPage(uint8_t page) { return blendedIn[page >> 4] + ((page & 0x0F) << 8); }
+    
+    //! @brief    Peek fallthrough for the I/O areas ($DE00 - $DFFF)
+    uint8_t peekIO(uint16_t addr);
     
     //! @brief    Poke fallthrough
     void poke(uint16_t addr, uint8_t value);
@@ -156,7 +183,7 @@ public:
     CartridgeType getCartridgeType() { return (CartridgeType)type; }
 
     /*! @brief    Counts the number of chips
-     *  @return   Value between 0 and 64
+     *  @return   Value between 0 and Cartridge::MAX_CHIPS
      */
     unsigned numberOfChips();
 
@@ -178,6 +205,22 @@ public:
     //! @brief    Blends in a cartridge chip into the ROM address space
     void switchBank(unsigned nr);
 
+    //! @brief    Blends in a cartridge chip at the specified address
+    void mapChip(unsigned nr, uint16_t addr);
+
+    /*! @brief    Blends in a cartridge chip at the specified address without notifying memory
+     *  @return   false, if the chip doesn't fit into the ROM address space
+     */
+    bool blendInChip(unsigned nr, uint16_t addr);
+
+    /*! @brief    Blends in the ROML and ROMH chip of the specified bank
+     *  @details  The ROMH chip shows up at $E000 in Ultimax mode and at $A000 otherwise.
+     */
+    void selectBank(uint8_t nr);
+
+    //! @brief    Sets up the bank tables
+    void updateBankTables();
+
     //! @brief    Returns true if a cartridge is attached to the expansion port
     inline bool getCartridgeAttached() { return type != CRT_NONE; }
 
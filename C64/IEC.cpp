@@ -26,19 +26,19 @@ IEC::IEC()
     // Register snapshot items
     SnapshotItem items[] = {
         
-        { &driveConnected,      sizeof(driveConnected),         CLEAR_ON_RESET },
+        { driveConnected,       sizeof(driveConnected),         KEEP_ON_RESET | BYTE_FORMAT },
         { &atnLine,             sizeof(atnLine),                CLEAR_ON_RESET },
         { &oldAtnLine,          sizeof(oldAtnLine),             CLEAR_ON_RESET },
         { &clockLine,           sizeof(clockLine),              CLEAR_ON_RESET },
         { &oldClockLine,        sizeof(oldClockLine),           CLEAR_ON_RESET },
         { &dataLine,            sizeof(dataLine),               CLEAR_ON_RESET },
         { &oldDataLine,         sizeof(oldDataLine),            CLEAR_ON_RESET },
-        { &deviceAtnPin,        sizeof(deviceAtnPin),           CLEAR_ON_RESET },
-        { &deviceAtnIsOutput,   sizeof(deviceAtnIsOutput),      CLEAR_ON_RESET },
-        { &deviceDataPin,       sizeof(deviceDataPin),          CLEAR_ON_RESET },
-        { &deviceDataIsOutput,  sizeof(deviceDataIsOutput),     CLEAR_ON_RESET },
-        { &deviceClockPin,      sizeof(deviceClockPin),         CLEAR_ON_RESET },
-        { &deviceClockIsOutput, sizeof(deviceClockIsOutput),    CLEAR_ON_RESET },
+        { deviceAtnPin,        sizeof(deviceAtnPin),           CLEAR_ON_RESET | BYTE_FORMAT },
+        { deviceAtnIsOutput,   sizeof(deviceAtnIsOutput),      CLEAR_ON_RESET | BYTE_FORMAT },
+        { deviceDataPin,       sizeof(deviceDataPin),          CLEAR_ON_RESET | BYTE_FORMAT },
+        { deviceDataIsOutput,  sizeof(deviceDataIsOutput),     CLEAR_ON_RESET | BYTE_FORMAT },
+        { deviceClockPin,      sizeof(deviceClockPin),         CLEAR_ON_RESET | BYTE_FORMAT },
+        { deviceClockIsOutput, sizeof(deviceClockIsOutput),    CLEAR_ON_RESET | BYTE_FORMAT },
         { &ciaDataPin,          sizeof(ciaDataPin),             CLEAR_ON_RESET },
         { &ciaDataIsOutput,     sizeof(ciaDataIsOutput),        CLEAR_ON_RESET },
         { &ciaClockPin,         sizeof(ciaClockPin),            CLEAR_ON_RESET },
@@ -49,11 +49,28 @@ IEC::IEC()
         { NULL,                 0,                              0 }};
     
     registerSnapshotItems(items, sizeof(items));
+    
+    // Only drive 8 is connected initially
+    for (unsigned i = 0; i < maxDrives; i++) {
+        drive[i] = NULL;
+        driveConnected[i] = (i == 0);
+    }
+    numActiveDrives = 0;
+    currentSlot = 0;
+    
+    fastLoader = false;
+    virtualDisk = NULL;
+    listening = talking = false;
+    memset(channel, 0, sizeof(channel));
+    setStatus(73, "CBM DOS V2.6 1541");
 }
 
 IEC::~IEC()
 {
 	debug(3, "  Releasing IEC bus...\n");
+    
+    closeAllChannels();
+    delete virtualDisk;
 }
 
 void 
@@ -61,18 +78,20 @@ IEC::reset()
 {
    VirtualComponent::reset();
     
-    // Establish bindings
-    drive = &c64->floppy;
+	// Establish bindings
+	for (unsigned i = 0; i < maxDrives; i++)
+		drive[i] = &c64->floppy[i];
     
-    driveConnected = 1;
 	atnLine = 1;
 	oldAtnLine = 1;
 	clockLine = 1;
 	oldClockLine = 1;
 	dataLine = 1;
 	oldDataLine = 1;
-	deviceDataPin = 1;
-	deviceClockPin = 1;
+	for (unsigned i = 0; i < maxDrives; i++) {
+		deviceDataPin[i] = 1;
+		deviceClockPin[i] = 1;
+	}
 	ciaDataPin = 1;
 	ciaDataIsOutput = 1;
 	ciaClockPin = 1;
@@ -80,15 +99,27 @@ IEC::reset()
 	ciaAtnPin = 1;
 	ciaAtnIsOutput = 1;
 	
-	setDeviceClockPin(1);
-	setDeviceDataPin(1);
+	_updateIecLines();
+	updateActiveDrives();
+    
+    // Reset the simulated drive of the fast loader
+    listening = talking = false;
+    closeAllChannels();
+    setStatus(73, "CBM DOS V2.6 1541");
+}
+
+void
+IEC::loadFromBuffer(uint8_t **buffer)
+{
+    VirtualComponent::loadFromBuffer(buffer);
+    updateActiveDrives();
 }
 
 void
 IEC::ping()
 {
- 	drive->c64->putMessage(MSG_VC1541_ATTACHED, driveConnected);
-    drive->c64->putMessage(MSG_VC1541_DATA, busActivity > 0);
+ 	c64->putMessage(MSG_VC1541_ATTACHED, driveConnected[0]);
+    c64->putMessage(MSG_VC1541_DATA, busActivity > 0);
     
 }
 
@@ -100,10 +131,12 @@ IEC::dumpState()
 	msg("\n");
 	dumpTrace();
 	msg("\n");
-	msg("Drive connected : %s\n", driveConnected ? "yes" : "no");
+	for (unsigned i = 0; i < maxDrives; i++)
+		msg("Drive %2d        : %s\n", 8 + i, driveConnected[i] ? "connected" : "disconnected");
 	msg("        old ATN : %d\n", oldAtnLine);
 	msg("        old CLK : %d\n", oldClockLine);
 	msg("       old DATA : %d\n", oldDataLine);
+	msg("    Fast loader : %s\n", fastLoader ? (virtualDisk ? "on" : "on (no disk)") : "off");
 	msg("\n");	
 }
 
@@ -112,39 +145,105 @@ IEC::dumpTrace()
 {
 	debug(1, "ATN: %s[%s%s%s%s] CLK: %s[%s%s%s%s] DATA: %s[%s%s%s%s]\n", 
 		  atnLine ? "1 F" : "0 T", 
-		  deviceAtnPin ? "1" : "0",
-		  deviceAtnIsOutput ? "<-" : "->", 
+		  deviceAtnPin[0] ? "1" : "0",
+		  deviceAtnIsOutput[0] ? "<-" : "->", 
 		  ciaAtnPin ? "1" : "0",
 		  ciaAtnIsOutput ? "<-" : "->",
 		  clockLine ? "1 F" : "0 T", 
-		  deviceClockPin ? "1" : "0",
-		  deviceClockIsOutput ? "<-" : "->", 
+		  deviceClockPin[0] ? "1" : "0",
+		  deviceClockIsOutput[0] ? "<-" : "->", 
 		  ciaClockPin ? "1" : "0",
 		  ciaClockIsOutput ? "<-" : "->",
 		  dataLine ? "1 F" : "0 T",
-		  deviceDataPin ? "1" : "0",
-		  deviceDataIsOutput ? "<-" : "->",
+		  deviceDataPin[0] ? "1" : "0",
+		  deviceDataIsOutput[0] ? "<-" : "->",
 		  ciaDataPin ? "1" : "0",
 		  ciaDataIsOutput ? "<-" : "->"); 
 }
 
 void 
-IEC::connectDrive() 
+IEC::connectDrive(unsigned nr) 
 { 
-	driveConnected = true; 
-	drive->c64->putMessage(MSG_VC1541_ATTACHED, 1);
-    if (drive->soundMessagesEnabled())
-        drive->c64->putMessage(MSG_VC1541_ATTACHED_SOUND, 1);
+	assert(nr >= 8 && nr < 8 + maxDrives);
+	
+	c64->suspend();
+	driveConnected[nr - 8] = true; 
+	updateActiveDrives();
+	updateIecLines();
+	c64->resume();
+	
+	if (nr != 8)
+		return;
+	
+	c64->putMessage(MSG_VC1541_ATTACHED, 1);
+    if (drive[0]->soundMessagesEnabled())
+        c64->putMessage(MSG_VC1541_ATTACHED_SOUND, 1);
 }
 	
 void 
-IEC::disconnectDrive()
+IEC::disconnectDrive(unsigned nr)
 { 
-	driveConnected = false; 
-	drive->c64->putMessage(MSG_VC1541_ATTACHED, 0);
-    if (drive->soundMessagesEnabled())
-        drive->c64->putMessage(MSG_VC1541_ATTACHED_SOUND, 0);
+	assert(nr >= 8 && nr < 8 + maxDrives);
+	
+	c64->suspend();
+	// Let the drive catch up with the C64 before it gets frozen
+	drive[nr - 8]->wakeUp();
+	driveConnected[nr - 8] = false; 
+	updateActiveDrives();
+	updateIecLines();
+	c64->resume();
+	
+	if (nr != 8)
+		return;
+	
+	c64->putMessage(MSG_VC1541_ATTACHED, 0);
+    if (drive[0]->soundMessagesEnabled())
+        c64->putMessage(MSG_VC1541_ATTACHED_SOUND, 0);
+
+}
+
+void
+IEC::updateActiveDrives()
+{
+	numActiveDrives = 0;
+	for (unsigned i = 0; i < maxDrives; i++) {
+		if (driveConnected[i])
+			activeSlot[numActiveDrives++] = i;
+	}
+	scheduleDrives();
+}
+
+bool
+IEC::executeDrives(uint64_t cycle)
+{
+	bool result = true;
+	
+	for (unsigned i = 0; i < numActiveDrives; i++) {
+		VC1541 *d = drive[currentSlot = activeSlot[i]];
+		if (!d->executeOrSkip(cycle))
+			result = false;
+	}
+	currentSlot = 0;
+	
+	// Determine the next drive cycle after all drives have been executed (a drive may wake up another one)
+	uint64_t next = UINT64_MAX;
+	for (unsigned i = 0; i < numActiveDrives; i++) {
+		
+		// A drive running on its own thread is synchronized in each cycle
+		VC1541 *d = drive[activeSlot[i]];
+		uint64_t wakeUpCycle = d->isDetached() ? 0 : d->getWakeUpCycle();
+		if (wakeUpCycle < next)
+			next = wakeUpCycle;
+	}
+	c64->scheduleEvent(C64::DRIVE_SLOT, next);
+	
+	return result;
+}
 
+void
+IEC::scheduleDrives()
+{
+	c64->scheduleEvent(C64::DRIVE_SLOT, 0);
 }
 
 bool IEC::_updateIecLines(bool *atnedge)
@@ -160,18 +259,23 @@ bool IEC::_updateIecLines(bool *atnedge)
 
 	clockLine = 1;
 	if (ciaClockIsOutput) clockLine &= ciaClockPin;
-	if (driveConnected && deviceClockIsOutput) clockLine &= deviceClockPin;
 	
 	dataLine = 1;
 	if (ciaDataIsOutput) dataLine &= ciaDataPin;
-	if (driveConnected && deviceDataIsOutput) dataLine &= deviceDataPin;
-
-	// Note: The device atn pin is not connected to the ATN line.
-	// It implements an auto acknowledge feature. When set to 1, the ATN signal
-	// is automatically acknowledged by the drive. This feature allows the C64
-	// to detect a connected drive without any interaction by the drive itself.
-	if (driveConnected && deviceAtnPin == 1)
-		dataLine &= atnLine;
+
+	for (unsigned i = 0; i < numActiveDrives; i++) {
+		
+		unsigned slot = activeSlot[i];
+		if (deviceClockIsOutput[slot]) clockLine &= deviceClockPin[slot];
+		if (deviceDataIsOutput[slot]) dataLine &= deviceDataPin[slot];
+		
+		// Note: The device atn pin is not connected to the ATN line.
+		// It implements an auto acknowledge feature. When set to 1, the ATN signal
+		// is automatically acknowledged by the drive. This feature allows the C64
+		// to detect a connected drive without any interaction by the drive itself.
+		if (deviceAtnPin[slot] == 1)
+			dataLine &= atnLine;
+	}
 	
 	// Check atn line for a negative edge
 	if (atnedge != NULL) 
@@ -189,18 +293,27 @@ void IEC::updateIecLines()
 	// Update port lines
 	signals_changed = _updateIecLines(&atn_edge);	
 
+	// Let parked drives catch up before they see the new line values. Drives in lower
+	// slots than the currently executed one have already completed the current cycle.
+	if (signals_changed) {
+		for (unsigned i = 0; i < numActiveDrives; i++) {
+			VC1541 *d = drive[activeSlot[i]];
+			d->wakeUp(*d->cpu.clock + (activeSlot[i] < currentSlot ? 1 : 0));
+		}
+	}
+
 	// Check if ATN edge occurred
 	if (atn_edge) {
-		drive->simulateAtnInterrupt();
+		for (unsigned i = 0; i < numActiveDrives; i++)
+			drive[activeSlot[i]]->simulateAtnInterrupt();
 	}
 
 	if (signals_changed) {
-		if (busActivity == 0) {
-			// Bus activity detected
-			drive->c64->putMessage(MSG_VC1541_DATA, 1);
-			drive->c64->setWarp(drive->c64->getAlwaysWarp() || drive->c64->getWarpLoad());
-		}
-		busActivity = 30;
+		// The drive thread leaves the bus activity to the C64 (see updateCiaView)
+		if (drive[0]->isDetached())
+			drive[0]->logBusChange(clockLine, dataLine);
+		else
+			signalBusActivity();
 	}
 
 	if (signals_changed && tracingEnabled()) {
@@ -208,7 +321,28 @@ void IEC::updateIecLines()
 	}
 }
 	
+void IEC::signalBusActivity()
+{
+	if (busActivity == 0) {
+		// Bus activity detected
+		c64->putMessage(MSG_VC1541_DATA, 1);
+		c64->setWarp(c64->getAlwaysWarp() || c64->getWarpLoad());
+	}
+	busActivity = 30;
+}
+
 void IEC::updateCiaPins(uint8_t cia_data, uint8_t cia_direction)
+{
+	// The drive thread applies the write in the same cycle
+	if (drive[0]->isDetached()) {
+		drive[0]->postCiaPins(cia_data, cia_direction);
+		return;
+	}
+	
+	applyCiaPins(cia_data, cia_direction);
+}
+
+void IEC::applyCiaPins(uint8_t cia_data, uint8_t cia_direction)
 {
 	// Note: On the pyhsical pins, 0 is dominant. 
 	// I.e., a single 0-source will bring the signal down to 0
@@ -223,30 +357,96 @@ void IEC::updateCiaPins(uint8_t cia_data, uint8_t cia_direction)
 	updateIecLines(); 
 }
 
-void IEC::updateDevicePins(uint8_t device_data, uint8_t device_direction)
+void IEC::updateDevicePins(unsigned nr, uint8_t device_data, uint8_t device_direction)
 {
+	assert(nr >= 8 && nr < 8 + maxDrives);
+	unsigned i = nr - 8;
+	
 	// Note: On the pyhsical pins, 0 is dominant. 
 	// I.e., a single 0-source will bring the signal down to 0
 	
-	deviceAtnIsOutput = (device_direction & 0x10) ? 1 : 0;
-	deviceClockIsOutput = (device_direction & 0x08) ? 1 : 0;
-	deviceDataIsOutput = (device_direction & 0x02) ? 1 : 0;
-	deviceAtnPin = (device_data & 0x10) ? 0 : 1; // Pin and line are connected via an inverter
-	deviceClockPin = (device_data & 0x08) ? 0 : 1; // Pin and line are connected via an inverter
-	deviceDataPin = (device_data & 0x02) ? 0 : 1; // Pin and line are connected via an inverter
+	deviceAtnIsOutput[i] = (device_direction & 0x10) ? 1 : 0;
+	deviceClockIsOutput[i] = (device_direction & 0x08) ? 1 : 0;
+	deviceDataIsOutput[i] = (device_direction & 0x02) ? 1 : 0;
+	deviceAtnPin[i] = (device_data & 0x10) ? 0 : 1; // Pin and line are connected via an inverter
+	deviceClockPin[i] = (device_data & 0x08) ? 0 : 1; // Pin and line are connected via an inverter
+	deviceDataPin[i] = (device_data & 0x02) ? 0 : 1; // Pin and line are connected via an inverter
 				
 	updateIecLines(); 
 }
 
+uint8_t IEC::getPackedCiaPins()
+{
+	return (ciaAtnPin ? 0x00 : 0x08) | (ciaClockPin ? 0x00 : 0x10) | (ciaDataPin ? 0x00 : 0x20) |
+		(ciaAtnIsOutput ? 0x01 : 0x00) | (ciaClockIsOutput ? 0x02 : 0x00) | (ciaDataIsOutput ? 0x04 : 0x00);
+}
+
+bool IEC::getCiaClockLine()
+{
+	if (!drive[0]->isDetached())
+		return clockLine;
+	
+	drive[0]->synchronize(c64->getCycles());
+	return ciaViewClockLine;
+}
+
+bool IEC::getCiaDataLine()
+{
+	if (!drive[0]->isDetached())
+		return dataLine;
+	
+	drive[0]->synchronize(c64->getCycles());
+	return ciaViewDataLine;
+}
+
+void IEC::updateCiaView(bool clock, bool data)
+{
+	ciaViewClockLine = clock;
+	ciaViewDataLine = data;
+	signalBusActivity();
+}
+
+void IEC::saveBusState(uint8_t **buffer)
+{
+	bool *state[] = {
+		&atnLine, &oldAtnLine, &clockLine, &oldClockLine, &dataLine, &oldDataLine,
+		&ciaDataPin, &ciaDataIsOutput, &ciaClockPin, &ciaClockIsOutput, &ciaAtnPin, &ciaAtnIsOutput };
+	bool *deviceState[] = {
+		deviceAtnPin, deviceAtnIsOutput, deviceDataPin, deviceDataIsOutput, deviceClockPin, deviceClockIsOutput };
+	
+	for (unsigned i = 0; i < sizeof(state) / sizeof(state[0]); i++)
+		write8(buffer, *state[i]);
+	for (unsigned i = 0; i < sizeof(deviceState) / sizeof(deviceState[0]); i++)
+		writeBlock(buffer, (uint8_t *)deviceState[i], maxDrives);
+}
+
+void IEC::loadBusState(uint8_t **buffer)
+{
+	bool *state[] = {
+		&atnLine, &oldAtnLine, &clockLine, &oldClockLine, &dataLine, &oldDataLine,
+		&ciaDataPin, &ciaDataIsOutput, &ciaClockPin, &ciaClockIsOutput, &ciaAtnPin, &ciaAtnIsOutput };
+	bool *deviceState[] = {
+		deviceAtnPin, deviceAtnIsOutput, deviceDataPin, deviceDataIsOutput, deviceClockPin, deviceClockIsOutput };
+	
+	for (unsigned i = 0; i < sizeof(state) / sizeof(state[0]); i++)
+		*state[i] = read8(buffer);
+	for (unsigned i = 0; i < sizeof(deviceState) / sizeof(deviceState[0]); i++)
+		readBlock(buffer, (uint8_t *)deviceState[i], maxDrives);
+}
+
 void IEC::execute()
 {
+	// Collect all bus changes of the drive thread up to now
+	if (drive[0]->isDetached())
+		drive[0]->synchronize(c64->getCycles());
+	
 	if (busActivity > 0) {
 
 		busActivity--;
 		if (busActivity == 0) {
 			// Bus is idle 
-			drive->c64->putMessage(MSG_VC1541_DATA, 0);
-			drive->c64->setWarp(drive->c64->getAlwaysWarp());
+			c64->putMessage(MSG_VC1541_DATA, 0);
+			c64->setWarp(c64->getAlwaysWarp());
 		}
 	}
 }
@@ -255,6 +455,140 @@ void IEC::execute()
 //                            Fast loader
 // -------------------------------------------------------------------
 
+const IEC::KernalTrap IEC::kernalTraps[] = {
+    
+    { 0xED09, { 0x09, 0x40 } },  // TALK   (ORA #$40)
+    { 0xED0C, { 0x09, 0x20 } },  // LISTEN (ORA #$20)
+    { 0xEDB9, { 0x85, 0x95 } },  // SECOND (STA $95)
+    { 0xEDC7, { 0x85, 0x95 } },  // TKSA   (STA $95)
+    { 0xEDDD, { 0x24, 0x94 } },  // CIOUT  (BIT $94)
+    { 0xEDEF, { 0x78, 0x20 } },  // UNTLK  (SEI, JSR $EE8E)
+    { 0xEDFE, { 0xA9, 0x3F } },  // UNLSN  (LDA #$3F)
+    { 0xEE13, { 0x78, 0xA9 } },  // ACPTR  (SEI, LDA #$00)
+    { 0x0000, { 0x00, 0x00 } }
+};
+
+void
+IEC::setFastLoader(bool enable)
+{
+    debug(2, "%s fast loader\n", enable ? "Enabling" : "Disabling");
+
+    c64->suspend();
+    
+    fastLoader = enable;
+    listening = talking = false;
+    closeAllChannels();
+    
+    for (const KernalTrap *trap = kernalTraps; trap->addr; trap++) {
+        if (enable)
+            c64->cpu.setTrap(trap->addr);
+        else
+            c64->cpu.deleteTrap(trap->addr);
+    }
+    
+    c64->resume();
+}
+
+void
+IEC::setVirtualDisk(D64Archive *disk)
+{
+    c64->suspend();
+    
+    delete virtualDisk;
+    virtualDisk = disk;
+    listening = talking = false;
+    closeAllChannels();
+    setStatus(0, "OK");
+    
+    c64->resume();
+}
+
+bool
+IEC::executeTrap(uint16_t addr)
+{
+    CPU *cpu = &c64->cpu;
+    C64Memory *mem = &c64->mem;
+    const KernalTrap *trap;
+    uint8_t result, byte;
+    
+    if (!fastLoader || !mem->kernelIsVisible())
+        return false;
+    
+    // Only intercept the original KERNAL routines
+    for (trap = kernalTraps; trap->addr && trap->addr != addr; trap++);
+    if (!trap->addr || mem->rom[addr] != trap->code[0] || mem->rom[addr + 1] != trap->code[1])
+        return false;
+    
+    switch (addr) {
+            
+        case 0xED09: // TALK
+        case 0xED0C: // LISTEN
+            
+            // Let the emulated drive answer if it's not our business
+            if ((cpu->getA() & 0x1F) != FAST_LOADER_DEVICE || virtualDisk == NULL) {
+                listening = talking = false;
+                return false;
+            }
+            result = IECOutATN(cpu->getA() | (addr == 0xED09 ? 0x40 : 0x20));
+            break;
+            
+        case 0xEDB9: // SECOND
+            
+            if (!listening) return false;
+            result = IECOutSec(cpu->getA());
+            break;
+
+        case 0xEDC7: // TKSA
+            
+            if (!talking) return false;
+            result = IECOutSec(cpu->getA());
+            break;
+
+        case 0xEDDD: // CIOUT
+            
+            if (!listening) return false;
+            result = IECOut(cpu->getA());
+            cpu->setC(0);
+            break;
+
+        case 0xEDEF: // UNTLK
+            
+            if (!talking) return false;
+            result = IECOutATN(0x5F);
+            break;
+
+        case 0xEDFE: // UNLSN
+            
+            if (!listening) return false;
+            result = IECOutATN(0x3F);
+            break;
+            
+        case 0xEE13: // ACPTR
+            
+            if (!talking) return false;
+            result = IECIn(&byte);
+            cpu->loadA(byte);
+            cpu->setC(0);
+            break;
+            
+        default:
+            return false;
+    }
+
+    // Update the KERNAL status variable ST
+    if (result)
+        mem->pokeRam(0x90, mem->peekRam(0x90) | result);
+    
+    // Return from subroutine
+    uint8_t sp = cpu->getSP();
+    uint8_t lo = mem->peekRam(0x100 | (uint8_t)(sp + 1));
+    uint8_t hi = mem->peekRam(0x100 | (uint8_t)(sp + 2));
+    cpu->setSP(sp + 2);
+    cpu->setPC(LO_HI(lo, hi) + 1);
+    
+    return true;
+}
+
 uint8_t IEC::IECOutATN(uint8_t byte)
 {
     // The upper four bits contain the command
@@ -269,8 +603,10 @@ uint8_t IEC::IECOutATN(uint8_t byte)
         case 2: /* LISTEN */
 
             debug(2, "Device %d is now listening\n", byte & 0x0F);
-            if ((byte & 0x0F) == 8) { // We only support device number 8
+            if ((byte & 0x0F) == FAST_LOADER_DEVICE) {
                 listening = true;
+                talking = false;
+                command = 0;
                 filename[0] = 0;
                 return IEC_OK;
             } else {
@@ -281,14 +617,20 @@ uint8_t IEC::IECOutATN(uint8_t byte)
         case 3: /* UNLISTEN */
 
             debug(2, "No longer listening\n");
+            if (command == IEC_CMD_OPEN) {
+                openChannel(secondary);
+            } else if (command == IEC_CMD_DATA && secondary == 15) {
+                openChannel(15);
+            }
             listening = false;
             return IEC_OK;
             
         case 4: /* TALK */
 
-            debug(2, "Device %d is now listening\n", byte & 0x0F);
-            if ((byte & 0x0F) == 8) { // We only support device number 8
+            debug(2, "Device %d is now talking\n", byte & 0x0F);
+            if ((byte & 0x0F) == FAST_LOADER_DEVICE) {
                 talking = true;
+                listening = false;
                 return IEC_OK;
             } else {
                 talking = false;
@@ -328,11 +670,16 @@ uint8_t IEC::IECOutSecWhileListening(uint8_t byte)
     
     switch (command) {
         case IEC_CMD_OPEN:
-            debug(2, "Received command: OPEN\n");
+            debug(2, "Received command: OPEN %d\n", secondary);
+            filename[0] = 0;
             return IEC_OK;
         case IEC_CMD_CLOSE:
-            debug(2, "Received command: CLOSE\n");
-            // Turn on LED
+            debug(2, "Received command: CLOSE %d\n", secondary);
+            closeChannel(secondary);
+            return IEC_OK;
+        case IEC_CMD_DATA:
+            if (secondary == 15)
+                channel[15].size = channel[15].pos = 0;
             return IEC_OK;
     }
     return IEC_OK;
@@ -342,48 +689,304 @@ uint8_t IEC::IECOutSecWhileTalking(uint8_t byte)
 {
     command = (byte >> 4);
     secondary = (byte & 0xF);
+    
+    // Provide the current status on the command channel
+    if (secondary == 15 && channel[15].pos >= channel[15].size) {
+        channel[15].size = channel[15].pos = 0;
+        for (unsigned i = 0; status[i]; i++)
+            appendToChannel(15, status[i]);
+        setStatus(0, "OK");
+    }
     return IEC_OK;
+}
+
+uint8_t IEC::IECOut(uint8_t byte)
+{
+    if (command == IEC_CMD_OPEN) {
+        
+        size_t len = strlen(filename);
+        if (len < sizeof(filename) - 1) {
+            filename[len] = byte;
+            filename[len + 1] = 0;
+        }
+        return IEC_OK;
+    }
+    
+    if (command == IEC_CMD_DATA && (channel[secondary].write || secondary == 15)) {
+        appendToChannel(secondary, byte);
+        return IEC_OK;
+    }
+    
+    return IEC_TIMEOUT;
+}
 
+uint8_t IEC::IECIn(uint8_t *byte)
+{
+    Channel *c = &channel[secondary];
+    
+    // Signal a timeout if there is nothing to read (e.g., if the file wasn't found)
+    if (c->write || c->pos >= c->size) {
+        *byte = 0x0D;
+        return IEC_READ_TIMEOUT | IEC_EOF;
+    }
+    
+    *byte = c->data[c->pos++];
+    return (c->pos == c->size) ? IEC_EOF : IEC_OK;
 }
 
-uint8_t IEC::IECOut(uint8_t byte, bool eoi)
+void
+IEC::openChannel(uint8_t nr)
 {
-    char tmp[2] = { byte, 0 };
-    strncat(filename, tmp, 16);
+    Channel *c = &channel[nr];
+    char *name = filename, *type;
     
-    if (eoi) {
-        printf("Filename: ");
-        for (unsigned i = 0; i < strlen(filename); i++)
-            printf("%c", pet2ascii(filename[i]));
-        printf("\n");
+    // Commands are sent on channel 15, either as file name or as data
+    if (nr == 15) {
+        
+        size_t len = strlen(filename);
+        for (unsigned i = 0; i < c->size && len < sizeof(filename) - 1; i++)
+            filename[len++] = c->data[i];
+        filename[len] = 0;
+        c->size = c->pos = 0;
+        
+        while (len > 0 && filename[len - 1] == 0x0D)
+            filename[--len] = 0;
+        if (len > 0)
+            executeCommand(filename);
+        filename[0] = 0;
+        return;
+    }
+    
+    closeChannel(nr);
+    
+    // Directory
+    if (filename[0] == '$') {
+        readDirectory(nr);
+        return;
+    }
+    
+    // Split off the replace flag, the drive number, and the file type and access mode
+    if (name[0] == '@') {
+        c->replace = true;
+        name++;
     }
+    if (strchr(name, ':'))
+        name = strchr(name, ':') + 1;
+    if ((type = strchr(name, ',')) != NULL) {
+        *type++ = 0;
+        c->write = strchr(type, 'W') != NULL;
+    }
+    
+    // Secondary address 1 is used by SAVE
+    if (nr == 1)
+        c->write = true;
 
-    return IEC_OK;
+    if (name[0] == 0) {
+        setStatus(34, "SYNTAX ERROR");
+        return;
+    }
+    
+    if (c->write) {
+        
+        if (drive[0]->disk.isWriteProtected()) {
+            setStatus(26, "WRITE PROTECT ON");
+            c->write = false;
+            return;
+        }
+        snprintf(c->name, sizeof(c->name), "%.16s", name);
+        setStatus(0, "OK");
+        return;
+    }
+    
+    // Look up file
+    char ascii[17];
+    snprintf(ascii, sizeof(ascii), "%.16s", name);
+    pet2ascii(ascii);
+    int item = virtualDisk->getItemWithName(ascii);
+    if (item < 0) {
+        setStatus(62, "FILE NOT FOUND");
+        return;
+    }
+    
+    // Read file (the first two bytes are part of the file)
+    debug(2, "Reading file %s\n", ascii);
+    uint16_t addr = virtualDisk->getDestinationAddrOfItem(item);
+    appendToChannel(nr, LO_BYTE(addr));
+    appendToChannel(nr, HI_BYTE(addr));
+    virtualDisk->selectItem(item);
+    for (int byte; (byte = virtualDisk->getByte()) != EOF; )
+        appendToChannel(nr, (uint8_t)byte);
+    
+    setStatus(0, "OK");
 }
 
-uint8_t IEC::IECIn(uint8_t *byte)
+void
+IEC::closeChannel(uint8_t nr)
 {
-    *byte = 42;
-    return IEC_OK;
+    Channel *c = &channel[nr];
+    
+    if (c->write)
+        writeFile(nr);
+    
+    free(c->data);
+    memset(c, 0, sizeof(Channel));
+}
+
+void
+IEC::closeAllChannels()
+{
+    for (unsigned i = 0; i < 16; i++) {
+        free(channel[i].data);
+        memset(&channel[i], 0, sizeof(Channel));
+    }
 }
 
-void IEC::IECSetATN()
+void
+IEC::appendToChannel(uint8_t nr, uint8_t byte)
 {
+    Channel *c = &channel[nr];
     
+    if (c->size == c->capacity) {
+        c->capacity = c->capacity ? 2 * c->capacity : 256;
+        c->data = (uint8_t *)realloc(c->data, c->capacity);
+    }
+    c->data[c->size++] = byte;
 }
 
-void IEC::IECRelATN()
+void
+IEC::appendLine(uint8_t nr, uint16_t number, const char *text)
 {
+    // Line link (fixed up by the Basic interpreter after loading)
+    appendToChannel(nr, 0x01);
+    appendToChannel(nr, 0x01);
+    
+    appendToChannel(nr, LO_BYTE(number));
+    appendToChannel(nr, HI_BYTE(number));
+    for (unsigned i = 0; text[i]; i++)
+        appendToChannel(nr, text[i]);
+    appendToChannel(nr, 0x00);
+}
+
+void
+IEC::readDirectory(uint8_t nr)
+{
+    char line[64], name[17];
+    
+    // The directory is loaded as a Basic program to $0401
+    appendToChannel(nr, 0x01);
+    appendToChannel(nr, 0x04);
+    
+    // Header: disk name, disk ID, and DOS type
+    snprintf(name, sizeof(name), "%.16s", virtualDisk->getNameAsPETString());
+    snprintf(line, sizeof(line), "\x12\"%-16s\" %c%c 2A",
+             name, virtualDisk->diskIdLow(), virtualDisk->diskIdHi());
+    appendLine(nr, 0, line);
+    
+    // One line per file
+    for (int i = 0; i < virtualDisk->getNumberOfItems(); i++) {
+        
+        unsigned blocks = virtualDisk->getSizeOfItemInBlocks(i);
+        const char *type = virtualDisk->getTypeOfItem(i);
+        snprintf(name, sizeof(name), "%.16s", virtualDisk->getNameOfItemAsPETString(i));
+        
+        snprintf(line, sizeof(line), "%*s\"%s\"%*s%s%s",
+                 blocks < 10 ? 3 : blocks < 100 ? 2 : 1, "",
+                 name, (int)(16 - strlen(name)), "",
+                 type[0] == '*' ? "" : " ", type);
+        appendLine(nr, blocks, line);
+    }
+    
+    appendLine(nr, virtualDisk->numberOfFreeBlocks(), "BLOCKS FREE.             ");
     
+    // End of program
+    appendToChannel(nr, 0x00);
+    appendToChannel(nr, 0x00);
+    
+    setStatus(0, "OK");
 }
 
-void IEC::IECTurnaround()
+void
+IEC::writeFile(uint8_t nr)
 {
+    Channel *c = &channel[nr];
+    char ascii[17];
+    
+    snprintf(ascii, sizeof(ascii), "%.16s", c->name);
+    pet2ascii(ascii);
+    debug(2, "Writing file %s (%d bytes)\n", ascii, c->size);
     
+    int item = virtualDisk->getItemWithName(ascii);
+    if (item >= 0 && !c->replace) {
+        setStatus(63, "FILE EXISTS");
+        return;
+    }
+    if (item >= 0)
+        virtualDisk->deleteItem(item);
+    
+    if (!virtualDisk->writeItem(c->name, c->data, c->size)) {
+        setStatus(72, "DISK FULL");
+        return;
+    }
+    
+    // Keep the emulated drive in sync
+    drive[0]->attach();
+    drive[0]->updateDisk(virtualDisk);
+    setStatus(0, "OK");
 }
 
-void IEC::IECRelease()
+void
+IEC::executeCommand(const char *cmd)
 {
+    debug(2, "Executing command %s\n", cmd);
     
+    switch (cmd[0]) {
+            
+        case 'I': // Initialize
+            
+            setStatus(0, "OK");
+            break;
+
+        case 'U': // Reset
+            
+            setStatus(73, "CBM DOS V2.6 1541");
+            break;
+
+        case 'S': // Scratch
+        {
+            const char *name = strchr(cmd, ':');
+            char ascii[17];
+            unsigned count = 0;
+            int item;
+            
+            if (name == NULL) {
+                setStatus(34, "SYNTAX ERROR");
+                break;
+            }
+            if (drive[0]->disk.isWriteProtected()) {
+                setStatus(26, "WRITE PROTECT ON");
+                break;
+            }
+            snprintf(ascii, sizeof(ascii), "%.16s", name + 1);
+            pet2ascii(ascii);
+            while ((item = virtualDisk->getItemWithName(ascii)) >= 0) {
+                virtualDisk->deleteItem(item);
+                count++;
+            }
+            if (count) {
+                drive[0]->attach();
+                drive[0]->updateDisk(virtualDisk);
+            }
+            setStatus(1, "FILES SCRATCHED", count);
+            break;
+        }
+        default:
+            
+            setStatus(31, "SYNTAX ERROR");
+    }
 }
 
+void
+IEC::setStatus(unsigned code, const char *text, unsigned track, unsigned sector)
+{
+    snprintf(status, sizeof(status), "%02u,%s,%02u,%02u\r", code, text, track, sector);
+}
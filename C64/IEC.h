@@ -41,18 +41,23 @@
 // Forward declarations
 class CIA2;
 class VC1541;
+class D64Archive;
 
 class IEC : public VirtualComponent {
 
 public:
 	
-	//! Reference to the virtual disk drive
-	VC1541 *drive;
+	//! Maximum number of disk drives on the bus (device numbers 8 to 11)
+	static const unsigned maxDrives = 4;
+	
+	//! References to the virtual disk drives
+	//* The drive in slot i listens to device number 8 + i.
+	VC1541 *drive[maxDrives];
 
 private:
 
-	//! True, iff drive is connected to the IEC bus
-	bool driveConnected;
+	//! True, iff the drive in the corresponding slot is connected to the IEC bus
+	bool driveConnected[maxDrives];
 	
 	//! Current value of the IEC bus atn line	
 	bool atnLine;
@@ -72,23 +77,23 @@ private:
 	//! Previous value of the IEC bus data line
 	bool oldDataLine;
 	 	
-	//! Current value of the atn pin of the connected external device
-	bool deviceAtnPin;
+	//! Current value of the atn pin of each external device
+	bool deviceAtnPin[maxDrives];
 
 	//! True, iff the device atn pin is configured as output
-	bool deviceAtnIsOutput;
+	bool deviceAtnIsOutput[maxDrives];
 
-	//! Current value of the data pin of the connected external device
-	bool deviceDataPin;
+	//! Current value of the data pin of each external device
+	bool deviceDataPin[maxDrives];
 
 	//! True, iff the device data pin is configured as output
-	bool deviceDataIsOutput;
+	bool deviceDataIsOutput[maxDrives];
 		
-	//! Current value of the clock pin of the connected external device
-	bool deviceClockPin;
+	//! Current value of the clock pin of each external device
+	bool deviceClockPin[maxDrives];
 
 	//! True, iff the device clock pin is configured as output
-	bool deviceClockIsOutput;
+	bool deviceClockIsOutput[maxDrives];
 	
 	//! Current value of the data pin of the connected CIA chip
 	bool ciaDataPin;
@@ -111,9 +116,28 @@ private:
 	//! Used to determine if the bus is idle or if data is transferred 
 	uint32_t busActivity;
 	
+	//! Value of the clock line as seen by the C64 while the drive runs on its own thread
+	bool ciaViewClockLine;
+	
+	//! Value of the data line as seen by the C64 while the drive runs on its own thread
+	bool ciaViewDataLine;
+	
+	//! Slots of all connected drives in ascending order
+	unsigned activeSlot[maxDrives];
+	
+	//! Number of connected drives
+	unsigned numActiveDrives;
+	
+	//! Slot of the drive that is currently executed by executeDrives
+	//* Drives in lower slots have already completed the current cycle.
+	unsigned currentSlot;
+	
 	//! Update IEC bus lines depending on the CIA and device pins
 	bool _updateIecLines(bool *atnedge = NULL);
 
+	//! Rebuilds the list of connected drives
+	void updateActiveDrives();
+	
 public:
 
 	//! Constructor
@@ -125,6 +149,9 @@ public:
 	//! Bring the component back to its initial state
 	void reset();
 
+	//! Custom implementation of loadFromBuffer (rebuilds the list of connected drives)
+	void loadFromBuffer(uint8_t **buffer);
+
     //! Dump current configuration into message queue
     void ping();
 	
@@ -134,18 +161,31 @@ public:
 	//! Write trace output to console
 	void dumpTrace();
 	
-	//! Connect the virtual diesc drive to the IEC bus
-	void setDrive(VC1541 *d) { assert(drive == NULL); drive = d; }
-	
-	//! Connect drive to the IEC bus
-	void connectDrive();
+	//! Connect a drive to the IEC bus
+	void connectDrive(unsigned nr = 8);
 	
-	//! Disconnect the drive from the IEC bus
-	void disconnectDrive();
+	//! Disconnect a drive from the IEC bus
+	//* A disconnected drive is frozen until it gets connected again.
+	void disconnectDrive(unsigned nr = 8);
 
-	//! Returns true, iff a virtual disk drive is connected
-	bool driveIsConnected() { return driveConnected; }
-		
+	//! Returns true, iff the drive with the specified device number is connected
+	bool driveIsConnected(unsigned nr = 8) {
+		assert(nr >= 8 && nr < 8 + maxDrives); return driveConnected[nr - 8]; }
+	
+	//! Returns the number of connected drives
+	unsigned numConnectedDrives() { return numActiveDrives; }
+	
+	/*! @brief    Executes all connected drives for a single cycle
+	 *  @details  Invoked by the C64 in all cycles in which one of the drives needs to be executed.
+	 *            Parked drives are skipped as a whole, no matter how many of them are connected.
+	 *            Returns false if one of the drives has hit a breakpoint or an illegal instruction.
+	 */
+	bool executeDrives(uint64_t cycle);
+	
+	//! Lets the C64 execute the drives in the next cycle
+	//* Invoked whenever the wake up cycle of a drive changes.
+	void scheduleDrives();
+	
 	//! Change/Update the value of all three bus lines 
 	void updateIecLines();
 	
@@ -153,13 +193,20 @@ public:
 	//* This function is to be invoked by the cia chip, only.
 	void updateCiaPins(uint8_t cia_data, uint8_t cia_direction);	
 
+	//! Applies a CIA write to the pin variables
+	//* Called by updateCiaPins or, if the drive runs on its own thread, by the drive thread.
+	void applyCiaPins(uint8_t cia_data, uint8_t cia_direction);
+
+	//! Packs the IEC relevant bits of a CIA write into a single byte
+	static uint8_t packCiaPins(uint8_t cia_data, uint8_t cia_direction) {
+		return (cia_data & 0x38) | ((cia_direction & 0x38) >> 3); }
+
+	//! Returns the current CIA pin variables in packed format
+	uint8_t getPackedCiaPins();
+
     //! Updates the values of the device pin variables
-	//* This function is to be invoked by the VC1541 drive, only.
-	void updateDevicePins(uint8_t device_data, uint8_t device_direction);	
-	
-	// Deprecated (won't drive them manually when the drive is constantly connected)
-	void setDeviceClockPin(bool value) { deviceClockPin = value; _updateIecLines(); } 
-	void setDeviceDataPin(bool value) { deviceDataPin = value; _updateIecLines(); }
+	//* This function is to be invoked by the VC1541 drive with the specified device number, only.
+	void updateDevicePins(unsigned nr, uint8_t device_data, uint8_t device_direction);	
 			
 	bool getAtnLine() { return atnLine; }
 	//bool getOldAtnLine() { return oldAtnLine; }
@@ -168,6 +215,26 @@ public:
 	bool getDataLine() { return dataLine; }
 	//bool getOldDataLine() { return oldDataLine; }
 
+	//! Returns the clock line as seen by CIA 2
+	//* Equals getClockLine() unless the drive runs on its own thread. In that case, the drive is
+	//* synchronized with the C64 first.
+	bool getCiaClockLine();
+
+	//! Returns the data line as seen by CIA 2
+	bool getCiaDataLine();
+
+	//! Sets the line values seen by CIA 2 to the current line values
+	void resetCiaView() { ciaViewClockLine = clockLine; ciaViewDataLine = dataLine; }
+
+	//! Informs the C64 about a bus change that has been logged by the drive thread
+	void updateCiaView(bool clock, bool data);
+
+	//! Saves the pin and line variables (used by the drive thread to take checkpoints)
+	void saveBusState(uint8_t **buffer);
+
+	//! Restores the pin and line variables
+	void loadBusState(uint8_t **buffer);
+
 	bool atnPositiveEdge() { return oldAtnLine == 0 && atnLine == 1; }
 	bool atnNegativeEdge() { return oldAtnLine == 1 && atnLine == 0; }
 	bool clockPositiveEdge() { return oldClockLine == 0 && clockLine == 1; }
@@ -177,12 +244,62 @@ public:
 			
 	//! Is invoked periodically by the run thread
 	void execute();
+
+	//! Indicates a change of the bus lines
+	void signalBusActivity();
     
     // -------------------------------------------------------------------
     //                     Frodo-style fast loader
     // -------------------------------------------------------------------
    
-private:
+    /*! @brief    KERNAL serial bus routines intercepted by the fast loader
+     *  @details  The routines are trapped at their entry points inside the KERNAL. These addresses
+     *            are reached via the jump table as well as via internal calls, e.g., from LOAD and
+     *            SAVE. To protect custom KERNALs, a trap is only taken if the first two bytes of the
+     *            routine match the original ROM.
+     */
+    typedef struct {
+        uint16_t addr;
+        uint8_t code[2];
+    } KernalTrap;
+    
+    static const KernalTrap kernalTraps[];
+    
+    //! @brief    Device number of the simulated drive
+    static const uint8_t FAST_LOADER_DEVICE = 8;
+
+    //! @brief    A logical channel of the simulated drive
+    typedef struct {
+        
+        //! @brief    Channel contents (read channels) or received bytes (write channels)
+        uint8_t *data;
+        
+        //! @brief    Number of valid bytes and allocated bytes
+        unsigned size, capacity;
+        
+        //! @brief    Read position
+        unsigned pos;
+        
+        //! @brief    Indicates if the channel has been opened for writing
+        bool write;
+        
+        //! @brief    Name of the file to write (PETSCII, zero terminated)
+        char name[17];
+        
+        //! @brief    Indicates if an existing file with the same name should be replaced
+        bool replace;
+        
+    } Channel;
+    
+    //! @brief    Indicates if the KERNAL serial routines are intercepted
+    bool fastLoader;
+
+    /*! @brief    Disk served by the simulated drive
+     *  @details  A copy of the archive that has been inserted into the VC1541. NULL, if the inserted
+     *            disk can't be served (no disk or a GCR encoded disk). In this case, all calls are
+     *            passed through to the KERNAL and served by the emulated drive.
+     */
+    D64Archive *virtualDisk;
     
     //! Indicates if the simulated drive is currently listening
     bool listening;
@@ -196,9 +313,15 @@ private:
     //! Received command
     uint8_t command;
     
-    //! Filename storage
-    char filename[17]; 
+    //! Filename storage (PETSCII, zero terminated)
+    char filename[41];
 
+    //! @brief    The logical channels (channel 15 is the command channel)
+    Channel channel[16];
+    
+    //! @brief    Current drive status as reported on the command channel
+    char status[41];
+    
 public:
     
     enum {
@@ -214,6 +337,35 @@ public:
         IEC_CMD_CLOSE = 0x0E,       // Close channel
         IEC_CMD_OPEN = 0x0F         // Open channel
     };
+    
+    //! @brief    Returns true iff the KERNAL serial routines are intercepted
+    bool getFastLoader() { return fastLoader; }
+    
+    /*! @brief    Enables or disables the fast loader
+     *  @details  If enabled, the KERNAL serial routines TALK, LISTEN, SECOND, TKSA, CIOUT, ACPTR,
+     *            UNTLK, and UNLSN are executed natively for device 8. Files are read from and written
+     *            to the inserted disk directly, bypassing the drive CPU and the GCR emulation. Hence,
+     *            standard LOAD and SAVE commands complete instantly. Custom fast loaders talk to the
+     *            drive directly and still require the emulated drive.
+     */
+    void setFastLoader(bool enable);
+    
+    /*! @brief    Sets the disk served by the fast loader
+     *  @details  Invoked by the VC1541 whenever a disk is inserted or ejected. The IEC bus takes
+     *            ownership of the archive. Pass NULL if the disk can't be served.
+     */
+    void setVirtualDisk(D64Archive *disk);
+
+    /*! @brief    Executes a trapped KERNAL routine natively
+     *  @details  Invoked by the C64 CPU when it is about to execute an instruction from a memory
+     *            cell tagged with CPU::TRAP. If the call is meant for the simulated drive, its
+     *            effect is emulated, the routine is left as if it had executed an RTS instruction,
+     *            and true is returned. Otherwise, the KERNAL routine is executed as usual.
+     */
+    bool executeTrap(uint16_t addr);
+    
+private:
+    
     //! Sends the attention signal to all connected devices
     uint8_t IECOutATN(uint8_t byte);
 
@@ -223,16 +375,37 @@ public:
     uint8_t IECOutSecWhileTalking(uint8_t byte);
     
     //! Write a data byte to the bus
-    /*! The last byte is signaled by setting eoi (end of information) to 1 */
-    uint8_t IECOut(uint8_t byte, bool eoi);
+    uint8_t IECOut(uint8_t byte);
 
     //! Read a data byte from the bus
     uint8_t IECIn(uint8_t *byte);
     
-    void IECSetATN();
-    void IECRelATN();
-    void IECTurnaround();
-    void IECRelease();
+    //! @brief    Opens a channel with the received file name
+    void openChannel(uint8_t nr);
+    
+    //! @brief    Closes a channel (files opened for writing are written to disk)
+    void closeChannel(uint8_t nr);
+    
+    //! @brief    Closes all channels
+    void closeAllChannels();
+    
+    //! @brief    Appends a byte to the buffer of a channel
+    void appendToChannel(uint8_t nr, uint8_t byte);
+    
+    //! @brief    Appends a Basic line to the buffer of a channel
+    void appendLine(uint8_t nr, uint16_t number, const char *text);
+
+    //! @brief    Creates the directory listing as a Basic program
+    void readDirectory(uint8_t nr);
+    
+    //! @brief    Writes the file received on a channel to disk
+    void writeFile(uint8_t nr);
+    
+    //! @brief    Executes a DOS command received on the command channel
+    void executeCommand(const char *cmd);
+    
+    //! @brief    Updates the status message of the command channel
+    void setStatus(unsigned code, const char *text, unsigned track = 0, unsigned sector = 0);
 };
 	
 #endif
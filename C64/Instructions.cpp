@@ -29,22 +29,25 @@ CPU::fetch() {
 	PC_at_cycle_0 = PC;
 	
 	// Check interrupt lines
-    // if (interruptsPending) {
-    if (1) {
+    if (*clock >= nextInterruptCycle) {
     
         if (nmiEdge && NMILineRaisedLongEnough()) {
             if (tracingEnabled())
                 debug(1, "NMI (source = %02X)\n", nmiLine);
             nmiEdge = false;
-            next = &CPU::nmi_2;
+            updateNextInterruptCycle();
+            next = MC_nmi_2;
             return;
 
         } else if (irqLine && !IRQsAreBlocked() && IRQLineRaisedLongEnough()) {
             if (tracingEnabled())
                 debug(1, "IRQ (source = %02X)\n", irqLine);
-            next = &CPU::irq_2;
+            next = MC_irq_2;
             return;
         }
+        
+        // No interrupt can be triggered before this cycle
+        updateNextInterruptCycle();
     }
 
     /*
@@ -53,6 +56,15 @@ CPU::fetch() {
     }
     */
 
+    // Execute a translated block if possible
+    if (translation && rdyLine && !tracingEnabled() && executeTranslatedBlock())
+        return;
+
+    // Let the trap handler execute the subroutine natively if possible
+    if ((breakpoint[PC] & TRAP) && rdyLine && c64->iec.executeTrap(PC)) {
+        PC_at_cycle_0 = PC;
+    }
+    
     // Execute fetch phase
     FETCH_OPCODE
     next = actionFunc[opcode];
@@ -98,7 +110,7 @@ CPU::fetch() {
     */
     
 	// Check breakpoint tag
-	if (breakpoint[PC_at_cycle_0] != NO_BREAKPOINT) {
+	if (breakpoint[PC_at_cycle_0] & (HARD_BREAKPOINT | SOFT_BREAKPOINT)) {
 		if (breakpoint[PC_at_cycle_0] & SOFT_BREAKPOINT) {
 			breakpoint[PC_at_cycle_0] &= ~SOFT_BREAKPOINT; // Soft breakpoints get deleted when reached
 			setErrorState(SOFT_BREAKPOINT_REACHED);
@@ -107,21 +119,26 @@ CPU::fetch() {
 		}
 		debug(1, "Breakpoint reached\n");
 	}
+    
+    // Try to execute the instruction in one go
+    if (fastPath && fastPathPrepare[opcode] && !tracingEnabled()) {
+        (*this.*fastPathPrepare[opcode])();
+    }
 }
 
 
 void 
-CPU::registerCallback(uint8_t opcode, void (CPU::*func)())
+CPU::registerCallback(uint8_t opcode, MicroInstruction func)
 {
 	registerCallback(opcode, "???", ADDR_IMPLIED, func);
 }
 
 void 
-CPU::registerCallback(uint8_t opcode, const char *mnc, AddressingMode mode, void (CPU::*func)())
+CPU::registerCallback(uint8_t opcode, const char *mnc, AddressingMode mode, MicroInstruction func)
 {
 	// table is write once!
-	if (func != &CPU::JAM) 
-		assert(actionFunc[opcode] == &CPU::JAM);
+	if (func != MC_JAM) 
+		assert(actionFunc[opcode] == MC_JAM);
 	
 	actionFunc[opcode] = func;
 	mnemonic[opcode] = mnc;
@@ -131,308 +148,308 @@ CPU::registerCallback(uint8_t opcode, const char *mnc, AddressingMode mode, void
 void 
 CPU::registerIllegalInstructions()
 {
-	registerCallback(0x93, "SHA*", ADDR_INDIRECT_Y, &CPU::SHA_indirect_y);
-	registerCallback(0x9F, "SHA*", ADDR_ABSOLUTE_Y, &CPU::SHA_absolute_y);
+	registerCallback(0x93, "SHA*", ADDR_INDIRECT_Y, MC_SHA_indirect_y);
+	registerCallback(0x9F, "SHA*", ADDR_ABSOLUTE_Y, MC_SHA_absolute_y);
 
-	registerCallback(0x4B, "ALR*", ADDR_IMMEDIATE, &CPU::ALR_immediate);
+	registerCallback(0x4B, "ALR*", ADDR_IMMEDIATE, MC_ALR_immediate);
 
-	registerCallback(0x0B, "ANC*", ADDR_IMMEDIATE, &CPU::ANC_immediate);
-	registerCallback(0x2B, "ANC*", ADDR_IMMEDIATE, &CPU::ANC_immediate);
+	registerCallback(0x0B, "ANC*", ADDR_IMMEDIATE, MC_ANC_immediate);
+	registerCallback(0x2B, "ANC*", ADDR_IMMEDIATE, MC_ANC_immediate);
 	
-	registerCallback(0x8B, "ANE*", ADDR_IMMEDIATE, &CPU::ANE_immediate);
-
-	registerCallback(0x6B, "ARR*", ADDR_IMMEDIATE, &CPU::ARR_immediate);
-	registerCallback(0xCB, "AXS*", ADDR_IMMEDIATE, &CPU::AXS_immediate);
-
-	registerCallback(0xC7, "DCP*", ADDR_ZERO_PAGE, &CPU::DCP_zero_page);
-	registerCallback(0xD7, "DCP*", ADDR_ZERO_PAGE_X, &CPU::DCP_zero_page_x);
-	registerCallback(0xC3, "DCP*", ADDR_INDIRECT_X, &CPU::DCP_indirect_x);
-	registerCallback(0xD3, "DCP*", ADDR_INDIRECT_Y, &CPU::DCP_indirect_y);
-	registerCallback(0xCF, "DCP*", ADDR_ABSOLUTE, &CPU::DCP_absolute);
-	registerCallback(0xDF, "DCP*", ADDR_ABSOLUTE_X, &CPU::DCP_absolute_x);
-	registerCallback(0xDB, "DCP*", ADDR_ABSOLUTE_Y, &CPU::DCP_absolute_y);
-
-	registerCallback(0xE7, "ISC*", ADDR_ZERO_PAGE, &CPU::ISC_zero_page);
-	registerCallback(0xF7, "ISC*", ADDR_ZERO_PAGE_X, &CPU::ISC_zero_page_x);
-	registerCallback(0xE3, "ISC*", ADDR_INDIRECT_X, &CPU::ISC_indirect_x);
-	registerCallback(0xF3, "ISC*", ADDR_INDIRECT_Y, &CPU::ISC_indirect_y);
-	registerCallback(0xEF, "ISC*", ADDR_ABSOLUTE, &CPU::ISC_absolute);
-	registerCallback(0xFF, "ISC*", ADDR_ABSOLUTE_X, &CPU::ISC_absolute_x);
-	registerCallback(0xFB, "ISC*", ADDR_ABSOLUTE_Y, &CPU::ISC_absolute_y);
-
-	registerCallback(0xBB, "LAS*", ADDR_ABSOLUTE_Y, &CPU::LAS_absolute_y);
-
-	registerCallback(0xA7, "LAX*", ADDR_ZERO_PAGE, &CPU::LAX_zero_page);
-	registerCallback(0xB7, "LAX*", ADDR_ZERO_PAGE_Y, &CPU::LAX_zero_page_y);
-	registerCallback(0xA3, "LAX*", ADDR_INDIRECT_X, &CPU::LAX_indirect_x);
-	registerCallback(0xB3, "LAX*", ADDR_INDIRECT_Y, &CPU::LAX_indirect_y);
-	registerCallback(0xAF, "LAX*", ADDR_ABSOLUTE, &CPU::LAX_absolute);
-	registerCallback(0xBF, "LAX*", ADDR_ABSOLUTE_Y, &CPU::LAX_absolute_y);
-
-	registerCallback(0xAB, "LXA*", ADDR_IMMEDIATE, &CPU::LXA_immediate);
-
-	registerCallback(0x80, "NOP*", ADDR_IMMEDIATE, &CPU::NOP_immediate);
-	registerCallback(0x82, "NOP*", ADDR_IMMEDIATE, &CPU::NOP_immediate);
-	registerCallback(0x89, "NOP*", ADDR_IMMEDIATE, &CPU::NOP_immediate);
-	registerCallback(0xC2, "NOP*", ADDR_IMMEDIATE, &CPU::NOP_immediate);	
-	registerCallback(0xE2, "NOP*", ADDR_IMMEDIATE, &CPU::NOP_immediate);
-	registerCallback(0x1A, "NOP*", ADDR_IMPLIED, &CPU::NOP);
-	registerCallback(0x3A, "NOP*", ADDR_IMPLIED, &CPU::NOP);
-	registerCallback(0x5A, "NOP*", ADDR_IMPLIED, &CPU::NOP);
-	registerCallback(0x7A, "NOP*", ADDR_IMPLIED, &CPU::NOP);
-	registerCallback(0xDA, "NOP*", ADDR_IMPLIED, &CPU::NOP);
-	registerCallback(0xFA, "NOP*", ADDR_IMPLIED, &CPU::NOP);
-	registerCallback(0x04, "NOP*", ADDR_ZERO_PAGE, &CPU::NOP_zero_page);
-	registerCallback(0x44, "NOP*", ADDR_ZERO_PAGE, &CPU::NOP_zero_page);
-	registerCallback(0x64, "NOP*", ADDR_ZERO_PAGE, &CPU::NOP_zero_page);
-	registerCallback(0x0C, "NOP*", ADDR_ABSOLUTE, &CPU::NOP_absolute);
-	registerCallback(0x14, "NOP*", ADDR_ZERO_PAGE_X, &CPU::NOP_zero_page_x);
-	registerCallback(0x34, "NOP*", ADDR_ZERO_PAGE_X, &CPU::NOP_zero_page_x);
-	registerCallback(0x54, "NOP*", ADDR_ZERO_PAGE_X, &CPU::NOP_zero_page_x);
-	registerCallback(0x74, "NOP*", ADDR_ZERO_PAGE_X, &CPU::NOP_zero_page_x);
-	registerCallback(0xD4, "NOP*", ADDR_ZERO_PAGE_X, &CPU::NOP_zero_page_x);
-	registerCallback(0xF4, "NOP*", ADDR_ZERO_PAGE_X, &CPU::NOP_zero_page_x);
-	registerCallback(0x1C, "NOP*", ADDR_ABSOLUTE_X, &CPU::NOP_absolute_x);
-	registerCallback(0x3C, "NOP*", ADDR_ABSOLUTE_X, &CPU::NOP_absolute_x);
-	registerCallback(0x5C, "NOP*", ADDR_ABSOLUTE_X, &CPU::NOP_absolute_x);
-	registerCallback(0x7C, "NOP*", ADDR_ABSOLUTE_X, &CPU::NOP_absolute_x);
-	registerCallback(0xDC, "NOP*", ADDR_ABSOLUTE_X, &CPU::NOP_absolute_x);
-	registerCallback(0xFC, "NOP*", ADDR_ABSOLUTE_X, &CPU::NOP_absolute_x);
-
-	registerCallback(0x27, "RLA*", ADDR_ZERO_PAGE, &CPU::RLA_zero_page);
-	registerCallback(0x37, "RLA*", ADDR_ZERO_PAGE_X, &CPU::RLA_zero_page_x);
-	registerCallback(0x23, "RLA*", ADDR_INDIRECT_X, &CPU::RLA_indirect_x);
-	registerCallback(0x33, "RLA*", ADDR_INDIRECT_Y, &CPU::RLA_indirect_y);
-	registerCallback(0x2F, "RLA*", ADDR_ABSOLUTE, &CPU::RLA_absolute);
-	registerCallback(0x3F, "RLA*", ADDR_ABSOLUTE_X, &CPU::RLA_absolute_x);
-	registerCallback(0x3B, "RLA*", ADDR_ABSOLUTE_Y, &CPU::RLA_absolute_y);
-
-	registerCallback(0x67, "RRA*", ADDR_ZERO_PAGE, &CPU::RRA_zero_page);
-	registerCallback(0x77, "RRA*", ADDR_ZERO_PAGE_X, &CPU::RRA_zero_page_x);
-	registerCallback(0x63, "RRA*", ADDR_INDIRECT_X, &CPU::RRA_indirect_x);
-	registerCallback(0x73, "RRA*", ADDR_INDIRECT_Y, &CPU::RRA_indirect_y);
-	registerCallback(0x6F, "RRA*", ADDR_ABSOLUTE, &CPU::RRA_absolute);
-	registerCallback(0x7F, "RRA*", ADDR_ABSOLUTE_X, &CPU::RRA_absolute_x);
-	registerCallback(0x7B, "RRA*", ADDR_ABSOLUTE_Y, &CPU::RRA_absolute_y);
-
-	registerCallback(0x87, "SAX*", ADDR_ZERO_PAGE, &CPU::SAX_zero_page);
-	registerCallback(0x97, "SAX*", ADDR_ZERO_PAGE_Y, &CPU::SAX_zero_page_y);
-	registerCallback(0x83, "SAX*", ADDR_INDIRECT_X, &CPU::SAX_indirect_x);
-	registerCallback(0x8F, "SAX*", ADDR_ABSOLUTE, &CPU::SAX_absolute);
-
-	registerCallback(0xEB, "SBC*", ADDR_IMMEDIATE, &CPU::SBC_immediate);
-
-	registerCallback(0x9E, "SHX*", ADDR_ABSOLUTE_Y, &CPU::SHX_absolute_y);
-	registerCallback(0x9C, "SHY*", ADDR_ABSOLUTE_X, &CPU::SHY_absolute_x);
-
-	registerCallback(0x07, "SLO*", ADDR_ZERO_PAGE, &CPU::SLO_zero_page);
-	registerCallback(0x17, "SLO*", ADDR_ZERO_PAGE_X, &CPU::SLO_zero_page_x);
-	registerCallback(0x03, "SLO*", ADDR_INDIRECT_X, &CPU::SLO_indirect_x);
-	registerCallback(0x13, "SLO*", ADDR_INDIRECT_Y, &CPU::SLO_indirect_y);
-	registerCallback(0x0F, "SLO*", ADDR_ABSOLUTE, &CPU::SLO_absolute);
-	registerCallback(0x1F, "SLO*", ADDR_ABSOLUTE_X, &CPU::SLO_absolute_x);
-	registerCallback(0x1B, "SLO*", ADDR_ABSOLUTE_Y, &CPU::SLO_absolute_y);
-
-	registerCallback(0x47, "SRE*", ADDR_ZERO_PAGE, &CPU::SRE_zero_page);
-	registerCallback(0x57, "SRE*", ADDR_ZERO_PAGE_X, &CPU::SRE_zero_page_x);
-	registerCallback(0x43, "SRE*", ADDR_INDIRECT_X, &CPU::SRE_indirect_x);
-	registerCallback(0x53, "SRE*", ADDR_INDIRECT_Y, &CPU::SRE_indirect_y);
-	registerCallback(0x4F, "SRE*", ADDR_ABSOLUTE, &CPU::SRE_absolute);
-	registerCallback(0x5F, "SRE*", ADDR_ABSOLUTE_X, &CPU::SRE_absolute_x);
-	registerCallback(0x5B, "SRE*", ADDR_ABSOLUTE_Y, &CPU::SRE_absolute_y);
+	registerCallback(0x8B, "ANE*", ADDR_IMMEDIATE, MC_ANE_immediate);
+
+	registerCallback(0x6B, "ARR*", ADDR_IMMEDIATE, MC_ARR_immediate);
+	registerCallback(0xCB, "AXS*", ADDR_IMMEDIATE, MC_AXS_immediate);
+
+	registerCallback(0xC7, "DCP*", ADDR_ZERO_PAGE, MC_DCP_zero_page);
+	registerCallback(0xD7, "DCP*", ADDR_ZERO_PAGE_X, MC_DCP_zero_page_x);
+	registerCallback(0xC3, "DCP*", ADDR_INDIRECT_X, MC_DCP_indirect_x);
+	registerCallback(0xD3, "DCP*", ADDR_INDIRECT_Y, MC_DCP_indirect_y);
+	registerCallback(0xCF, "DCP*", ADDR_ABSOLUTE, MC_DCP_absolute);
+	registerCallback(0xDF, "DCP*", ADDR_ABSOLUTE_X, MC_DCP_absolute_x);
+	registerCallback(0xDB, "DCP*", ADDR_ABSOLUTE_Y, MC_DCP_absolute_y);
+
+	registerCallback(0xE7, "ISC*", ADDR_ZERO_PAGE, MC_ISC_zero_page);
+	registerCallback(0xF7, "ISC*", ADDR_ZERO_PAGE_X, MC_ISC_zero_page_x);
+	registerCallback(0xE3, "ISC*", ADDR_INDIRECT_X, MC_ISC_indirect_x);
+	registerCallback(0xF3, "ISC*", ADDR_INDIRECT_Y, MC_ISC_indirect_y);
+	registerCallback(0xEF, "ISC*", ADDR_ABSOLUTE, MC_ISC_absolute);
+	registerCallback(0xFF, "ISC*", ADDR_ABSOLUTE_X, MC_ISC_absolute_x);
+	registerCallback(0xFB, "ISC*", ADDR_ABSOLUTE_Y, MC_ISC_absolute_y);
+
+	registerCallback(0xBB, "LAS*", ADDR_ABSOLUTE_Y, MC_LAS_absolute_y);
+
+	registerCallback(0xA7, "LAX*", ADDR_ZERO_PAGE, MC_LAX_zero_page);
+	registerCallback(0xB7, "LAX*", ADDR_ZERO_PAGE_Y, MC_LAX_zero_page_y);
+	registerCallback(0xA3, "LAX*", ADDR_INDIRECT_X, MC_LAX_indirect_x);
+	registerCallback(0xB3, "LAX*", ADDR_INDIRECT_Y, MC_LAX_indirect_y);
+	registerCallback(0xAF, "LAX*", ADDR_ABSOLUTE, MC_LAX_absolute);
+	registerCallback(0xBF, "LAX*", ADDR_ABSOLUTE_Y, MC_LAX_absolute_y);
+
+	registerCallback(0xAB, "LXA*", ADDR_IMMEDIATE, MC_LXA_immediate);
+
+	registerCallback(0x80, "NOP*", ADDR_IMMEDIATE, MC_NOP_immediate);
+	registerCallback(0x82, "NOP*", ADDR_IMMEDIATE, MC_NOP_immediate);
+	registerCallback(0x89, "NOP*", ADDR_IMMEDIATE, MC_NOP_immediate);
+	registerCallback(0xC2, "NOP*", ADDR_IMMEDIATE, MC_NOP_immediate);	
+	registerCallback(0xE2, "NOP*", ADDR_IMMEDIATE, MC_NOP_immediate);
+	registerCallback(0x1A, "NOP*", ADDR_IMPLIED, MC_NOP);
+	registerCallback(0x3A, "NOP*", ADDR_IMPLIED, MC_NOP);
+	registerCallback(0x5A, "NOP*", ADDR_IMPLIED, MC_NOP);
+	registerCallback(0x7A, "NOP*", ADDR_IMPLIED, MC_NOP);
+	registerCallback(0xDA, "NOP*", ADDR_IMPLIED, MC_NOP);
+	registerCallback(0xFA, "NOP*", ADDR_IMPLIED, MC_NOP);
+	registerCallback(0x04, "NOP*", ADDR_ZERO_PAGE, MC_NOP_zero_page);
+	registerCallback(0x44, "NOP*", ADDR_ZERO_PAGE, MC_NOP_zero_page);
+	registerCallback(0x64, "NOP*", ADDR_ZERO_PAGE, MC_NOP_zero_page);
+	registerCallback(0x0C, "NOP*", ADDR_ABSOLUTE, MC_NOP_absolute);
+	registerCallback(0x14, "NOP*", ADDR_ZERO_PAGE_X, MC_NOP_zero_page_x);
+	registerCallback(0x34, "NOP*", ADDR_ZERO_PAGE_X, MC_NOP_zero_page_x);
+	registerCallback(0x54, "NOP*", ADDR_ZERO_PAGE_X, MC_NOP_zero_page_x);
+	registerCallback(0x74, "NOP*", ADDR_ZERO_PAGE_X, MC_NOP_zero_page_x);
+	registerCallback(0xD4, "NOP*", ADDR_ZERO_PAGE_X, MC_NOP_zero_page_x);
+	registerCallback(0xF4, "NOP*", ADDR_ZERO_PAGE_X, MC_NOP_zero_page_x);
+	registerCallback(0x1C, "NOP*", ADDR_ABSOLUTE_X, MC_NOP_absolute_x);
+	registerCallback(0x3C, "NOP*", ADDR_ABSOLUTE_X, MC_NOP_absolute_x);
+	registerCallback(0x5C, "NOP*", ADDR_ABSOLUTE_X, MC_NOP_absolute_x);
+	registerCallback(0x7C, "NOP*", ADDR_ABSOLUTE_X, MC_NOP_absolute_x);
+	registerCallback(0xDC, "NOP*", ADDR_ABSOLUTE_X, MC_NOP_absolute_x);
+	registerCallback(0xFC, "NOP*", ADDR_ABSOLUTE_X, MC_NOP_absolute_x);
+
+	registerCallback(0x27, "RLA*", ADDR_ZERO_PAGE, MC_RLA_zero_page);
+	registerCallback(0x37, "RLA*", ADDR_ZERO_PAGE_X, MC_RLA_zero_page_x);
+	registerCallback(0x23, "RLA*", ADDR_INDIRECT_X, MC_RLA_indirect_x);
+	registerCallback(0x33, "RLA*", ADDR_INDIRECT_Y, MC_RLA_indirect_y);
+	registerCallback(0x2F, "RLA*", ADDR_ABSOLUTE, MC_RLA_absolute);
+	registerCallback(0x3F, "RLA*", ADDR_ABSOLUTE_X, MC_RLA_absolute_x);
+	registerCallback(0x3B, "RLA*", ADDR_ABSOLUTE_Y, MC_RLA_absolute_y);
+
+	registerCallback(0x67, "RRA*", ADDR_ZERO_PAGE, MC_RRA_zero_page);
+	registerCallback(0x77, "RRA*", ADDR_ZERO_PAGE_X, MC_RRA_zero_page_x);
+	registerCallback(0x63, "RRA*", ADDR_INDIRECT_X, MC_RRA_indirect_x);
+	registerCallback(0x73, "RRA*", ADDR_INDIRECT_Y, MC_RRA_indirect_y);
+	registerCallback(0x6F, "RRA*", ADDR_ABSOLUTE, MC_RRA_absolute);
+	registerCallback(0x7F, "RRA*", ADDR_ABSOLUTE_X, MC_RRA_absolute_x);
+	registerCallback(0x7B, "RRA*", ADDR_ABSOLUTE_Y, MC_RRA_absolute_y);
+
+	registerCallback(0x87, "SAX*", ADDR_ZERO_PAGE, MC_SAX_zero_page);
+	registerCallback(0x97, "SAX*", ADDR_ZERO_PAGE_Y, MC_SAX_zero_page_y);
+	registerCallback(0x83, "SAX*", ADDR_INDIRECT_X, MC_SAX_indirect_x);
+	registerCallback(0x8F, "SAX*", ADDR_ABSOLUTE, MC_SAX_absolute);
+
+	registerCallback(0xEB, "SBC*", ADDR_IMMEDIATE, MC_SBC_immediate);
+
+	registerCallback(0x9E, "SHX*", ADDR_ABSOLUTE_Y, MC_SHX_absolute_y);
+	registerCallback(0x9C, "SHY*", ADDR_ABSOLUTE_X, MC_SHY_absolute_x);
+
+	registerCallback(0x07, "SLO*", ADDR_ZERO_PAGE, MC_SLO_zero_page);
+	registerCallback(0x17, "SLO*", ADDR_ZERO_PAGE_X, MC_SLO_zero_page_x);
+	registerCallback(0x03, "SLO*", ADDR_INDIRECT_X, MC_SLO_indirect_x);
+	registerCallback(0x13, "SLO*", ADDR_INDIRECT_Y, MC_SLO_indirect_y);
+	registerCallback(0x0F, "SLO*", ADDR_ABSOLUTE, MC_SLO_absolute);
+	registerCallback(0x1F, "SLO*", ADDR_ABSOLUTE_X, MC_SLO_absolute_x);
+	registerCallback(0x1B, "SLO*", ADDR_ABSOLUTE_Y, MC_SLO_absolute_y);
+
+	registerCallback(0x47, "SRE*", ADDR_ZERO_PAGE, MC_SRE_zero_page);
+	registerCallback(0x57, "SRE*", ADDR_ZERO_PAGE_X, MC_SRE_zero_page_x);
+	registerCallback(0x43, "SRE*", ADDR_INDIRECT_X, MC_SRE_indirect_x);
+	registerCallback(0x53, "SRE*", ADDR_INDIRECT_Y, MC_SRE_indirect_y);
+	registerCallback(0x4F, "SRE*", ADDR_ABSOLUTE, MC_SRE_absolute);
+	registerCallback(0x5F, "SRE*", ADDR_ABSOLUTE_X, MC_SRE_absolute_x);
+	registerCallback(0x5B, "SRE*", ADDR_ABSOLUTE_Y, MC_SRE_absolute_y);
 	
-	registerCallback(0x9B, "TAS*", ADDR_ABSOLUTE_Y, &CPU::TAS_absolute_y);
+	registerCallback(0x9B, "TAS*", ADDR_ABSOLUTE_Y, MC_TAS_absolute_y);
 }
 
 	
 void CPU::registerInstructions()
 {
 	for (int i=0; i<256; i++)
-		registerCallback(i, &CPU::JAM);
-
-	registerCallback(0x69, "ADC", ADDR_IMMEDIATE, &CPU::ADC_immediate);
-	registerCallback(0x65, "ADC", ADDR_ZERO_PAGE, &CPU::ADC_zero_page);
-	registerCallback(0x75, "ADC", ADDR_ZERO_PAGE_X, &CPU::ADC_zero_page_x);
-	registerCallback(0x6D, "ADC", ADDR_ABSOLUTE, &CPU::ADC_absolute);
-	registerCallback(0x7D, "ADC", ADDR_ABSOLUTE_X, &CPU::ADC_absolute_x);
-	registerCallback(0x79, "ADC", ADDR_ABSOLUTE_Y, &CPU::ADC_absolute_y);
-	registerCallback(0x61, "ADC", ADDR_INDIRECT_X, &CPU::ADC_indirect_x);
-	registerCallback(0x71, "ADC", ADDR_INDIRECT_Y, &CPU::ADC_indirect_y);
-
-	registerCallback(0x29, "AND", ADDR_IMMEDIATE, &CPU::AND_immediate);
-	registerCallback(0x25, "AND", ADDR_ZERO_PAGE, &CPU::AND_zero_page);
-	registerCallback(0x35, "AND", ADDR_ZERO_PAGE_X, &CPU::AND_zero_page_x);
-	registerCallback(0x2D, "AND", ADDR_ABSOLUTE, &CPU::AND_absolute);
-	registerCallback(0x3D, "AND", ADDR_ABSOLUTE_X, &CPU::AND_absolute_x);
-	registerCallback(0x39, "AND", ADDR_ABSOLUTE_Y, &CPU::AND_absolute_y);
-	registerCallback(0x21, "AND", ADDR_INDIRECT_X, &CPU::AND_indirect_x);
-	registerCallback(0x31, "AND", ADDR_INDIRECT_Y, &CPU::AND_indirect_y);
+		registerCallback(i, MC_JAM);
+
+	registerCallback(0x69, "ADC", ADDR_IMMEDIATE, MC_ADC_immediate);
+	registerCallback(0x65, "ADC", ADDR_ZERO_PAGE, MC_ADC_zero_page);
+	registerCallback(0x75, "ADC", ADDR_ZERO_PAGE_X, MC_ADC_zero_page_x);
+	registerCallback(0x6D, "ADC", ADDR_ABSOLUTE, MC_ADC_absolute);
+	registerCallback(0x7D, "ADC", ADDR_ABSOLUTE_X, MC_ADC_absolute_x);
+	registerCallback(0x79, "ADC", ADDR_ABSOLUTE_Y, MC_ADC_absolute_y);
+	registerCallback(0x61, "ADC", ADDR_INDIRECT_X, MC_ADC_indirect_x);
+	registerCallback(0x71, "ADC", ADDR_INDIRECT_Y, MC_ADC_indirect_y);
+
+	registerCallback(0x29, "AND", ADDR_IMMEDIATE, MC_AND_immediate);
+	registerCallback(0x25, "AND", ADDR_ZERO_PAGE, MC_AND_zero_page);
+	registerCallback(0x35, "AND", ADDR_ZERO_PAGE_X, MC_AND_zero_page_x);
+	registerCallback(0x2D, "AND", ADDR_ABSOLUTE, MC_AND_absolute);
+	registerCallback(0x3D, "AND", ADDR_ABSOLUTE_X, MC_AND_absolute_x);
+	registerCallback(0x39, "AND", ADDR_ABSOLUTE_Y, MC_AND_absolute_y);
+	registerCallback(0x21, "AND", ADDR_INDIRECT_X, MC_AND_indirect_x);
+	registerCallback(0x31, "AND", ADDR_INDIRECT_Y, MC_AND_indirect_y);
 	
-	registerCallback(0x0A, "ASL", ADDR_ACCUMULATOR, &CPU::ASL_accumulator);
-	registerCallback(0x06, "ASL", ADDR_ZERO_PAGE, &CPU::ASL_zero_page);
-	registerCallback(0x16, "ASL", ADDR_ZERO_PAGE_X, &CPU::ASL_zero_page_x);
-	registerCallback(0x0E, "ASL", ADDR_ABSOLUTE, &CPU::ASL_absolute);
-	registerCallback(0x1E, "ASL", ADDR_ABSOLUTE_X, &CPU::ASL_absolute_x);
+	registerCallback(0x0A, "ASL", ADDR_ACCUMULATOR, MC_ASL_accumulator);
+	registerCallback(0x06, "ASL", ADDR_ZERO_PAGE, MC_ASL_zero_page);
+	registerCallback(0x16, "ASL", ADDR_ZERO_PAGE_X, MC_ASL_zero_page_x);
+	registerCallback(0x0E, "ASL", ADDR_ABSOLUTE, MC_ASL_absolute);
+	registerCallback(0x1E, "ASL", ADDR_ABSOLUTE_X, MC_ASL_absolute_x);
 	
-	registerCallback(0x90, "BCC", ADDR_RELATIVE, &CPU::BCC_relative);
-	registerCallback(0xB0, "BCS", ADDR_RELATIVE, &CPU::BCS_relative);
-	registerCallback(0xF0, "BEQ", ADDR_RELATIVE, &CPU::BEQ_relative);
+	registerCallback(0x90, "BCC", ADDR_RELATIVE, MC_BCC_relative);
+	registerCallback(0xB0, "BCS", ADDR_RELATIVE, MC_BCS_relative);
+	registerCallback(0xF0, "BEQ", ADDR_RELATIVE, MC_BEQ_relative);
 
-	registerCallback(0x24, "BIT", ADDR_ZERO_PAGE, &CPU::BIT_zero_page);
-	registerCallback(0x2C, "BIT", ADDR_ABSOLUTE, &CPU::BIT_absolute);
+	registerCallback(0x24, "BIT", ADDR_ZERO_PAGE, MC_BIT_zero_page);
+	registerCallback(0x2C, "BIT", ADDR_ABSOLUTE, MC_BIT_absolute);
 	
-	registerCallback(0x30, "BMI", ADDR_RELATIVE, &CPU::BMI_relative);
-	registerCallback(0xD0, "BNE", ADDR_RELATIVE, &CPU::BNE_relative);
-	registerCallback(0x10, "BPL", ADDR_RELATIVE, &CPU::BPL_relative);
-	registerCallback(0x00, "BRK", ADDR_IMPLIED, &CPU::BRK);
-	registerCallback(0x50, "BVC", ADDR_RELATIVE, &CPU::BVC_relative);
-	registerCallback(0x70, "BVS", ADDR_RELATIVE, &CPU::BVS_relative);
-
-	registerCallback(0x18, "CLC", ADDR_IMPLIED, &CPU::CLC);
-	registerCallback(0xD8, "CLD", ADDR_IMPLIED, &CPU::CLD);
-	registerCallback(0x58, "CLI", ADDR_IMPLIED, &CPU::CLI);
-	registerCallback(0xB8, "CLV", ADDR_IMPLIED, &CPU::CLV);
-
-	registerCallback(0xC9, "CMP", ADDR_IMMEDIATE, &CPU::CMP_immediate);
-	registerCallback(0xC5, "CMP", ADDR_ZERO_PAGE, &CPU::CMP_zero_page);
-	registerCallback(0xD5, "CMP", ADDR_ZERO_PAGE_X, &CPU::CMP_zero_page_x);
-	registerCallback(0xCD, "CMP", ADDR_ABSOLUTE, &CPU::CMP_absolute);
-	registerCallback(0xDD, "CMP", ADDR_ABSOLUTE_X, &CPU::CMP_absolute_x);
-	registerCallback(0xD9, "CMP", ADDR_ABSOLUTE_Y, &CPU::CMP_absolute_y);
-	registerCallback(0xC1, "CMP", ADDR_INDIRECT_X, &CPU::CMP_indirect_x);
-	registerCallback(0xD1, "CMP", ADDR_INDIRECT_Y, &CPU::CMP_indirect_y);
-
-	registerCallback(0xE0, "CPX", ADDR_IMMEDIATE, &CPU::CPX_immediate);
-	registerCallback(0xE4, "CPX", ADDR_ZERO_PAGE, &CPU::CPX_zero_page);
-	registerCallback(0xEC, "CPX", ADDR_ABSOLUTE, &CPU::CPX_absolute);
-
-	registerCallback(0xC0, "CPY", ADDR_IMMEDIATE, &CPU::CPY_immediate);
-	registerCallback(0xC4, "CPY", ADDR_ZERO_PAGE, &CPU::CPY_zero_page);
-	registerCallback(0xCC, "CPY", ADDR_ABSOLUTE, &CPU::CPY_absolute);
-
-	registerCallback(0xC6, "DEC", ADDR_ZERO_PAGE, &CPU::DEC_zero_page);
-	registerCallback(0xD6, "DEC", ADDR_ZERO_PAGE_X, &CPU::DEC_zero_page_x);
-	registerCallback(0xCE, "DEC", ADDR_ABSOLUTE, &CPU::DEC_absolute);
-	registerCallback(0xDE, "DEC", ADDR_ABSOLUTE_X, &CPU::DEC_absolute_x);
-
-	registerCallback(0xCA, "DEX", ADDR_IMPLIED, &CPU::DEX);
-	registerCallback(0x88, "DEY", ADDR_IMPLIED, &CPU::DEY);
+	registerCallback(0x30, "BMI", ADDR_RELATIVE, MC_BMI_relative);
+	registerCallback(0xD0, "BNE", ADDR_RELATIVE, MC_BNE_relative);
+	registerCallback(0x10, "BPL", ADDR_RELATIVE, MC_BPL_relative);
+	registerCallback(0x00, "BRK", ADDR_IMPLIED, MC_BRK);
+	registerCallback(0x50, "BVC", ADDR_RELATIVE, MC_BVC_relative);
+	registerCallback(0x70, "BVS", ADDR_RELATIVE, MC_BVS_relative);
+
+	registerCallback(0x18, "CLC", ADDR_IMPLIED, MC_CLC);
+	registerCallback(0xD8, "CLD", ADDR_IMPLIED, MC_CLD);
+	registerCallback(0x58, "CLI", ADDR_IMPLIED, MC_CLI);
+	registerCallback(0xB8, "CLV", ADDR_IMPLIED, MC_CLV);
+
+	registerCallback(0xC9, "CMP", ADDR_IMMEDIATE, MC_CMP_immediate);
+	registerCallback(0xC5, "CMP", ADDR_ZERO_PAGE, MC_CMP_zero_page);
+	registerCallback(0xD5, "CMP", ADDR_ZERO_PAGE_X, MC_CMP_zero_page_x);
+	registerCallback(0xCD, "CMP", ADDR_ABSOLUTE, MC_CMP_absolute);
+	registerCallback(0xDD, "CMP", ADDR_ABSOLUTE_X, MC_CMP_absolute_x);
+	registerCallback(0xD9, "CMP", ADDR_ABSOLUTE_Y, MC_CMP_absolute_y);
+	registerCallback(0xC1, "CMP", ADDR_INDIRECT_X, MC_CMP_indirect_x);
+	registerCallback(0xD1, "CMP", ADDR_INDIRECT_Y, MC_CMP_indirect_y);
+
+	registerCallback(0xE0, "CPX", ADDR_IMMEDIATE, MC_CPX_immediate);
+	registerCallback(0xE4, "CPX", ADDR_ZERO_PAGE, MC_CPX_zero_page);
+	registerCallback(0xEC, "CPX", ADDR_ABSOLUTE, MC_CPX_absolute);
+
+	registerCallback(0xC0, "CPY", ADDR_IMMEDIATE, MC_CPY_immediate);
+	registerCallback(0xC4, "CPY", ADDR_ZERO_PAGE, MC_CPY_zero_page);
+	registerCallback(0xCC, "CPY", ADDR_ABSOLUTE, MC_CPY_absolute);
+
+	registerCallback(0xC6, "DEC", ADDR_ZERO_PAGE, MC_DEC_zero_page);
+	registerCallback(0xD6, "DEC", ADDR_ZERO_PAGE_X, MC_DEC_zero_page_x);
+	registerCallback(0xCE, "DEC", ADDR_ABSOLUTE, MC_DEC_absolute);
+	registerCallback(0xDE, "DEC", ADDR_ABSOLUTE_X, MC_DEC_absolute_x);
+
+	registerCallback(0xCA, "DEX", ADDR_IMPLIED, MC_DEX);
+	registerCallback(0x88, "DEY", ADDR_IMPLIED, MC_DEY);
 	
-	registerCallback(0x49, "EOR", ADDR_IMMEDIATE, &CPU::EOR_immediate);
-	registerCallback(0x45, "EOR", ADDR_ZERO_PAGE, &CPU::EOR_zero_page);
-	registerCallback(0x55, "EOR", ADDR_ZERO_PAGE_X, &CPU::EOR_zero_page_x);
-	registerCallback(0x4D, "EOR", ADDR_ABSOLUTE, &CPU::EOR_absolute);
-	registerCallback(0x5D, "EOR", ADDR_ABSOLUTE_X, &CPU::EOR_absolute_x);
-	registerCallback(0x59, "EOR", ADDR_ABSOLUTE_Y, &CPU::EOR_absolute_y);
-	registerCallback(0x41, "EOR", ADDR_INDIRECT_X, &CPU::EOR_indirect_x);
-	registerCallback(0x51, "EOR", ADDR_INDIRECT_Y, &CPU::EOR_indirect_y);
-
-	registerCallback(0xE6, "INC", ADDR_ZERO_PAGE, &CPU::INC_zero_page);
-	registerCallback(0xF6, "INC", ADDR_ZERO_PAGE_X, &CPU::INC_zero_page_x);
-	registerCallback(0xEE, "INC", ADDR_ABSOLUTE, &CPU::INC_absolute);
-	registerCallback(0xFE, "INC", ADDR_ABSOLUTE_X, &CPU::INC_absolute_x);
+	registerCallback(0x49, "EOR", ADDR_IMMEDIATE, MC_EOR_immediate);
+	registerCallback(0x45, "EOR", ADDR_ZERO_PAGE, MC_EOR_zero_page);
+	registerCallback(0x55, "EOR", ADDR_ZERO_PAGE_X, MC_EOR_zero_page_x);
+	registerCallback(0x4D, "EOR", ADDR_ABSOLUTE, MC_EOR_absolute);
+	registerCallback(0x5D, "EOR", ADDR_ABSOLUTE_X, MC_EOR_absolute_x);
+	registerCallback(0x59, "EOR", ADDR_ABSOLUTE_Y, MC_EOR_absolute_y);
+	registerCallback(0x41, "EOR", ADDR_INDIRECT_X, MC_EOR_indirect_x);
+	registerCallback(0x51, "EOR", ADDR_INDIRECT_Y, MC_EOR_indirect_y);
+
+	registerCallback(0xE6, "INC", ADDR_ZERO_PAGE, MC_INC_zero_page);
+	registerCallback(0xF6, "INC", ADDR_ZERO_PAGE_X, MC_INC_zero_page_x);
+	registerCallback(0xEE, "INC", ADDR_ABSOLUTE, MC_INC_absolute);
+	registerCallback(0xFE, "INC", ADDR_ABSOLUTE_X, MC_INC_absolute_x);
 	
-	registerCallback(0xE8, "INX", ADDR_IMPLIED, &CPU::INX);
-	registerCallback(0xC8, "INY", ADDR_IMPLIED, &CPU::INY);
-
-	registerCallback(0x4C, "JMP", ADDR_DIRECT, &CPU::JMP_absolute);
-	registerCallback(0x6C, "JMP", ADDR_INDIRECT, &CPU::JMP_absolute_indirect);
-
-	registerCallback(0x20, "JSR", ADDR_DIRECT, &CPU::JSR);
-
-	registerCallback(0xA9, "LDA", ADDR_IMMEDIATE, &CPU::LDA_immediate);
-	registerCallback(0xA5, "LDA", ADDR_ZERO_PAGE, &CPU::LDA_zero_page);
-	registerCallback(0xB5, "LDA", ADDR_ZERO_PAGE_X, &CPU::LDA_zero_page_x);
-	registerCallback(0xAD, "LDA", ADDR_ABSOLUTE, &CPU::LDA_absolute);
-	registerCallback(0xBD, "LDA", ADDR_ABSOLUTE_X, &CPU::LDA_absolute_x);
-	registerCallback(0xB9, "LDA", ADDR_ABSOLUTE_Y, &CPU::LDA_absolute_y);
-	registerCallback(0xA1, "LDA", ADDR_INDIRECT_X, &CPU::LDA_indirect_x);
-	registerCallback(0xB1, "LDA", ADDR_INDIRECT_Y, &CPU::LDA_indirect_y);
-
-	registerCallback(0xA2, "LDX", ADDR_IMMEDIATE, &CPU::LDX_immediate);
-	registerCallback(0xA6, "LDX", ADDR_ZERO_PAGE, &CPU::LDX_zero_page);
-	registerCallback(0xB6, "LDX", ADDR_ZERO_PAGE_Y,&CPU::LDX_zero_page_y);
-	registerCallback(0xAE, "LDX", ADDR_ABSOLUTE, &CPU::LDX_absolute);
-	registerCallback(0xBE, "LDX", ADDR_ABSOLUTE_Y, &CPU::LDX_absolute_y);
-
-	registerCallback(0xA0, "LDY", ADDR_IMMEDIATE, &CPU::LDY_immediate);
-	registerCallback(0xA4, "LDY", ADDR_ZERO_PAGE, &CPU::LDY_zero_page);
-	registerCallback(0xB4, "LDY", ADDR_ZERO_PAGE_X, &CPU::LDY_zero_page_x);
-	registerCallback(0xAC, "LDY", ADDR_ABSOLUTE, &CPU::LDY_absolute);
-	registerCallback(0xBC, "LDY", ADDR_ABSOLUTE_X, &CPU::LDY_absolute_x);
+	registerCallback(0xE8, "INX", ADDR_IMPLIED, MC_INX);
+	registerCallback(0xC8, "INY", ADDR_IMPLIED, MC_INY);
+
+	registerCallback(0x4C, "JMP", ADDR_DIRECT, MC_JMP_absolute);
+	registerCallback(0x6C, "JMP", ADDR_INDIRECT, MC_JMP_absolute_indirect);
+
+	registerCallback(0x20, "JSR", ADDR_DIRECT, MC_JSR);
+
+	registerCallback(0xA9, "LDA", ADDR_IMMEDIATE, MC_LDA_immediate);
+	registerCallback(0xA5, "LDA", ADDR_ZERO_PAGE, MC_LDA_zero_page);
+	registerCallback(0xB5, "LDA", ADDR_ZERO_PAGE_X, MC_LDA_zero_page_x);
+	registerCallback(0xAD, "LDA", ADDR_ABSOLUTE, MC_LDA_absolute);
+	registerCallback(0xBD, "LDA", ADDR_ABSOLUTE_X, MC_LDA_absolute_x);
+	registerCallback(0xB9, "LDA", ADDR_ABSOLUTE_Y, MC_LDA_absolute_y);
+	registerCallback(0xA1, "LDA", ADDR_INDIRECT_X, MC_LDA_indirect_x);
+	registerCallback(0xB1, "LDA", ADDR_INDIRECT_Y, MC_LDA_indirect_y);
+
+	registerCallback(0xA2, "LDX", ADDR_IMMEDIATE, MC_LDX_immediate);
+	registerCallback(0xA6, "LDX", ADDR_ZERO_PAGE, MC_LDX_zero_page);
+	registerCallback(0xB6, "LDX", ADDR_ZERO_PAGE_Y,MC_LDX_zero_page_y);
+	registerCallback(0xAE, "LDX", ADDR_ABSOLUTE, MC_LDX_absolute);
+	registerCallback(0xBE, "LDX", ADDR_ABSOLUTE_Y, MC_LDX_absolute_y);
+
+	registerCallback(0xA0, "LDY", ADDR_IMMEDIATE, MC_LDY_immediate);
+	registerCallback(0xA4, "LDY", ADDR_ZERO_PAGE, MC_LDY_zero_page);
+	registerCallback(0xB4, "LDY", ADDR_ZERO_PAGE_X, MC_LDY_zero_page_x);
+	registerCallback(0xAC, "LDY", ADDR_ABSOLUTE, MC_LDY_absolute);
+	registerCallback(0xBC, "LDY", ADDR_ABSOLUTE_X, MC_LDY_absolute_x);
 	
-	registerCallback(0x4A, "LSR", ADDR_ACCUMULATOR, &CPU::LSR_accumulator);
-	registerCallback(0x46, "LSR", ADDR_ZERO_PAGE, &CPU::LSR_zero_page);
-	registerCallback(0x56, "LSR", ADDR_ZERO_PAGE_X, &CPU::LSR_zero_page_x);
-	registerCallback(0x4E, "LSR", ADDR_ABSOLUTE, &CPU::LSR_absolute);
-	registerCallback(0x5E, "LSR", ADDR_ABSOLUTE_X, &CPU::LSR_absolute_x);
+	registerCallback(0x4A, "LSR", ADDR_ACCUMULATOR, MC_LSR_accumulator);
+	registerCallback(0x46, "LSR", ADDR_ZERO_PAGE, MC_LSR_zero_page);
+	registerCallback(0x56, "LSR", ADDR_ZERO_PAGE_X, MC_LSR_zero_page_x);
+	registerCallback(0x4E, "LSR", ADDR_ABSOLUTE, MC_LSR_absolute);
+	registerCallback(0x5E, "LSR", ADDR_ABSOLUTE_X, MC_LSR_absolute_x);
 
-	registerCallback(0xEA, "NOP", ADDR_IMPLIED, &CPU::NOP);
+	registerCallback(0xEA, "NOP", ADDR_IMPLIED, MC_NOP);
 	
-	registerCallback(0x09, "ORA", ADDR_IMMEDIATE, &CPU::ORA_immediate);
-	registerCallback(0x05, "ORA", ADDR_ZERO_PAGE, &CPU::ORA_zero_page);
-	registerCallback(0x15, "ORA", ADDR_ZERO_PAGE_X, &CPU::ORA_zero_page_x);
-	registerCallback(0x0D, "ORA", ADDR_ABSOLUTE, &CPU::ORA_absolute);
-	registerCallback(0x1D, "ORA", ADDR_ABSOLUTE_X, &CPU::ORA_absolute_x);
-	registerCallback(0x19, "ORA", ADDR_ABSOLUTE_Y, &CPU::ORA_absolute_y);
-	registerCallback(0x01, "ORA", ADDR_INDIRECT_X, &CPU::ORA_indirect_x);
-	registerCallback(0x11, "ORA", ADDR_INDIRECT_Y, &CPU::ORA_indirect_y);
-
-	registerCallback(0x48, "PHA", ADDR_IMPLIED, &CPU::PHA);
-	registerCallback(0x08, "PHP", ADDR_IMPLIED, &CPU::PHP);
-	registerCallback(0x68, "PLA", ADDR_IMPLIED, &CPU::PLA);
-	registerCallback(0x28, "PLP", ADDR_IMPLIED, &CPU::PLP);
-
-	registerCallback(0x2A, "ROL", ADDR_ACCUMULATOR, &CPU::ROL_accumulator);
-	registerCallback(0x26, "ROL", ADDR_ZERO_PAGE, &CPU::ROL_zero_page);
-	registerCallback(0x36, "ROL", ADDR_ZERO_PAGE_X, &CPU::ROL_zero_page_x);
-	registerCallback(0x2E, "ROL", ADDR_ABSOLUTE, &CPU::ROL_absolute);
-	registerCallback(0x3E, "ROL", ADDR_ABSOLUTE_X, &CPU::ROL_absolute_x);
-
-	registerCallback(0x6A, "ROR", ADDR_ACCUMULATOR, &CPU::ROR_accumulator);
-	registerCallback(0x66, "ROR", ADDR_ZERO_PAGE, &CPU::ROR_zero_page);
-	registerCallback(0x76, "ROR", ADDR_ZERO_PAGE_X, &CPU::ROR_zero_page_x);
-	registerCallback(0x6E, "ROR", ADDR_ABSOLUTE, &CPU::ROR_absolute);
-	registerCallback(0x7E, "ROR", ADDR_ABSOLUTE_X, &CPU::ROR_absolute_x);
+	registerCallback(0x09, "ORA", ADDR_IMMEDIATE, MC_ORA_immediate);
+	registerCallback(0x05, "ORA", ADDR_ZERO_PAGE, MC_ORA_zero_page);
+	registerCallback(0x15, "ORA", ADDR_ZERO_PAGE_X, MC_ORA_zero_page_x);
+	registerCallback(0x0D, "ORA", ADDR_ABSOLUTE, MC_ORA_absolute);
+	registerCallback(0x1D, "ORA", ADDR_ABSOLUTE_X, MC_ORA_absolute_x);
+	registerCallback(0x19, "ORA", ADDR_ABSOLUTE_Y, MC_ORA_absolute_y);
+	registerCallback(0x01, "ORA", ADDR_INDIRECT_X, MC_ORA_indirect_x);
+	registerCallback(0x11, "ORA", ADDR_INDIRECT_Y, MC_ORA_indirect_y);
+
+	registerCallback(0x48, "PHA", ADDR_IMPLIED, MC_PHA);
+	registerCallback(0x08, "PHP", ADDR_IMPLIED, MC_PHP);
+	registerCallback(0x68, "PLA", ADDR_IMPLIED, MC_PLA);
+	registerCallback(0x28, "PLP", ADDR_IMPLIED, MC_PLP);
+
+	registerCallback(0x2A, "ROL", ADDR_ACCUMULATOR, MC_ROL_accumulator);
+	registerCallback(0x26, "ROL", ADDR_ZERO_PAGE, MC_ROL_zero_page);
+	registerCallback(0x36, "ROL", ADDR_ZERO_PAGE_X, MC_ROL_zero_page_x);
+	registerCallback(0x2E, "ROL", ADDR_ABSOLUTE, MC_ROL_absolute);
+	registerCallback(0x3E, "ROL", ADDR_ABSOLUTE_X, MC_ROL_absolute_x);
+
+	registerCallback(0x6A, "ROR", ADDR_ACCUMULATOR, MC_ROR_accumulator);
+	registerCallback(0x66, "ROR", ADDR_ZERO_PAGE, MC_ROR_zero_page);
+	registerCallback(0x76, "ROR", ADDR_ZERO_PAGE_X, MC_ROR_zero_page_x);
+	registerCallback(0x6E, "ROR", ADDR_ABSOLUTE, MC_ROR_absolute);
+	registerCallback(0x7E, "ROR", ADDR_ABSOLUTE_X, MC_ROR_absolute_x);
 	
-	registerCallback(0x40, "RTI", ADDR_IMPLIED, &CPU::RTI);
-	registerCallback(0x60, "RTS", ADDR_IMPLIED, &CPU::RTS);
-
-	registerCallback(0xE9, "SBC", ADDR_IMMEDIATE, &CPU::SBC_immediate);
-	registerCallback(0xE5, "SBC", ADDR_ZERO_PAGE, &CPU::SBC_zero_page);
-	registerCallback(0xF5, "SBC", ADDR_ZERO_PAGE_X, &CPU::SBC_zero_page_x);
-	registerCallback(0xED, "SBC", ADDR_ABSOLUTE, &CPU::SBC_absolute);
-	registerCallback(0xFD, "SBC", ADDR_ABSOLUTE_X, &CPU::SBC_absolute_x);
-	registerCallback(0xF9, "SBC", ADDR_ABSOLUTE_Y, &CPU::SBC_absolute_y);
-	registerCallback(0xE1, "SBC", ADDR_INDIRECT_X, &CPU::SBC_indirect_x);
-	registerCallback(0xF1, "SBC", ADDR_INDIRECT_Y, &CPU::SBC_indirect_y);	
-
-	registerCallback(0x38, "SEC", ADDR_IMPLIED, &CPU::SEC);	
-	registerCallback(0xF8, "SED", ADDR_IMPLIED, &CPU::SED);	
-	registerCallback(0x78, "SEI", ADDR_IMPLIED, &CPU::SEI);	
-
-	registerCallback(0x85, "STA", ADDR_ZERO_PAGE, &CPU::STA_zero_page);
-	registerCallback(0x95, "STA", ADDR_ZERO_PAGE_X, &CPU::STA_zero_page_x);
-	registerCallback(0x8D, "STA", ADDR_ABSOLUTE, &CPU::STA_absolute);
-	registerCallback(0x9D, "STA", ADDR_ABSOLUTE_X, &CPU::STA_absolute_x);
-	registerCallback(0x99, "STA", ADDR_ABSOLUTE_Y, &CPU::STA_absolute_y);
-	registerCallback(0x81, "STA", ADDR_INDIRECT_X, &CPU::STA_indirect_x);
-	registerCallback(0x91, "STA", ADDR_INDIRECT_Y, &CPU::STA_indirect_y);
-
-	registerCallback(0x86, "STX", ADDR_ZERO_PAGE, &CPU::STX_zero_page);
-	registerCallback(0x96, "STX", ADDR_ZERO_PAGE_Y, &CPU::STX_zero_page_y);
-	registerCallback(0x8E, "STX", ADDR_ABSOLUTE, &CPU::STX_absolute);
-
-	registerCallback(0x84, "STY", ADDR_ZERO_PAGE, &CPU::STY_zero_page);
-	registerCallback(0x94, "STY", ADDR_ZERO_PAGE_X, &CPU::STY_zero_page_x);
-	registerCallback(0x8C, "STY", ADDR_ABSOLUTE, &CPU::STY_absolute);
-
-	registerCallback(0xAA, "TAX", ADDR_IMPLIED, &CPU::TAX);	
-	registerCallback(0xA8, "TAY", ADDR_IMPLIED, &CPU::TAY);	
-	registerCallback(0xBA, "TSX", ADDR_IMPLIED, &CPU::TSX);	
-	registerCallback(0x8A, "TXA", ADDR_IMPLIED, &CPU::TXA);	
-	registerCallback(0x9A, "TXS", ADDR_IMPLIED, &CPU::TXS);	
-	registerCallback(0x98, "TYA", ADDR_IMPLIED, &CPU::TYA);	
+	registerCallback(0x40, "RTI", ADDR_IMPLIED, MC_RTI);
+	registerCallback(0x60, "RTS", ADDR_IMPLIED, MC_RTS);
+
+	registerCallback(0xE9, "SBC", ADDR_IMMEDIATE, MC_SBC_immediate);
+	registerCallback(0xE5, "SBC", ADDR_ZERO_PAGE, MC_SBC_zero_page);
+	registerCallback(0xF5, "SBC", ADDR_ZERO_PAGE_X, MC_SBC_zero_page_x);
+	registerCallback(0xED, "SBC", ADDR_ABSOLUTE, MC_SBC_absolute);
+	registerCallback(0xFD, "SBC", ADDR_ABSOLUTE_X, MC_SBC_absolute_x);
+	registerCallback(0xF9, "SBC", ADDR_ABSOLUTE_Y, MC_SBC_absolute_y);
+	registerCallback(0xE1, "SBC", ADDR_INDIRECT_X, MC_SBC_indirect_x);
+	registerCallback(0xF1, "SBC", ADDR_INDIRECT_Y, MC_SBC_indirect_y);	
+
+	registerCallback(0x38, "SEC", ADDR_IMPLIED, MC_SEC);	
+	registerCallback(0xF8, "SED", ADDR_IMPLIED, MC_SED);	
+	registerCallback(0x78, "SEI", ADDR_IMPLIED, MC_SEI);	
+
+	registerCallback(0x85, "STA", ADDR_ZERO_PAGE, MC_STA_zero_page);
+	registerCallback(0x95, "STA", ADDR_ZERO_PAGE_X, MC_STA_zero_page_x);
+	registerCallback(0x8D, "STA", ADDR_ABSOLUTE, MC_STA_absolute);
+	registerCallback(0x9D, "STA", ADDR_ABSOLUTE_X, MC_STA_absolute_x);
+	registerCallback(0x99, "STA", ADDR_ABSOLUTE_Y, MC_STA_absolute_y);
+	registerCallback(0x81, "STA", ADDR_INDIRECT_X, MC_STA_indirect_x);
+	registerCallback(0x91, "STA", ADDR_INDIRECT_Y, MC_STA_indirect_y);
+
+	registerCallback(0x86, "STX", ADDR_ZERO_PAGE, MC_STX_zero_page);
+	registerCallback(0x96, "STX", ADDR_ZERO_PAGE_Y, MC_STX_zero_page_y);
+	registerCallback(0x8E, "STX", ADDR_ABSOLUTE, MC_STX_absolute);
+
+	registerCallback(0x84, "STY", ADDR_ZERO_PAGE, MC_STY_zero_page);
+	registerCallback(0x94, "STY", ADDR_ZERO_PAGE_X, MC_STY_zero_page_x);
+	registerCallback(0x8C, "STY", ADDR_ABSOLUTE, MC_STY_absolute);
+
+	registerCallback(0xAA, "TAX", ADDR_IMPLIED, MC_TAX);	
+	registerCallback(0xA8, "TAY", ADDR_IMPLIED, MC_TAY);	
+	registerCallback(0xBA, "TSX", ADDR_IMPLIED, MC_TSX);	
+	registerCallback(0x8A, "TXA", ADDR_IMPLIED, MC_TXA);	
+	registerCallback(0x9A, "TXS", ADDR_IMPLIED, MC_TXS);	
+	registerCallback(0x98, "TYA", ADDR_IMPLIED, MC_TYA);	
 
 	// Register illegal instructions
 	registerIllegalInstructions();	
@@ -445,7 +462,7 @@ void CPU::registerInstructions()
 void CPU::JAM()
 {
 	setErrorState(ILLEGAL_INSTRUCTION);
-	next = &CPU::JAM_2;
+	next = MC_JAM_2;
 }
 
 void CPU::JAM_2()
@@ -459,34 +476,35 @@ void CPU::JAM_2()
 void CPU::irq()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::irq_2;
+	next = MC_irq_2;
 }
 void CPU::irq_2()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::irq_3;
+	next = MC_irq_3;
 }
 void CPU::irq_3()
 {
 	mem->poke(0x100+(SP--), HI_BYTE(PC));
-	next = &CPU::irq_4;
+	next = MC_irq_4;
 }
 void CPU::irq_4()
 {
 	mem->poke(0x100+(SP--), LO_BYTE(PC));
-	next = &CPU::irq_5;
+	next = MC_irq_5;
 }
 void CPU::irq_5()
 {
 	uint8_t p = getPWithClearedB();
 	mem->poke(0x100+(SP--), p);	
 	setI(1);
-	next = &CPU::irq_6;
+	oldI = 1; // Don't let a preceding CLI reopen the interrupt window
+	next = MC_irq_6;
 }
 void CPU::irq_6()
 {
 	data = mem->peek(0xFFFE);
-	next = &CPU::irq_7;
+	next = MC_irq_7;
 }
 void CPU::irq_7()
 {
@@ -502,33 +520,34 @@ void CPU::irq_7()
 void CPU::nmi()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::nmi_2;
+	next = MC_nmi_2;
 }
 void CPU::nmi_2()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::nmi_3;
+	next = MC_nmi_3;
 }
 void CPU::nmi_3()
 {
 	mem->poke(0x100+(SP--), HI_BYTE(PC));
-	next = &CPU::nmi_4;
+	next = MC_nmi_4;
 }
 void CPU::nmi_4()
 {
 	mem->poke(0x100+(SP--), LO_BYTE(PC));
-	next = &CPU::nmi_5;
+	next = MC_nmi_5;
 }
 void CPU::nmi_5()
 {
 	mem->poke(0x100+(SP--), getPWithClearedB());	
 	setI(1);
-	next = &CPU::nmi_6;
+	oldI = 1; // Don't let a preceding CLI reopen the interrupt window
+	next = MC_nmi_6;
 }
 void CPU::nmi_6()
 {
 	data = mem->peek(0xFFFA);
-	next = &CPU::nmi_7;
+	next = MC_nmi_7;
 }
 void CPU::nmi_7()
 {
@@ -608,7 +627,7 @@ void CPU::ADC_immediate()
 void CPU::ADC_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ADC_zero_page_2;
+	next = MC_ADC_zero_page_2;
 }
 
 void CPU::ADC_zero_page_2() 
@@ -622,13 +641,13 @@ void CPU::ADC_zero_page_2()
 void CPU::ADC_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ADC_zero_page_x_2;
+	next = MC_ADC_zero_page_x_2;
 }
 void CPU::ADC_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::ADC_zero_page_x_3;
+	next = MC_ADC_zero_page_x_3;
 }
 void CPU::ADC_zero_page_x_3() 
 {
@@ -641,12 +660,12 @@ void CPU::ADC_zero_page_x_3()
 void CPU::ADC_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::ADC_absolute_2; 
+	next = MC_ADC_absolute_2; 
 }
 void CPU::ADC_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::ADC_absolute_3; 
+	next = MC_ADC_absolute_3; 
 }
 void CPU::ADC_absolute_3() 
 { 
@@ -659,20 +678,20 @@ void CPU::ADC_absolute_3()
 void CPU::ADC_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ADC_absolute_x_2;
+	next = MC_ADC_absolute_x_2;
 }
 void CPU::ADC_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::ADC_absolute_x_3;
+	next = MC_ADC_absolute_x_3;
 }
 void CPU::ADC_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::ADC_absolute_x_4;
+		next = MC_ADC_absolute_x_4;
 	} else {
 		adc(data);
 		DONE;
@@ -689,20 +708,20 @@ void CPU::ADC_absolute_x_4()
 void CPU::ADC_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ADC_absolute_y_2;
+	next = MC_ADC_absolute_y_2;
 }
 void CPU::ADC_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::ADC_absolute_y_3;
+	next = MC_ADC_absolute_y_3;
 }
 void CPU::ADC_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::ADC_absolute_y_4;
+		next = MC_ADC_absolute_y_4;
 	} else {
 		adc(data);
 		DONE;
@@ -719,23 +738,23 @@ void CPU::ADC_absolute_y_4()
 void CPU::ADC_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ADC_indirect_x_2;
+	next = MC_ADC_indirect_x_2;
 }
 void CPU::ADC_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::ADC_indirect_x_3;
+	next = MC_ADC_indirect_x_3;
 }
 void CPU::ADC_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ADC_indirect_x_4;
+	next = MC_ADC_indirect_x_4;
 }
 void CPU::ADC_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::ADC_indirect_x_5;
+	next = MC_ADC_indirect_x_5;
 }
 void CPU::ADC_indirect_x_5()
 {
@@ -748,25 +767,25 @@ void CPU::ADC_indirect_x_5()
 void CPU::ADC_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ADC_indirect_y_2;
+	next = MC_ADC_indirect_y_2;
 }
 void CPU::ADC_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ADC_indirect_y_3;
+	next = MC_ADC_indirect_y_3;
 }
 void CPU::ADC_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::ADC_indirect_y_4;
+	next = MC_ADC_indirect_y_4;
 }
 void CPU::ADC_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::ADC_indirect_y_5;
+		next = MC_ADC_indirect_y_5;
 	} else {
 		adc(data);
 		DONE;
@@ -799,11 +818,11 @@ void CPU::AND_immediate()
 // -------------------------------------------------------------------------------
 void CPU::AND_absolute() {
 	FETCH_ADDR_LO;
-	next = &CPU::AND_absolute_2;
+	next = MC_AND_absolute_2;
 }
 void CPU::AND_absolute_2() {
 	FETCH_ADDR_HI;
-	next = &CPU::AND_absolute_3;
+	next = MC_AND_absolute_3;
 }
 void CPU::AND_absolute_3() {
 	READ_FROM_ADDRESS;
@@ -815,7 +834,7 @@ void CPU::AND_absolute_3() {
 void CPU::AND_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::AND_zero_page_2;
+	next = MC_AND_zero_page_2;
 }
 void CPU::AND_zero_page_2()
 {
@@ -828,13 +847,13 @@ void CPU::AND_zero_page_2()
 void CPU::AND_zero_page_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::AND_zero_page_x_2;
+	next = MC_AND_zero_page_x_2;
 }
 void CPU::AND_zero_page_x_2()
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::AND_zero_page_x_3;
+	next = MC_AND_zero_page_x_3;
 }
 void CPU::AND_zero_page_x_3()
 {
@@ -847,20 +866,20 @@ void CPU::AND_zero_page_x_3()
 void CPU::AND_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::AND_absolute_x_2;
+	next = MC_AND_absolute_x_2;
 }
 void CPU::AND_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::AND_absolute_x_3;
+	next = MC_AND_absolute_x_3;
 }
 void CPU::AND_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::AND_absolute_x_4;
+		next = MC_AND_absolute_x_4;
 	} else {
 		loadA(A & data);
 		DONE;
@@ -877,20 +896,20 @@ void CPU::AND_absolute_x_4()
 void CPU::AND_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::AND_absolute_y_2;
+	next = MC_AND_absolute_y_2;
 }
 void CPU::AND_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::AND_absolute_y_3;
+	next = MC_AND_absolute_y_3;
 }
 void CPU::AND_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::AND_absolute_y_4;
+		next = MC_AND_absolute_y_4;
 	} else {
 		loadA(A & data);
 		DONE;
@@ -907,23 +926,23 @@ void CPU::AND_absolute_y_4()
 void CPU::AND_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::AND_indirect_x_2;
+	next = MC_AND_indirect_x_2;
 }
 void CPU::AND_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::AND_indirect_x_3;
+	next = MC_AND_indirect_x_3;
 }
 void CPU::AND_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::AND_indirect_x_4;
+	next = MC_AND_indirect_x_4;
 }
 void CPU::AND_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::AND_indirect_x_5;
+	next = MC_AND_indirect_x_5;
 }
 void CPU::AND_indirect_x_5()
 {
@@ -936,25 +955,25 @@ void CPU::AND_indirect_x_5()
 void CPU::AND_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::AND_indirect_y_2;
+	next = MC_AND_indirect_y_2;
 }
 void CPU::AND_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::AND_indirect_y_3;
+	next = MC_AND_indirect_y_3;
 }
 void CPU::AND_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::AND_indirect_y_4;
+	next = MC_AND_indirect_y_4;
 }
 void CPU::AND_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::AND_indirect_y_5;
+		next = MC_AND_indirect_y_5;
 	} else {
 		loadA(A & data);
 		DONE;
@@ -991,18 +1010,18 @@ void CPU::ASL_accumulator()
 void CPU::ASL_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ASL_zero_page_2;
+	next = MC_ASL_zero_page_2;
 }
 void CPU::ASL_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ASL_zero_page_3;
+	next = MC_ASL_zero_page_3;
 }
 void CPU::ASL_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ASL;
-	next = &CPU::ASL_zero_page_4;
+	next = MC_ASL_zero_page_4;
 }
 void CPU::ASL_zero_page_4()
 {
@@ -1014,24 +1033,24 @@ void CPU::ASL_zero_page_4()
 void CPU::ASL_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ASL_zero_page_x_2;
+	next = MC_ASL_zero_page_x_2;
 }
 void CPU::ASL_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::ASL_zero_page_x_3;
+	next = MC_ASL_zero_page_x_3;
 }
 void CPU::ASL_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ASL_zero_page_x_4;
+	next = MC_ASL_zero_page_x_4;
 }
 void CPU::ASL_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ASL;
-	next = &CPU::ASL_zero_page_x_5;
+	next = MC_ASL_zero_page_x_5;
 }
 void CPU::ASL_zero_page_x_5()
 {
@@ -1043,23 +1062,23 @@ void CPU::ASL_zero_page_x_5()
 void CPU::ASL_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ASL_absolute_2;
+	next = MC_ASL_absolute_2;
 }
 void CPU::ASL_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::ASL_absolute_3;
+	next = MC_ASL_absolute_3;
 }
 void CPU::ASL_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ASL_absolute_4;
+	next = MC_ASL_absolute_4;
 }
 void CPU::ASL_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_ASL;
-	next = &CPU::ASL_absolute_5;
+	next = MC_ASL_absolute_5;
 }
 void CPU::ASL_absolute_5()
 {
@@ -1071,31 +1090,31 @@ void CPU::ASL_absolute_5()
 void CPU::ASL_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ASL_absolute_x_2;
+	next = MC_ASL_absolute_x_2;
 }
 void CPU::ASL_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::ASL_absolute_x_3;
+	next = MC_ASL_absolute_x_3;
 }
 void CPU::ASL_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::ASL_absolute_x_4;
+	next = MC_ASL_absolute_x_4;
 }
 void CPU::ASL_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ASL_absolute_x_5;
+	next = MC_ASL_absolute_x_5;
 }
 void CPU::ASL_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ASL;
-	next = &CPU::ASL_absolute_x_6;
+	next = MC_ASL_absolute_x_6;
 }
 void CPU::ASL_absolute_x_6()
 {
@@ -1107,34 +1126,34 @@ void CPU::ASL_absolute_x_6()
 void CPU::ASL_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ASL_indirect_x_2;
+	next = MC_ASL_indirect_x_2;
 }
 void CPU::ASL_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::ASL_indirect_x_3;
+	next = MC_ASL_indirect_x_3;
 }
 void CPU::ASL_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ASL_indirect_x_4;
+	next = MC_ASL_indirect_x_4;
 }
 void CPU::ASL_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::ASL_indirect_x_5;
+	next = MC_ASL_indirect_x_5;
 }
 void CPU::ASL_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ASL_indirect_x_6;
+	next = MC_ASL_indirect_x_6;
 }
 void CPU::ASL_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ASL;
-	next = &CPU::ASL_indirect_x_7;
+	next = MC_ASL_indirect_x_7;
 }
 void CPU::ASL_indirect_x_7()
 {
@@ -1173,7 +1192,7 @@ void CPU::BCC_relative()
 {
 	READ_IMMEDIATE;
 	if (!getC()) { 
-		next = &CPU::BCC_relative_2;
+		next = MC_BCC_relative_2;
 	} else {
 		DONE;
 	}
@@ -1185,7 +1204,7 @@ void CPU::BCC_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		next = (data & 0x80) ? MC_branch_3_underflow : MC_branch_3_overflow;
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++;
@@ -1207,7 +1226,7 @@ void CPU::BCS_relative()
 {	
 	READ_IMMEDIATE;
 	if (getC()) { 
-		next = &CPU::BCS_relative_2;
+		next = MC_BCS_relative_2;
 	} else {
 		DONE;
 	}
@@ -1219,7 +1238,7 @@ void CPU::BCS_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		next = (data & 0x80) ? MC_branch_3_underflow : MC_branch_3_overflow;
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++;
@@ -1241,7 +1260,7 @@ void CPU::BEQ_relative()
 {	
 	READ_IMMEDIATE;
 	if (getZ()) { 
-		next = &CPU::BEQ_relative_2;
+		next = MC_BEQ_relative_2;
 	} else {
 		DONE;
 	}
@@ -1253,7 +1272,7 @@ void CPU::BEQ_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		next = (data & 0x80) ? MC_branch_3_underflow : MC_branch_3_overflow;
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++;
@@ -1274,7 +1293,7 @@ void CPU::BEQ_relative_2()
 void CPU::BIT_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::BIT_zero_page_2;
+	next = MC_BIT_zero_page_2;
 }
 void CPU::BIT_zero_page_2()
 {
@@ -1289,12 +1308,12 @@ void CPU::BIT_zero_page_2()
 void CPU::BIT_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::BIT_absolute_2;
+	next = MC_BIT_absolute_2;
 }
 void CPU::BIT_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::BIT_absolute_3;
+	next = MC_BIT_absolute_3;
 }
 void CPU::BIT_absolute_3()
 {
@@ -1319,7 +1338,7 @@ void CPU::BMI_relative()
 {	
 	READ_IMMEDIATE;
 	if (getN()) { 
-		next = &CPU::BMI_relative_2;
+		next = MC_BMI_relative_2;
 	} else {
 		DONE;
 	}
@@ -1331,7 +1350,7 @@ void CPU::BMI_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		next = (data & 0x80) ? MC_branch_3_underflow : MC_branch_3_overflow;
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++;
@@ -1353,7 +1372,7 @@ void CPU::BNE_relative()
 {	
 	READ_IMMEDIATE;
 	if (!getZ()) { 
-		next = &CPU::BNE_relative_2;
+		next = MC_BNE_relative_2;
 	} else {
 		DONE;
 	}
@@ -1365,7 +1384,7 @@ void CPU::BNE_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		next = (data & 0x80) ? MC_branch_3_underflow : MC_branch_3_overflow;
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++;
@@ -1387,7 +1406,7 @@ void CPU::BPL_relative()
 {	
 	READ_IMMEDIATE;
 	if (!getN()) { 
-		next = &CPU::BPL_relative_2;
+		next = MC_BPL_relative_2;
 	} else {
 		DONE;
 	}
@@ -1399,7 +1418,7 @@ void CPU::BPL_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		next = (data & 0x80) ? MC_branch_3_underflow : MC_branch_3_overflow;
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
         nextPossibleNmiCycle++;
@@ -1420,13 +1439,13 @@ void CPU::BPL_relative_2()
 void CPU::BRK()
 {
 	IDLE_READ_IMMEDIATE;
-	next = &CPU::BRK_2;
+	next = MC_BRK_2;
 }
 void CPU::BRK_2()
 {
 	setB(1); 
 	PUSH_PCH;
-	next = &CPU::BRK_3;
+	next = MC_BRK_3;
 }
 void CPU::BRK_3()
 {
@@ -1437,20 +1456,20 @@ void CPU::BRK_3()
 	//  jump to the NMI vector ($FFFA), and the P register will be pushed on the stack with the B flag set."
 	if (nmiEdge) {
         clearNMIEdge();
-		next = &CPU::BRK_nmi_4;
+		next = MC_BRK_nmi_4;
 	} else {
-		next = &CPU::BRK_4;
+		next = MC_BRK_4;
 	}
 }
 void CPU::BRK_4()
 {
 	PUSH_P;
-	next = &CPU::BRK_5;
+	next = MC_BRK_5;
 }
 void CPU::BRK_5()
 {
 	data = mem->peek(0xFFFE);
-	next = &CPU::BRK_6;
+	next = MC_BRK_6;
 }
 void CPU::BRK_6()
 {
@@ -1460,21 +1479,21 @@ void CPU::BRK_6()
 
 	// "Ein NMI darf nicht sofort nach einem BRK oder IRQ ausgefhrt werden, sondern erst mit 1 Cycle Delay." 
 	// [http://www.c64-wiki.de/index.php/Micro64]
-	if (nextPossibleNmiCycle < c64->getCycles() + 2)
-		nextPossibleNmiCycle = c64->getCycles() + 2;
+	if (nextPossibleNmiCycle < *clock + 2)
+		nextPossibleNmiCycle = *clock + 2;
 	DONE;
 }
 
 void CPU::BRK_nmi_4()
 {
 	PUSH_P;
-	next = &CPU::BRK_nmi_5;
+	next = MC_BRK_nmi_5;
 }
 
 void CPU::BRK_nmi_5()
 {
 	data = mem->peek(0xFFFA);
-	next = &CPU::BRK_nmi_6;
+	next = MC_BRK_nmi_6;
 }
 void CPU::BRK_nmi_6()
 {
@@ -1497,11 +1516,11 @@ void CPU::BVC_relative()
 {	
 	READ_IMMEDIATE;
 
-    if (chipModel == MOS6502 /* Drive CPU */ && !c64->floppy.getBitAccuracy()) {
+    if (chipModel == MOS6502 /* Drive CPU */ && !floppy->getBitAccuracy()) {
         
         // Special handling for the VC1541 CPU. Taken from Frodo
-        if (!((c64->floppy.via2.io[12] & 0x0E) == 0x0E || getV())) {
-            next = &CPU::BVC_relative_2;
+        if (!((floppy->via2.io[12] & 0x0E) == 0x0E || getV())) {
+            next = MC_BVC_relative_2;
         } else {
             DONE;
         }
@@ -1510,7 +1529,7 @@ void CPU::BVC_relative()
         
         // Standard CPU behavior
         if (!getV()) {
-            next = &CPU::BVC_relative_2;
+            next = MC_BVC_relative_2;
         } else {
             DONE;
         }
@@ -1524,7 +1543,7 @@ void CPU::BVC_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		next = (data & 0x80) ? MC_branch_3_underflow : MC_branch_3_overflow;
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++;
@@ -1546,11 +1565,11 @@ void CPU::BVS_relative()
 {	
 	READ_IMMEDIATE;
     
-    if (chipModel == MOS6502 /* Drive CPU */ && !c64->floppy.getBitAccuracy()) {
+    if (chipModel == MOS6502 /* Drive CPU */ && !floppy->getBitAccuracy()) {
         
         // Special handling for the VC1541 CPU. Taken from Frodo
-        if ((c64->floppy.via2.io[12] & 0x0E) == 0x0E || getV()) {
-            next = &CPU::BVS_relative_2;
+        if ((floppy->via2.io[12] & 0x0E) == 0x0E || getV()) {
+            next = MC_BVS_relative_2;
         } else {
             DONE;
         }
@@ -1559,7 +1578,7 @@ void CPU::BVS_relative()
         
         // Standard CPU behavior
         if (getV()) {
-            next = &CPU::BVS_relative_2;
+            next = MC_BVS_relative_2;
         } else {
             DONE;
         }
@@ -1573,7 +1592,7 @@ void CPU::BVS_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		next = (data & 0x80) ? MC_branch_3_underflow : MC_branch_3_overflow;
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++; 
@@ -1689,11 +1708,11 @@ void CPU::CMP_immediate()
 // -------------------------------------------------------------------------------
 void CPU::CMP_absolute() {
 	FETCH_ADDR_LO;
-	next = &CPU::CMP_absolute_2;
+	next = MC_CMP_absolute_2;
 }
 void CPU::CMP_absolute_2() {
 	FETCH_ADDR_HI;
-	next = &CPU::CMP_absolute_3;
+	next = MC_CMP_absolute_3;
 }
 void CPU::CMP_absolute_3() {
 	READ_FROM_ADDRESS;
@@ -1705,7 +1724,7 @@ void CPU::CMP_absolute_3() {
 void CPU::CMP_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::CMP_zero_page_2;
+	next = MC_CMP_zero_page_2;
 }
 void CPU::CMP_zero_page_2()
 {
@@ -1718,13 +1737,13 @@ void CPU::CMP_zero_page_2()
 void CPU::CMP_zero_page_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::CMP_zero_page_x_2;
+	next = MC_CMP_zero_page_x_2;
 }
 void CPU::CMP_zero_page_x_2()
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::CMP_zero_page_x_3;
+	next = MC_CMP_zero_page_x_3;
 }
 void CPU::CMP_zero_page_x_3()
 {
@@ -1737,20 +1756,20 @@ void CPU::CMP_zero_page_x_3()
 void CPU::CMP_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::CMP_absolute_x_2;
+	next = MC_CMP_absolute_x_2;
 }
 void CPU::CMP_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::CMP_absolute_x_3;
+	next = MC_CMP_absolute_x_3;
 }
 void CPU::CMP_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::CMP_absolute_x_4;
+		next = MC_CMP_absolute_x_4;
 	} else {
 		cmp(A, data);
 		DONE;
@@ -1767,20 +1786,20 @@ void CPU::CMP_absolute_x_4()
 void CPU::CMP_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::CMP_absolute_y_2;
+	next = MC_CMP_absolute_y_2;
 }
 void CPU::CMP_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::CMP_absolute_y_3;
+	next = MC_CMP_absolute_y_3;
 }
 void CPU::CMP_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::CMP_absolute_y_4;
+		next = MC_CMP_absolute_y_4;
 	} else {
 		cmp(A, data);
 		DONE;
@@ -1797,23 +1816,23 @@ void CPU::CMP_absolute_y_4()
 void CPU::CMP_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::CMP_indirect_x_2;
+	next = MC_CMP_indirect_x_2;
 }
 void CPU::CMP_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::CMP_indirect_x_3;
+	next = MC_CMP_indirect_x_3;
 }
 void CPU::CMP_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::CMP_indirect_x_4;
+	next = MC_CMP_indirect_x_4;
 }
 void CPU::CMP_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::CMP_indirect_x_5;
+	next = MC_CMP_indirect_x_5;
 }
 void CPU::CMP_indirect_x_5()
 {
@@ -1826,25 +1845,25 @@ void CPU::CMP_indirect_x_5()
 void CPU::CMP_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::CMP_indirect_y_2;
+	next = MC_CMP_indirect_y_2;
 }
 void CPU::CMP_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::CMP_indirect_y_3;
+	next = MC_CMP_indirect_y_3;
 }
 void CPU::CMP_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::CMP_indirect_y_4;
+	next = MC_CMP_indirect_y_4;
 }
 void CPU::CMP_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::CMP_indirect_y_5;
+		next = MC_CMP_indirect_y_5;
 	} else {
 		cmp(A, data);
 		DONE;
@@ -1878,7 +1897,7 @@ void CPU::CPX_immediate()
 void CPU::CPX_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::CPX_zero_page_2;
+	next = MC_CPX_zero_page_2;
 }
 void CPU::CPX_zero_page_2()
 {
@@ -1890,11 +1909,11 @@ void CPU::CPX_zero_page_2()
 // -------------------------------------------------------------------------------
 void CPU::CPX_absolute() {
 	FETCH_ADDR_LO;
-	next = &CPU::CPX_absolute_2;
+	next = MC_CPX_absolute_2;
 }
 void CPU::CPX_absolute_2() {
 	FETCH_ADDR_HI;
-	next = &CPU::CPX_absolute_3;
+	next = MC_CPX_absolute_3;
 }
 void CPU::CPX_absolute_3() {
 	READ_FROM_ADDRESS;
@@ -1923,7 +1942,7 @@ void CPU::CPY_immediate()
 void CPU::CPY_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::CPY_zero_page_2;
+	next = MC_CPY_zero_page_2;
 }
 void CPU::CPY_zero_page_2()
 {
@@ -1935,11 +1954,11 @@ void CPU::CPY_zero_page_2()
 // -------------------------------------------------------------------------------
 void CPU::CPY_absolute() {
 	FETCH_ADDR_LO;
-	next = &CPU::CPY_absolute_2;
+	next = MC_CPY_absolute_2;
 }
 void CPU::CPY_absolute_2() {
 	FETCH_ADDR_HI;
-	next = &CPU::CPY_absolute_3;
+	next = MC_CPY_absolute_3;
 }
 void CPU::CPY_absolute_3() {
 	READ_FROM_ADDRESS;
@@ -1963,18 +1982,18 @@ void CPU::CPY_absolute_3() {
 void CPU::DEC_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DEC_zero_page_2;
+	next = MC_DEC_zero_page_2;
 }
 void CPU::DEC_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::DEC_zero_page_3;
+	next = MC_DEC_zero_page_3;
 }
 void CPU::DEC_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_DEC;
-	next = &CPU::DEC_zero_page_4;
+	next = MC_DEC_zero_page_4;
 }
 void CPU::DEC_zero_page_4()
 {
@@ -1986,24 +2005,24 @@ void CPU::DEC_zero_page_4()
 void CPU::DEC_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DEC_zero_page_x_2;
+	next = MC_DEC_zero_page_x_2;
 }
 void CPU::DEC_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::DEC_zero_page_x_3;
+	next = MC_DEC_zero_page_x_3;
 }
 void CPU::DEC_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::DEC_zero_page_x_4;
+	next = MC_DEC_zero_page_x_4;
 }
 void CPU::DEC_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_DEC;
-	next = &CPU::DEC_zero_page_x_5;
+	next = MC_DEC_zero_page_x_5;
 }
 void CPU::DEC_zero_page_x_5()
 {
@@ -2015,23 +2034,23 @@ void CPU::DEC_zero_page_x_5()
 void CPU::DEC_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DEC_absolute_2;
+	next = MC_DEC_absolute_2;
 }
 void CPU::DEC_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::DEC_absolute_3;
+	next = MC_DEC_absolute_3;
 }
 void CPU::DEC_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DEC_absolute_4;
+	next = MC_DEC_absolute_4;
 }
 void CPU::DEC_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DEC_absolute_5;
+	next = MC_DEC_absolute_5;
 }
 void CPU::DEC_absolute_5()
 {
@@ -2043,13 +2062,13 @@ void CPU::DEC_absolute_5()
 void CPU::DEC_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DEC_absolute_x_2;
+	next = MC_DEC_absolute_x_2;
 }
 void CPU::DEC_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::DEC_absolute_x_3;
+	next = MC_DEC_absolute_x_3;
 }
 void CPU::DEC_absolute_x_3()
 {
@@ -2057,18 +2076,18 @@ void CPU::DEC_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::DEC_absolute_x_4;
+	next = MC_DEC_absolute_x_4;
 }
 void CPU::DEC_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DEC_absolute_x_5;
+	next = MC_DEC_absolute_x_5;
 }
 void CPU::DEC_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DEC_absolute_x_6;
+	next = MC_DEC_absolute_x_6;
 }
 void CPU::DEC_absolute_x_6()
 {
@@ -2080,34 +2099,34 @@ void CPU::DEC_absolute_x_6()
 void CPU::DEC_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::DEC_indirect_x_2;
+	next = MC_DEC_indirect_x_2;
 }
 void CPU::DEC_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::DEC_indirect_x_3;
+	next = MC_DEC_indirect_x_3;
 }
 void CPU::DEC_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::DEC_indirect_x_4;
+	next = MC_DEC_indirect_x_4;
 }
 void CPU::DEC_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::DEC_indirect_x_5;
+	next = MC_DEC_indirect_x_5;
 }
 void CPU::DEC_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DEC_indirect_x_6;
+	next = MC_DEC_indirect_x_6;
 }
 void CPU::DEC_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DEC_indirect_x_7;
+	next = MC_DEC_indirect_x_7;
 }
 void CPU::DEC_indirect_x_7()
 {
@@ -2169,11 +2188,11 @@ void CPU::EOR_immediate()
 // -------------------------------------------------------------------------------
 void CPU::EOR_absolute() {
 	FETCH_ADDR_LO;
-	next = &CPU::EOR_absolute_2;
+	next = MC_EOR_absolute_2;
 }
 void CPU::EOR_absolute_2() {
 	FETCH_ADDR_HI;
-	next = &CPU::EOR_absolute_3;
+	next = MC_EOR_absolute_3;
 }
 void CPU::EOR_absolute_3() {
 	READ_FROM_ADDRESS;
@@ -2185,7 +2204,7 @@ void CPU::EOR_absolute_3() {
 void CPU::EOR_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::EOR_zero_page_2;
+	next = MC_EOR_zero_page_2;
 }
 void CPU::EOR_zero_page_2()
 {
@@ -2198,13 +2217,13 @@ void CPU::EOR_zero_page_2()
 void CPU::EOR_zero_page_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::EOR_zero_page_x_2;
+	next = MC_EOR_zero_page_x_2;
 }
 void CPU::EOR_zero_page_x_2()
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::EOR_zero_page_x_3;
+	next = MC_EOR_zero_page_x_3;
 }
 void CPU::EOR_zero_page_x_3()
 {
@@ -2217,20 +2236,20 @@ void CPU::EOR_zero_page_x_3()
 void CPU::EOR_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::EOR_absolute_x_2;
+	next = MC_EOR_absolute_x_2;
 }
 void CPU::EOR_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::EOR_absolute_x_3;
+	next = MC_EOR_absolute_x_3;
 }
 void CPU::EOR_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::EOR_absolute_x_4;
+		next = MC_EOR_absolute_x_4;
 	} else {
 		loadA(A ^ data);
 		DONE;
@@ -2247,20 +2266,20 @@ void CPU::EOR_absolute_x_4()
 void CPU::EOR_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::EOR_absolute_y_2;
+	next = MC_EOR_absolute_y_2;
 }
 void CPU::EOR_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::EOR_absolute_y_3;
+	next = MC_EOR_absolute_y_3;
 }
 void CPU::EOR_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::EOR_absolute_y_4;
+		next = MC_EOR_absolute_y_4;
 	} else {
 		loadA(A ^ data);
 		DONE;
@@ -2277,23 +2296,23 @@ void CPU::EOR_absolute_y_4()
 void CPU::EOR_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::EOR_indirect_x_2;
+	next = MC_EOR_indirect_x_2;
 }
 void CPU::EOR_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::EOR_indirect_x_3;
+	next = MC_EOR_indirect_x_3;
 }
 void CPU::EOR_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::EOR_indirect_x_4;
+	next = MC_EOR_indirect_x_4;
 }
 void CPU::EOR_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::EOR_indirect_x_5;
+	next = MC_EOR_indirect_x_5;
 }
 void CPU::EOR_indirect_x_5()
 {
@@ -2306,25 +2325,25 @@ void CPU::EOR_indirect_x_5()
 void CPU::EOR_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::EOR_indirect_y_2;
+	next = MC_EOR_indirect_y_2;
 }
 void CPU::EOR_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::EOR_indirect_y_3;
+	next = MC_EOR_indirect_y_3;
 }
 void CPU::EOR_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::EOR_indirect_y_4;
+	next = MC_EOR_indirect_y_4;
 }
 void CPU::EOR_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::EOR_indirect_y_5;
+		next = MC_EOR_indirect_y_5;
 	} else {
 		loadA(A ^ data);
 		DONE;
@@ -2353,18 +2372,18 @@ void CPU::EOR_indirect_y_5()
 void CPU::INC_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::INC_zero_page_2;
+	next = MC_INC_zero_page_2;
 }
 void CPU::INC_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::INC_zero_page_3;
+	next = MC_INC_zero_page_3;
 }
 void CPU::INC_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_INC;
-	next = &CPU::INC_zero_page_4;
+	next = MC_INC_zero_page_4;
 }
 void CPU::INC_zero_page_4()
 {
@@ -2376,24 +2395,24 @@ void CPU::INC_zero_page_4()
 void CPU::INC_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::INC_zero_page_x_2;
+	next = MC_INC_zero_page_x_2;
 }
 void CPU::INC_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::INC_zero_page_x_3;
+	next = MC_INC_zero_page_x_3;
 }
 void CPU::INC_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::INC_zero_page_x_4;
+	next = MC_INC_zero_page_x_4;
 }
 void CPU::INC_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_INC;
-	next = &CPU::INC_zero_page_x_5;
+	next = MC_INC_zero_page_x_5;
 }
 void CPU::INC_zero_page_x_5()
 {
@@ -2405,23 +2424,23 @@ void CPU::INC_zero_page_x_5()
 void CPU::INC_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::INC_absolute_2;
+	next = MC_INC_absolute_2;
 }
 void CPU::INC_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::INC_absolute_3;
+	next = MC_INC_absolute_3;
 }
 void CPU::INC_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::INC_absolute_4;
+	next = MC_INC_absolute_4;
 }
 void CPU::INC_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::INC_absolute_5;
+	next = MC_INC_absolute_5;
 }
 void CPU::INC_absolute_5()
 {
@@ -2433,13 +2452,13 @@ void CPU::INC_absolute_5()
 void CPU::INC_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::INC_absolute_x_2;
+	next = MC_INC_absolute_x_2;
 }
 void CPU::INC_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::INC_absolute_x_3;
+	next = MC_INC_absolute_x_3;
 }
 void CPU::INC_absolute_x_3()
 {
@@ -2447,18 +2466,18 @@ void CPU::INC_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::INC_absolute_x_4;
+	next = MC_INC_absolute_x_4;
 }
 void CPU::INC_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::INC_absolute_x_5;
+	next = MC_INC_absolute_x_5;
 }
 void CPU::INC_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::INC_absolute_x_6;
+	next = MC_INC_absolute_x_6;
 }
 void CPU::INC_absolute_x_6()
 {
@@ -2470,34 +2489,34 @@ void CPU::INC_absolute_x_6()
 void CPU::INC_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::INC_indirect_x_2;
+	next = MC_INC_indirect_x_2;
 }
 void CPU::INC_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::INC_indirect_x_3;
+	next = MC_INC_indirect_x_3;
 }
 void CPU::INC_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::INC_indirect_x_4;
+	next = MC_INC_indirect_x_4;
 }
 void CPU::INC_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::INC_indirect_x_5;
+	next = MC_INC_indirect_x_5;
 }
 void CPU::INC_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::INC_indirect_x_6;
+	next = MC_INC_indirect_x_6;
 }
 void CPU::INC_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::INC_indirect_x_7;
+	next = MC_INC_indirect_x_7;
 }
 void CPU::INC_indirect_x_7()
 {
@@ -2552,7 +2571,7 @@ void CPU::INY()
 void CPU::JMP_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::JMP_absolute_2;
+	next = MC_JMP_absolute_2;
 }
 void CPU::JMP_absolute_2()
 {
@@ -2565,17 +2584,17 @@ void CPU::JMP_absolute_2()
 void CPU::JMP_absolute_indirect()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::JMP_absolute_indirect_2;
+	next = MC_JMP_absolute_indirect_2;
 }
 void CPU::JMP_absolute_indirect_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::JMP_absolute_indirect_3;
+	next = MC_JMP_absolute_indirect_3;
 }
 void CPU::JMP_absolute_indirect_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::JMP_absolute_indirect_4;
+	next = MC_JMP_absolute_indirect_4;
 }
 void CPU::JMP_absolute_indirect_4()
 {
@@ -2597,21 +2616,21 @@ void CPU::JSR()
 {
 	FETCH_ADDR_LO;
 	callStack[callStackPointer++] = PC;
-	next = &CPU::JSR_2;
+	next = MC_JSR_2;
 }
 void CPU::JSR_2()
 {
-	next = &CPU::JSR_3;
+	next = MC_JSR_3;
 }
 void CPU::JSR_3()
 {
 	PUSH_PCH;
-	next = &CPU::JSR_4;
+	next = MC_JSR_4;
 }
 void CPU::JSR_4()
 {
 	PUSH_PCL;
-	next = &CPU::JSR_5;
+	next = MC_JSR_5;
 }
 void CPU::JSR_5()
 {
@@ -2642,7 +2661,7 @@ void CPU::LDA_immediate()
 void CPU::LDA_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDA_zero_page_2;
+	next = MC_LDA_zero_page_2;
 }
 
 void CPU::LDA_zero_page_2() 
@@ -2656,13 +2675,13 @@ void CPU::LDA_zero_page_2()
 void CPU::LDA_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDA_zero_page_x_2;
+	next = MC_LDA_zero_page_x_2;
 }
 void CPU::LDA_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::LDA_zero_page_x_3;
+	next = MC_LDA_zero_page_x_3;
 }
 void CPU::LDA_zero_page_x_3() 
 {
@@ -2675,12 +2694,12 @@ void CPU::LDA_zero_page_x_3()
 void CPU::LDA_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::LDA_absolute_2; 
+	next = MC_LDA_absolute_2; 
 }
 void CPU::LDA_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::LDA_absolute_3; 
+	next = MC_LDA_absolute_3; 
 }
 void CPU::LDA_absolute_3() 
 { 
@@ -2693,20 +2712,20 @@ void CPU::LDA_absolute_3()
 void CPU::LDA_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDA_absolute_x_2;
+	next = MC_LDA_absolute_x_2;
 }
 void CPU::LDA_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::LDA_absolute_x_3;
+	next = MC_LDA_absolute_x_3;
 }
 void CPU::LDA_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDA_absolute_x_4;
+		next = MC_LDA_absolute_x_4;
 	} else {
 		loadA(data);
 		DONE;
@@ -2723,20 +2742,20 @@ void CPU::LDA_absolute_x_4()
 void CPU::LDA_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDA_absolute_y_2;
+	next = MC_LDA_absolute_y_2;
 }
 void CPU::LDA_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::LDA_absolute_y_3;
+	next = MC_LDA_absolute_y_3;
 }
 void CPU::LDA_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDA_absolute_y_4;
+		next = MC_LDA_absolute_y_4;
 	} else {
 		loadA(data);
 		DONE;
@@ -2753,23 +2772,23 @@ void CPU::LDA_absolute_y_4()
 void CPU::LDA_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LDA_indirect_x_2;
+	next = MC_LDA_indirect_x_2;
 }
 void CPU::LDA_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::LDA_indirect_x_3;
+	next = MC_LDA_indirect_x_3;
 }
 void CPU::LDA_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LDA_indirect_x_4;
+	next = MC_LDA_indirect_x_4;
 }
 void CPU::LDA_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::LDA_indirect_x_5;
+	next = MC_LDA_indirect_x_5;
 }
 void CPU::LDA_indirect_x_5()
 {
@@ -2782,25 +2801,25 @@ void CPU::LDA_indirect_x_5()
 void CPU::LDA_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LDA_indirect_y_2;
+	next = MC_LDA_indirect_y_2;
 }
 void CPU::LDA_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LDA_indirect_y_3;
+	next = MC_LDA_indirect_y_3;
 }
 void CPU::LDA_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::LDA_indirect_y_4;
+	next = MC_LDA_indirect_y_4;
 }
 void CPU::LDA_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDA_indirect_y_5;
+		next = MC_LDA_indirect_y_5;
 	} else {
 		loadA(data);
 		DONE;
@@ -2835,7 +2854,7 @@ void CPU::LDX_immediate()
 void CPU::LDX_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDX_zero_page_2;
+	next = MC_LDX_zero_page_2;
 }
 
 void CPU::LDX_zero_page_2() 
@@ -2849,13 +2868,13 @@ void CPU::LDX_zero_page_2()
 void CPU::LDX_zero_page_y() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDX_zero_page_y_2;
+	next = MC_LDX_zero_page_y_2;
 }
 void CPU::LDX_zero_page_y_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_Y;
-	next = &CPU::LDX_zero_page_y_3;
+	next = MC_LDX_zero_page_y_3;
 }
 void CPU::LDX_zero_page_y_3() 
 {
@@ -2868,12 +2887,12 @@ void CPU::LDX_zero_page_y_3()
 void CPU::LDX_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::LDX_absolute_2; 
+	next = MC_LDX_absolute_2; 
 }
 void CPU::LDX_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::LDX_absolute_3; 
+	next = MC_LDX_absolute_3; 
 }
 void CPU::LDX_absolute_3() 
 { 
@@ -2886,20 +2905,20 @@ void CPU::LDX_absolute_3()
 void CPU::LDX_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDX_absolute_y_2;
+	next = MC_LDX_absolute_y_2;
 }
 void CPU::LDX_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::LDX_absolute_y_3;
+	next = MC_LDX_absolute_y_3;
 }
 void CPU::LDX_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDX_absolute_y_4;
+		next = MC_LDX_absolute_y_4;
 	} else {
 		loadX(data);
 		DONE;
@@ -2916,23 +2935,23 @@ void CPU::LDX_absolute_y_4()
 void CPU::LDX_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LDX_indirect_x_2;
+	next = MC_LDX_indirect_x_2;
 }
 void CPU::LDX_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::LDX_indirect_x_3;
+	next = MC_LDX_indirect_x_3;
 }
 void CPU::LDX_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LDX_indirect_x_4;
+	next = MC_LDX_indirect_x_4;
 }
 void CPU::LDX_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::LDX_indirect_x_5;
+	next = MC_LDX_indirect_x_5;
 }
 void CPU::LDX_indirect_x_5()
 {
@@ -2945,25 +2964,25 @@ void CPU::LDX_indirect_x_5()
 void CPU::LDX_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LDX_indirect_y_2;
+	next = MC_LDX_indirect_y_2;
 }
 void CPU::LDX_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LDX_indirect_y_3;
+	next = MC_LDX_indirect_y_3;
 }
 void CPU::LDX_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::LDX_indirect_y_4;
+	next = MC_LDX_indirect_y_4;
 }
 void CPU::LDX_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDX_indirect_y_5;
+		next = MC_LDX_indirect_y_5;
 	} else {
 		loadX(data);
 		DONE;
@@ -2998,7 +3017,7 @@ void CPU::LDY_immediate()
 void CPU::LDY_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDY_zero_page_2;
+	next = MC_LDY_zero_page_2;
 }
 
 void CPU::LDY_zero_page_2() 
@@ -3012,13 +3031,13 @@ void CPU::LDY_zero_page_2()
 void CPU::LDY_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDY_zero_page_x_2;
+	next = MC_LDY_zero_page_x_2;
 }
 void CPU::LDY_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::LDY_zero_page_x_3;
+	next = MC_LDY_zero_page_x_3;
 }
 void CPU::LDY_zero_page_x_3() 
 {
@@ -3031,12 +3050,12 @@ void CPU::LDY_zero_page_x_3()
 void CPU::LDY_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::LDY_absolute_2; 
+	next = MC_LDY_absolute_2; 
 }
 void CPU::LDY_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::LDY_absolute_3; 
+	next = MC_LDY_absolute_3; 
 }
 void CPU::LDY_absolute_3() 
 { 
@@ -3049,20 +3068,20 @@ void CPU::LDY_absolute_3()
 void CPU::LDY_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDY_absolute_x_2;
+	next = MC_LDY_absolute_x_2;
 }
 void CPU::LDY_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::LDY_absolute_x_3;
+	next = MC_LDY_absolute_x_3;
 }
 void CPU::LDY_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDY_absolute_x_4;
+		next = MC_LDY_absolute_x_4;
 	} else {
 		loadY(data);
 		DONE;
@@ -3079,23 +3098,23 @@ void CPU::LDY_absolute_x_4()
 void CPU::LDY_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LDY_indirect_x_2;
+	next = MC_LDY_indirect_x_2;
 }
 void CPU::LDY_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::LDY_indirect_x_3;
+	next = MC_LDY_indirect_x_3;
 }
 void CPU::LDY_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LDY_indirect_x_4;
+	next = MC_LDY_indirect_x_4;
 }
 void CPU::LDY_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::LDY_indirect_x_5;
+	next = MC_LDY_indirect_x_5;
 }
 void CPU::LDY_indirect_x_5()
 {
@@ -3108,25 +3127,25 @@ void CPU::LDY_indirect_x_5()
 void CPU::LDY_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LDY_indirect_y_2;
+	next = MC_LDY_indirect_y_2;
 }
 void CPU::LDY_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LDY_indirect_y_3;
+	next = MC_LDY_indirect_y_3;
 }
 void CPU::LDY_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::LDY_indirect_y_4;
+	next = MC_LDY_indirect_y_4;
 }
 void CPU::LDY_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDY_indirect_y_5;
+		next = MC_LDY_indirect_y_5;
 	} else {
 		loadY(data);
 		DONE;
@@ -3163,18 +3182,18 @@ void CPU::LSR_accumulator()
 void CPU::LSR_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LSR_zero_page_2;
+	next = MC_LSR_zero_page_2;
 }
 void CPU::LSR_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::LSR_zero_page_3;
+	next = MC_LSR_zero_page_3;
 }
 void CPU::LSR_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_LSR;
-	next = &CPU::LSR_zero_page_4;
+	next = MC_LSR_zero_page_4;
 }
 void CPU::LSR_zero_page_4()
 {
@@ -3186,24 +3205,24 @@ void CPU::LSR_zero_page_4()
 void CPU::LSR_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LSR_zero_page_x_2;
+	next = MC_LSR_zero_page_x_2;
 }
 void CPU::LSR_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::LSR_zero_page_x_3;
+	next = MC_LSR_zero_page_x_3;
 }
 void CPU::LSR_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::LSR_zero_page_x_4;
+	next = MC_LSR_zero_page_x_4;
 }
 void CPU::LSR_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_LSR;
-	next = &CPU::LSR_zero_page_x_5;
+	next = MC_LSR_zero_page_x_5;
 }
 void CPU::LSR_zero_page_x_5()
 {
@@ -3215,23 +3234,23 @@ void CPU::LSR_zero_page_x_5()
 void CPU::LSR_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LSR_absolute_2;
+	next = MC_LSR_absolute_2;
 }
 void CPU::LSR_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::LSR_absolute_3;
+	next = MC_LSR_absolute_3;
 }
 void CPU::LSR_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::LSR_absolute_4;
+	next = MC_LSR_absolute_4;
 }
 void CPU::LSR_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_LSR;
-	next = &CPU::LSR_absolute_5;
+	next = MC_LSR_absolute_5;
 }
 void CPU::LSR_absolute_5()
 {
@@ -3243,13 +3262,13 @@ void CPU::LSR_absolute_5()
 void CPU::LSR_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LSR_absolute_x_2;
+	next = MC_LSR_absolute_x_2;
 }
 void CPU::LSR_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::LSR_absolute_x_3;
+	next = MC_LSR_absolute_x_3;
 }
 void CPU::LSR_absolute_x_3()
 {
@@ -3257,18 +3276,18 @@ void CPU::LSR_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::LSR_absolute_x_4;
+	next = MC_LSR_absolute_x_4;
 }
 void CPU::LSR_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::LSR_absolute_x_5;
+	next = MC_LSR_absolute_x_5;
 }
 void CPU::LSR_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_LSR;
-	next = &CPU::LSR_absolute_x_6;
+	next = MC_LSR_absolute_x_6;
 }
 void CPU::LSR_absolute_x_6()
 {
@@ -3280,13 +3299,13 @@ void CPU::LSR_absolute_x_6()
 void CPU::LSR_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LSR_absolute_y_2;
+	next = MC_LSR_absolute_y_2;
 }
 void CPU::LSR_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::LSR_absolute_y_3;
+	next = MC_LSR_absolute_y_3;
 }
 void CPU::LSR_absolute_y_3()
 {
@@ -3294,18 +3313,18 @@ void CPU::LSR_absolute_y_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::LSR_absolute_y_4;
+	next = MC_LSR_absolute_y_4;
 }
 void CPU::LSR_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::LSR_absolute_y_5;
+	next = MC_LSR_absolute_y_5;
 }
 void CPU::LSR_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_LSR;
-	next = &CPU::LSR_absolute_y_6;
+	next = MC_LSR_absolute_y_6;
 }
 void CPU::LSR_absolute_y_6()
 {
@@ -3317,34 +3336,34 @@ void CPU::LSR_absolute_y_6()
 void CPU::LSR_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LSR_indirect_x_2;
+	next = MC_LSR_indirect_x_2;
 }
 void CPU::LSR_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::LSR_indirect_x_3;
+	next = MC_LSR_indirect_x_3;
 }
 void CPU::LSR_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LSR_indirect_x_4;
+	next = MC_LSR_indirect_x_4;
 }
 void CPU::LSR_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::LSR_indirect_x_5;
+	next = MC_LSR_indirect_x_5;
 }
 void CPU::LSR_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::LSR_indirect_x_6;
+	next = MC_LSR_indirect_x_6;
 }
 void CPU::LSR_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_LSR;
-	next = &CPU::LSR_indirect_x_7;
+	next = MC_LSR_indirect_x_7;
 }
 void CPU::LSR_indirect_x_7()
 {
@@ -3356,18 +3375,18 @@ void CPU::LSR_indirect_x_7()
 void CPU::LSR_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LSR_indirect_y_2;
+	next = MC_LSR_indirect_y_2;
 }
 void CPU::LSR_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LSR_indirect_y_3;
+	next = MC_LSR_indirect_y_3;
 }
 void CPU::LSR_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::LSR_indirect_y_4;
+	next = MC_LSR_indirect_y_4;
 }
 void CPU::LSR_indirect_y_4()
 {
@@ -3375,18 +3394,18 @@ void CPU::LSR_indirect_y_4()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::LSR_indirect_y_5;
+	next = MC_LSR_indirect_y_5;
 }
 void CPU::LSR_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::LSR_indirect_y_6;
+	next = MC_LSR_indirect_y_6;
 }
 void CPU::LSR_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_LSR;
-	next = &CPU::LSR_indirect_y_7;
+	next = MC_LSR_indirect_y_7;
 }
 
 void CPU::LSR_indirect_y_7()
@@ -3422,7 +3441,7 @@ void CPU::NOP_immediate()
 void CPU::NOP_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::NOP_zero_page_2;
+	next = MC_NOP_zero_page_2;
 }
 
 void CPU::NOP_zero_page_2() 
@@ -3435,13 +3454,13 @@ void CPU::NOP_zero_page_2()
 void CPU::NOP_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::NOP_zero_page_x_2;
+	next = MC_NOP_zero_page_x_2;
 }
 void CPU::NOP_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::NOP_zero_page_x_3;
+	next = MC_NOP_zero_page_x_3;
 }
 void CPU::NOP_zero_page_x_3() 
 {
@@ -3453,12 +3472,12 @@ void CPU::NOP_zero_page_x_3()
 void CPU::NOP_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::NOP_absolute_2; 
+	next = MC_NOP_absolute_2; 
 }
 void CPU::NOP_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::NOP_absolute_3; 
+	next = MC_NOP_absolute_3; 
 }
 void CPU::NOP_absolute_3() 
 { 
@@ -3470,20 +3489,20 @@ void CPU::NOP_absolute_3()
 void CPU::NOP_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::NOP_absolute_x_2;
+	next = MC_NOP_absolute_x_2;
 }
 void CPU::NOP_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::NOP_absolute_x_3;
+	next = MC_NOP_absolute_x_3;
 }
 void CPU::NOP_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::NOP_absolute_x_4;
+		next = MC_NOP_absolute_x_4;
 	} else {
 		DONE;
 	}
@@ -3514,11 +3533,11 @@ void CPU::ORA_immediate()
 // -------------------------------------------------------------------------------
 void CPU::ORA_absolute() {
 	FETCH_ADDR_LO;
-	next = &CPU::ORA_absolute_2;
+	next = MC_ORA_absolute_2;
 }
 void CPU::ORA_absolute_2() {
 	FETCH_ADDR_HI;
-	next = &CPU::ORA_absolute_3;
+	next = MC_ORA_absolute_3;
 }
 void CPU::ORA_absolute_3() {
 	READ_FROM_ADDRESS;
@@ -3530,7 +3549,7 @@ void CPU::ORA_absolute_3() {
 void CPU::ORA_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ORA_zero_page_2;
+	next = MC_ORA_zero_page_2;
 }
 void CPU::ORA_zero_page_2()
 {
@@ -3543,13 +3562,13 @@ void CPU::ORA_zero_page_2()
 void CPU::ORA_zero_page_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ORA_zero_page_x_2;
+	next = MC_ORA_zero_page_x_2;
 }
 void CPU::ORA_zero_page_x_2()
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::ORA_zero_page_x_3;
+	next = MC_ORA_zero_page_x_3;
 }
 void CPU::ORA_zero_page_x_3()
 {
@@ -3562,20 +3581,20 @@ void CPU::ORA_zero_page_x_3()
 void CPU::ORA_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ORA_absolute_x_2;
+	next = MC_ORA_absolute_x_2;
 }
 void CPU::ORA_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::ORA_absolute_x_3;
+	next = MC_ORA_absolute_x_3;
 }
 void CPU::ORA_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::ORA_absolute_x_4;
+		next = MC_ORA_absolute_x_4;
 	} else {
 		loadA(A | data);
 		DONE;
@@ -3592,20 +3611,20 @@ void CPU::ORA_absolute_x_4()
 void CPU::ORA_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ORA_absolute_y_2;
+	next = MC_ORA_absolute_y_2;
 }
 void CPU::ORA_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::ORA_absolute_y_3;
+	next = MC_ORA_absolute_y_3;
 }
 void CPU::ORA_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::ORA_absolute_y_4;
+		next = MC_ORA_absolute_y_4;
 	} else {
 		loadA(A | data);
 		DONE;
@@ -3622,23 +3641,23 @@ void CPU::ORA_absolute_y_4()
 void CPU::ORA_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ORA_indirect_x_2;
+	next = MC_ORA_indirect_x_2;
 }
 void CPU::ORA_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::ORA_indirect_x_3;
+	next = MC_ORA_indirect_x_3;
 }
 void CPU::ORA_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ORA_indirect_x_4;
+	next = MC_ORA_indirect_x_4;
 }
 void CPU::ORA_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::ORA_indirect_x_5;
+	next = MC_ORA_indirect_x_5;
 }
 void CPU::ORA_indirect_x_5()
 {
@@ -3651,25 +3670,25 @@ void CPU::ORA_indirect_x_5()
 void CPU::ORA_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ORA_indirect_y_2;
+	next = MC_ORA_indirect_y_2;
 }
 void CPU::ORA_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ORA_indirect_y_3;
+	next = MC_ORA_indirect_y_3;
 }
 void CPU::ORA_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::ORA_indirect_y_4;
+	next = MC_ORA_indirect_y_4;
 }
 void CPU::ORA_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::ORA_indirect_y_5;
+		next = MC_ORA_indirect_y_5;
 	} else {
 		loadA(A | data);
 		DONE;
@@ -3695,7 +3714,7 @@ void CPU::ORA_indirect_y_5()
 void CPU::PHA()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::PHA_2;
+	next = MC_PHA_2;
 }
 void CPU::PHA_2()
 {
@@ -3716,7 +3735,7 @@ void CPU::PHA_2()
 void CPU::PHP()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::PHP_2;
+	next = MC_PHP_2;
 }
 void CPU::PHP_2()
 {
@@ -3737,12 +3756,12 @@ void CPU::PHP_2()
 void CPU::PLA()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::PLA_2;
+	next = MC_PLA_2;
 }
 void CPU::PLA_2()
 {
 	SP++;
-	next = &CPU::PLA_3;
+	next = MC_PLA_3;
 }
 void CPU::PLA_3()
 {
@@ -3763,12 +3782,12 @@ void CPU::PLA_3()
 void CPU::PLP()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::PLP_2;
+	next = MC_PLP_2;
 }
 void CPU::PLP_2()
 {
 	SP++;
-	next = &CPU::PLP_3;
+	next = MC_PLP_3;
 }
 void CPU::PLP_3()
 {
@@ -3816,18 +3835,18 @@ void CPU::ROL_accumulator()
 void CPU::ROL_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROL_zero_page_2;
+	next = MC_ROL_zero_page_2;
 }
 void CPU::ROL_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ROL_zero_page_3;
+	next = MC_ROL_zero_page_3;
 }
 void CPU::ROL_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROL;
-	next = &CPU::ROL_zero_page_4;
+	next = MC_ROL_zero_page_4;
 }
 void CPU::ROL_zero_page_4()
 {
@@ -3839,24 +3858,24 @@ void CPU::ROL_zero_page_4()
 void CPU::ROL_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROL_zero_page_x_2;
+	next = MC_ROL_zero_page_x_2;
 }
 void CPU::ROL_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::ROL_zero_page_x_3;
+	next = MC_ROL_zero_page_x_3;
 }
 void CPU::ROL_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ROL_zero_page_x_4;
+	next = MC_ROL_zero_page_x_4;
 }
 void CPU::ROL_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROL;
-	next = &CPU::ROL_zero_page_x_5;
+	next = MC_ROL_zero_page_x_5;
 }
 void CPU::ROL_zero_page_x_5()
 {
@@ -3868,23 +3887,23 @@ void CPU::ROL_zero_page_x_5()
 void CPU::ROL_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROL_absolute_2;
+	next = MC_ROL_absolute_2;
 }
 void CPU::ROL_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::ROL_absolute_3;
+	next = MC_ROL_absolute_3;
 }
 void CPU::ROL_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ROL_absolute_4;
+	next = MC_ROL_absolute_4;
 }
 void CPU::ROL_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::ROL_absolute_5;
+	next = MC_ROL_absolute_5;
 }
 void CPU::ROL_absolute_5()
 {
@@ -3896,13 +3915,13 @@ void CPU::ROL_absolute_5()
 void CPU::ROL_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROL_absolute_x_2;
+	next = MC_ROL_absolute_x_2;
 }
 void CPU::ROL_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::ROL_absolute_x_3;
+	next = MC_ROL_absolute_x_3;
 }
 void CPU::ROL_absolute_x_3()
 {
@@ -3910,18 +3929,18 @@ void CPU::ROL_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::ROL_absolute_x_4;
+	next = MC_ROL_absolute_x_4;
 }
 void CPU::ROL_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ROL_absolute_x_5;
+	next = MC_ROL_absolute_x_5;
 }
 void CPU::ROL_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::ROL_absolute_x_6;
+	next = MC_ROL_absolute_x_6;
 }
 void CPU::ROL_absolute_x_6()
 {
@@ -3933,34 +3952,34 @@ void CPU::ROL_absolute_x_6()
 void CPU::ROL_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ROL_indirect_x_2;
+	next = MC_ROL_indirect_x_2;
 }
 void CPU::ROL_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::ROL_indirect_x_3;
+	next = MC_ROL_indirect_x_3;
 }
 void CPU::ROL_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ROL_indirect_x_4;
+	next = MC_ROL_indirect_x_4;
 }
 void CPU::ROL_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::ROL_indirect_x_5;
+	next = MC_ROL_indirect_x_5;
 }
 void CPU::ROL_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ROL_indirect_x_6;
+	next = MC_ROL_indirect_x_6;
 }
 void CPU::ROL_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::ROL_indirect_x_7;
+	next = MC_ROL_indirect_x_7;
 }
 void CPU::ROL_indirect_x_7()
 {
@@ -4008,18 +4027,18 @@ void CPU::ROR_accumulator()
 void CPU::ROR_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROR_zero_page_2;
+	next = MC_ROR_zero_page_2;
 }
 void CPU::ROR_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ROR_zero_page_3;
+	next = MC_ROR_zero_page_3;
 }
 void CPU::ROR_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROR;
-	next = &CPU::ROR_zero_page_4;
+	next = MC_ROR_zero_page_4;
 }
 void CPU::ROR_zero_page_4()
 {
@@ -4031,24 +4050,24 @@ void CPU::ROR_zero_page_4()
 void CPU::ROR_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROR_zero_page_x_2;
+	next = MC_ROR_zero_page_x_2;
 }
 void CPU::ROR_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::ROR_zero_page_x_3;
+	next = MC_ROR_zero_page_x_3;
 }
 void CPU::ROR_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ROR_zero_page_x_4;
+	next = MC_ROR_zero_page_x_4;
 }
 void CPU::ROR_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROR;
-	next = &CPU::ROR_zero_page_x_5;
+	next = MC_ROR_zero_page_x_5;
 }
 void CPU::ROR_zero_page_x_5()
 {
@@ -4060,23 +4079,23 @@ void CPU::ROR_zero_page_x_5()
 void CPU::ROR_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROR_absolute_2;
+	next = MC_ROR_absolute_2;
 }
 void CPU::ROR_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::ROR_absolute_3;
+	next = MC_ROR_absolute_3;
 }
 void CPU::ROR_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ROR_absolute_4;
+	next = MC_ROR_absolute_4;
 }
 void CPU::ROR_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::ROR_absolute_5;
+	next = MC_ROR_absolute_5;
 }
 void CPU::ROR_absolute_5()
 {
@@ -4088,13 +4107,13 @@ void CPU::ROR_absolute_5()
 void CPU::ROR_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROR_absolute_x_2;
+	next = MC_ROR_absolute_x_2;
 }
 void CPU::ROR_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::ROR_absolute_x_3;
+	next = MC_ROR_absolute_x_3;
 }
 void CPU::ROR_absolute_x_3()
 {
@@ -4102,18 +4121,18 @@ void CPU::ROR_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::ROR_absolute_x_4;
+	next = MC_ROR_absolute_x_4;
 }
 void CPU::ROR_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ROR_absolute_x_5;
+	next = MC_ROR_absolute_x_5;
 }
 void CPU::ROR_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::ROR_absolute_x_6;
+	next = MC_ROR_absolute_x_6;
 }
 void CPU::ROR_absolute_x_6()
 {
@@ -4125,34 +4144,34 @@ void CPU::ROR_absolute_x_6()
 void CPU::ROR_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ROR_indirect_x_2;
+	next = MC_ROR_indirect_x_2;
 }
 void CPU::ROR_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::ROR_indirect_x_3;
+	next = MC_ROR_indirect_x_3;
 }
 void CPU::ROR_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ROR_indirect_x_4;
+	next = MC_ROR_indirect_x_4;
 }
 void CPU::ROR_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::ROR_indirect_x_5;
+	next = MC_ROR_indirect_x_5;
 }
 void CPU::ROR_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ROR_indirect_x_6;
+	next = MC_ROR_indirect_x_6;
 }
 void CPU::ROR_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::ROR_indirect_x_7;
+	next = MC_ROR_indirect_x_7;
 }
 void CPU::ROR_indirect_x_7()
 {
@@ -4173,24 +4192,24 @@ void CPU::ROR_indirect_x_7()
 void CPU::RTI()
 {
 	IDLE_READ_IMMEDIATE;
-	next = &CPU::RTI_2;
+	next = MC_RTI_2;
 }
 void CPU::RTI_2()
 {
 	SP++;
-	next = &CPU::RTI_3;
+	next = MC_RTI_3;
 }
 void CPU::RTI_3()
 {
 	PULL_P;
 	SP++;
-	next = &CPU::RTI_4;
+	next = MC_RTI_4;
 }
 void CPU::RTI_4()
 {
 	PULL_PCL;
 	SP++;
-	next = &CPU::RTI_5;
+	next = MC_RTI_5;
 }
 void CPU::RTI_5()
 {
@@ -4210,23 +4229,23 @@ void CPU::RTI_5()
 void CPU::RTS()
 {
 	IDLE_READ_IMMEDIATE;
-	next = &CPU::RTS_2;
+	next = MC_RTS_2;
 }
 void CPU::RTS_2()
 {
 	IDLE_READ_IMMEDIATE_SP; // SP++;
-	next = &CPU::RTS_3;
+	next = MC_RTS_3;
 }
 void CPU::RTS_3()
 {
 	PULL_PCL;
 	SP++;
-	next = &CPU::RTS_4;
+	next = MC_RTS_4;
 }
 void CPU::RTS_4()
 {
 	PULL_PCH;
-	next = &CPU::RTS_5;
+	next = MC_RTS_5;
 }
 void CPU::RTS_5()
 {
@@ -4298,7 +4317,7 @@ void CPU::SBC_immediate()
 void CPU::SBC_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SBC_zero_page_2;
+	next = MC_SBC_zero_page_2;
 }
 
 void CPU::SBC_zero_page_2() 
@@ -4312,13 +4331,13 @@ void CPU::SBC_zero_page_2()
 void CPU::SBC_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SBC_zero_page_x_2;
+	next = MC_SBC_zero_page_x_2;
 }
 void CPU::SBC_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::SBC_zero_page_x_3;
+	next = MC_SBC_zero_page_x_3;
 }
 void CPU::SBC_zero_page_x_3() 
 {
@@ -4331,12 +4350,12 @@ void CPU::SBC_zero_page_x_3()
 void CPU::SBC_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::SBC_absolute_2; 
+	next = MC_SBC_absolute_2; 
 }
 void CPU::SBC_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::SBC_absolute_3; 
+	next = MC_SBC_absolute_3; 
 }
 void CPU::SBC_absolute_3() 
 { 
@@ -4349,20 +4368,20 @@ void CPU::SBC_absolute_3()
 void CPU::SBC_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SBC_absolute_x_2;
+	next = MC_SBC_absolute_x_2;
 }
 void CPU::SBC_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::SBC_absolute_x_3;
+	next = MC_SBC_absolute_x_3;
 }
 void CPU::SBC_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::SBC_absolute_x_4;
+		next = MC_SBC_absolute_x_4;
 	} else {
 		sbc(data);
 		DONE;
@@ -4379,20 +4398,20 @@ void CPU::SBC_absolute_x_4()
 void CPU::SBC_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SBC_absolute_y_2;
+	next = MC_SBC_absolute_y_2;
 }
 void CPU::SBC_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::SBC_absolute_y_3;
+	next = MC_SBC_absolute_y_3;
 }
 void CPU::SBC_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::SBC_absolute_y_4;
+		next = MC_SBC_absolute_y_4;
 	} else {
 		sbc(data);
 		DONE;
@@ -4409,23 +4428,23 @@ void CPU::SBC_absolute_y_4()
 void CPU::SBC_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SBC_indirect_x_2;
+	next = MC_SBC_indirect_x_2;
 }
 void CPU::SBC_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::SBC_indirect_x_3;
+	next = MC_SBC_indirect_x_3;
 }
 void CPU::SBC_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SBC_indirect_x_4;
+	next = MC_SBC_indirect_x_4;
 }
 void CPU::SBC_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::SBC_indirect_x_5;
+	next = MC_SBC_indirect_x_5;
 }
 void CPU::SBC_indirect_x_5()
 {
@@ -4438,25 +4457,25 @@ void CPU::SBC_indirect_x_5()
 void CPU::SBC_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SBC_indirect_y_2;
+	next = MC_SBC_indirect_y_2;
 }
 void CPU::SBC_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SBC_indirect_y_3;
+	next = MC_SBC_indirect_y_3;
 }
 void CPU::SBC_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::SBC_indirect_y_4;
+	next = MC_SBC_indirect_y_4;
 }
 void CPU::SBC_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::SBC_indirect_y_5;
+		next = MC_SBC_indirect_y_5;
 	} else {
 		sbc(data);
 		DONE;
@@ -4535,7 +4554,7 @@ void CPU::SEI()
 void CPU::STA_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STA_zero_page_2;
+	next = MC_STA_zero_page_2;
 }
 void CPU::STA_zero_page_2()
 {
@@ -4548,13 +4567,13 @@ void CPU::STA_zero_page_2()
 void CPU::STA_zero_page_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STA_zero_page_x_2;
+	next = MC_STA_zero_page_x_2;
 }
 void CPU::STA_zero_page_x_2()
 {
 	IDLE_READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::STA_zero_page_x_3;
+	next = MC_STA_zero_page_x_3;
 }	
 void CPU::STA_zero_page_x_3()
 {
@@ -4567,12 +4586,12 @@ void CPU::STA_zero_page_x_3()
 void CPU::STA_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STA_absolute_2;
+	next = MC_STA_absolute_2;
 }
 void CPU::STA_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::STA_absolute_3;
+	next = MC_STA_absolute_3;
 }
 void CPU::STA_absolute_3()
 {
@@ -4585,20 +4604,20 @@ void CPU::STA_absolute_3()
 void CPU::STA_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STA_absolute_x_2;
+	next = MC_STA_absolute_x_2;
 }
 void CPU::STA_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::STA_absolute_x_3;
+	next = MC_STA_absolute_x_3;
 }
 void CPU::STA_absolute_x_3()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::STA_absolute_x_4;
+	next = MC_STA_absolute_x_4;
 }
 void CPU::STA_absolute_x_4()
 {
@@ -4611,20 +4630,20 @@ void CPU::STA_absolute_x_4()
 void CPU::STA_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STA_absolute_y_2;
+	next = MC_STA_absolute_y_2;
 }
 void CPU::STA_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::STA_absolute_y_3;
+	next = MC_STA_absolute_y_3;
 }
 void CPU::STA_absolute_y_3()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::STA_absolute_y_4;
+	next = MC_STA_absolute_y_4;
 }
 void CPU::STA_absolute_y_4()
 {
@@ -4637,23 +4656,23 @@ void CPU::STA_absolute_y_4()
 void CPU::STA_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::STA_indirect_x_2;
+	next = MC_STA_indirect_x_2;
 }
 void CPU::STA_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::STA_indirect_x_3;
+	next = MC_STA_indirect_x_3;
 }
 void CPU::STA_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::STA_indirect_x_4;
+	next = MC_STA_indirect_x_4;
 }
 void CPU::STA_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::STA_indirect_x_5;
+	next = MC_STA_indirect_x_5;
 }
 void CPU::STA_indirect_x_5()
 {
@@ -4666,25 +4685,25 @@ void CPU::STA_indirect_x_5()
 void CPU::STA_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::STA_indirect_y_2;
+	next = MC_STA_indirect_y_2;
 }
 void CPU::STA_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::STA_indirect_y_3;
+	next = MC_STA_indirect_y_3;
 }
 void CPU::STA_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::STA_indirect_y_4;
+	next = MC_STA_indirect_y_4;
 }
 void CPU::STA_indirect_y_4()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::STA_indirect_y_5;
+	next = MC_STA_indirect_y_5;
 }
 void CPU::STA_indirect_y_5()
 {
@@ -4706,7 +4725,7 @@ void CPU::STA_indirect_y_5()
 void CPU::STX_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STX_zero_page_2;
+	next = MC_STX_zero_page_2;
 }
 void CPU::STX_zero_page_2()
 {
@@ -4719,13 +4738,13 @@ void CPU::STX_zero_page_2()
 void CPU::STX_zero_page_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STX_zero_page_y_2;
+	next = MC_STX_zero_page_y_2;
 }
 void CPU::STX_zero_page_y_2()
 {
 	IDLE_READ_FROM_ZERO_PAGE;
 	ADD_INDEX_Y;
-	next = &CPU::STX_zero_page_y_3;
+	next = MC_STX_zero_page_y_3;
 }	
 void CPU::STX_zero_page_y_3()
 {
@@ -4738,12 +4757,12 @@ void CPU::STX_zero_page_y_3()
 void CPU::STX_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STX_absolute_2;
+	next = MC_STX_absolute_2;
 }
 void CPU::STX_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::STX_absolute_3;
+	next = MC_STX_absolute_3;
 }
 void CPU::STX_absolute_3()
 {
@@ -4765,7 +4784,7 @@ void CPU::STX_absolute_3()
 void CPU::STY_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STY_zero_page_2;
+	next = MC_STY_zero_page_2;
 }
 void CPU::STY_zero_page_2()
 {
@@ -4778,13 +4797,13 @@ void CPU::STY_zero_page_2()
 void CPU::STY_zero_page_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STY_zero_page_x_2;
+	next = MC_STY_zero_page_x_2;
 }
 void CPU::STY_zero_page_x_2()
 {
 	IDLE_READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::STY_zero_page_x_3;
+	next = MC_STY_zero_page_x_3;
 }	
 void CPU::STY_zero_page_x_3()
 {
@@ -4797,12 +4816,12 @@ void CPU::STY_zero_page_x_3()
 void CPU::STY_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STY_absolute_2;
+	next = MC_STY_absolute_2;
 }
 void CPU::STY_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::STY_absolute_3;
+	next = MC_STY_absolute_3;
 }
 void CPU::STY_absolute_3()
 {
@@ -5031,18 +5050,18 @@ void CPU::AXS_immediate()
 void CPU::DCP_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DCP_zero_page_2;
+	next = MC_DCP_zero_page_2;
 }
 void CPU::DCP_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::DCP_zero_page_3;
+	next = MC_DCP_zero_page_3;
 }
 void CPU::DCP_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_DEC;
-	next = &CPU::DCP_zero_page_4;
+	next = MC_DCP_zero_page_4;
 }
 void CPU::DCP_zero_page_4()
 {
@@ -5055,24 +5074,24 @@ void CPU::DCP_zero_page_4()
 void CPU::DCP_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DCP_zero_page_x_2;
+	next = MC_DCP_zero_page_x_2;
 }
 void CPU::DCP_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::DCP_zero_page_x_3;
+	next = MC_DCP_zero_page_x_3;
 }
 void CPU::DCP_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::DCP_zero_page_x_4;
+	next = MC_DCP_zero_page_x_4;
 }
 void CPU::DCP_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_DEC;
-	next = &CPU::DCP_zero_page_x_5;
+	next = MC_DCP_zero_page_x_5;
 }
 void CPU::DCP_zero_page_x_5()
 {
@@ -5085,23 +5104,23 @@ void CPU::DCP_zero_page_x_5()
 void CPU::DCP_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DCP_absolute_2;
+	next = MC_DCP_absolute_2;
 }
 void CPU::DCP_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::DCP_absolute_3;
+	next = MC_DCP_absolute_3;
 }
 void CPU::DCP_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DCP_absolute_4;
+	next = MC_DCP_absolute_4;
 }
 void CPU::DCP_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DCP_absolute_5;
+	next = MC_DCP_absolute_5;
 }
 void CPU::DCP_absolute_5()
 {
@@ -5114,13 +5133,13 @@ void CPU::DCP_absolute_5()
 void CPU::DCP_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DCP_absolute_x_2;
+	next = MC_DCP_absolute_x_2;
 }
 void CPU::DCP_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::DCP_absolute_x_3;
+	next = MC_DCP_absolute_x_3;
 }
 void CPU::DCP_absolute_x_3()
 {
@@ -5128,18 +5147,18 @@ void CPU::DCP_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::DCP_absolute_x_4;
+	next = MC_DCP_absolute_x_4;
 }
 void CPU::DCP_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DCP_absolute_x_5;
+	next = MC_DCP_absolute_x_5;
 }
 void CPU::DCP_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DCP_absolute_x_6;
+	next = MC_DCP_absolute_x_6;
 }
 void CPU::DCP_absolute_x_6()
 {
@@ -5152,13 +5171,13 @@ void CPU::DCP_absolute_x_6()
 void CPU::DCP_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DCP_absolute_y_2;
+	next = MC_DCP_absolute_y_2;
 }
 void CPU::DCP_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::DCP_absolute_y_3;
+	next = MC_DCP_absolute_y_3;
 }
 void CPU::DCP_absolute_y_3()
 {
@@ -5166,18 +5185,18 @@ void CPU::DCP_absolute_y_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::DCP_absolute_y_4;
+	next = MC_DCP_absolute_y_4;
 }
 void CPU::DCP_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DCP_absolute_y_5;
+	next = MC_DCP_absolute_y_5;
 }
 void CPU::DCP_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DCP_absolute_y_6;
+	next = MC_DCP_absolute_y_6;
 }
 void CPU::DCP_absolute_y_6()
 {
@@ -5190,34 +5209,34 @@ void CPU::DCP_absolute_y_6()
 void CPU::DCP_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::DCP_indirect_x_2;
+	next = MC_DCP_indirect_x_2;
 }
 void CPU::DCP_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::DCP_indirect_x_3;
+	next = MC_DCP_indirect_x_3;
 }
 void CPU::DCP_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::DCP_indirect_x_4;
+	next = MC_DCP_indirect_x_4;
 }
 void CPU::DCP_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::DCP_indirect_x_5;
+	next = MC_DCP_indirect_x_5;
 }
 void CPU::DCP_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DCP_indirect_x_6;
+	next = MC_DCP_indirect_x_6;
 }
 void CPU::DCP_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DCP_indirect_x_7;
+	next = MC_DCP_indirect_x_7;
 }
 void CPU::DCP_indirect_x_7()
 {
@@ -5230,18 +5249,18 @@ void CPU::DCP_indirect_x_7()
 void CPU::DCP_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::DCP_indirect_y_2;
+	next = MC_DCP_indirect_y_2;
 }
 void CPU::DCP_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::DCP_indirect_y_3;
+	next = MC_DCP_indirect_y_3;
 }
 void CPU::DCP_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::DCP_indirect_y_4;
+	next = MC_DCP_indirect_y_4;
 }
 void CPU::DCP_indirect_y_4()
 {
@@ -5249,18 +5268,18 @@ void CPU::DCP_indirect_y_4()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::DCP_indirect_y_5;
+	next = MC_DCP_indirect_y_5;
 }
 void CPU::DCP_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DCP_indirect_y_6;
+	next = MC_DCP_indirect_y_6;
 }
 void CPU::DCP_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DCP_indirect_y_7;
+	next = MC_DCP_indirect_y_7;
 }
 
 void CPU::DCP_indirect_y_7()
@@ -5283,18 +5302,18 @@ void CPU::DCP_indirect_y_7()
 void CPU::ISC_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ISC_zero_page_2;
+	next = MC_ISC_zero_page_2;
 }
 void CPU::ISC_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ISC_zero_page_3;
+	next = MC_ISC_zero_page_3;
 }
 void CPU::ISC_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_INC;
-	next = &CPU::ISC_zero_page_4;
+	next = MC_ISC_zero_page_4;
 }
 void CPU::ISC_zero_page_4()
 {
@@ -5307,24 +5326,24 @@ void CPU::ISC_zero_page_4()
 void CPU::ISC_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ISC_zero_page_x_2;
+	next = MC_ISC_zero_page_x_2;
 }
 void CPU::ISC_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::ISC_zero_page_x_3;
+	next = MC_ISC_zero_page_x_3;
 }
 void CPU::ISC_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ISC_zero_page_x_4;
+	next = MC_ISC_zero_page_x_4;
 }
 void CPU::ISC_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_INC;
-	next = &CPU::ISC_zero_page_x_5;
+	next = MC_ISC_zero_page_x_5;
 }
 void CPU::ISC_zero_page_x_5()
 {
@@ -5337,23 +5356,23 @@ void CPU::ISC_zero_page_x_5()
 void CPU::ISC_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ISC_absolute_2;
+	next = MC_ISC_absolute_2;
 }
 void CPU::ISC_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::ISC_absolute_3;
+	next = MC_ISC_absolute_3;
 }
 void CPU::ISC_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ISC_absolute_4;
+	next = MC_ISC_absolute_4;
 }
 void CPU::ISC_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::ISC_absolute_5;
+	next = MC_ISC_absolute_5;
 }
 void CPU::ISC_absolute_5()
 {
@@ -5366,13 +5385,13 @@ void CPU::ISC_absolute_5()
 void CPU::ISC_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ISC_absolute_x_2;
+	next = MC_ISC_absolute_x_2;
 }
 void CPU::ISC_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::ISC_absolute_x_3;
+	next = MC_ISC_absolute_x_3;
 }
 void CPU::ISC_absolute_x_3()
 {
@@ -5380,18 +5399,18 @@ void CPU::ISC_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::ISC_absolute_x_4;
+	next = MC_ISC_absolute_x_4;
 }
 void CPU::ISC_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ISC_absolute_x_5;
+	next = MC_ISC_absolute_x_5;
 }
 void CPU::ISC_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::ISC_absolute_x_6;
+	next = MC_ISC_absolute_x_6;
 }
 void CPU::ISC_absolute_x_6()
 {
@@ -5404,13 +5423,13 @@ void CPU::ISC_absolute_x_6()
 void CPU::ISC_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ISC_absolute_y_2;
+	next = MC_ISC_absolute_y_2;
 }
 void CPU::ISC_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::ISC_absolute_y_3;
+	next = MC_ISC_absolute_y_3;
 }
 void CPU::ISC_absolute_y_3()
 {
@@ -5418,18 +5437,18 @@ void CPU::ISC_absolute_y_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::ISC_absolute_y_4;
+	next = MC_ISC_absolute_y_4;
 }
 void CPU::ISC_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ISC_absolute_y_5;
+	next = MC_ISC_absolute_y_5;
 }
 void CPU::ISC_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::ISC_absolute_y_6;
+	next = MC_ISC_absolute_y_6;
 }
 void CPU::ISC_absolute_y_6()
 {
@@ -5442,34 +5461,34 @@ void CPU::ISC_absolute_y_6()
 void CPU::ISC_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ISC_indirect_x_2;
+	next = MC_ISC_indirect_x_2;
 }
 void CPU::ISC_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::ISC_indirect_x_3;
+	next = MC_ISC_indirect_x_3;
 }
 void CPU::ISC_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ISC_indirect_x_4;
+	next = MC_ISC_indirect_x_4;
 }
 void CPU::ISC_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::ISC_indirect_x_5;
+	next = MC_ISC_indirect_x_5;
 }
 void CPU::ISC_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ISC_indirect_x_6;
+	next = MC_ISC_indirect_x_6;
 }
 void CPU::ISC_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::ISC_indirect_x_7;
+	next = MC_ISC_indirect_x_7;
 }
 void CPU::ISC_indirect_x_7()
 {
@@ -5482,18 +5501,18 @@ void CPU::ISC_indirect_x_7()
 void CPU::ISC_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ISC_indirect_y_2;
+	next = MC_ISC_indirect_y_2;
 }
 void CPU::ISC_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ISC_indirect_y_3;
+	next = MC_ISC_indirect_y_3;
 }
 void CPU::ISC_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::ISC_indirect_y_4;
+	next = MC_ISC_indirect_y_4;
 }
 void CPU::ISC_indirect_y_4()
 {
@@ -5501,18 +5520,18 @@ void CPU::ISC_indirect_y_4()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::ISC_indirect_y_5;
+	next = MC_ISC_indirect_y_5;
 }
 void CPU::ISC_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ISC_indirect_y_6;
+	next = MC_ISC_indirect_y_6;
 }
 void CPU::ISC_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::ISC_indirect_y_7;
+	next = MC_ISC_indirect_y_7;
 }
 
 void CPU::ISC_indirect_y_7()
@@ -5535,20 +5554,20 @@ void CPU::ISC_indirect_y_7()
 void CPU::LAS_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LAS_absolute_y_2;
+	next = MC_LAS_absolute_y_2;
 }
 void CPU::LAS_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::LAS_absolute_y_3;
+	next = MC_LAS_absolute_y_3;
 }
 void CPU::LAS_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LAS_absolute_y_4;		
+		next = MC_LAS_absolute_y_4;		
 	} else {
 		data &= SP;
 		SP = data;
@@ -5580,7 +5599,7 @@ void CPU::LAS_absolute_y_4()
 void CPU::LAX_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LAX_zero_page_2;
+	next = MC_LAX_zero_page_2;
 }
 
 void CPU::LAX_zero_page_2() 
@@ -5595,13 +5614,13 @@ void CPU::LAX_zero_page_2()
 void CPU::LAX_zero_page_y() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LAX_zero_page_y_2;
+	next = MC_LAX_zero_page_y_2;
 }
 void CPU::LAX_zero_page_y_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_Y;
-	next = &CPU::LAX_zero_page_y_3;
+	next = MC_LAX_zero_page_y_3;
 }
 void CPU::LAX_zero_page_y_3() 
 {
@@ -5615,12 +5634,12 @@ void CPU::LAX_zero_page_y_3()
 void CPU::LAX_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::LAX_absolute_2; 
+	next = MC_LAX_absolute_2; 
 }
 void CPU::LAX_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::LAX_absolute_3; 
+	next = MC_LAX_absolute_3; 
 }
 void CPU::LAX_absolute_3() 
 { 
@@ -5634,20 +5653,20 @@ void CPU::LAX_absolute_3()
 void CPU::LAX_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LAX_absolute_y_2;
+	next = MC_LAX_absolute_y_2;
 }
 void CPU::LAX_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::LAX_absolute_y_3;
+	next = MC_LAX_absolute_y_3;
 }
 void CPU::LAX_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LAX_absolute_y_4;
+		next = MC_LAX_absolute_y_4;
 	} else {
 		loadA(data);
 		loadX(data);
@@ -5666,23 +5685,23 @@ void CPU::LAX_absolute_y_4()
 void CPU::LAX_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LAX_indirect_x_2;
+	next = MC_LAX_indirect_x_2;
 }
 void CPU::LAX_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::LAX_indirect_x_3;
+	next = MC_LAX_indirect_x_3;
 }
 void CPU::LAX_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LAX_indirect_x_4;
+	next = MC_LAX_indirect_x_4;
 }
 void CPU::LAX_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::LAX_indirect_x_5;
+	next = MC_LAX_indirect_x_5;
 }
 void CPU::LAX_indirect_x_5()
 {
@@ -5696,25 +5715,25 @@ void CPU::LAX_indirect_x_5()
 void CPU::LAX_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LAX_indirect_y_2;
+	next = MC_LAX_indirect_y_2;
 }
 void CPU::LAX_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LAX_indirect_y_3;
+	next = MC_LAX_indirect_y_3;
 }
 void CPU::LAX_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::LAX_indirect_y_4;
+	next = MC_LAX_indirect_y_4;
 }
 void CPU::LAX_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LAX_indirect_y_5;
+		next = MC_LAX_indirect_y_5;
 	} else {
 		loadA(data);
 		loadX(data);
@@ -5743,18 +5762,18 @@ void CPU::LAX_indirect_y_5()
 void CPU::RLA_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RLA_zero_page_2;
+	next = MC_RLA_zero_page_2;
 }
 void CPU::RLA_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::RLA_zero_page_3;
+	next = MC_RLA_zero_page_3;
 }
 void CPU::RLA_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROL;
-	next = &CPU::RLA_zero_page_4;
+	next = MC_RLA_zero_page_4;
 }
 void CPU::RLA_zero_page_4()
 {
@@ -5767,24 +5786,24 @@ void CPU::RLA_zero_page_4()
 void CPU::RLA_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RLA_zero_page_x_2;
+	next = MC_RLA_zero_page_x_2;
 }
 void CPU::RLA_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::RLA_zero_page_x_3;
+	next = MC_RLA_zero_page_x_3;
 }
 void CPU::RLA_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::RLA_zero_page_x_4;
+	next = MC_RLA_zero_page_x_4;
 }
 void CPU::RLA_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROL;
-	next = &CPU::RLA_zero_page_x_5;
+	next = MC_RLA_zero_page_x_5;
 }
 void CPU::RLA_zero_page_x_5()
 {
@@ -5797,23 +5816,23 @@ void CPU::RLA_zero_page_x_5()
 void CPU::RLA_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RLA_absolute_2;
+	next = MC_RLA_absolute_2;
 }
 void CPU::RLA_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::RLA_absolute_3;
+	next = MC_RLA_absolute_3;
 }
 void CPU::RLA_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RLA_absolute_4;
+	next = MC_RLA_absolute_4;
 }
 void CPU::RLA_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::RLA_absolute_5;
+	next = MC_RLA_absolute_5;
 }
 void CPU::RLA_absolute_5()
 {
@@ -5826,31 +5845,31 @@ void CPU::RLA_absolute_5()
 void CPU::RLA_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RLA_absolute_x_2;
+	next = MC_RLA_absolute_x_2;
 }
 void CPU::RLA_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::RLA_absolute_x_3;
+	next = MC_RLA_absolute_x_3;
 }
 void CPU::RLA_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::RLA_absolute_x_4;
+	next = MC_RLA_absolute_x_4;
 }
 void CPU::RLA_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RLA_absolute_x_5;
+	next = MC_RLA_absolute_x_5;
 }
 void CPU::RLA_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::RLA_absolute_x_6;
+	next = MC_RLA_absolute_x_6;
 }
 void CPU::RLA_absolute_x_6()
 {
@@ -5863,31 +5882,31 @@ void CPU::RLA_absolute_x_6()
 void CPU::RLA_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RLA_absolute_y_2;
+	next = MC_RLA_absolute_y_2;
 }
 void CPU::RLA_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::RLA_absolute_y_3;
+	next = MC_RLA_absolute_y_3;
 }
 void CPU::RLA_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::RLA_absolute_y_4;
+	next = MC_RLA_absolute_y_4;
 }
 void CPU::RLA_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RLA_absolute_y_5;
+	next = MC_RLA_absolute_y_5;
 }
 void CPU::RLA_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::RLA_absolute_y_6;
+	next = MC_RLA_absolute_y_6;
 }
 void CPU::RLA_absolute_y_6()
 {
@@ -5900,34 +5919,34 @@ void CPU::RLA_absolute_y_6()
 void CPU::RLA_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::RLA_indirect_x_2;
+	next = MC_RLA_indirect_x_2;
 }
 void CPU::RLA_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::RLA_indirect_x_3;
+	next = MC_RLA_indirect_x_3;
 }
 void CPU::RLA_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::RLA_indirect_x_4;
+	next = MC_RLA_indirect_x_4;
 }
 void CPU::RLA_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::RLA_indirect_x_5;
+	next = MC_RLA_indirect_x_5;
 }
 void CPU::RLA_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RLA_indirect_x_6;
+	next = MC_RLA_indirect_x_6;
 }
 void CPU::RLA_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::RLA_indirect_x_7;
+	next = MC_RLA_indirect_x_7;
 }
 
 void CPU::RLA_indirect_x_7()
@@ -5941,36 +5960,36 @@ void CPU::RLA_indirect_x_7()
 void CPU::RLA_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::RLA_indirect_y_2;
+	next = MC_RLA_indirect_y_2;
 }
 void CPU::RLA_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::RLA_indirect_y_3;
+	next = MC_RLA_indirect_y_3;
 }
 void CPU::RLA_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::RLA_indirect_y_4;
+	next = MC_RLA_indirect_y_4;
 }
 void CPU::RLA_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::RLA_indirect_y_5;
+	next = MC_RLA_indirect_y_5;
 }
 void CPU::RLA_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RLA_indirect_y_6;
+	next = MC_RLA_indirect_y_6;
 }
 void CPU::RLA_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::RLA_indirect_y_7;
+	next = MC_RLA_indirect_y_7;
 }
 
 void CPU::RLA_indirect_y_7()
@@ -5994,18 +6013,18 @@ void CPU::RLA_indirect_y_7()
 void CPU::RRA_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RRA_zero_page_2;
+	next = MC_RRA_zero_page_2;
 }
 void CPU::RRA_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::RRA_zero_page_3;
+	next = MC_RRA_zero_page_3;
 }
 void CPU::RRA_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROR;
-	next = &CPU::RRA_zero_page_4;
+	next = MC_RRA_zero_page_4;
 }
 void CPU::RRA_zero_page_4()
 {
@@ -6018,24 +6037,24 @@ void CPU::RRA_zero_page_4()
 void CPU::RRA_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RRA_zero_page_x_2;
+	next = MC_RRA_zero_page_x_2;
 }
 void CPU::RRA_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::RRA_zero_page_x_3;
+	next = MC_RRA_zero_page_x_3;
 }
 void CPU::RRA_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::RRA_zero_page_x_4;
+	next = MC_RRA_zero_page_x_4;
 }
 void CPU::RRA_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROR;
-	next = &CPU::RRA_zero_page_x_5;
+	next = MC_RRA_zero_page_x_5;
 }
 void CPU::RRA_zero_page_x_5()
 {
@@ -6048,23 +6067,23 @@ void CPU::RRA_zero_page_x_5()
 void CPU::RRA_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RRA_absolute_2;
+	next = MC_RRA_absolute_2;
 }
 void CPU::RRA_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::RRA_absolute_3;
+	next = MC_RRA_absolute_3;
 }
 void CPU::RRA_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RRA_absolute_4;
+	next = MC_RRA_absolute_4;
 }
 void CPU::RRA_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::RRA_absolute_5;
+	next = MC_RRA_absolute_5;
 }
 void CPU::RRA_absolute_5()
 {
@@ -6077,31 +6096,31 @@ void CPU::RRA_absolute_5()
 void CPU::RRA_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RRA_absolute_x_2;
+	next = MC_RRA_absolute_x_2;
 }
 void CPU::RRA_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::RRA_absolute_x_3;
+	next = MC_RRA_absolute_x_3;
 }
 void CPU::RRA_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::RRA_absolute_x_4;
+	next = MC_RRA_absolute_x_4;
 }
 void CPU::RRA_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RRA_absolute_x_5;
+	next = MC_RRA_absolute_x_5;
 }
 void CPU::RRA_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::RRA_absolute_x_6;
+	next = MC_RRA_absolute_x_6;
 }
 void CPU::RRA_absolute_x_6()
 {
@@ -6114,31 +6133,31 @@ void CPU::RRA_absolute_x_6()
 void CPU::RRA_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RRA_absolute_y_2;
+	next = MC_RRA_absolute_y_2;
 }
 void CPU::RRA_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::RRA_absolute_y_3;
+	next = MC_RRA_absolute_y_3;
 }
 void CPU::RRA_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::RRA_absolute_y_4;
+	next = MC_RRA_absolute_y_4;
 }
 void CPU::RRA_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RRA_absolute_y_5;
+	next = MC_RRA_absolute_y_5;
 }
 void CPU::RRA_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::RRA_absolute_y_6;
+	next = MC_RRA_absolute_y_6;
 }
 void CPU::RRA_absolute_y_6()
 {
@@ -6151,34 +6170,34 @@ void CPU::RRA_absolute_y_6()
 void CPU::RRA_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::RRA_indirect_x_2;
+	next = MC_RRA_indirect_x_2;
 }
 void CPU::RRA_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::RRA_indirect_x_3;
+	next = MC_RRA_indirect_x_3;
 }
 void CPU::RRA_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::RRA_indirect_x_4;
+	next = MC_RRA_indirect_x_4;
 }
 void CPU::RRA_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::RRA_indirect_x_5;
+	next = MC_RRA_indirect_x_5;
 }
 void CPU::RRA_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RRA_indirect_x_6;
+	next = MC_RRA_indirect_x_6;
 }
 void CPU::RRA_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::RRA_indirect_x_7;
+	next = MC_RRA_indirect_x_7;
 }
 
 void CPU::RRA_indirect_x_7()
@@ -6192,36 +6211,36 @@ void CPU::RRA_indirect_x_7()
 void CPU::RRA_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::RRA_indirect_y_2;
+	next = MC_RRA_indirect_y_2;
 }
 void CPU::RRA_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::RRA_indirect_y_3;
+	next = MC_RRA_indirect_y_3;
 }
 void CPU::RRA_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::RRA_indirect_y_4;
+	next = MC_RRA_indirect_y_4;
 }
 void CPU::RRA_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::RRA_indirect_y_5;
+	next = MC_RRA_indirect_y_5;
 }
 void CPU::RRA_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RRA_indirect_y_6;
+	next = MC_RRA_indirect_y_6;
 }
 void CPU::RRA_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::RRA_indirect_y_7;
+	next = MC_RRA_indirect_y_7;
 }
 
 void CPU::RRA_indirect_y_7()
@@ -6244,7 +6263,7 @@ void CPU::RRA_indirect_y_7()
 void CPU::SAX_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SAX_zero_page_2;
+	next = MC_SAX_zero_page_2;
 }
 void CPU::SAX_zero_page_2()
 {
@@ -6257,13 +6276,13 @@ void CPU::SAX_zero_page_2()
 void CPU::SAX_zero_page_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SAX_zero_page_y_2;
+	next = MC_SAX_zero_page_y_2;
 }
 void CPU::SAX_zero_page_y_2()
 {
 	IDLE_READ_FROM_ZERO_PAGE;
 	ADD_INDEX_Y;
-	next = &CPU::SAX_zero_page_y_3;
+	next = MC_SAX_zero_page_y_3;
 }	
 void CPU::SAX_zero_page_y_3()
 {
@@ -6276,12 +6295,12 @@ void CPU::SAX_zero_page_y_3()
 void CPU::SAX_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SAX_absolute_2;
+	next = MC_SAX_absolute_2;
 }
 void CPU::SAX_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::SAX_absolute_3;
+	next = MC_SAX_absolute_3;
 }
 void CPU::SAX_absolute_3()
 {
@@ -6294,23 +6313,23 @@ void CPU::SAX_absolute_3()
 void CPU::SAX_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SAX_indirect_x_2;
+	next = MC_SAX_indirect_x_2;
 }
 void CPU::SAX_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::SAX_indirect_x_3;
+	next = MC_SAX_indirect_x_3;
 }
 void CPU::SAX_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SAX_indirect_x_4;
+	next = MC_SAX_indirect_x_4;
 }
 void CPU::SAX_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::SAX_indirect_x_5;
+	next = MC_SAX_indirect_x_5;
 }
 void CPU::SAX_indirect_x_5()
 {
@@ -6332,20 +6351,20 @@ void CPU::SAX_indirect_x_5()
 void CPU::SHA_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SHA_absolute_y_2;
+	next = MC_SHA_absolute_y_2;
 }
 void CPU::SHA_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::SHA_absolute_y_3;
+	next = MC_SHA_absolute_y_3;
 }
 void CPU::SHA_absolute_y_3()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SHA_absolute_y_4;
+	next = MC_SHA_absolute_y_4;
 }
 void CPU::SHA_absolute_y_4()
 {
@@ -6358,25 +6377,25 @@ void CPU::SHA_absolute_y_4()
 void CPU::SHA_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SHA_indirect_y_2;
+	next = MC_SHA_indirect_y_2;
 }
 void CPU::SHA_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SHA_indirect_y_3;
+	next = MC_SHA_indirect_y_3;
 }
 void CPU::SHA_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::SHA_indirect_y_4;
+	next = MC_SHA_indirect_y_4;
 }
 void CPU::SHA_indirect_y_4()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SHA_indirect_y_5;
+	next = MC_SHA_indirect_y_5;
 }
 void CPU::SHA_indirect_y_5()
 {
@@ -6398,20 +6417,20 @@ void CPU::SHA_indirect_y_5()
 void CPU::SHX_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SHX_absolute_y_2;
+	next = MC_SHX_absolute_y_2;
 }
 void CPU::SHX_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::SHX_absolute_y_3;
+	next = MC_SHX_absolute_y_3;
 }
 void CPU::SHX_absolute_y_3()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SHX_absolute_y_4;
+	next = MC_SHX_absolute_y_4;
 }
 void CPU::SHX_absolute_y_4()
 {
@@ -6433,20 +6452,20 @@ void CPU::SHX_absolute_y_4()
 void CPU::SHY_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SHY_absolute_x_2;
+	next = MC_SHY_absolute_x_2;
 }
 void CPU::SHY_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::SHY_absolute_x_3;
+	next = MC_SHY_absolute_x_3;
 }
 void CPU::SHY_absolute_x_3()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SHY_absolute_x_4;
+	next = MC_SHY_absolute_x_4;
 }
 void CPU::SHY_absolute_x_4()
 {
@@ -6471,18 +6490,18 @@ void CPU::SHY_absolute_x_4()
 void CPU::SLO_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SLO_zero_page_2;
+	next = MC_SLO_zero_page_2;
 }
 void CPU::SLO_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::SLO_zero_page_3;
+	next = MC_SLO_zero_page_3;
 }
 void CPU::SLO_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_SLO;
-	next = &CPU::SLO_zero_page_4;
+	next = MC_SLO_zero_page_4;
 }
 void CPU::SLO_zero_page_4()
 {
@@ -6495,24 +6514,24 @@ void CPU::SLO_zero_page_4()
 void CPU::SLO_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SLO_zero_page_x_2;
+	next = MC_SLO_zero_page_x_2;
 }
 void CPU::SLO_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::SLO_zero_page_x_3;
+	next = MC_SLO_zero_page_x_3;
 }
 void CPU::SLO_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::SLO_zero_page_x_4;
+	next = MC_SLO_zero_page_x_4;
 }
 void CPU::SLO_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_SLO;
-	next = &CPU::SLO_zero_page_x_5;
+	next = MC_SLO_zero_page_x_5;
 }
 void CPU::SLO_zero_page_x_5()
 {
@@ -6525,23 +6544,23 @@ void CPU::SLO_zero_page_x_5()
 void CPU::SLO_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SLO_absolute_2;
+	next = MC_SLO_absolute_2;
 }
 void CPU::SLO_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::SLO_absolute_3;
+	next = MC_SLO_absolute_3;
 }
 void CPU::SLO_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SLO_absolute_4;
+	next = MC_SLO_absolute_4;
 }
 void CPU::SLO_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_SLO;
-	next = &CPU::SLO_absolute_5;
+	next = MC_SLO_absolute_5;
 }
 void CPU::SLO_absolute_5()
 {
@@ -6554,31 +6573,31 @@ void CPU::SLO_absolute_5()
 void CPU::SLO_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SLO_absolute_x_2;
+	next = MC_SLO_absolute_x_2;
 }
 void CPU::SLO_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::SLO_absolute_x_3;
+	next = MC_SLO_absolute_x_3;
 }
 void CPU::SLO_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SLO_absolute_x_4;
+	next = MC_SLO_absolute_x_4;
 }
 void CPU::SLO_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SLO_absolute_x_5;
+	next = MC_SLO_absolute_x_5;
 }
 void CPU::SLO_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_SLO;
-	next = &CPU::SLO_absolute_x_6;
+	next = MC_SLO_absolute_x_6;
 }
 void CPU::SLO_absolute_x_6()
 {
@@ -6591,31 +6610,31 @@ void CPU::SLO_absolute_x_6()
 void CPU::SLO_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SLO_absolute_y_2;
+	next = MC_SLO_absolute_y_2;
 }
 void CPU::SLO_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::SLO_absolute_y_3;
+	next = MC_SLO_absolute_y_3;
 }
 void CPU::SLO_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SLO_absolute_y_4;
+	next = MC_SLO_absolute_y_4;
 }
 void CPU::SLO_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SLO_absolute_y_5;
+	next = MC_SLO_absolute_y_5;
 }
 void CPU::SLO_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_SLO;
-	next = &CPU::SLO_absolute_y_6;
+	next = MC_SLO_absolute_y_6;
 }
 void CPU::SLO_absolute_y_6()
 {
@@ -6628,34 +6647,34 @@ void CPU::SLO_absolute_y_6()
 void CPU::SLO_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SLO_indirect_x_2;
+	next = MC_SLO_indirect_x_2;
 }
 void CPU::SLO_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::SLO_indirect_x_3;
+	next = MC_SLO_indirect_x_3;
 }
 void CPU::SLO_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SLO_indirect_x_4;
+	next = MC_SLO_indirect_x_4;
 }
 void CPU::SLO_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::SLO_indirect_x_5;
+	next = MC_SLO_indirect_x_5;
 }
 void CPU::SLO_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SLO_indirect_x_6;
+	next = MC_SLO_indirect_x_6;
 }
 void CPU::SLO_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_SLO;
-	next = &CPU::SLO_indirect_x_7;
+	next = MC_SLO_indirect_x_7;
 }
 
 void CPU::SLO_indirect_x_7()
@@ -6669,36 +6688,36 @@ void CPU::SLO_indirect_x_7()
 void CPU::SLO_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SLO_indirect_y_2;
+	next = MC_SLO_indirect_y_2;
 }
 void CPU::SLO_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SLO_indirect_y_3;
+	next = MC_SLO_indirect_y_3;
 }
 void CPU::SLO_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::SLO_indirect_y_4;
+	next = MC_SLO_indirect_y_4;
 }
 void CPU::SLO_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SLO_indirect_y_5;
+	next = MC_SLO_indirect_y_5;
 }
 void CPU::SLO_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SLO_indirect_y_6;
+	next = MC_SLO_indirect_y_6;
 }
 void CPU::SLO_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_SLO;
-	next = &CPU::SLO_indirect_y_7;
+	next = MC_SLO_indirect_y_7;
 }
 
 void CPU::SLO_indirect_y_7()
@@ -6724,18 +6743,18 @@ void CPU::SLO_indirect_y_7()
 void CPU::SRE_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SRE_zero_page_2;
+	next = MC_SRE_zero_page_2;
 }
 void CPU::SRE_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::SRE_zero_page_3;
+	next = MC_SRE_zero_page_3;
 }
 void CPU::SRE_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_SRE;
-	next = &CPU::SRE_zero_page_4;
+	next = MC_SRE_zero_page_4;
 }
 void CPU::SRE_zero_page_4()
 {
@@ -6748,24 +6767,24 @@ void CPU::SRE_zero_page_4()
 void CPU::SRE_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SRE_zero_page_x_2;
+	next = MC_SRE_zero_page_x_2;
 }
 void CPU::SRE_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::SRE_zero_page_x_3;
+	next = MC_SRE_zero_page_x_3;
 }
 void CPU::SRE_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::SRE_zero_page_x_4;
+	next = MC_SRE_zero_page_x_4;
 }
 void CPU::SRE_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_SRE;
-	next = &CPU::SRE_zero_page_x_5;
+	next = MC_SRE_zero_page_x_5;
 }
 void CPU::SRE_zero_page_x_5()
 {
@@ -6778,23 +6797,23 @@ void CPU::SRE_zero_page_x_5()
 void CPU::SRE_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SRE_absolute_2;
+	next = MC_SRE_absolute_2;
 }
 void CPU::SRE_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::SRE_absolute_3;
+	next = MC_SRE_absolute_3;
 }
 void CPU::SRE_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SRE_absolute_4;
+	next = MC_SRE_absolute_4;
 }
 void CPU::SRE_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_SRE;
-	next = &CPU::SRE_absolute_5;
+	next = MC_SRE_absolute_5;
 }
 void CPU::SRE_absolute_5()
 {
@@ -6807,31 +6826,31 @@ void CPU::SRE_absolute_5()
 void CPU::SRE_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SRE_absolute_x_2;
+	next = MC_SRE_absolute_x_2;
 }
 void CPU::SRE_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::SRE_absolute_x_3;
+	next = MC_SRE_absolute_x_3;
 }
 void CPU::SRE_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SRE_absolute_x_4;
+	next = MC_SRE_absolute_x_4;
 }
 void CPU::SRE_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SRE_absolute_x_5;
+	next = MC_SRE_absolute_x_5;
 }
 void CPU::SRE_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_SRE;
-	next = &CPU::SRE_absolute_x_6;
+	next = MC_SRE_absolute_x_6;
 }
 void CPU::SRE_absolute_x_6()
 {
@@ -6844,31 +6863,31 @@ void CPU::SRE_absolute_x_6()
 void CPU::SRE_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SRE_absolute_y_2;
+	next = MC_SRE_absolute_y_2;
 }
 void CPU::SRE_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::SRE_absolute_y_3;
+	next = MC_SRE_absolute_y_3;
 }
 void CPU::SRE_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SRE_absolute_y_4;
+	next = MC_SRE_absolute_y_4;
 }
 void CPU::SRE_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SRE_absolute_y_5;
+	next = MC_SRE_absolute_y_5;
 }
 void CPU::SRE_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_SRE;
-	next = &CPU::SRE_absolute_y_6;
+	next = MC_SRE_absolute_y_6;
 }
 void CPU::SRE_absolute_y_6()
 {
@@ -6881,34 +6900,34 @@ void CPU::SRE_absolute_y_6()
 void CPU::SRE_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SRE_indirect_x_2;
+	next = MC_SRE_indirect_x_2;
 }
 void CPU::SRE_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::SRE_indirect_x_3;
+	next = MC_SRE_indirect_x_3;
 }
 void CPU::SRE_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SRE_indirect_x_4;
+	next = MC_SRE_indirect_x_4;
 }
 void CPU::SRE_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::SRE_indirect_x_5;
+	next = MC_SRE_indirect_x_5;
 }
 void CPU::SRE_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SRE_indirect_x_6;
+	next = MC_SRE_indirect_x_6;
 }
 void CPU::SRE_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_SRE;
-	next = &CPU::SRE_indirect_x_7;
+	next = MC_SRE_indirect_x_7;
 }
 
 void CPU::SRE_indirect_x_7()
@@ -6922,36 +6941,36 @@ void CPU::SRE_indirect_x_7()
 void CPU::SRE_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SRE_indirect_y_2;
+	next = MC_SRE_indirect_y_2;
 }
 void CPU::SRE_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SRE_indirect_y_3;
+	next = MC_SRE_indirect_y_3;
 }
 void CPU::SRE_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::SRE_indirect_y_4;
+	next = MC_SRE_indirect_y_4;
 }
 void CPU::SRE_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SRE_indirect_y_5;
+	next = MC_SRE_indirect_y_5;
 }
 void CPU::SRE_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SRE_indirect_y_6;
+	next = MC_SRE_indirect_y_6;
 }
 void CPU::SRE_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_SRE;
-	next = &CPU::SRE_indirect_y_7;
+	next = MC_SRE_indirect_y_7;
 }
 
 void CPU::SRE_indirect_y_7()
@@ -6975,24 +6994,24 @@ void CPU::TAS_absolute_y()
 {
 	data = mem->peek(PC + 1) + 1;
 	FETCH_ADDR_LO;
-	next = &CPU::TAS_absolute_y_2;
+	next = MC_TAS_absolute_y_2;
 }
 void CPU::TAS_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::TAS_absolute_y_3;
+	next = MC_TAS_absolute_y_3;
 }
 void CPU::TAS_absolute_y_3()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::TAS_absolute_y_4;
+		next = MC_TAS_absolute_y_4;
 	} else {
 		// Note: We always perform an extra cycle here, even if page boundary is not crossed. 
 		// Otherwise, the CPUTIMING test fails.
-		next = &CPU::TAS_absolute_y_4;
+		next = MC_TAS_absolute_y_4;
 #if 0
 		SP = A & X;
 		data &= SP;
@@ -7044,297 +7063,675 @@ void CPU::LXA_immediate()
 	DONE;
 }
 
-void ((CPU::*CPU::callbacks[])(void)) = {
+
+// -------------------------------------------------------------------------------
+// Fast path
+//
+// Instructions that only touch plain memory are decoded in the fetch phase and
+// executed as a whole in the cycle in which the original CPU performs its last
+// memory access. All cycles in between pass idly.
+// -------------------------------------------------------------------------------
+
+// Instructions handled by the fast path
+static const uint8_t fastPathReadOps[] = {
+	0xB5, 0xAD, 0xBD, 0xB9, 0xA1, 0xB1, /* LDA */
+	0xB6, 0xAE, 0xBE,                   /* LDX */
+	0xB4, 0xAC, 0xBC,                   /* LDY */
+	0x75, 0x6D, 0x7D, 0x79, 0x61, 0x71, /* ADC */
+	0xF5, 0xED, 0xFD, 0xF9, 0xE1, 0xF1, /* SBC */
+	0x35, 0x2D, 0x3D, 0x39, 0x21, 0x31, /* AND */
+	0x15, 0x0D, 0x1D, 0x19, 0x01, 0x11, /* ORA */
+	0x55, 0x4D, 0x5D, 0x59, 0x41, 0x51, /* EOR */
+	0xD5, 0xCD, 0xDD, 0xD9, 0xC1, 0xD1, /* CMP */
+	0xEC, 0xCC, 0x2C                    /* CPX, CPY, BIT */
+};
+static const uint8_t fastPathWriteOps[] = {
+	0x95, 0x8D, 0x9D, 0x99, 0x81, 0x91, /* STA */
+	0x96, 0x8E, 0x94, 0x8C              /* STX, STY */
+};
+static const uint8_t fastPathModifyOps[] = {
+	0x06, 0x16, 0x0E, 0x1E, 0x46, 0x56, 0x4E, 0x5E, /* ASL, LSR */
+	0x26, 0x36, 0x2E, 0x3E, 0x66, 0x76, 0x6E, 0x7E, /* ROL, ROR */
+	0xE6, 0xF6, 0xEE, 0xFE, 0xC6, 0xD6, 0xCE, 0xDE  /* INC, DEC */
+};
+static const uint8_t fastPathOtherOps[] = { 0x6C, 0x60 }; /* JMP (indirect), RTS */
+
+// Three cycle instructions (omitted by the fast path)
+static const uint8_t zeroPageReadOps[] = {
+	0xA5, 0xA6, 0xA4, 0x65, 0xE5, 0x25, 0x05, 0x45, 0xC5, 0xE4, 0xC4, 0x24
+};
+static const uint8_t zeroPageWriteOps[] = { 0x85, 0x86, 0x84 };
+
+#define FAST_PATH_DECODER(mode) \
+	(kind == FP_READ ? &CPU::prepareFastPath<mode, FP_READ> : \
+	 kind == FP_WRITE ? &CPU::prepareFastPath<mode, FP_WRITE> : &CPU::prepareFastPath<mode, FP_MODIFY>)
+
+void CPU::registerFastPath(uint8_t opcode, FastPathKind kind)
+{
+	switch (addressingMode[opcode]) {
+		case ADDR_ZERO_PAGE:   fastPathPrepare[opcode] = FAST_PATH_DECODER(ADDR_ZERO_PAGE); break;
+		case ADDR_ZERO_PAGE_X: fastPathPrepare[opcode] = FAST_PATH_DECODER(ADDR_ZERO_PAGE_X); break;
+		case ADDR_ZERO_PAGE_Y: fastPathPrepare[opcode] = FAST_PATH_DECODER(ADDR_ZERO_PAGE_Y); break;
+		case ADDR_ABSOLUTE:    fastPathPrepare[opcode] = FAST_PATH_DECODER(ADDR_ABSOLUTE); break;
+		case ADDR_ABSOLUTE_X:  fastPathPrepare[opcode] = FAST_PATH_DECODER(ADDR_ABSOLUTE_X); break;
+		case ADDR_ABSOLUTE_Y:  fastPathPrepare[opcode] = FAST_PATH_DECODER(ADDR_ABSOLUTE_Y); break;
+		case ADDR_INDIRECT_X:  fastPathPrepare[opcode] = FAST_PATH_DECODER(ADDR_INDIRECT_X); break;
+		case ADDR_INDIRECT_Y:  fastPathPrepare[opcode] = FAST_PATH_DECODER(ADDR_INDIRECT_Y); break;
+		case ADDR_INDIRECT:    fastPathPrepare[opcode] = &CPU::prepareFastPath<ADDR_INDIRECT, FP_OTHER>; break;
+		case ADDR_IMPLIED:     fastPathPrepare[opcode] = &CPU::prepareFastPath<ADDR_IMPLIED, FP_OTHER>; break;
+		default:               assert(false);
+	}
+}
+
+void CPU::registerFastPath()
+{
+	// Three cycle instructions are omitted, because decoding them takes longer than
+	// executing them cycle by cycle
+	for (unsigned i = 0; i < 256; i++)
+		fastPathPrepare[i] = NULL;
+	for (unsigned i = 0; i < sizeof(fastPathReadOps); i++)
+		registerFastPath(fastPathReadOps[i], FP_READ);
+	for (unsigned i = 0; i < sizeof(fastPathWriteOps); i++)
+		registerFastPath(fastPathWriteOps[i], FP_WRITE);
+	for (unsigned i = 0; i < sizeof(fastPathModifyOps); i++)
+		registerFastPath(fastPathModifyOps[i], FP_MODIFY);
+	for (unsigned i = 0; i < sizeof(fastPathOtherOps); i++)
+		registerFastPath(fastPathOtherOps[i], FP_OTHER);
+}
+
+template <CPU::AddressingMode mode, CPU::FastPathKind kind>
+bool CPU::resolveFastPath(uint16_t operand, uint16_t &ea, uint8_t &cycles)
+{
+	Memory *m = mem;
+	uint16_t base = 0;
+	uint8_t lo, hi, p;
+
+	switch (mode) {
+
+		case ADDR_ZERO_PAGE:
+
+			ea = LO_BYTE(operand);
+			cycles = 3;
+			break;
+
+		case ADDR_ZERO_PAGE_X:
+		case ADDR_ZERO_PAGE_Y:
+
+			lo = LO_BYTE(operand);
+			if (!m->isPlainPeekAddr(lo)) return false;
+			ea = (uint8_t)(lo + (mode == ADDR_ZERO_PAGE_X ? X : Y));
+			cycles = 4;
+			break;
+
+		case ADDR_ABSOLUTE:
+
+			ea = operand;
+			cycles = 4;
+			break;
+
+		case ADDR_ABSOLUTE_X:
+		case ADDR_ABSOLUTE_Y:
+
+			base = operand;
+			ea = base + (mode == ADDR_ABSOLUTE_X ? X : Y);
+			cycles = 4;
+			break;
+
+		case ADDR_INDIRECT_X:
+
+			p = LO_BYTE(operand);
+			if (!m->isPlainPeekAddr(p)) return false;
+			p += X;
+			if (!m->isPlainPeekAddr(p) || !m->isPlainPeekAddr((uint8_t)(p + 1))) return false;
+			ea = LO_HI(m->peekPlain(p), m->peekPlain((uint8_t)(p + 1)));
+			cycles = 6;
+			break;
+
+		case ADDR_INDIRECT_Y:
+
+			p = LO_BYTE(operand);
+			if (!m->isPlainPeekAddr(p) || !m->isPlainPeekAddr((uint8_t)(p + 1))) return false;
+			base = LO_HI(m->peekPlain(p), m->peekPlain((uint8_t)(p + 1)));
+			ea = base + Y;
+			cycles = 5;
+			break;
+
+		case ADDR_INDIRECT:
+
+			lo = LO_BYTE(operand);
+			hi = HI_BYTE(operand);
+			if (!m->isPlainPeekAddr(LO_HI(lo, hi)) || !m->isPlainPeekAddr(LO_HI((uint8_t)(lo + 1), hi))) return false;
+			ea = LO_HI(m->peekPlain(LO_HI(lo, hi)), m->peekPlain(LO_HI((uint8_t)(lo + 1), hi)));
+			cycles = 5;
+			break;
+
+		default:
+
+			// RTS (the effective address is the return address)
+			if (!m->isPlainPeekAddr(0x100 | SP) ||
+				!m->isPlainPeekAddr(0x100 | (uint8_t)(SP + 1)) ||
+				!m->isPlainPeekAddr(0x100 | (uint8_t)(SP + 2))) return false;
+			ea = LO_HI(m->peekPlain(0x100 | (uint8_t)(SP + 1)), m->peekPlain(0x100 | (uint8_t)(SP + 2)));
+			if (!m->isPlainPeekAddr(ea++)) return false;
+			cycles = 6;
+			break;
+	}
+
+	// Idle read from the unfixed address in indexed addressing modes
+	if (mode == ADDR_ABSOLUTE_X || mode == ADDR_ABSOLUTE_Y || mode == ADDR_INDIRECT_Y) {
+		if (HI_BYTE(ea) != HI_BYTE(base) || kind != FP_READ) {
+			if (!m->isPlainPeekAddr((base & 0xFF00) | (ea & 0x00FF))) return false;
+			cycles++;
+		}
+	}
+
+	// Effective address
+	if (kind == FP_READ || kind == FP_MODIFY) {
+		if (!m->isPlainPeekAddr(ea)) return false;
+	}
+	if (kind == FP_WRITE || kind == FP_MODIFY) {
+		if (!m->isPlainPokeAddr(ea)) return false;
+	}
+
+	// Read-modify-write instructions write twice
+	if (kind == FP_MODIFY)
+		cycles += 2;
+
+	return true;
+}
+
+template <CPU::AddressingMode mode, CPU::FastPathKind kind> void CPU::prepareFastPath()
+{
+	Memory *m = mem;
+	uint16_t ea, pc = PC;
+	uint8_t cycles;
+
+	// Operand bytes
+	if (!m->isPlainPeekAddr(pc) || !m->isPlainPeekAddr(pc + 1))
+		return;
+	if (!resolveFastPath<mode, kind>(LO_HI(m->peekPlain(pc), m->peekPlain(pc + 1)), ea, cycles))
+		return;
+
+	switch (mode) {
+		case ADDR_ABSOLUTE:
+		case ADDR_ABSOLUTE_X:
+		case ADDR_ABSOLUTE_Y:
+			PC = pc + 2;
+			break;
+		case ADDR_INDIRECT: /* JMP */
+		case ADDR_IMPLIED: /* RTS */
+			PC = ea;
+			break;
+		default:
+			PC = pc + 1;
+	}
+
+	// Read-modify-write instructions are executed in their next to last cycle, because
+	// the original CPU writes back the modified value in two consecutive cycles
+	if (kind == FP_MODIFY)
+		cycles -= 1;
+
+	fastPathAddr = ea;
+	fastPathRead = (kind == FP_READ || mode == ADDR_IMPLIED /* RTS */);
+	fastPathLength = fastPathCycles = cycles - 1;
+	next = MC_fastPathExecute;
+}
+
+void CPU::leaveFastPath()
+{
+	bool rdy = rdyLine;
+	unsigned elapsed = fastPathLength - fastPathCycles;
+
+	// Replay all cycles that have passed (all of them read from plain memory)
+	PC = PC_at_cycle_0 + 1;
+	next = actionFunc[opcode];
+	rdyLine = true;
+	for (unsigned i = 0; i < elapsed; i++)
+		callbacks[next](this);
+	rdyLine = rdy;
+	fastPathCycles = 0;
+}
+
+inline bool CPU::executeFastPathOperation(uint8_t op, uint16_t ea)
+{
+	Memory *m = mem;
+
+	switch (op) {
+
+		case 0xA5: case 0xB5: case 0xAD: case 0xBD: case 0xB9: case 0xA1: case 0xB1:
+			loadA(m->peekPlain(ea));
+			break;
+		case 0xA6: case 0xB6: case 0xAE: case 0xBE:
+			loadX(m->peekPlain(ea));
+			break;
+		case 0xA4: case 0xB4: case 0xAC: case 0xBC:
+			loadY(m->peekPlain(ea));
+			break;
+		case 0x65: case 0x75: case 0x6D: case 0x7D: case 0x79: case 0x61: case 0x71:
+			adc(m->peekPlain(ea));
+			break;
+		case 0xE5: case 0xF5: case 0xED: case 0xFD: case 0xF9: case 0xE1: case 0xF1:
+			sbc(m->peekPlain(ea));
+			break;
+		case 0x25: case 0x35: case 0x2D: case 0x3D: case 0x39: case 0x21: case 0x31:
+			loadA(A & m->peekPlain(ea));
+			break;
+		case 0x05: case 0x15: case 0x0D: case 0x1D: case 0x19: case 0x01: case 0x11:
+			loadA(A | m->peekPlain(ea));
+			break;
+		case 0x45: case 0x55: case 0x4D: case 0x5D: case 0x59: case 0x41: case 0x51:
+			loadA(A ^ m->peekPlain(ea));
+			break;
+		case 0xC5: case 0xD5: case 0xCD: case 0xDD: case 0xD9: case 0xC1: case 0xD1:
+			cmp(A, m->peekPlain(ea));
+			break;
+		case 0xE4: case 0xEC:
+			cmp(X, m->peekPlain(ea));
+			break;
+		case 0xC4: case 0xCC:
+			cmp(Y, m->peekPlain(ea));
+			break;
+		case 0x24: case 0x2C:
+			data = m->peekPlain(ea);
+			setN(data & 128);
+			setV(data & 64);
+			setZ((data & A) == 0);
+			break;
+
+		case 0x85: case 0x95: case 0x8D: case 0x9D: case 0x99: case 0x81: case 0x91:
+			m->pokePlain(ea, A);
+			break;
+		case 0x86: case 0x96: case 0x8E:
+			m->pokePlain(ea, X);
+			break;
+		case 0x84: case 0x94: case 0x8C:
+			m->pokePlain(ea, Y);
+			break;
+
+		case 0x06: case 0x16: case 0x0E: case 0x1E:
+			data = m->peekPlain(ea); m->pokePlain(ea, data); DO_ASL;
+			return true;
+		case 0x46: case 0x56: case 0x4E: case 0x5E:
+			data = m->peekPlain(ea); m->pokePlain(ea, data); DO_LSR;
+			return true;
+		case 0x26: case 0x36: case 0x2E: case 0x3E:
+			data = m->peekPlain(ea); m->pokePlain(ea, data); DO_ROL;
+			return true;
+		case 0x66: case 0x76: case 0x6E: case 0x7E:
+			data = m->peekPlain(ea); m->pokePlain(ea, data); DO_ROR;
+			return true;
+		case 0xE6: case 0xF6: case 0xEE: case 0xFE:
+			data = m->peekPlain(ea); m->pokePlain(ea, data); DO_INC;
+			return true;
+		case 0xC6: case 0xD6: case 0xCE: case 0xDE:
+			data = m->peekPlain(ea); m->pokePlain(ea, data); DO_DEC;
+			return true;
+
+		case 0x60:
+			SP += 2;
+			break;
+
+		default: /* JMP */
+			break;
+	}
+	return false;
+}
+
+void CPU::fastPathExecute()
+{
+	// Freeze if the RDY line is down
+	if (fastPathRead && !rdyLine)
+		return;
+	fastPathCycles = 0;
+
+	if (executeFastPathOperation(opcode, fastPathAddr)) {
+		next = MC_fastPathWriteBack;
+	} else {
+		DONE;
+	}
+}
+
+void CPU::fastPathWriteBack()
+{
+	mem->pokePlain(fastPathAddr, data);
+	N = data & 128;
+	Z = (data == 0);
+	DONE;
+}
+
+
+// -------------------------------------------------------------------------------
+// Translation cache
+//
+// Basic blocks are decoded once and stored with their operands and handler
+// functions. A translated block is executed as a whole in the fetch phase of its
+// first instruction.
+// -------------------------------------------------------------------------------
+
+#define TRANSLATED_MEMORY(mode) \
+	(kind == FP_READ ? &CPU::translatedMemory<mode, FP_READ> : \
+	 kind == FP_WRITE ? &CPU::translatedMemory<mode, FP_WRITE> : &CPU::translatedMemory<mode, FP_MODIFY>)
+
+void CPU::registerTranslation(uint8_t opcode, FastPathKind kind)
+{
+	switch (addressingMode[opcode]) {
+		case ADDR_ZERO_PAGE:   translatedHandler[opcode] = TRANSLATED_MEMORY(ADDR_ZERO_PAGE); break;
+		case ADDR_ZERO_PAGE_X: translatedHandler[opcode] = TRANSLATED_MEMORY(ADDR_ZERO_PAGE_X); break;
+		case ADDR_ZERO_PAGE_Y: translatedHandler[opcode] = TRANSLATED_MEMORY(ADDR_ZERO_PAGE_Y); break;
+		case ADDR_ABSOLUTE:    translatedHandler[opcode] = TRANSLATED_MEMORY(ADDR_ABSOLUTE); break;
+		case ADDR_ABSOLUTE_X:  translatedHandler[opcode] = TRANSLATED_MEMORY(ADDR_ABSOLUTE_X); break;
+		case ADDR_ABSOLUTE_Y:  translatedHandler[opcode] = TRANSLATED_MEMORY(ADDR_ABSOLUTE_Y); break;
+		case ADDR_INDIRECT_X:  translatedHandler[opcode] = TRANSLATED_MEMORY(ADDR_INDIRECT_X); break;
+		case ADDR_INDIRECT_Y:  translatedHandler[opcode] = TRANSLATED_MEMORY(ADDR_INDIRECT_Y); break;
+		case ADDR_INDIRECT:    translatedHandler[opcode] = &CPU::translatedMemory<ADDR_INDIRECT, FP_OTHER>; break;
+		case ADDR_IMPLIED:     translatedHandler[opcode] = &CPU::translatedMemory<ADDR_IMPLIED, FP_OTHER>; break;
+		default:               assert(false);
+	}
+}
+
+void CPU::registerTranslation()
+{
+	static const uint8_t immediate[] = {
+		0xA9, 0xA2, 0xA0, 0x69, 0xE9, 0x29, 0x09, 0x49, 0xC9, 0xE0, 0xC0
+	};
+	static const uint8_t implied[] = {
+		0xAA, 0xA8, 0x8A, 0x98, 0xBA, 0x9A, 0xE8, 0xC8, 0xCA, 0x88, /* Transfer, INC, DEC */
+		0x18, 0x38, 0xD8, 0xF8, 0xB8, 0xEA, 0x0A, 0x4A, 0x2A, 0x6A  /* Flags, NOP, shift */
+	};
+	static const uint8_t stack[] = { 0x48, 0x08, 0x68 }; /* PHA, PHP, PLA */
+	static const uint8_t branch[] = { 0x10, 0x30, 0x50, 0x70, 0x90, 0xB0, 0xD0, 0xF0 };
+	static const uint8_t jump[] = { 0x4C, 0x20 }; /* JMP, JSR */
+	
+	for (unsigned i = 0; i < 256; i++)
+		translatedHandler[i] = NULL;
+	
+	for (unsigned i = 0; i < sizeof(fastPathReadOps); i++)
+		registerTranslation(fastPathReadOps[i], FP_READ);
+	for (unsigned i = 0; i < sizeof(zeroPageReadOps); i++)
+		registerTranslation(zeroPageReadOps[i], FP_READ);
+	for (unsigned i = 0; i < sizeof(fastPathWriteOps); i++)
+		registerTranslation(fastPathWriteOps[i], FP_WRITE);
+	for (unsigned i = 0; i < sizeof(zeroPageWriteOps); i++)
+		registerTranslation(zeroPageWriteOps[i], FP_WRITE);
+	for (unsigned i = 0; i < sizeof(fastPathModifyOps); i++)
+		registerTranslation(fastPathModifyOps[i], FP_MODIFY);
+	for (unsigned i = 0; i < sizeof(fastPathOtherOps); i++)
+		registerTranslation(fastPathOtherOps[i], FP_OTHER);
+	
+	for (unsigned i = 0; i < sizeof(immediate); i++)
+		translatedHandler[immediate[i]] = &CPU::translatedImmediate;
+	for (unsigned i = 0; i < sizeof(implied); i++)
+		translatedHandler[implied[i]] = &CPU::translatedImplied;
+	for (unsigned i = 0; i < sizeof(stack); i++)
+		translatedHandler[stack[i]] = &CPU::translatedStack;
+	for (unsigned i = 0; i < sizeof(branch); i++)
+		translatedHandler[branch[i]] = &CPU::translatedBranch;
+	for (unsigned i = 0; i < sizeof(jump); i++)
+		translatedHandler[jump[i]] = &CPU::translatedJump;
+}
+
+void CPU::setTranslation(bool enable)
+{
+	if (enable && translationCache == NULL) {
+		translationCache = new TranslatedBlock[TRANSLATION_CACHE_SIZE];
+		flushTranslationCache();
+	}
+	if (!enable && translationCache != NULL) {
+		delete[] translationCache;
+		translationCache = NULL;
+	}
+	translation = enable;
+}
+
+void CPU::flushTranslationCache()
+{
+	if (translationCache == NULL)
+		return;
+	
+	for (unsigned i = 0; i < TRANSLATION_CACHE_SIZE; i++)
+		translationCache[i].length = 0;
+}
+
+bool CPU::translateBlock(uint16_t pc, TranslatedBlock *block)
+{
+	uint8_t page = HI_BYTE(pc);
+	uint8_t *code = mem->plainPeekPage[page];
+	
+	if (code == NULL || pc < mem->firstPlainAddr)
+		return false;
+	
+	block->pc = pc;
+	block->code = code;
+	block->length = 0;
+	
+	while (block->length < MAX_BLOCK_LENGTH && HI_BYTE(pc) == page) {
+		
+		uint8_t op = code[LO_BYTE(pc)];
+		unsigned length = getLengthOfInstruction(op);
+		
+		// Instructions must not cross the page boundary
+		if (translatedHandler[op] == NULL || LO_BYTE(pc) + length > 0x100)
+			break;
+		
+		TranslatedInstruction *instr = &block->instr[block->length++];
+		instr->handler = translatedHandler[op];
+		instr->opcode = op;
+		instr->operand = (length == 1) ? 0 : (length == 2) ? code[LO_BYTE(pc + 1)] : LO_HI(code[LO_BYTE(pc + 1)], code[LO_BYTE(pc + 2)]);
+		instr->next = pc + length;
+		pc += length;
+		
+		// Control transfer instructions end the block
+		if (addressingMode[op] == ADDR_RELATIVE || op == 0x4C || op == 0x20 || op == 0x6C || op == 0x60)
+			break;
+	}
+	
+	if (block->length == 0)
+		return false;
+	
+	// Writing into the page invalidates the block
+	uint8_t physical = mem->physicalPage[page];
+	block->version = mem->pageVersion[physical];
+	mem->translatedPage[physical] = true;
+	return true;
+}
+
+bool CPU::executeTranslatedBlock()
+{
+	uint16_t pc = PC;
+	uint8_t page = HI_BYTE(pc);
+	uint8_t physical = mem->physicalPage[page];
+	TranslatedBlock *block = &translationCache[pc & (TRANSLATION_CACHE_SIZE - 1)];
+	
+	// Look up block
+	if (block->length == 0 || block->pc != pc || block->code != mem->plainPeekPage[page] ||
+		block->version != mem->pageVersion[physical]) {
+		if (!translateBlock(pc, block))
+			return false;
+	}
+	
+	unsigned cycles = 0;
+	uint32_t version = block->version;
+	
+	for (unsigned i = 0; i < block->length; i++) {
+		
+		const TranslatedInstruction *instr = &block->instr[i];
+		
+		// Stop at breakpoints
+		if (breakpoint[pc] != NO_BREAKPOINT)
+			break;
+		
+		PC = instr->next;
+		uint8_t elapsed = (*this.*instr->handler)(instr);
+		if (elapsed == 0) {
+			PC = pc; // Not executable in this context
+			break;
+		}
+		opcode = instr->opcode;
+		cycles += elapsed;
+		pc = PC;
+		
+		// Stop if the block has modified itself
+		if (version != mem->pageVersion[physical])
+			break;
+	}
+	
+	if (cycles == 0)
+		return false;
+	
+	// Let the remaining cycles pass idly
+	fastPathRead = false;
+	fastPathLength = fastPathCycles = cycles - 1;
+	next = MC_translatedBlockDone;
+	return true;
+}
+
+void CPU::translatedBlockDone()
+{
+	fastPathCycles = 0;
+	DONE;
+}
+
+template <CPU::AddressingMode mode, CPU::FastPathKind kind>
+uint8_t CPU::translatedMemory(const TranslatedInstruction *instr)
+{
+	uint16_t ea;
+	uint8_t cycles;
 	
-&CPU::fetch,
-
-&CPU::JAM, &CPU::JAM_2,
-
-&CPU::irq, &CPU::irq_2, &CPU::irq_3, &CPU::irq_4, &CPU::irq_5, &CPU::irq_6, &CPU::irq_7,
-&CPU::nmi, &CPU::nmi_2, &CPU::nmi_3, &CPU::nmi_4, &CPU::nmi_5, &CPU::nmi_6, &CPU::nmi_7,
-
-&CPU::ADC_immediate,
-&CPU::ADC_zero_page, &CPU::ADC_zero_page_2,
-&CPU::ADC_zero_page_x, &CPU::ADC_zero_page_x_2, &CPU::ADC_zero_page_x_3,
-&CPU::ADC_absolute, &CPU::ADC_absolute_2, &CPU::ADC_absolute_3,
-&CPU::ADC_absolute_x, &CPU::ADC_absolute_x_2, &CPU::ADC_absolute_x_3, &CPU::ADC_absolute_x_4,
-&CPU::ADC_absolute_y, &CPU::ADC_absolute_y_2, &CPU::ADC_absolute_y_3, &CPU::ADC_absolute_y_4,
-&CPU::ADC_indirect_x, &CPU::ADC_indirect_x_2, &CPU::ADC_indirect_x_3, &CPU::ADC_indirect_x_4, &CPU::ADC_indirect_x_5,
-&CPU::ADC_indirect_y, &CPU::ADC_indirect_y_2, &CPU::ADC_indirect_y_3, &CPU::ADC_indirect_y_4, &CPU::ADC_indirect_y_5,
-
-&CPU::AND_immediate,
-&CPU::AND_zero_page, &CPU::AND_zero_page_2,
-&CPU::AND_zero_page_x, &CPU::AND_zero_page_x_2, &CPU::AND_zero_page_x_3,
-&CPU::AND_absolute, &CPU::AND_absolute_2, &CPU::AND_absolute_3,
-&CPU::AND_absolute_x, &CPU::AND_absolute_x_2, &CPU::AND_absolute_x_3, &CPU::AND_absolute_x_4,
-&CPU::AND_absolute_y, &CPU::AND_absolute_y_2, &CPU::AND_absolute_y_3, &CPU::AND_absolute_y_4,
-&CPU::AND_indirect_x, &CPU::AND_indirect_x_2, &CPU::AND_indirect_x_3, &CPU::AND_indirect_x_4, &CPU::AND_indirect_x_5,
-&CPU::AND_indirect_y, &CPU::AND_indirect_y_2, &CPU::AND_indirect_y_3, &CPU::AND_indirect_y_4, &CPU::AND_indirect_y_5,
-
-&CPU::ASL_accumulator,
-&CPU::ASL_zero_page, &CPU::ASL_zero_page_2, &CPU::ASL_zero_page_3, &CPU::ASL_zero_page_4,
-&CPU::ASL_zero_page_x, &CPU::ASL_zero_page_x_2, &CPU::ASL_zero_page_x_3, &CPU::ASL_zero_page_x_4, &CPU::ASL_zero_page_x_5,
-&CPU::ASL_absolute, &CPU::ASL_absolute_2, &CPU::ASL_absolute_3, &CPU::ASL_absolute_4, &CPU::ASL_absolute_5,
-&CPU::ASL_absolute_x, &CPU::ASL_absolute_x_2, &CPU::ASL_absolute_x_3, &CPU::ASL_absolute_x_4, &CPU::ASL_absolute_x_5, &CPU::ASL_absolute_x_6,
-&CPU::ASL_indirect_x, &CPU::ASL_indirect_x_2, &CPU::ASL_indirect_x_3, &CPU::ASL_indirect_x_4, &CPU::ASL_indirect_x_5, &CPU::ASL_indirect_x_6, &CPU::ASL_indirect_x_7,     
-
-&CPU::branch_3_underflow, &CPU::branch_3_overflow,
-&CPU::BCC_relative, &CPU::BCC_relative_2, 
-&CPU::BCS_relative, &CPU::BCS_relative_2, 
-&CPU::BEQ_relative, &CPU::BEQ_relative_2, 
-
-&CPU::BIT_zero_page, &CPU::BIT_zero_page_2,
-&CPU::BIT_absolute, &CPU::BIT_absolute_2, &CPU::BIT_absolute_3,
-
-&CPU::BMI_relative, &CPU::BMI_relative_2, 
-&CPU::BNE_relative, &CPU::BNE_relative_2, 
-&CPU::BPL_relative, &CPU::BPL_relative_2, 
-
-&CPU::BRK, &CPU::BRK_2, &CPU::BRK_3, &CPU::BRK_4, &CPU::BRK_5, &CPU::BRK_6,
-&CPU::BRK_nmi_4, &CPU::BRK_nmi_5, &CPU::BRK_nmi_6, 
-
-&CPU::BVC_relative, &CPU::BVC_relative_2, 
-&CPU::BVS_relative, &CPU::BVS_relative_2, 
-&CPU::CLC,
-&CPU::CLD,
-&CPU::CLI,
-&CPU::CLV,
-
-&CPU::CMP_immediate,
-&CPU::CMP_zero_page, &CPU::CMP_zero_page_2,
-&CPU::CMP_zero_page_x, &CPU::CMP_zero_page_x_2, &CPU::CMP_zero_page_x_3,
-&CPU::CMP_absolute, &CPU::CMP_absolute_2, &CPU::CMP_absolute_3,
-&CPU::CMP_absolute_x, &CPU::CMP_absolute_x_2, &CPU::CMP_absolute_x_3, &CPU::CMP_absolute_x_4,
-&CPU::CMP_absolute_y, &CPU::CMP_absolute_y_2, &CPU::CMP_absolute_y_3, &CPU::CMP_absolute_y_4,
-&CPU::CMP_indirect_x, &CPU::CMP_indirect_x_2, &CPU::CMP_indirect_x_3, &CPU::CMP_indirect_x_4, &CPU::CMP_indirect_x_5,
-&CPU::CMP_indirect_y, &CPU::CMP_indirect_y_2, &CPU::CMP_indirect_y_3, &CPU::CMP_indirect_y_4, &CPU::CMP_indirect_y_5,
-
-&CPU::CPX_immediate,
-&CPU::CPX_zero_page, &CPU::CPX_zero_page_2, 
-&CPU::CPX_absolute, &CPU::CPX_absolute_2, &CPU::CPX_absolute_3,
-
-&CPU::CPY_immediate,
-&CPU::CPY_zero_page, &CPU::CPY_zero_page_2,
-&CPU::CPY_absolute, &CPU::CPY_absolute_2, &CPU::CPY_absolute_3,
-
-&CPU::DEC_zero_page, &CPU::DEC_zero_page_2, &CPU::DEC_zero_page_3, &CPU::DEC_zero_page_4,
-&CPU::DEC_zero_page_x, &CPU::DEC_zero_page_x_2, &CPU::DEC_zero_page_x_3, &CPU::DEC_zero_page_x_4, &CPU::DEC_zero_page_x_5,
-&CPU::DEC_absolute, &CPU::DEC_absolute_2, &CPU::DEC_absolute_3, &CPU::DEC_absolute_4, &CPU::DEC_absolute_5,
-&CPU::DEC_absolute_x, &CPU::DEC_absolute_x_2, &CPU::DEC_absolute_x_3, &CPU::DEC_absolute_x_4, &CPU::DEC_absolute_x_5, &CPU::DEC_absolute_x_6,
-&CPU::DEC_indirect_x, &CPU::DEC_indirect_x_2, &CPU::DEC_indirect_x_3, &CPU::DEC_indirect_x_4, &CPU::DEC_indirect_x_5, &CPU::DEC_indirect_x_6, &CPU::DEC_indirect_x_7,     
-
-&CPU::DEX,
-&CPU::DEY,
-
-&CPU::EOR_immediate,
-&CPU::EOR_zero_page, &CPU::EOR_zero_page_2,
-&CPU::EOR_zero_page_x, &CPU::EOR_zero_page_x_2, &CPU::EOR_zero_page_x_3,
-&CPU::EOR_absolute, &CPU::EOR_absolute_2, &CPU::EOR_absolute_3,
-&CPU::EOR_absolute_x, &CPU::EOR_absolute_x_2, &CPU::EOR_absolute_x_3, &CPU::EOR_absolute_x_4,
-&CPU::EOR_absolute_y, &CPU::EOR_absolute_y_2, &CPU::EOR_absolute_y_3, &CPU::EOR_absolute_y_4,
-&CPU::EOR_indirect_x, &CPU::EOR_indirect_x_2, &CPU::EOR_indirect_x_3, &CPU::EOR_indirect_x_4, &CPU::EOR_indirect_x_5,
-&CPU::EOR_indirect_y, &CPU::EOR_indirect_y_2, &CPU::EOR_indirect_y_3, &CPU::EOR_indirect_y_4, &CPU::EOR_indirect_y_5,
-
-&CPU::INC_zero_page, &CPU::INC_zero_page_2, &CPU::INC_zero_page_3, &CPU::INC_zero_page_4,
-&CPU::INC_zero_page_x, &CPU::INC_zero_page_x_2, &CPU::INC_zero_page_x_3, &CPU::INC_zero_page_x_4, &CPU::INC_zero_page_x_5,
-&CPU::INC_absolute, &CPU::INC_absolute_2, &CPU::INC_absolute_3, &CPU::INC_absolute_4, &CPU::INC_absolute_5,
-&CPU::INC_absolute_x, &CPU::INC_absolute_x_2, &CPU::INC_absolute_x_3, &CPU::INC_absolute_x_4, &CPU::INC_absolute_x_5, &CPU::INC_absolute_x_6,
-&CPU::INC_indirect_x, &CPU::INC_indirect_x_2, &CPU::INC_indirect_x_3, &CPU::INC_indirect_x_4, &CPU::INC_indirect_x_5, &CPU::INC_indirect_x_6, &CPU::INC_indirect_x_7,     
-
-&CPU::INX,
-&CPU::INY,
-
-&CPU::JMP_absolute, &CPU::JMP_absolute_2,
-&CPU::JMP_absolute_indirect, &CPU::JMP_absolute_indirect_2, &CPU::JMP_absolute_indirect_3, &CPU::JMP_absolute_indirect_4,
-
-&CPU::JSR, &CPU::JSR_2, &CPU::JSR_3, &CPU::JSR_4, &CPU::JSR_5,
-
-&CPU::LDA_immediate,
-&CPU::LDA_zero_page, &CPU::LDA_zero_page_2,
-&CPU::LDA_zero_page_x, &CPU::LDA_zero_page_x_2, &CPU::LDA_zero_page_x_3,
-&CPU::LDA_absolute, &CPU::LDA_absolute_2, &CPU::LDA_absolute_3,
-&CPU::LDA_absolute_x, &CPU::LDA_absolute_x_2, &CPU::LDA_absolute_x_3, &CPU::LDA_absolute_x_4,
-&CPU::LDA_absolute_y, &CPU::LDA_absolute_y_2, &CPU::LDA_absolute_y_3, &CPU::LDA_absolute_y_4,
-&CPU::LDA_indirect_x, &CPU::LDA_indirect_x_2, &CPU::LDA_indirect_x_3, &CPU::LDA_indirect_x_4, &CPU::LDA_indirect_x_5,
-&CPU::LDA_indirect_y, &CPU::LDA_indirect_y_2, &CPU::LDA_indirect_y_3, &CPU::LDA_indirect_y_4, &CPU::LDA_indirect_y_5,
-
-&CPU::LDX_immediate,
-&CPU::LDX_zero_page, &CPU::LDX_zero_page_2,
-&CPU::LDX_zero_page_y, &CPU::LDX_zero_page_y_2, &CPU::LDX_zero_page_y_3,
-&CPU::LDX_absolute, &CPU::LDX_absolute_2, &CPU::LDX_absolute_3,
-&CPU::LDX_absolute_y, &CPU::LDX_absolute_y_2, &CPU::LDX_absolute_y_3, &CPU::LDX_absolute_y_4,
-&CPU::LDX_indirect_x, &CPU::LDX_indirect_x_2, &CPU::LDX_indirect_x_3, &CPU::LDX_indirect_x_4, &CPU::LDX_indirect_x_5,
-&CPU::LDX_indirect_y, &CPU::LDX_indirect_y_2, &CPU::LDX_indirect_y_3, &CPU::LDX_indirect_y_4, &CPU::LDX_indirect_y_5,
-
-&CPU::LDY_immediate,
-&CPU::LDY_zero_page, &CPU::LDY_zero_page_2,
-&CPU::LDY_zero_page_x, &CPU::LDY_zero_page_x_2, &CPU::LDY_zero_page_x_3,
-&CPU::LDY_absolute, &CPU::LDY_absolute_2, &CPU::LDY_absolute_3,
-&CPU::LDY_absolute_x, &CPU::LDY_absolute_x_2, &CPU::LDY_absolute_x_3, &CPU::LDY_absolute_x_4,
-&CPU::LDY_indirect_x, &CPU::LDY_indirect_x_2, &CPU::LDY_indirect_x_3, &CPU::LDY_indirect_x_4, &CPU::LDY_indirect_x_5,
-&CPU::LDY_indirect_y, &CPU::LDY_indirect_y_2, &CPU::LDY_indirect_y_3, &CPU::LDY_indirect_y_4, &CPU::LDY_indirect_y_5,
-
-&CPU::LSR_accumulator,
-&CPU::LSR_zero_page, &CPU::LSR_zero_page_2, &CPU::LSR_zero_page_3, &CPU::LSR_zero_page_4,
-&CPU::LSR_zero_page_x, &CPU::LSR_zero_page_x_2, &CPU::LSR_zero_page_x_3, &CPU::LSR_zero_page_x_4, &CPU::LSR_zero_page_x_5,
-&CPU::LSR_absolute, &CPU::LSR_absolute_2, &CPU::LSR_absolute_3, &CPU::LSR_absolute_4, &CPU::LSR_absolute_5,
-&CPU::LSR_absolute_x, &CPU::LSR_absolute_x_2, &CPU::LSR_absolute_x_3, &CPU::LSR_absolute_x_4, &CPU::LSR_absolute_x_5, &CPU::LSR_absolute_x_6,
-&CPU::LSR_absolute_y, &CPU::LSR_absolute_y_2, &CPU::LSR_absolute_y_3, &CPU::LSR_absolute_y_4, &CPU::LSR_absolute_y_5, &CPU::LSR_absolute_y_6, 
-&CPU::LSR_indirect_x, &CPU::LSR_indirect_x_2, &CPU::LSR_indirect_x_3, &CPU::LSR_indirect_x_4, &CPU::LSR_indirect_x_5, &CPU::LSR_indirect_x_6, &CPU::LSR_indirect_x_7,     
-&CPU::LSR_indirect_y, &CPU::LSR_indirect_y_2, &CPU::LSR_indirect_y_3, &CPU::LSR_indirect_y_4, &CPU::LSR_indirect_y_5, &CPU::LSR_indirect_y_6, &CPU::LSR_indirect_y_7,
-
-&CPU::NOP,
-&CPU::NOP_immediate,
-&CPU::NOP_zero_page, &CPU::NOP_zero_page_2,
-&CPU::NOP_zero_page_x, &CPU::NOP_zero_page_x_2, &CPU::NOP_zero_page_x_3,
-&CPU::NOP_absolute, &CPU::NOP_absolute_2, &CPU::NOP_absolute_3,
-&CPU::NOP_absolute_x, &CPU::NOP_absolute_x_2, &CPU::NOP_absolute_x_3, &CPU::NOP_absolute_x_4,
-
-&CPU::ORA_immediate,
-&CPU::ORA_zero_page, &CPU::ORA_zero_page_2,
-&CPU::ORA_zero_page_x, &CPU::ORA_zero_page_x_2, &CPU::ORA_zero_page_x_3,
-&CPU::ORA_absolute, &CPU::ORA_absolute_2, &CPU::ORA_absolute_3,
-&CPU::ORA_absolute_x, &CPU::ORA_absolute_x_2, &CPU::ORA_absolute_x_3, &CPU::ORA_absolute_x_4,
-&CPU::ORA_absolute_y, &CPU::ORA_absolute_y_2, &CPU::ORA_absolute_y_3, &CPU::ORA_absolute_y_4,
-&CPU::ORA_indirect_x, &CPU::ORA_indirect_x_2, &CPU::ORA_indirect_x_3, &CPU::ORA_indirect_x_4, &CPU::ORA_indirect_x_5,
-&CPU::ORA_indirect_y, &CPU::ORA_indirect_y_2, &CPU::ORA_indirect_y_3, &CPU::ORA_indirect_y_4, &CPU::ORA_indirect_y_5,
-
-&CPU::PHA, &CPU::PHA_2,
-&CPU::PHP, &CPU::PHP_2,
-&CPU::PLA, &CPU::PLA_2, &CPU::PLA_3,
-&CPU::PLP, &CPU::PLP_2, &CPU::PLP_3,
-
-&CPU::ROL_accumulator,
-&CPU::ROL_zero_page, &CPU::ROL_zero_page_2, &CPU::ROL_zero_page_3, &CPU::ROL_zero_page_4,
-&CPU::ROL_zero_page_x, &CPU::ROL_zero_page_x_2, &CPU::ROL_zero_page_x_3, &CPU::ROL_zero_page_x_4, &CPU::ROL_zero_page_x_5,
-&CPU::ROL_absolute, &CPU::ROL_absolute_2, &CPU::ROL_absolute_3, &CPU::ROL_absolute_4, &CPU::ROL_absolute_5,
-&CPU::ROL_absolute_x, &CPU::ROL_absolute_x_2, &CPU::ROL_absolute_x_3, &CPU::ROL_absolute_x_4, &CPU::ROL_absolute_x_5, &CPU::ROL_absolute_x_6,
-&CPU::ROL_indirect_x, &CPU::ROL_indirect_x_2, &CPU::ROL_indirect_x_3, &CPU::ROL_indirect_x_4, &CPU::ROL_indirect_x_5, &CPU::ROL_indirect_x_6, &CPU::ROL_indirect_x_7,     
-
-&CPU::ROR_accumulator,
-&CPU::ROR_zero_page, &CPU::ROR_zero_page_2, &CPU::ROR_zero_page_3, &CPU::ROR_zero_page_4,
-&CPU::ROR_zero_page_x, &CPU::ROR_zero_page_x_2, &CPU::ROR_zero_page_x_3, &CPU::ROR_zero_page_x_4, &CPU::ROR_zero_page_x_5,
-&CPU::ROR_absolute, &CPU::ROR_absolute_2, &CPU::ROR_absolute_3, &CPU::ROR_absolute_4, &CPU::ROR_absolute_5,
-&CPU::ROR_absolute_x, &CPU::ROR_absolute_x_2, &CPU::ROR_absolute_x_3, &CPU::ROR_absolute_x_4, &CPU::ROR_absolute_x_5, &CPU::ROR_absolute_x_6,
-&CPU::ROR_indirect_x, &CPU::ROR_indirect_x_2, &CPU::ROR_indirect_x_3, &CPU::ROR_indirect_x_4, &CPU::ROR_indirect_x_5, &CPU::ROR_indirect_x_6, &CPU::ROR_indirect_x_7,     
-
-&CPU::RTI, &CPU::RTI_2, &CPU::RTI_3, &CPU::RTI_4, &CPU::RTI_5,
-&CPU::RTS, &CPU::RTS_2, &CPU::RTS_3, &CPU::RTS_4, &CPU::RTS_5,
-
-&CPU::SBC_immediate,
-&CPU::SBC_zero_page, &CPU::SBC_zero_page_2,
-&CPU::SBC_zero_page_x, &CPU::SBC_zero_page_x_2, &CPU::SBC_zero_page_x_3,
-&CPU::SBC_absolute, &CPU::SBC_absolute_2, &CPU::SBC_absolute_3,
-&CPU::SBC_absolute_x, &CPU::SBC_absolute_x_2, &CPU::SBC_absolute_x_3, &CPU::SBC_absolute_x_4,
-&CPU::SBC_absolute_y, &CPU::SBC_absolute_y_2, &CPU::SBC_absolute_y_3, &CPU::SBC_absolute_y_4,
-&CPU::SBC_indirect_x, &CPU::SBC_indirect_x_2, &CPU::SBC_indirect_x_3, &CPU::SBC_indirect_x_4, &CPU::SBC_indirect_x_5,
-&CPU::SBC_indirect_y, &CPU::SBC_indirect_y_2, &CPU::SBC_indirect_y_3, &CPU::SBC_indirect_y_4, &CPU::SBC_indirect_y_5,
-
-&CPU::SEC,
-&CPU::SED,
-&CPU::SEI,
-
-&CPU::STA_zero_page, &CPU::STA_zero_page_2,
-&CPU::STA_zero_page_x, &CPU::STA_zero_page_x_2, &CPU::STA_zero_page_x_3,
-&CPU::STA_absolute, &CPU::STA_absolute_2, &CPU::STA_absolute_3,
-&CPU::STA_absolute_x, &CPU::STA_absolute_x_2, &CPU::STA_absolute_x_3, &CPU::STA_absolute_x_4,
-&CPU::STA_absolute_y, &CPU::STA_absolute_y_2, &CPU::STA_absolute_y_3, &CPU::STA_absolute_y_4,
-&CPU::STA_indirect_x, &CPU::STA_indirect_x_2, &CPU::STA_indirect_x_3, &CPU::STA_indirect_x_4, &CPU::STA_indirect_x_5,
-&CPU::STA_indirect_y, &CPU::STA_indirect_y_2, &CPU::STA_indirect_y_3, &CPU::STA_indirect_y_4, &CPU::STA_indirect_y_5,
-
-&CPU::STX_zero_page, &CPU::STX_zero_page_2,
-&CPU::STX_zero_page_y, &CPU::STX_zero_page_y_2, &CPU::STX_zero_page_y_3,
-&CPU::STX_absolute, &CPU::STX_absolute_2, &CPU::STX_absolute_3,
-
-&CPU::STY_zero_page, &CPU::STY_zero_page_2,
-&CPU::STY_zero_page_x, &CPU::STY_zero_page_x_2, &CPU::STY_zero_page_x_3,
-&CPU::STY_absolute, &CPU::STY_absolute_2, &CPU::STY_absolute_3,
-
-&CPU::TAX,
-&CPU::TAY,
-&CPU::TSX,
-&CPU::TXA,
-&CPU::TXS,
-&CPU::TYA,
+	if (!resolveFastPath<mode, kind>(instr->operand, ea, cycles))
+		return 0;
+	
+	if (executeFastPathOperation(instr->opcode, ea)) {
+		mem->pokePlain(ea, data);
+		N = data & 128;
+		Z = (data == 0);
+	}
+	
+	// Indirect jumps and RTS go to the effective address
+	if (mode == ADDR_INDIRECT || mode == ADDR_IMPLIED)
+		PC = ea;
+	
+	return cycles;
+}
 
-// Illegal instructions
+uint8_t CPU::translatedImmediate(const TranslatedInstruction *instr)
+{
+	uint8_t value = LO_BYTE(instr->operand);
+	
+	switch (instr->opcode) {
+		case 0xA9: loadA(value); break;
+		case 0xA2: loadX(value); break;
+		case 0xA0: loadY(value); break;
+		case 0x69: adc(value); break;
+		case 0xE9: sbc(value); break;
+		case 0x29: loadA(A & value); break;
+		case 0x09: loadA(A | value); break;
+		case 0x49: loadA(A ^ value); break;
+		case 0xC9: cmp(A, value); break;
+		case 0xE0: cmp(X, value); break;
+		case 0xC0: cmp(Y, value); break;
+		default: assert(false);
+	}
+	return 2;
+}
+
+uint8_t CPU::translatedImplied(const TranslatedInstruction *instr)
+{
+	switch (instr->opcode) {
+		case 0xAA: loadX(A); break;
+		case 0xA8: loadY(A); break;
+		case 0x8A: loadA(X); break;
+		case 0x98: loadA(Y); break;
+		case 0xBA: loadX(SP); break;
+		case 0x9A: SP = X; break;
+		case 0xE8: loadX(X + 1); break;
+		case 0xC8: loadY(Y + 1); break;
+		case 0xCA: loadX(X - 1); break;
+		case 0x88: loadY(Y - 1); break;
+		case 0x18: setC(0); break;
+		case 0x38: setC(1); break;
+		case 0xD8: setD(0); break;
+		case 0xF8: setD(1); break;
+		case 0xB8: setV(0); break;
+		case 0xEA: break;
+		case 0x0A: data = A; DO_ASL; loadA(data); break;
+		case 0x4A: data = A; DO_LSR; loadA(data); break;
+		case 0x2A: data = A; DO_ROL; loadA(data); break;
+		case 0x6A: data = A; DO_ROR; loadA(data); break;
+		default: assert(false);
+	}
+	return 2;
+}
+
+uint8_t CPU::translatedStack(const TranslatedInstruction *instr)
+{
+	switch (instr->opcode) {
+		case 0x48: /* PHA */
+			if (!mem->isPlainPokeAddr(0x100 | SP)) return 0;
+			mem->pokePlain(0x100 | SP--, A);
+			return 3;
+		case 0x08: /* PHP */
+			if (!mem->isPlainPokeAddr(0x100 | SP)) return 0;
+			mem->pokePlain(0x100 | SP--, getP());
+			return 3;
+		default: /* PLA */
+			if (!mem->isPlainPeekAddr(0x100 | SP) || !mem->isPlainPeekAddr(0x100 | (uint8_t)(SP + 1))) return 0;
+			loadA(mem->peekPlain(0x100 | ++SP));
+			return 4;
+	}
+}
+
+uint8_t CPU::translatedBranch(const TranslatedInstruction *instr)
+{
+	bool taken;
+	
+	switch (instr->opcode) {
+		case 0x10: taken = !getN(); break;
+		case 0x30: taken = getN(); break;
+		case 0x50: taken = !getV(); break;
+		case 0x70: taken = getV(); break;
+		case 0x90: taken = !getC(); break;
+		case 0xB0: taken = getC(); break;
+		case 0xD0: taken = !getZ(); break;
+		default:   taken = getZ(); break;
+	}
+	if (!taken)
+		return 2;
+	
+	uint16_t target = PC + (int8_t)LO_BYTE(instr->operand);
+	if (HI_BYTE(target) == HI_BYTE(PC)) {
+		nextPossibleIrqCycle++; // Delay IRQs by one cycle
+		nextPossibleNmiCycle++;
+		PC = target;
+		return 3;
+	}
+	
+	// Idle read from the unfixed address
+	if (!mem->isPlainPeekAddr((PC & 0xFF00) | (target & 0x00FF)))
+		return 0;
+	PC = target;
+	return 4;
+}
+
+uint8_t CPU::translatedJump(const TranslatedInstruction *instr)
+{
+	if (instr->opcode == 0x4C) {
+		PC = instr->operand;
+		return 3;
+	}
+	
+	// JSR
+	if (!mem->isPlainPokeAddr(0x100 | SP) || !mem->isPlainPokeAddr(0x100 | (uint8_t)(SP - 1)))
+		return 0;
+	PC--;
+	callStack[callStackPointer++] = PC;
+	mem->pokePlain(0x100 | SP--, HI_BYTE(PC));
+	mem->pokePlain(0x100 | SP--, LO_BYTE(PC));
+	PC = instr->operand;
+	return 6;
+}
+
+#define MICROCODE_CALLBACK(name) &CPU::callback<&CPU::name>,
 
-&CPU::ALR_immediate,   
-&CPU::ANC_immediate,   
-&CPU::ANE_immediate,
-&CPU::ARR_immediate,   
-&CPU::AXS_immediate,   
-
-&CPU::DCP_zero_page, &CPU::DCP_zero_page_2, &CPU::DCP_zero_page_3, &CPU::DCP_zero_page_4,
-&CPU::DCP_zero_page_x, &CPU::DCP_zero_page_x_2, &CPU::DCP_zero_page_x_3, &CPU::DCP_zero_page_x_4, &CPU::DCP_zero_page_x_5,
-&CPU::DCP_absolute, &CPU::DCP_absolute_2, &CPU::DCP_absolute_3, &CPU::DCP_absolute_4, &CPU::DCP_absolute_5,
-&CPU::DCP_absolute_x, &CPU::DCP_absolute_x_2, &CPU::DCP_absolute_x_3, &CPU::DCP_absolute_x_4, &CPU::DCP_absolute_x_5, &CPU::DCP_absolute_x_6,
-&CPU::DCP_absolute_y, &CPU::DCP_absolute_y_2, &CPU::DCP_absolute_y_3, &CPU::DCP_absolute_y_4, &CPU::DCP_absolute_y_5, &CPU::DCP_absolute_y_6, 
-&CPU::DCP_indirect_x, &CPU::DCP_indirect_x_2, &CPU::DCP_indirect_x_3, &CPU::DCP_indirect_x_4, &CPU::DCP_indirect_x_5, &CPU::DCP_indirect_x_6, &CPU::DCP_indirect_x_7,     
-&CPU::DCP_indirect_y, &CPU::DCP_indirect_y_2, &CPU::DCP_indirect_y_3, &CPU::DCP_indirect_y_4, &CPU::DCP_indirect_y_5, &CPU::DCP_indirect_y_6, &CPU::DCP_indirect_y_7,
-
-&CPU::ISC_zero_page, &CPU::ISC_zero_page_2, &CPU::ISC_zero_page_3, &CPU::ISC_zero_page_4,
-&CPU::ISC_zero_page_x, &CPU::ISC_zero_page_x_2, &CPU::ISC_zero_page_x_3, &CPU::ISC_zero_page_x_4, &CPU::ISC_zero_page_x_5,
-&CPU::ISC_absolute, &CPU::ISC_absolute_2, &CPU::ISC_absolute_3, &CPU::ISC_absolute_4, &CPU::ISC_absolute_5,
-&CPU::ISC_absolute_x, &CPU::ISC_absolute_x_2, &CPU::ISC_absolute_x_3, &CPU::ISC_absolute_x_4, &CPU::ISC_absolute_x_5, &CPU::ISC_absolute_x_6,
-&CPU::ISC_absolute_y, &CPU::ISC_absolute_y_2, &CPU::ISC_absolute_y_3, &CPU::ISC_absolute_y_4, &CPU::ISC_absolute_y_5, &CPU::ISC_absolute_y_6, 
-&CPU::ISC_indirect_x, &CPU::ISC_indirect_x_2, &CPU::ISC_indirect_x_3, &CPU::ISC_indirect_x_4, &CPU::ISC_indirect_x_5, &CPU::ISC_indirect_x_6, &CPU::ISC_indirect_x_7,     
-&CPU::ISC_indirect_y, &CPU::ISC_indirect_y_2, &CPU::ISC_indirect_y_3, &CPU::ISC_indirect_y_4, &CPU::ISC_indirect_y_5, &CPU::ISC_indirect_y_6, &CPU::ISC_indirect_y_7,
-
-&CPU::LAS_absolute_y, &CPU::LAS_absolute_y_2, &CPU::LAS_absolute_y_3, &CPU::LAS_absolute_y_4,
-
-&CPU::LAX_zero_page, &CPU::LAX_zero_page_2,
-&CPU::LAX_zero_page_y, &CPU::LAX_zero_page_y_2, &CPU::LAX_zero_page_y_3,
-&CPU::LAX_absolute, &CPU::LAX_absolute_2, &CPU::LAX_absolute_3,
-&CPU::LAX_absolute_y, &CPU::LAX_absolute_y_2, &CPU::LAX_absolute_y_3, &CPU::LAX_absolute_y_4,
-&CPU::LAX_indirect_x, &CPU::LAX_indirect_x_2, &CPU::LAX_indirect_x_3, &CPU::LAX_indirect_x_4, &CPU::LAX_indirect_x_5,
-&CPU::LAX_indirect_y, &CPU::LAX_indirect_y_2, &CPU::LAX_indirect_y_3, &CPU::LAX_indirect_y_4, &CPU::LAX_indirect_y_5,
-
-&CPU::LXA_immediate,
-
-&CPU::RLA_zero_page, &CPU::RLA_zero_page_2, &CPU::RLA_zero_page_3, &CPU::RLA_zero_page_4,
-&CPU::RLA_zero_page_x, &CPU::RLA_zero_page_x_2, &CPU::RLA_zero_page_x_3, &CPU::RLA_zero_page_x_4, &CPU::RLA_zero_page_x_5,
-&CPU::RLA_absolute, &CPU::RLA_absolute_2, &CPU::RLA_absolute_3, &CPU::RLA_absolute_4, &CPU::RLA_absolute_5,
-&CPU::RLA_absolute_x, &CPU::RLA_absolute_x_2, &CPU::RLA_absolute_x_3, &CPU::RLA_absolute_x_4, &CPU::RLA_absolute_x_5, &CPU::RLA_absolute_x_6,
-&CPU::RLA_absolute_y, &CPU::RLA_absolute_y_2, &CPU::RLA_absolute_y_3, &CPU::RLA_absolute_y_4, &CPU::RLA_absolute_y_5, &CPU::RLA_absolute_y_6,
-&CPU::RLA_indirect_x, &CPU::RLA_indirect_x_2, &CPU::RLA_indirect_x_3, &CPU::RLA_indirect_x_4, &CPU::RLA_indirect_x_5, &CPU::RLA_indirect_x_6, &CPU::RLA_indirect_x_7,
-&CPU::RLA_indirect_y, &CPU::RLA_indirect_y_2, &CPU::RLA_indirect_y_3, &CPU::RLA_indirect_y_4, &CPU::RLA_indirect_y_5, &CPU::RLA_indirect_y_6, &CPU::RLA_indirect_y_7,
-
-&CPU::RRA_zero_page, &CPU::RRA_zero_page_2, &CPU::RRA_zero_page_3, &CPU::RRA_zero_page_4,
-&CPU::RRA_zero_page_x, &CPU::RRA_zero_page_x_2, &CPU::RRA_zero_page_x_3, &CPU::RRA_zero_page_x_4, &CPU::RRA_zero_page_x_5,
-&CPU::RRA_absolute, &CPU::RRA_absolute_2, &CPU::RRA_absolute_3, &CPU::RRA_absolute_4, &CPU::RRA_absolute_5,
-&CPU::RRA_absolute_x, &CPU::RRA_absolute_x_2, &CPU::RRA_absolute_x_3, &CPU::RRA_absolute_x_4, &CPU::RRA_absolute_x_5, &CPU::RRA_absolute_x_6,
-&CPU::RRA_absolute_y, &CPU::RRA_absolute_y_2, &CPU::RRA_absolute_y_3, &CPU::RRA_absolute_y_4, &CPU::RRA_absolute_y_5, &CPU::RRA_absolute_y_6,
-&CPU::RRA_indirect_x, &CPU::RRA_indirect_x_2, &CPU::RRA_indirect_x_3, &CPU::RRA_indirect_x_4, &CPU::RRA_indirect_x_5, &CPU::RRA_indirect_x_6, &CPU::RRA_indirect_x_7,
-&CPU::RRA_indirect_y, &CPU::RRA_indirect_y_2, &CPU::RRA_indirect_y_3, &CPU::RRA_indirect_y_4, &CPU::RRA_indirect_y_5, &CPU::RRA_indirect_y_6, &CPU::RRA_indirect_y_7,
-
-&CPU::SAX_zero_page, &CPU::SAX_zero_page_2,
-&CPU::SAX_zero_page_y, &CPU::SAX_zero_page_y_2, &CPU::SAX_zero_page_y_3,
-&CPU::SAX_absolute, &CPU::SAX_absolute_2, &CPU::SAX_absolute_3,
-&CPU::SAX_indirect_x, &CPU::SAX_indirect_x_2, &CPU::SAX_indirect_x_3, &CPU::SAX_indirect_x_4, &CPU::SAX_indirect_x_5,
-
-&CPU::SHA_indirect_y, &CPU::SHA_indirect_y_2, &CPU::SHA_indirect_y_3, &CPU::SHA_indirect_y_4, &CPU::SHA_indirect_y_5,
-&CPU::SHA_absolute_y, &CPU::SHA_absolute_y_2, &CPU::SHA_absolute_y_3, &CPU::SHA_absolute_y_4,
-
-&CPU::SHX_absolute_y, &CPU::SHX_absolute_y_2, &CPU::SHX_absolute_y_3, &CPU::SHX_absolute_y_4,
-&CPU::SHY_absolute_x, &CPU::SHY_absolute_x_2, &CPU::SHY_absolute_x_3, &CPU::SHY_absolute_x_4,
-
-&CPU::SLO_zero_page, &CPU::SLO_zero_page_2, &CPU::SLO_zero_page_3, &CPU::SLO_zero_page_4,
-&CPU::SLO_zero_page_x, &CPU::SLO_zero_page_x_2, &CPU::SLO_zero_page_x_3, &CPU::SLO_zero_page_x_4, &CPU::SLO_zero_page_x_5,
-&CPU::SLO_absolute, &CPU::SLO_absolute_2, &CPU::SLO_absolute_3, &CPU::SLO_absolute_4, &CPU::SLO_absolute_5,
-&CPU::SLO_absolute_x, &CPU::SLO_absolute_x_2, &CPU::SLO_absolute_x_3, &CPU::SLO_absolute_x_4, &CPU::SLO_absolute_x_5, &CPU::SLO_absolute_x_6,
-&CPU::SLO_absolute_y, &CPU::SLO_absolute_y_2, &CPU::SLO_absolute_y_3, &CPU::SLO_absolute_y_4, &CPU::SLO_absolute_y_5, &CPU::SLO_absolute_y_6,
-&CPU::SLO_indirect_x, &CPU::SLO_indirect_x_2, &CPU::SLO_indirect_x_3, &CPU::SLO_indirect_x_4, &CPU::SLO_indirect_x_5, &CPU::SLO_indirect_x_6, &CPU::SLO_indirect_x_7,
-&CPU::SLO_indirect_y, &CPU::SLO_indirect_y_2, &CPU::SLO_indirect_y_3, &CPU::SLO_indirect_y_4, &CPU::SLO_indirect_y_5, &CPU::SLO_indirect_y_6, &CPU::SLO_indirect_y_7,
-
-&CPU::SRE_zero_page, &CPU::SRE_zero_page_2, &CPU::SRE_zero_page_3, &CPU::SRE_zero_page_4,
-&CPU::SRE_zero_page_x, &CPU::SRE_zero_page_x_2, &CPU::SRE_zero_page_x_3, &CPU::SRE_zero_page_x_4, &CPU::SRE_zero_page_x_5,
-&CPU::SRE_absolute, &CPU::SRE_absolute_2, &CPU::SRE_absolute_3, &CPU::SRE_absolute_4, &CPU::SRE_absolute_5,
-&CPU::SRE_absolute_x, &CPU::SRE_absolute_x_2, &CPU::SRE_absolute_x_3, &CPU::SRE_absolute_x_4, &CPU::SRE_absolute_x_5, &CPU::SRE_absolute_x_6,
-&CPU::SRE_absolute_y, &CPU::SRE_absolute_y_2, &CPU::SRE_absolute_y_3, &CPU::SRE_absolute_y_4, &CPU::SRE_absolute_y_5, &CPU::SRE_absolute_y_6,
-&CPU::SRE_indirect_x, &CPU::SRE_indirect_x_2, &CPU::SRE_indirect_x_3, &CPU::SRE_indirect_x_4, &CPU::SRE_indirect_x_5, &CPU::SRE_indirect_x_6, &CPU::SRE_indirect_x_7,
-&CPU::SRE_indirect_y, &CPU::SRE_indirect_y_2, &CPU::SRE_indirect_y_3, &CPU::SRE_indirect_y_4, &CPU::SRE_indirect_y_5, &CPU::SRE_indirect_y_6, &CPU::SRE_indirect_y_7,
-
-&CPU::TAS_absolute_y, &CPU::TAS_absolute_y_2, &CPU::TAS_absolute_y_3, &CPU::TAS_absolute_y_4,
-NULL
+void (* const CPU::callbacks[MC_COUNT])(CPU *) = {
+    MICRO_INSTRUCTIONS(MICROCODE_CALLBACK)
 };
@@ -60,7 +60,7 @@
 #define PAGE_BOUNDARY_CROSSED overflow
 #define FIX_ADDR_HI addr_hi++;
 
-#define DONE next = &CPU::fetch;
+#define DONE next = MC_fetch;
 
 //! Mnemonic strings (used by the source level debugger only)
 const char *mnemonic[256];
@@ -68,14 +68,17 @@ const char *mnemonic[256];
 //! Adressing mode (used by the source level debugger only)
 AddressingMode addressingMode[256];
 
-//! Static array containing all callback function
-static void (CPU::*callbacks[])(void);
+//! Calls a microcode function (used to build the callbacks table)
+template <void (CPU::*func)(void)> static void callback(CPU *cpu) { (cpu->*func)(); }
+
+//! Static array containing all callback functions, indexed by MicroInstruction
+static void (* const callbacks[MC_COUNT])(CPU *);
 
 //! Register callback function for a single opcode
-void registerCallback(uint8_t opcode, void (CPU::*func)(void));
+void registerCallback(uint8_t opcode, MicroInstruction func);
 
 //! Register callback function for a single opcode
-void registerCallback(uint8_t opcode, const char *mnemonic, AddressingMode mode, void (CPU::*func)(void));
+void registerCallback(uint8_t opcode, const char *mnemonic, AddressingMode mode, MicroInstruction func);
 
 //! Register illegal instructions
 void registerIllegalInstructions();
@@ -95,11 +98,51 @@ void cmp(uint8_t op1, uint8_t op2);
 uint8_t ror(uint8_t op);
 uint8_t rol(uint8_t op);
 
+//! Register fast path decoder for a single opcode
+void registerFastPath(uint8_t opcode, FastPathKind kind);
+
+//! Register fast path decoders for all supported instructions
+void registerFastPath();
+
+//! Decode the current instruction and schedule it for fast execution if possible
+template <AddressingMode mode, FastPathKind kind> void prepareFastPath();
+
+//! Reconstruct the microcode state of a pending fast path instruction
+void leaveFastPath();
+
+//! Perform the operation of a fast path instruction. Returns true if a modified value needs to be written back
+bool executeFastPathOperation(uint8_t op, uint16_t ea);
+
+//! Compute the effective address and the cycle count of an instruction that only touches plain memory
+template <AddressingMode mode, FastPathKind kind> bool resolveFastPath(uint16_t operand, uint16_t &ea, uint8_t &cycles);
+
+//! Register translation handler for a single memory accessing opcode
+void registerTranslation(uint8_t opcode, FastPathKind kind);
+
+//! Register translation handlers for all supported instructions
+void registerTranslation();
+
+//! Translate the basic block starting at the specified address
+bool translateBlock(uint16_t pc, TranslatedBlock *block);
+
+//! Execute the basic block starting at the program counter. Returns false if nothing has been executed
+bool executeTranslatedBlock();
+
+// Translation handlers
+template <AddressingMode mode, FastPathKind kind> uint8_t translatedMemory(const TranslatedInstruction *instr);
+uint8_t translatedImmediate(const TranslatedInstruction *instr);
+uint8_t translatedImplied(const TranslatedInstruction *instr);
+uint8_t translatedStack(const TranslatedInstruction *instr);
+uint8_t translatedBranch(const TranslatedInstruction *instr);
+uint8_t translatedJump(const TranslatedInstruction *instr);
+
 // Execution functions
 public: 
 
 void fetch();
 
+void fastPathExecute(); void fastPathWriteBack(); void translatedBlockDone();
+
 void JAM(); void JAM_2(); // Default action for illegal instructions
 
 void irq(); void irq_2(); void irq_3(); void irq_4(); void irq_5(); void irq_6(); void irq_7();
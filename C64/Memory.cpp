@@ -21,6 +21,14 @@
 Memory::Memory()
 {	
 	setDescription("MEM");
+    
+    for (unsigned i = 0; i < 256; i++) {
+        plainPeekPage[i] = plainPokePage[i] = NULL;
+        physicalPage[i] = i;
+        translatedPage[i] = false;
+        pageVersion[i] = 0;
+    }
+    firstPlainAddr = 0;
 }
 
 Memory::~Memory()
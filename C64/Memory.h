@@ -50,6 +50,41 @@ public:
 	//! @brief    Reference to the connected virtual CPU
 	CPU *cpu; 
 
+    /*! @brief    Read pointers of all memory pages that can be accessed without side effects
+     *  @details  A page is plain if reading from it does not trigger any action and if its
+     *            contents can only be changed by the connected CPU itself, either directly or
+     *            by switching banks. In that case, plainPeekPage[i] points to the memory cell
+     *            that is read when address i << 8 is accessed. Otherwise, the entry is NULL.
+     *            The CPU uses this information to decide whether a memory access can be
+     *            postponed. Subclasses use it to serve plain accesses without further lookups.
+     *  @see      CPU::fastPath
+     */
+    uint8_t *plainPeekPage[256];
+
+    //! @brief    Write pointers of all memory pages that can be accessed without side effects
+    uint8_t *plainPokePage[256];
+
+    /*! @brief    Lowest plain address inside page 0
+     *  @details  Used to exclude the processor port of the C64 CPU.
+     */
+    uint16_t firstPlainAddr;
+
+    /*! @brief    Canonical page number of each memory page
+     *  @details  Mirrored pages share the same canonical page. Used to track modifications of
+     *            translated code.
+     */
+    uint8_t physicalPage[256];
+
+    /*! @brief    Indicates which canonical pages hold translated code
+     *  @details  When such a page is written to, the mark is removed and the version number of
+     *            the page is incremented, which invalidates all of its translations.
+     *  @see      CPU::translation
+     */
+    bool translatedPage[256];
+
+    //! @brief    Version number of each canonical page
+    uint32_t pageVersion[256];
+
 public:
 	
 	//! @brief    Constructor
@@ -76,6 +111,23 @@ protected:
 
 public:
 
+	//! @brief    Returns true, if the specified address can be read without side effects.
+	inline bool isPlainPeekAddr(uint16_t addr) { return plainPeekPage[addr >> 8] && addr >= firstPlainAddr; }
+
+	//! @brief    Returns true, if the specified address can be written without side effects.
+	inline bool isPlainPokeAddr(uint16_t addr) { return plainPokePage[addr >> 8] && addr >= firstPlainAddr; }
+
+	//! @brief    Reads a byte from a plain memory location.
+	inline uint8_t peekPlain(uint16_t addr) { return plainPeekPage[addr >> 8][addr & 0xFF]; }
+
+	//! @brief    Writes a byte into a plain memory location.
+	inline void pokePlain(uint16_t addr, uint8_t value) { codeModified(addr); plainPokePage[addr >> 8][addr & 0xFF] = value; }
+
+	//! @brief    Invalidates all translations of the page containing the specified address.
+	inline void codeModified(uint16_t addr) {
+		uint8_t page = physicalPage[addr >> 8];
+		if (translatedPage[page]) { translatedPage[page] = false; pageVersion[page]++; } }
+
 	//! @brief    Reads a byte from the specified memory source.
 	uint8_t peekFrom(uint16_t addr, MemoryType source);
 
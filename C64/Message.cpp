@@ -106,6 +106,8 @@ MessageQueue::getMessage()
 void
 MessageQueue::putMessage(int id, int i, void *p, const char *c)
 { 
+	bool overflow = false;
+	
 	pthread_mutex_lock(&lock);
 		
 	// Write data
@@ -120,9 +122,13 @@ MessageQueue::putMessage(int id, int i, void *p, const char *c)
 	w = (w + 1) % queue_size;
 
 	if (w == r) {
-		warn("Queue overflow!!! Message is lost!!!\n");
+		overflow = true;
 		r = (r + 1) % queue_size;
 	} 
 	
 	pthread_mutex_unlock(&lock);
+	
+	// Printing is a cancellation point. Hence, we must not print while holding the lock
+	if (overflow)
+		warn("Queue overflow!!! Message is lost!!!\n");
 }
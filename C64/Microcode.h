@@ -0,0 +1,325 @@
+/*
+ * (C) 2006-2009 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _MICROCODE_INC
+#define _MICROCODE_INC
+
+/*! @brief    List of all microcode functions of the virtual CPU
+ *  @details  Each entry names a member function that performs the actions of a single cycle.
+ *            The list is expanded twice: once into the CPU::MicroInstruction enumeration and
+ *            once into the CPU::callbacks dispatch table. Hence, the position of each entry is
+ *            the value that is written into snapshots. New entries must be appended to the end
+ *            of the list to keep older snapshots loadable.
+ *            The last two entries are transient states. They are never stored in snapshots,
+ *            because CPU::saveToBuffer converts them back into regular microcode states.
+ */
+#define MICRO_INSTRUCTIONS(X) \
+    X(fetch) \
+ \
+    X(JAM) X(JAM_2) \
+ \
+    X(irq) X(irq_2) X(irq_3) X(irq_4) X(irq_5) X(irq_6) X(irq_7) \
+    X(nmi) X(nmi_2) X(nmi_3) X(nmi_4) X(nmi_5) X(nmi_6) X(nmi_7) \
+ \
+    X(ADC_immediate) \
+    X(ADC_zero_page) X(ADC_zero_page_2) \
+    X(ADC_zero_page_x) X(ADC_zero_page_x_2) X(ADC_zero_page_x_3) \
+    X(ADC_absolute) X(ADC_absolute_2) X(ADC_absolute_3) \
+    X(ADC_absolute_x) X(ADC_absolute_x_2) X(ADC_absolute_x_3) X(ADC_absolute_x_4) \
+    X(ADC_absolute_y) X(ADC_absolute_y_2) X(ADC_absolute_y_3) X(ADC_absolute_y_4) \
+    X(ADC_indirect_x) X(ADC_indirect_x_2) X(ADC_indirect_x_3) X(ADC_indirect_x_4) X(ADC_indirect_x_5) \
+    X(ADC_indirect_y) X(ADC_indirect_y_2) X(ADC_indirect_y_3) X(ADC_indirect_y_4) X(ADC_indirect_y_5) \
+ \
+    X(AND_immediate) \
+    X(AND_zero_page) X(AND_zero_page_2) \
+    X(AND_zero_page_x) X(AND_zero_page_x_2) X(AND_zero_page_x_3) \
+    X(AND_absolute) X(AND_absolute_2) X(AND_absolute_3) \
+    X(AND_absolute_x) X(AND_absolute_x_2) X(AND_absolute_x_3) X(AND_absolute_x_4) \
+    X(AND_absolute_y) X(AND_absolute_y_2) X(AND_absolute_y_3) X(AND_absolute_y_4) \
+    X(AND_indirect_x) X(AND_indirect_x_2) X(AND_indirect_x_3) X(AND_indirect_x_4) X(AND_indirect_x_5) \
+    X(AND_indirect_y) X(AND_indirect_y_2) X(AND_indirect_y_3) X(AND_indirect_y_4) X(AND_indirect_y_5) \
+ \
+    X(ASL_accumulator) \
+    X(ASL_zero_page) X(ASL_zero_page_2) X(ASL_zero_page_3) X(ASL_zero_page_4) \
+    X(ASL_zero_page_x) X(ASL_zero_page_x_2) X(ASL_zero_page_x_3) X(ASL_zero_page_x_4) X(ASL_zero_page_x_5) \
+    X(ASL_absolute) X(ASL_absolute_2) X(ASL_absolute_3) X(ASL_absolute_4) X(ASL_absolute_5) \
+    X(ASL_absolute_x) X(ASL_absolute_x_2) X(ASL_absolute_x_3) X(ASL_absolute_x_4) X(ASL_absolute_x_5) X(ASL_absolute_x_6) \
+    X(ASL_indirect_x) X(ASL_indirect_x_2) X(ASL_indirect_x_3) X(ASL_indirect_x_4) X(ASL_indirect_x_5) X(ASL_indirect_x_6) X(ASL_indirect_x_7) \
+ \
+    X(branch_3_underflow) X(branch_3_overflow) \
+    X(BCC_relative) X(BCC_relative_2) \
+    X(BCS_relative) X(BCS_relative_2) \
+    X(BEQ_relative) X(BEQ_relative_2) \
+ \
+    X(BIT_zero_page) X(BIT_zero_page_2) \
+    X(BIT_absolute) X(BIT_absolute_2) X(BIT_absolute_3) \
+ \
+    X(BMI_relative) X(BMI_relative_2) \
+    X(BNE_relative) X(BNE_relative_2) \
+    X(BPL_relative) X(BPL_relative_2) \
+ \
+    X(BRK) X(BRK_2) X(BRK_3) X(BRK_4) X(BRK_5) X(BRK_6) \
+    X(BRK_nmi_4) X(BRK_nmi_5) X(BRK_nmi_6) \
+ \
+    X(BVC_relative) X(BVC_relative_2) \
+    X(BVS_relative) X(BVS_relative_2) \
+    X(CLC) \
+    X(CLD) \
+    X(CLI) \
+    X(CLV) \
+ \
+    X(CMP_immediate) \
+    X(CMP_zero_page) X(CMP_zero_page_2) \
+    X(CMP_zero_page_x) X(CMP_zero_page_x_2) X(CMP_zero_page_x_3) \
+    X(CMP_absolute) X(CMP_absolute_2) X(CMP_absolute_3) \
+    X(CMP_absolute_x) X(CMP_absolute_x_2) X(CMP_absolute_x_3) X(CMP_absolute_x_4) \
+    X(CMP_absolute_y) X(CMP_absolute_y_2) X(CMP_absolute_y_3) X(CMP_absolute_y_4) \
+    X(CMP_indirect_x) X(CMP_indirect_x_2) X(CMP_indirect_x_3) X(CMP_indirect_x_4) X(CMP_indirect_x_5) \
+    X(CMP_indirect_y) X(CMP_indirect_y_2) X(CMP_indirect_y_3) X(CMP_indirect_y_4) X(CMP_indirect_y_5) \
+ \
+    X(CPX_immediate) \
+    X(CPX_zero_page) X(CPX_zero_page_2) \
+    X(CPX_absolute) X(CPX_absolute_2) X(CPX_absolute_3) \
+ \
+    X(CPY_immediate) \
+    X(CPY_zero_page) X(CPY_zero_page_2) \
+    X(CPY_absolute) X(CPY_absolute_2) X(CPY_absolute_3) \
+ \
+    X(DEC_zero_page) X(DEC_zero_page_2) X(DEC_zero_page_3) X(DEC_zero_page_4) \
+    X(DEC_zero_page_x) X(DEC_zero_page_x_2) X(DEC_zero_page_x_3) X(DEC_zero_page_x_4) X(DEC_zero_page_x_5) \
+    X(DEC_absolute) X(DEC_absolute_2) X(DEC_absolute_3) X(DEC_absolute_4) X(DEC_absolute_5) \
+    X(DEC_absolute_x) X(DEC_absolute_x_2) X(DEC_absolute_x_3) X(DEC_absolute_x_4) X(DEC_absolute_x_5) X(DEC_absolute_x_6) \
+    X(DEC_indirect_x) X(DEC_indirect_x_2) X(DEC_indirect_x_3) X(DEC_indirect_x_4) X(DEC_indirect_x_5) X(DEC_indirect_x_6) X(DEC_indirect_x_7) \
+ \
+    X(DEX) \
+    X(DEY) \
+ \
+    X(EOR_immediate) \
+    X(EOR_zero_page) X(EOR_zero_page_2) \
+    X(EOR_zero_page_x) X(EOR_zero_page_x_2) X(EOR_zero_page_x_3) \
+    X(EOR_absolute) X(EOR_absolute_2) X(EOR_absolute_3) \
+    X(EOR_absolute_x) X(EOR_absolute_x_2) X(EOR_absolute_x_3) X(EOR_absolute_x_4) \
+    X(EOR_absolute_y) X(EOR_absolute_y_2) X(EOR_absolute_y_3) X(EOR_absolute_y_4) \
+    X(EOR_indirect_x) X(EOR_indirect_x_2) X(EOR_indirect_x_3) X(EOR_indirect_x_4) X(EOR_indirect_x_5) \
+    X(EOR_indirect_y) X(EOR_indirect_y_2) X(EOR_indirect_y_3) X(EOR_indirect_y_4) X(EOR_indirect_y_5) \
+ \
+    X(INC_zero_page) X(INC_zero_page_2) X(INC_zero_page_3) X(INC_zero_page_4) \
+    X(INC_zero_page_x) X(INC_zero_page_x_2) X(INC_zero_page_x_3) X(INC_zero_page_x_4) X(INC_zero_page_x_5) \
+    X(INC_absolute) X(INC_absolute_2) X(INC_absolute_3) X(INC_absolute_4) X(INC_absolute_5) \
+    X(INC_absolute_x) X(INC_absolute_x_2) X(INC_absolute_x_3) X(INC_absolute_x_4) X(INC_absolute_x_5) X(INC_absolute_x_6) \
+    X(INC_indirect_x) X(INC_indirect_x_2) X(INC_indirect_x_3) X(INC_indirect_x_4) X(INC_indirect_x_5) X(INC_indirect_x_6) X(INC_indirect_x_7) \
+ \
+    X(INX) \
+    X(INY) \
+ \
+    X(JMP_absolute) X(JMP_absolute_2) \
+    X(JMP_absolute_indirect) X(JMP_absolute_indirect_2) X(JMP_absolute_indirect_3) X(JMP_absolute_indirect_4) \
+ \
+    X(JSR) X(JSR_2) X(JSR_3) X(JSR_4) X(JSR_5) \
+ \
+    X(LDA_immediate) \
+    X(LDA_zero_page) X(LDA_zero_page_2) \
+    X(LDA_zero_page_x) X(LDA_zero_page_x_2) X(LDA_zero_page_x_3) \
+    X(LDA_absolute) X(LDA_absolute_2) X(LDA_absolute_3) \
+    X(LDA_absolute_x) X(LDA_absolute_x_2) X(LDA_absolute_x_3) X(LDA_absolute_x_4) \
+    X(LDA_absolute_y) X(LDA_absolute_y_2) X(LDA_absolute_y_3) X(LDA_absolute_y_4) \
+    X(LDA_indirect_x) X(LDA_indirect_x_2) X(LDA_indirect_x_3) X(LDA_indirect_x_4) X(LDA_indirect_x_5) \
+    X(LDA_indirect_y) X(LDA_indirect_y_2) X(LDA_indirect_y_3) X(LDA_indirect_y_4) X(LDA_indirect_y_5) \
+ \
+    X(LDX_immediate) \
+    X(LDX_zero_page) X(LDX_zero_page_2) \
+    X(LDX_zero_page_y) X(LDX_zero_page_y_2) X(LDX_zero_page_y_3) \
+    X(LDX_absolute) X(LDX_absolute_2) X(LDX_absolute_3) \
+    X(LDX_absolute_y) X(LDX_absolute_y_2) X(LDX_absolute_y_3) X(LDX_absolute_y_4) \
+    X(LDX_indirect_x) X(LDX_indirect_x_2) X(LDX_indirect_x_3) X(LDX_indirect_x_4) X(LDX_indirect_x_5) \
+    X(LDX_indirect_y) X(LDX_indirect_y_2) X(LDX_indirect_y_3) X(LDX_indirect_y_4) X(LDX_indirect_y_5) \
+ \
+    X(LDY_immediate) \
+    X(LDY_zero_page) X(LDY_zero_page_2) \
+    X(LDY_zero_page_x) X(LDY_zero_page_x_2) X(LDY_zero_page_x_3) \
+    X(LDY_absolute) X(LDY_absolute_2) X(LDY_absolute_3) \
+    X(LDY_absolute_x) X(LDY_absolute_x_2) X(LDY_absolute_x_3) X(LDY_absolute_x_4) \
+    X(LDY_indirect_x) X(LDY_indirect_x_2) X(LDY_indirect_x_3) X(LDY_indirect_x_4) X(LDY_indirect_x_5) \
+    X(LDY_indirect_y) X(LDY_indirect_y_2) X(LDY_indirect_y_3) X(LDY_indirect_y_4) X(LDY_indirect_y_5) \
+ \
+    X(LSR_accumulator) \
+    X(LSR_zero_page) X(LSR_zero_page_2) X(LSR_zero_page_3) X(LSR_zero_page_4) \
+    X(LSR_zero_page_x) X(LSR_zero_page_x_2) X(LSR_zero_page_x_3) X(LSR_zero_page_x_4) X(LSR_zero_page_x_5) \
+    X(LSR_absolute) X(LSR_absolute_2) X(LSR_absolute_3) X(LSR_absolute_4) X(LSR_absolute_5) \
+    X(LSR_absolute_x) X(LSR_absolute_x_2) X(LSR_absolute_x_3) X(LSR_absolute_x_4) X(LSR_absolute_x_5) X(LSR_absolute_x_6) \
+    X(LSR_absolute_y) X(LSR_absolute_y_2) X(LSR_absolute_y_3) X(LSR_absolute_y_4) X(LSR_absolute_y_5) X(LSR_absolute_y_6) \
+    X(LSR_indirect_x) X(LSR_indirect_x_2) X(LSR_indirect_x_3) X(LSR_indirect_x_4) X(LSR_indirect_x_5) X(LSR_indirect_x_6) X(LSR_indirect_x_7) \
+    X(LSR_indirect_y) X(LSR_indirect_y_2) X(LSR_indirect_y_3) X(LSR_indirect_y_4) X(LSR_indirect_y_5) X(LSR_indirect_y_6) X(LSR_indirect_y_7) \
+ \
+    X(NOP) \
+    X(NOP_immediate) \
+    X(NOP_zero_page) X(NOP_zero_page_2) \
+    X(NOP_zero_page_x) X(NOP_zero_page_x_2) X(NOP_zero_page_x_3) \
+    X(NOP_absolute) X(NOP_absolute_2) X(NOP_absolute_3) \
+    X(NOP_absolute_x) X(NOP_absolute_x_2) X(NOP_absolute_x_3) X(NOP_absolute_x_4) \
+ \
+    X(ORA_immediate) \
+    X(ORA_zero_page) X(ORA_zero_page_2) \
+    X(ORA_zero_page_x) X(ORA_zero_page_x_2) X(ORA_zero_page_x_3) \
+    X(ORA_absolute) X(ORA_absolute_2) X(ORA_absolute_3) \
+    X(ORA_absolute_x) X(ORA_absolute_x_2) X(ORA_absolute_x_3) X(ORA_absolute_x_4) \
+    X(ORA_absolute_y) X(ORA_absolute_y_2) X(ORA_absolute_y_3) X(ORA_absolute_y_4) \
+    X(ORA_indirect_x) X(ORA_indirect_x_2) X(ORA_indirect_x_3) X(ORA_indirect_x_4) X(ORA_indirect_x_5) \
+    X(ORA_indirect_y) X(ORA_indirect_y_2) X(ORA_indirect_y_3) X(ORA_indirect_y_4) X(ORA_indirect_y_5) \
+ \
+    X(PHA) X(PHA_2) \
+    X(PHP) X(PHP_2) \
+    X(PLA) X(PLA_2) X(PLA_3) \
+    X(PLP) X(PLP_2) X(PLP_3) \
+ \
+    X(ROL_accumulator) \
+    X(ROL_zero_page) X(ROL_zero_page_2) X(ROL_zero_page_3) X(ROL_zero_page_4) \
+    X(ROL_zero_page_x) X(ROL_zero_page_x_2) X(ROL_zero_page_x_3) X(ROL_zero_page_x_4) X(ROL_zero_page_x_5) \
+    X(ROL_absolute) X(ROL_absolute_2) X(ROL_absolute_3) X(ROL_absolute_4) X(ROL_absolute_5) \
+    X(ROL_absolute_x) X(ROL_absolute_x_2) X(ROL_absolute_x_3) X(ROL_absolute_x_4) X(ROL_absolute_x_5) X(ROL_absolute_x_6) \
+    X(ROL_indirect_x) X(ROL_indirect_x_2) X(ROL_indirect_x_3) X(ROL_indirect_x_4) X(ROL_indirect_x_5) X(ROL_indirect_x_6) X(ROL_indirect_x_7) \
+ \
+    X(ROR_accumulator) \
+    X(ROR_zero_page) X(ROR_zero_page_2) X(ROR_zero_page_3) X(ROR_zero_page_4) \
+    X(ROR_zero_page_x) X(ROR_zero_page_x_2) X(ROR_zero_page_x_3) X(ROR_zero_page_x_4) X(ROR_zero_page_x_5) \
+    X(ROR_absolute) X(ROR_absolute_2) X(ROR_absolute_3) X(ROR_absolute_4) X(ROR_absolute_5) \
+    X(ROR_absolute_x) X(ROR_absolute_x_2) X(ROR_absolute_x_3) X(ROR_absolute_x_4) X(ROR_absolute_x_5) X(ROR_absolute_x_6) \
+    X(ROR_indirect_x) X(ROR_indirect_x_2) X(ROR_indirect_x_3) X(ROR_indirect_x_4) X(ROR_indirect_x_5) X(ROR_indirect_x_6) X(ROR_indirect_x_7) \
+ \
+    X(RTI) X(RTI_2) X(RTI_3) X(RTI_4) X(RTI_5) \
+    X(RTS) X(RTS_2) X(RTS_3) X(RTS_4) X(RTS_5) \
+ \
+    X(SBC_immediate) \
+    X(SBC_zero_page) X(SBC_zero_page_2) \
+    X(SBC_zero_page_x) X(SBC_zero_page_x_2) X(SBC_zero_page_x_3) \
+    X(SBC_absolute) X(SBC_absolute_2) X(SBC_absolute_3) \
+    X(SBC_absolute_x) X(SBC_absolute_x_2) X(SBC_absolute_x_3) X(SBC_absolute_x_4) \
+    X(SBC_absolute_y) X(SBC_absolute_y_2) X(SBC_absolute_y_3) X(SBC_absolute_y_4) \
+    X(SBC_indirect_x) X(SBC_indirect_x_2) X(SBC_indirect_x_3) X(SBC_indirect_x_4) X(SBC_indirect_x_5) \
+    X(SBC_indirect_y) X(SBC_indirect_y_2) X(SBC_indirect_y_3) X(SBC_indirect_y_4) X(SBC_indirect_y_5) \
+ \
+    X(SEC) \
+    X(SED) \
+    X(SEI) \
+ \
+    X(STA_zero_page) X(STA_zero_page_2) \
+    X(STA_zero_page_x) X(STA_zero_page_x_2) X(STA_zero_page_x_3) \
+    X(STA_absolute) X(STA_absolute_2) X(STA_absolute_3) \
+    X(STA_absolute_x) X(STA_absolute_x_2) X(STA_absolute_x_3) X(STA_absolute_x_4) \
+    X(STA_absolute_y) X(STA_absolute_y_2) X(STA_absolute_y_3) X(STA_absolute_y_4) \
+    X(STA_indirect_x) X(STA_indirect_x_2) X(STA_indirect_x_3) X(STA_indirect_x_4) X(STA_indirect_x_5) \
+    X(STA_indirect_y) X(STA_indirect_y_2) X(STA_indirect_y_3) X(STA_indirect_y_4) X(STA_indirect_y_5) \
+ \
+    X(STX_zero_page) X(STX_zero_page_2) \
+    X(STX_zero_page_y) X(STX_zero_page_y_2) X(STX_zero_page_y_3) \
+    X(STX_absolute) X(STX_absolute_2) X(STX_absolute_3) \
+ \
+    X(STY_zero_page) X(STY_zero_page_2) \
+    X(STY_zero_page_x) X(STY_zero_page_x_2) X(STY_zero_page_x_3) \
+    X(STY_absolute) X(STY_absolute_2) X(STY_absolute_3) \
+ \
+    X(TAX) \
+    X(TAY) \
+    X(TSX) \
+    X(TXA) \
+    X(TXS) \
+    X(TYA) \
+ \
+    X(ALR_immediate) \
+    X(ANC_immediate) \
+    X(ANE_immediate) \
+    X(ARR_immediate) \
+    X(AXS_immediate) \
+ \
+    X(DCP_zero_page) X(DCP_zero_page_2) X(DCP_zero_page_3) X(DCP_zero_page_4) \
+    X(DCP_zero_page_x) X(DCP_zero_page_x_2) X(DCP_zero_page_x_3) X(DCP_zero_page_x_4) X(DCP_zero_page_x_5) \
+    X(DCP_absolute) X(DCP_absolute_2) X(DCP_absolute_3) X(DCP_absolute_4) X(DCP_absolute_5) \
+    X(DCP_absolute_x) X(DCP_absolute_x_2) X(DCP_absolute_x_3) X(DCP_absolute_x_4) X(DCP_absolute_x_5) X(DCP_absolute_x_6) \
+    X(DCP_absolute_y) X(DCP_absolute_y_2) X(DCP_absolute_y_3) X(DCP_absolute_y_4) X(DCP_absolute_y_5) X(DCP_absolute_y_6) \
+    X(DCP_indirect_x) X(DCP_indirect_x_2) X(DCP_indirect_x_3) X(DCP_indirect_x_4) X(DCP_indirect_x_5) X(DCP_indirect_x_6) X(DCP_indirect_x_7) \
+    X(DCP_indirect_y) X(DCP_indirect_y_2) X(DCP_indirect_y_3) X(DCP_indirect_y_4) X(DCP_indirect_y_5) X(DCP_indirect_y_6) X(DCP_indirect_y_7) \
+ \
+    X(ISC_zero_page) X(ISC_zero_page_2) X(ISC_zero_page_3) X(ISC_zero_page_4) \
+    X(ISC_zero_page_x) X(ISC_zero_page_x_2) X(ISC_zero_page_x_3) X(ISC_zero_page_x_4) X(ISC_zero_page_x_5) \
+    X(ISC_absolute) X(ISC_absolute_2) X(ISC_absolute_3) X(ISC_absolute_4) X(ISC_absolute_5) \
+    X(ISC_absolute_x) X(ISC_absolute_x_2) X(ISC_absolute_x_3) X(ISC_absolute_x_4) X(ISC_absolute_x_5) X(ISC_absolute_x_6) \
+    X(ISC_absolute_y) X(ISC_absolute_y_2) X(ISC_absolute_y_3) X(ISC_absolute_y_4) X(ISC_absolute_y_5) X(ISC_absolute_y_6) \
+    X(ISC_indirect_x) X(ISC_indirect_x_2) X(ISC_indirect_x_3) X(ISC_indirect_x_4) X(ISC_indirect_x_5) X(ISC_indirect_x_6) X(ISC_indirect_x_7) \
+    X(ISC_indirect_y) X(ISC_indirect_y_2) X(ISC_indirect_y_3) X(ISC_indirect_y_4) X(ISC_indirect_y_5) X(ISC_indirect_y_6) X(ISC_indirect_y_7) \
+ \
+    X(LAS_absolute_y) X(LAS_absolute_y_2) X(LAS_absolute_y_3) X(LAS_absolute_y_4) \
+ \
+    X(LAX_zero_page) X(LAX_zero_page_2) \
+    X(LAX_zero_page_y) X(LAX_zero_page_y_2) X(LAX_zero_page_y_3) \
+    X(LAX_absolute) X(LAX_absolute_2) X(LAX_absolute_3) \
+    X(LAX_absolute_y) X(LAX_absolute_y_2) X(LAX_absolute_y_3) X(LAX_absolute_y_4) \
+    X(LAX_indirect_x) X(LAX_indirect_x_2) X(LAX_indirect_x_3) X(LAX_indirect_x_4) X(LAX_indirect_x_5) \
+    X(LAX_indirect_y) X(LAX_indirect_y_2) X(LAX_indirect_y_3) X(LAX_indirect_y_4) X(LAX_indirect_y_5) \
+ \
+    X(LXA_immediate) \
+ \
+    X(RLA_zero_page) X(RLA_zero_page_2) X(RLA_zero_page_3) X(RLA_zero_page_4) \
+    X(RLA_zero_page_x) X(RLA_zero_page_x_2) X(RLA_zero_page_x_3) X(RLA_zero_page_x_4) X(RLA_zero_page_x_5) \
+    X(RLA_absolute) X(RLA_absolute_2) X(RLA_absolute_3) X(RLA_absolute_4) X(RLA_absolute_5) \
+    X(RLA_absolute_x) X(RLA_absolute_x_2) X(RLA_absolute_x_3) X(RLA_absolute_x_4) X(RLA_absolute_x_5) X(RLA_absolute_x_6) \
+    X(RLA_absolute_y) X(RLA_absolute_y_2) X(RLA_absolute_y_3) X(RLA_absolute_y_4) X(RLA_absolute_y_5) X(RLA_absolute_y_6) \
+    X(RLA_indirect_x) X(RLA_indirect_x_2) X(RLA_indirect_x_3) X(RLA_indirect_x_4) X(RLA_indirect_x_5) X(RLA_indirect_x_6) X(RLA_indirect_x_7) \
+    X(RLA_indirect_y) X(RLA_indirect_y_2) X(RLA_indirect_y_3) X(RLA_indirect_y_4) X(RLA_indirect_y_5) X(RLA_indirect_y_6) X(RLA_indirect_y_7) \
+ \
+    X(RRA_zero_page) X(RRA_zero_page_2) X(RRA_zero_page_3) X(RRA_zero_page_4) \
+    X(RRA_zero_page_x) X(RRA_zero_page_x_2) X(RRA_zero_page_x_3) X(RRA_zero_page_x_4) X(RRA_zero_page_x_5) \
+    X(RRA_absolute) X(RRA_absolute_2) X(RRA_absolute_3) X(RRA_absolute_4) X(RRA_absolute_5) \
+    X(RRA_absolute_x) X(RRA_absolute_x_2) X(RRA_absolute_x_3) X(RRA_absolute_x_4) X(RRA_absolute_x_5) X(RRA_absolute_x_6) \
+    X(RRA_absolute_y) X(RRA_absolute_y_2) X(RRA_absolute_y_3) X(RRA_absolute_y_4) X(RRA_absolute_y_5) X(RRA_absolute_y_6) \
+    X(RRA_indirect_x) X(RRA_indirect_x_2) X(RRA_indirect_x_3) X(RRA_indirect_x_4) X(RRA_indirect_x_5) X(RRA_indirect_x_6) X(RRA_indirect_x_7) \
+    X(RRA_indirect_y) X(RRA_indirect_y_2) X(RRA_indirect_y_3) X(RRA_indirect_y_4) X(RRA_indirect_y_5) X(RRA_indirect_y_6) X(RRA_indirect_y_7) \
+ \
+    X(SAX_zero_page) X(SAX_zero_page_2) \
+    X(SAX_zero_page_y) X(SAX_zero_page_y_2) X(SAX_zero_page_y_3) \
+    X(SAX_absolute) X(SAX_absolute_2) X(SAX_absolute_3) \
+    X(SAX_indirect_x) X(SAX_indirect_x_2) X(SAX_indirect_x_3) X(SAX_indirect_x_4) X(SAX_indirect_x_5) \
+ \
+    X(SHA_indirect_y) X(SHA_indirect_y_2) X(SHA_indirect_y_3) X(SHA_indirect_y_4) X(SHA_indirect_y_5) \
+    X(SHA_absolute_y) X(SHA_absolute_y_2) X(SHA_absolute_y_3) X(SHA_absolute_y_4) \
+ \
+    X(SHX_absolute_y) X(SHX_absolute_y_2) X(SHX_absolute_y_3) X(SHX_absolute_y_4) \
+    X(SHY_absolute_x) X(SHY_absolute_x_2) X(SHY_absolute_x_3) X(SHY_absolute_x_4) \
+ \
+    X(SLO_zero_page) X(SLO_zero_page_2) X(SLO_zero_page_3) X(SLO_zero_page_4) \
+    X(SLO_zero_page_x) X(SLO_zero_page_x_2) X(SLO_zero_page_x_3) X(SLO_zero_page_x_4) X(SLO_zero_page_x_5) \
+    X(SLO_absolute) X(SLO_absolute_2) X(SLO_absolute_3) X(SLO_absolute_4) X(SLO_absolute_5) \
+    X(SLO_absolute_x) X(SLO_absolute_x_2) X(SLO_absolute_x_3) X(SLO_absolute_x_4) X(SLO_absolute_x_5) X(SLO_absolute_x_6) \
+    X(SLO_absolute_y) X(SLO_absolute_y_2) X(SLO_absolute_y_3) X(SLO_absolute_y_4) X(SLO_absolute_y_5) X(SLO_absolute_y_6) \
+    X(SLO_indirect_x) X(SLO_indirect_x_2) X(SLO_indirect_x_3) X(SLO_indirect_x_4) X(SLO_indirect_x_5) X(SLO_indirect_x_6) X(SLO_indirect_x_7) \
+    X(SLO_indirect_y) X(SLO_indirect_y_2) X(SLO_indirect_y_3) X(SLO_indirect_y_4) X(SLO_indirect_y_5) X(SLO_indirect_y_6) X(SLO_indirect_y_7) \
+ \
+    X(SRE_zero_page) X(SRE_zero_page_2) X(SRE_zero_page_3) X(SRE_zero_page_4) \
+    X(SRE_zero_page_x) X(SRE_zero_page_x_2) X(SRE_zero_page_x_3) X(SRE_zero_page_x_4) X(SRE_zero_page_x_5) \
+    X(SRE_absolute) X(SRE_absolute_2) X(SRE_absolute_3) X(SRE_absolute_4) X(SRE_absolute_5) \
+    X(SRE_absolute_x) X(SRE_absolute_x_2) X(SRE_absolute_x_3) X(SRE_absolute_x_4) X(SRE_absolute_x_5) X(SRE_absolute_x_6) \
+    X(SRE_absolute_y) X(SRE_absolute_y_2) X(SRE_absolute_y_3) X(SRE_absolute_y_4) X(SRE_absolute_y_5) X(SRE_absolute_y_6) \
+    X(SRE_indirect_x) X(SRE_indirect_x_2) X(SRE_indirect_x_3) X(SRE_indirect_x_4) X(SRE_indirect_x_5) X(SRE_indirect_x_6) X(SRE_indirect_x_7) \
+    X(SRE_indirect_y) X(SRE_indirect_y_2) X(SRE_indirect_y_3) X(SRE_indirect_y_4) X(SRE_indirect_y_5) X(SRE_indirect_y_6) X(SRE_indirect_y_7) \
+ \
+    X(TAS_absolute_y) X(TAS_absolute_y_2) X(TAS_absolute_y_3) X(TAS_absolute_y_4) \
+ \
+    X(fastPathWriteBack) \
+ \
+    X(fastPathExecute) X(translatedBlockDone)
+
+#endif
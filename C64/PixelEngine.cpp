@@ -20,6 +20,10 @@
 
 #include "C64.h"
 
+#if defined(__i386__) || defined(__x86_64__)
+#include <tmmintrin.h>
+#endif
+
 // DIRK DEBUG, REMOVE ASAP
 extern unsigned dirktrace;
 extern unsigned dirkcnt;
@@ -31,9 +35,44 @@ PixelEngine::PixelEngine() // C64 *c64)
     
     debug(3, "  Creating PixelEngine at address %p...\n", this);
     
-    currentScreenBuffer = screenBuffer1[0];
-    pixelBuffer = currentScreenBuffer;
+    backBuffer = 0;
+    middleBuffer = 1;
+    frontBuffer = 2;
+    completedBuffer = 1;
+    completedFrames = 0;
+    memset(indexBufferFrameNr, 0, sizeof(indexBufferFrameNr));
+    memset(lineHash, 0, sizeof(lineHash));
+    rgbaGeneration = 0;
+    memset(rgbaLineGeneration, 0, sizeof(rgbaLineGeneration));
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_cpu_init();
+    ssse3 = __builtin_cpu_supports("ssse3");
+#else
+    ssse3 = false;
+#endif
+    pixelBuffer = indexBuffer[backBuffer][0];
+    rgbaFrameNr = UINT64_MAX;
     bufferoffset = 0;
+    warpFrameInterval = 1;
+    renderFrame = true;
+    
+    // Setup expansion tables for drawEightCanvasPixels()
+    for (unsigned data = 0; data < 256; data++) {
+        
+        uint8_t sc[8], mc[4][8];
+        for (unsigned i = 0; i < 8; i++) {
+            
+            uint8_t bit = (data >> (7 - i)) & 0x01;
+            uint8_t two_bits = (data >> (6 - (i & 0x06))) & 0x03;
+            
+            sc[i] = bit ? 0xFF : 0x00;
+            for (unsigned bits = 0; bits < 4; bits++)
+                mc[bits][i] = (two_bits == bits) ? 0xFF : 0x00;
+        }
+        memcpy(&singleColorMask[data], sc, 8);
+        for (unsigned bits = 0; bits < 4; bits++)
+            memcpy(&multiColorMask[bits][data], mc[bits], 8);
+    }
     
     // Register snapshot items
     SnapshotItem items[] = {
@@ -84,15 +123,147 @@ PixelEngine::resetScreenBuffers()
 {
     for (unsigned line = 0; line < PAL_RASTERLINES; line++) {
         for (unsigned i = 0; i < NTSC_PIXELS; i++) {
-            screenBuffer1[line][i] = screenBuffer2[line][i] = (line % 2) ? colors[8] : colors[9];
+            for (unsigned nr = 0; nr < 3; nr++)
+                indexBuffer[nr][line][i] = (line % 2) ? LTBROWN : BROWN;
+        }
+        for (unsigned nr = 0; nr < 3; nr++)
+            lineHash[nr][line] = hashLine(indexBuffer[nr][line]);
+    }
+    rgbaFrameNr = UINT64_MAX;
+}
+
+uint64_t
+PixelEngine::hashLine(const uint8_t *line)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    uint64_t chunk;
+    unsigned i;
+    
+    // Each step is invertible, so a single changed chunk always changes the hash value
+    for (i = 0; i + 8 <= NTSC_PIXELS; i += 8) {
+        memcpy(&chunk, line + i, 8);
+        hash = (hash ^ chunk) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 32;
+    }
+    for (; i < NTSC_PIXELS; i++) {
+        hash = (hash ^ line[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+uint8_t *
+PixelEngine::indexScreenBuffer()
+{
+    // Pick up the latest frame if the emulator thread has completed a new one
+    if (middleBuffer.load(std::memory_order_relaxed) & 0x80) {
+        frontBuffer = middleBuffer.exchange(frontBuffer, std::memory_order_acq_rel) & 0x03;
+    }
+    return indexBuffer[frontBuffer][0];
+}
+
+void *
+PixelEngine::screenBuffer()
+{
+    uint8_t *indices = indexScreenBuffer();
+    uint64_t frameNr = indexBufferFrameNr[frontBuffer];
+    const uint64_t *hashes = lineHash[frontBuffer];
+    bool all = (rgbaFrameNr == UINT64_MAX);
+    
+    if (rgbaFrameNr == frameNr)
+        return rgbaBuffer[0];
+    
+    rgbaGeneration++;
+    
+    // Translate all changed lines to RGBA (consecutive lines are translated in one go)
+    for (unsigned first = 0, last; first < PAL_RASTERLINES; first = last) {
+        
+        last = first + 1;
+        if (!all && hashes[first] == rgbaLineHash[first])
+            continue;
+        
+        while (last < PAL_RASTERLINES && (all || hashes[last] != rgbaLineHash[last]))
+            last++;
+        
+        translateToRGBA(indices + first * NTSC_PIXELS, rgbaBuffer[first], (last - first) * NTSC_PIXELS);
+        for (unsigned line = first; line < last; line++) {
+            rgbaLineHash[line] = hashes[line];
+            rgbaLineGeneration[line] = rgbaGeneration;
         }
     }
+    
+    rgbaFrameNr = frameNr;
+    return rgbaBuffer[0];
 }
 
+void
+PixelEngine::translateToRGBA(const uint8_t *src, uint32_t *dst, size_t count)
+{
+#if defined(__i386__) || defined(__x86_64__)
+    if (ssse3) {
+        translateToRGBASSSE3(src, dst, count);
+        return;
+    }
+#endif
+    translateToRGBAScalar(src, dst, count);
+}
+
+void
+PixelEngine::translateToRGBAScalar(const uint8_t *src, uint32_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = colors[src[i] & 0x0F];
+    }
+}
+
+#if defined(__i386__) || defined(__x86_64__)
+
+__attribute__((target("ssse3"))) void
+PixelEngine::translateToRGBASSSE3(const uint8_t *src, uint32_t *dst, size_t count)
+{
+    size_t i = 0;
+    
+    // Split the palette into four byte planes and look up 16 pixels per shuffle
+    uint8_t plane[4][16];
+    for (unsigned c = 0; c < 16; c++) {
+        for (unsigned b = 0; b < 4; b++) {
+            plane[b][c] = (uint8_t)(colors[c] >> (8 * b));
+        }
+    }
+    __m128i p0 = _mm_loadu_si128((const __m128i *)plane[0]);
+    __m128i p1 = _mm_loadu_si128((const __m128i *)plane[1]);
+    __m128i p2 = _mm_loadu_si128((const __m128i *)plane[2]);
+    __m128i p3 = _mm_loadu_si128((const __m128i *)plane[3]);
+    __m128i mask = _mm_set1_epi8(0x0F);
+    
+    for (; i + 16 <= count; i += 16) {
+        
+        __m128i idx = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + i)), mask);
+        __m128i b0 = _mm_shuffle_epi8(p0, idx);
+        __m128i b1 = _mm_shuffle_epi8(p1, idx);
+        __m128i b2 = _mm_shuffle_epi8(p2, idx);
+        __m128i b3 = _mm_shuffle_epi8(p3, idx);
+        __m128i lo01 = _mm_unpacklo_epi8(b0, b1), hi01 = _mm_unpackhi_epi8(b0, b1);
+        __m128i lo23 = _mm_unpacklo_epi8(b2, b3), hi23 = _mm_unpackhi_epi8(b2, b3);
+        _mm_storeu_si128((__m128i *)(dst + i),      _mm_unpacklo_epi16(lo01, lo23));
+        _mm_storeu_si128((__m128i *)(dst + i + 4),  _mm_unpackhi_epi16(lo01, lo23));
+        _mm_storeu_si128((__m128i *)(dst + i + 8),  _mm_unpacklo_epi16(hi01, hi23));
+        _mm_storeu_si128((__m128i *)(dst + i + 12), _mm_unpackhi_epi16(hi01, hi23));
+    }
+    
+    // Translate the remaining pixels one by one
+    translateToRGBAScalar(src + i, dst + i, count - i);
+}
+
+#endif
+
 void
 PixelEngine::beginFrame()
 {
     visibleColumn = false;
+    
+    // Decide whether pixels are synthesized in this frame
+    renderFrame = !c64->getWarp() ||
+    (warpFrameInterval != 0 && c64->getFrame() % warpFrameInterval == 0);
 }
 
 void
@@ -119,11 +290,6 @@ PixelEngine::beginRasterline()
         // sprite_sr[i].mcol_bits = sprite_sr[i].scol_bit = 0;
         sprite_sr[i].col_bits = 0;
     }
-    
-    // Clear pixel buffer (has same size as pixelSource and zBuffer)
-    // FOR DEBUGGING ONLY, 0xBB is a randomly chose debug color
-    if (!vic->vblank)
-        memset(pixelBuffer, 0xBB, sizeof(pixelSource));
 }
 
 void
@@ -131,8 +297,15 @@ PixelEngine::endRasterline()
 {
     if (!vic->vblank) {
         
-        // Make the border look nice
-        expandBorders();
+        if (renderFrame) {
+            
+            // Make the border look nice
+            expandBorders();
+            
+            // Remember the line's hash value for dirty line tracking
+            unsigned line = (unsigned)(pixelBuffer - indexBuffer[backBuffer][0]) / NTSC_PIXELS;
+            lineHash[backBuffer][line] = hashLine(pixelBuffer);
+        }
         
         // Advance pixelBuffer
         uint16_t nextline = c64->getRasterline() - PAL_UPPER_VBLANK + 1;
@@ -143,7 +316,7 @@ PixelEngine::endRasterline()
             // pxbuf += NTSC_PIXELS;
             
             // New code (slightly slower, but foolproof. Can't get outside the screen buffer)
-            pixelBuffer = currentScreenBuffer + (nextline * NTSC_PIXELS);
+            pixelBuffer = indexBuffer[backBuffer][nextline];
             // pxbuf = pixelBuffer + bufshift;
             
         }
@@ -153,9 +326,17 @@ PixelEngine::endRasterline()
 void
 PixelEngine::endFrame()
 {
-    // Switch active screen buffer
-    currentScreenBuffer = (currentScreenBuffer == screenBuffer1[0]) ? screenBuffer2[0] : screenBuffer1[0];
-    pixelBuffer = currentScreenBuffer;    
+    // Hand over the completed frame (a skipped frame leaves the stable buffer untouched)
+    if (renderFrame) {
+        indexBufferFrameNr[backBuffer] = ++completedFrames;
+        completedBuffer = backBuffer;
+        backBuffer = middleBuffer.exchange(backBuffer | 0x80, std::memory_order_acq_rel) & 0x03;
+
+        // Record frame
+        if (c64->recorder.isRecording())
+            c64->recorder.addFrame(indexBuffer[completedBuffer][0], colors, c64->getCycles());
+    }
+    pixelBuffer = indexBuffer[backBuffer][0];
 }
 
 // -----------------------------------------------------------------------------------------------
@@ -179,8 +360,13 @@ PixelEngine::draw()
     if (vic->vblank)
         return;
         
-    drawCanvas();
-    drawBorder();
+    if (renderFrame) {
+        drawCanvas();
+        drawBorder();
+    } else {
+        skipCanvas();
+        skipBorder();
+    }
     drawSprites();
     
     bufferoffset += 8;
@@ -192,8 +378,13 @@ PixelEngine::draw17()
     if (vic->vblank)
         return;
     
-    drawCanvas();
-    drawBorder17();
+    if (renderFrame) {
+        drawCanvas();
+        drawBorder17();
+    } else {
+        skipCanvas();
+        skipBorder17();
+    }
     drawSprites();
     
     bufferoffset += 8;
@@ -205,8 +396,13 @@ PixelEngine::draw55()
     if (vic->vblank)
         return;
     
-    drawCanvas();
-    drawBorder55();
+    if (renderFrame) {
+        drawCanvas();
+        drawBorder55();
+    } else {
+        skipCanvas();
+        skipBorder55();
+    }
     drawSprites();
     
     bufferoffset += 8;
@@ -226,19 +422,19 @@ PixelEngine::drawBorder()
 {
     if (pipe.mainFrameFF) {
         
-        setFramePixel(0, colors[bpipe.borderColor]);
+        setFramePixel(0, bpipe.borderColor);
         
         // After the first pixel has been drawn, color register changes show up
         bpipe = vic->bp;
         
-        int rgba = colors[bpipe.borderColor];
-        setFramePixel(1, rgba);
-        setFramePixel(2, rgba);
-        setFramePixel(3, rgba);
-        setFramePixel(4, rgba);
-        setFramePixel(5, rgba);
-        setFramePixel(6, rgba);
-        setFramePixel(7, rgba);
+        uint8_t color = bpipe.borderColor;
+        setFramePixel(1, color);
+        setFramePixel(2, color);
+        setFramePixel(3, color);
+        setFramePixel(4, color);
+        setFramePixel(5, color);
+        setFramePixel(6, color);
+        setFramePixel(7, color);
     }
 }
 
@@ -248,18 +444,18 @@ PixelEngine::drawBorder17()
     if (pipe.mainFrameFF && !vic->p.mainFrameFF) {
         
         // 38 column mode
-        setFramePixel(0, colors[bpipe.borderColor]);
+        setFramePixel(0, bpipe.borderColor);
         
         // After the first pixel has been drawn, color register changes show up
         bpipe = vic->bp;
         
-        int rgba = colors[bpipe.borderColor];
-        setFramePixel(1, rgba);
-        setFramePixel(2, rgba);
-        setFramePixel(3, rgba);
-        setFramePixel(4, rgba);
-        setFramePixel(5, rgba);
-        setFramePixel(6, rgba);
+        uint8_t color = bpipe.borderColor;
+        setFramePixel(1, color);
+        setFramePixel(2, color);
+        setFramePixel(3, color);
+        setFramePixel(4, color);
+        setFramePixel(5, color);
+        setFramePixel(6, color);
         // That's all, we only draw 7 pixels here
         
     } else {
@@ -275,7 +471,7 @@ PixelEngine::drawBorder55()
     if (!pipe.mainFrameFF && vic->p.mainFrameFF) {
         
         // 38 column mode
-        setFramePixel(7, colors[bpipe.borderColor]);
+        setFramePixel(7, bpipe.borderColor);
         
     } else {
         
@@ -298,6 +494,13 @@ PixelEngine::drawCanvas()
         uint8_t D011 = vic->p.registerCTRL1 & 0x60; // -xx- ----
         uint8_t D016 = vic->p.registerCTRL2 & 0x10; // ---x ----
         
+        // Take the fast path if nothing changes inside the 8 pixel window
+        if (sr.canLoad && (pipe.registerCTRL2 & 0x07) == 0 && displayMode == (D011 | D016) &&
+            memcmp(&cpipe, &vic->cp, sizeof(cpipe)) == 0) {
+            drawEightCanvasPixels();
+            return;
+        }
+        
         drawCanvasPixel(0);
         
         // After the first pixel has been drawn, color register changes show up
@@ -333,10 +536,10 @@ PixelEngine::drawCanvas()
     } else {
         
         // "... bei gesetztem Flipflop wird die letzte aktuelle Hintergrundfarbe dargestellt."
-        int col = colors[vic->getBackgroundColor()];
+        uint8_t color = vic->getBackgroundColor();
         // The following fix (which was done for border-bm-idle is wrong)
-        // int col = col_rgba[0];
-        setEightBackgroundPixels(col);
+        // uint8_t color = col[0];
+        setEightBackgroundPixels(color);
     }
 }
 
@@ -375,6 +578,157 @@ PixelEngine::drawCanvasPixel(uint8_t pixelnr)
     sr.mc_flop = !sr.mc_flop;
 }
 
+inline void
+PixelEngine::drawEightCanvasPixels()
+{
+    unsigned offset = bufferoffset;
+    assert(offset + 8 <= NTSC_PIXELS);
+    
+    // Load shift register
+    uint8_t data = pipe.g_data;
+    sr.latchedCharacter = pipe.g_character;
+    sr.latchedColor = pipe.g_color;
+    
+    // Load colors
+    loadColors((DisplayMode)displayMode, sr.latchedCharacter, sr.latchedColor);
+    
+    // Render pixels
+    const uint64_t spread = 0x0101010101010101ULL;
+    uint64_t pixels;
+    uint8_t foreground;
+    
+    if (multicol) {
+        pixels =
+        (multiColorMask[0][data] & (col[0] * spread)) |
+        (multiColorMask[1][data] & (col[1] * spread)) |
+        (multiColorMask[2][data] & (col[2] * spread)) |
+        (multiColorMask[3][data] & (col[3] * spread));
+        foreground = (data & 0xAA) | ((data & 0xAA) >> 1);
+        sr.colorbits = data & 0x03;
+    } else {
+        pixels =
+        (singleColorMask[data] & (col[1] * spread)) |
+        (~singleColorMask[data] & (col[0] * spread));
+        foreground = data;
+    }
+    memcpy(pixelBuffer + offset, &pixels, 8);
+    
+    for (unsigned i = 0; i < 8; i++) {
+        if (foreground & (0x80 >> i)) {
+            zBuffer[i] = FOREGROUND_LAYER_DEPTH;
+            pixelSource[i] = 0x80;
+        } else {
+            zBuffer[i] = BACKGROUD_LAYER_DEPTH;
+            pixelSource[i] = 0x00;
+        }
+    }
+    
+    // All bits have been shifted out and the multicolor flipflop has toggled 8 times
+    sr.data = 0;
+    sr.mc_flop = true;
+}
+
+inline void
+PixelEngine::skipBorder()
+{
+    if (pipe.mainFrameFF) {
+        
+        bpipe = vic->bp;
+        for (unsigned i = 0; i < 8; i++)
+            pixelSource[i] &= (~0x80);
+    }
+}
+
+inline void
+PixelEngine::skipBorder17()
+{
+    if (pipe.mainFrameFF && !vic->p.mainFrameFF) {
+        
+        // 38 column mode
+        bpipe = vic->bp;
+        for (unsigned i = 0; i < 7; i++)
+            pixelSource[i] &= (~0x80);
+        
+    } else {
+        
+        // 40 column mode
+        skipBorder();
+    }
+}
+
+inline void
+PixelEngine::skipBorder55()
+{
+    if (!pipe.mainFrameFF && vic->p.mainFrameFF) {
+        
+        // 38 column mode
+        pixelSource[7] &= (~0x80);
+        
+    } else {
+        
+        // 40 column mode
+        skipBorder();
+    }
+}
+
+inline void
+PixelEngine::skipCanvas()
+{
+    // Mirrors drawCanvas(), but without looking up any colors
+    if (!pipe.verticalFrameFF) {
+        
+        uint8_t D011 = vic->p.registerCTRL1 & 0x60; // -xx- ----
+        uint8_t D016 = vic->p.registerCTRL2 & 0x10; // ---x ----
+        
+        skipCanvasPixel(0);
+        cpipe = vic->cp;
+        skipCanvasPixel(1);
+        skipCanvasPixel(2);
+        skipCanvasPixel(3);
+        displayMode |= D016;
+        displayMode &= D016 | 0xEF;
+        displayMode |= D011;
+        skipCanvasPixel(4);
+        skipCanvasPixel(5);
+        displayMode &= D011 | 0x9F;
+        skipCanvasPixel(6);
+        skipCanvasPixel(7);
+        
+    } else {
+        
+        memset(pixelSource, 0x00, sizeof(pixelSource));
+    }
+}
+
+inline void
+PixelEngine::skipCanvasPixel(uint8_t pixelnr)
+{
+    assert(pixelnr < 8);
+    
+    if (pixelnr == (pipe.registerCTRL2 & 0x07) /* horizontal raster scroll */ && sr.canLoad) {
+        
+        sr.data = pipe.g_data;
+        sr.latchedCharacter = pipe.g_character;
+        sr.latchedColor = pipe.g_color;
+        sr.mc_flop = true;
+    }
+    
+    // Same decision as in loadColors(): multicolor bitmap or multicolor text with MC flag set
+    multicol = (displayMode & 0x10) && ((displayMode & 0x20) || (sr.latchedColor & 0x08));
+    
+    // Only the pixel source is recorded (foreground pixels take part in collision detection)
+    if (multicol) {
+        if (sr.mc_flop)
+            sr.colorbits = (sr.data >> 6);
+        pixelSource[pixelnr] = (sr.colorbits & 0x02) ? 0x80 : 0x00;
+    } else {
+        pixelSource[pixelnr] = (sr.data & 0x80) ? 0x80 : 0x00;
+    }
+    
+    sr.data <<= 1;
+    sr.mc_flop = !sr.mc_flop;
+}
+
 
 inline void
 PixelEngine::drawSprites()
@@ -388,46 +742,140 @@ PixelEngine::drawSprites()
     // Update sprite color registers
     spipe = vic->sp;
     
-    // Draw first four pixels for each sprite
+    // The first four pixels are synthesized with the old sprite enable bits, the last four with the new ones
+    uint8_t onOff = dc.spriteOnOff;
+    updateSpriteOnOff();
+    uint8_t onOffNext = dc.spriteOnOff;
+    
+    // Run sprite sequencers and record the opaque pixels of each sprite (bit n corresponds to pixel n)
+    uint8_t opaque[8];
     for (unsigned i = 0; i < 8; i++) {
-        if (GET_BIT(dc.spriteOnOff, i)) {
-
-            bool firstDMAi = GET_BIT(firstDMA, i);
-            bool secondDMAi = GET_BIT(secondDMA, i);
+        
+        opaque[i] = 0;
+        if (!GET_BIT(onOff | onOffNext, i))
+            continue;
+        
+        bool firstDMAi = GET_BIT(firstDMA, i);
+        bool secondDMAi = GET_BIT(secondDMA, i);
+        bool multicol = vic->spriteIsMulticolor(i);
+        uint8_t color[4] = { 0, multicol ? spipe.spriteExtraColor1 : spipe.spriteColor[i],
+                             spipe.spriteColor[i], spipe.spriteExtraColor2 };
+        
+        for (unsigned first = 0; first < 8; first += 4) {
+            
+            if (!GET_BIT(first ? onOffNext : onOff, i))
+                continue;
             
-            drawSpritePixel(i, 0, secondDMAi             /* freeze */, 0          /* halt */, 0         /* load */);
-            drawSpritePixel(i, 1, secondDMAi             /* freeze */, 0          /* halt */, 0         /* load */);
-            drawSpritePixel(i, 2, secondDMAi             /* freeze */, secondDMAi /* halt */, 0         /* load */);
-            drawSpritePixel(i, 3, firstDMAi | secondDMAi /* freeze */, 0          /* halt */, 0         /* load */);
+            if (spriteIsIdle(i, first)) {
+                
+                // Only the halt signal (pixel 2) and the load signal (pixel 4) have an effect
+                if (secondDMAi) {
+                    if (first) {
+                        loadShiftRegister(i);
+                    } else {
+                        sprite_sr[i].remaining_bits = -1;
+                        sprite_sr[i].col_bits = 0;
+                    }
+                }
+                continue;
+            }
+            
+            for (unsigned pixel = first; pixel < first + 4; pixel++) {
+                
+                bool freeze = pixel < 3 ? secondDMAi : pixel < 7 ? (firstDMAi || secondDMAi) : firstDMAi;
+                bool halt = pixel == 2 && secondDMAi;
+                bool load = pixel == 4 && secondDMAi;
+                
+                uint8_t bits = runSpriteSequencer(i, pixel, freeze, halt, load, multicol);
+                if (bits) {
+                    opaque[i] |= (1 << pixel);
+                    spritePixelColor[i][pixel] = color[bits];
+                }
+            }
         }
     }
-
-    updateSpriteOnOff();
     
-    // Draw last four pixels for each sprite
+    // Sprites are only drawn inside the visible area and if sprite drawing is not switched off for debugging
+    if (!visibleColumn || !vic->drawSprites)
+        return;
+    
+    // Determine all pixels that are covered by at least one and by at least two sprites
+    uint8_t covered = 0, overlap = 0;
     for (unsigned i = 0; i < 8; i++) {
-        if (GET_BIT(dc.spriteOnOff, i)) {
-
-            bool firstDMAi = GET_BIT(firstDMA, i);
-            bool secondDMAi = GET_BIT(secondDMA, i);
+        overlap |= covered & opaque[i];
+        covered |= opaque[i];
+    }
+    if (!covered)
+        return;
+    
+    // Check sprite/sprite collision
+    if (overlap && vic->spriteSpriteCollisionEnabled) {
+        uint8_t collision = 0;
+        for (unsigned i = 0; i < 8; i++)
+            if (opaque[i] & overlap) collision |= (1 << i);
+        vic->iomem[0x1E] |= collision;
+        vic->triggerIRQ(4);
+    }
+    
+    // Check sprite/background collision
+    if (vic->spriteBackgroundCollisionEnabled) {
+        uint8_t foreground = 0;
+        for (unsigned pixel = 0; pixel < 8; pixel++)
+            if (pixelSource[pixel] & 0x80) foreground |= (1 << pixel);
+        if (covered & foreground) {
+            uint8_t collision = 0;
+            for (unsigned i = 0; i < 8; i++)
+                if (opaque[i] & foreground) collision |= (1 << i);
+            vic->iomem[0x1F] |= collision;
+            vic->triggerIRQ(2);
+        }
+    }
+    
+    // Draw pixels
+    if (!renderFrame)
+        return;
+    
+    for (unsigned i = 0; i < 8; i++) {
+        if (opaque[i]) {
+            int depth = vic->spriteDepth(i);
+            for (unsigned pixel = 0; pixel < 8; pixel++) {
+                if (opaque[i] & (1 << pixel))
+                    setSpritePixel(pixel, spritePixelColor[i][pixel], depth);
+            }
+        }
+    }
+}
 
-            drawSpritePixel(i, 4, firstDMAi | secondDMAi /* freeze */, 0         /* halt */, secondDMAi /* load */);
-            drawSpritePixel(i, 5, firstDMAi | secondDMAi /* freeze */, 0         /* halt */, 0          /* load */);
-            drawSpritePixel(i, 6, firstDMAi | secondDMAi /* freeze */, 0         /* halt */, 0          /* load */);
-            drawSpritePixel(i, 7, firstDMAi              /* freeze */, 0         /* halt */, 0          /* load */);
+inline bool
+PixelEngine::spriteIsIdle(unsigned spritenr, unsigned pixelnr)
+{
+    assert(spritenr < 8);
+    
+    switch (sprite_sr[spritenr].remaining_bits) {
+            
+        case -1: {
+            
+            // Waiting for the horizontal trigger condition
+            int trigger = (int)pipe.spriteX[spritenr] - (int)pipe.xCounter - (int)pixelnr;
+            return trigger < 0 || trigger > 3;
         }
+        case 0:
+            
+            // All bits shifted out, the last color bits are still visible if they are non zero
+            return (sprite_sr[spritenr].col_bits & 0x03) == 0;
+            
+        default:
+            return false;
     }
 }
 
-void
-PixelEngine::drawSpritePixel(unsigned spritenr, unsigned pixelnr, bool freeze, bool halt, bool load)
+inline uint8_t
+PixelEngine::runSpriteSequencer(unsigned spritenr, unsigned pixelnr, bool freeze, bool halt, bool load, bool multicol)
 {
     assert(spritenr < 8);
     assert(sprite_sr[spritenr].remaining_bits >= -1);
     assert(sprite_sr[spritenr].remaining_bits <= 26);
     
-    bool multicol = vic->spriteIsMulticolor(spritenr);
-
     // Load shift register if applicable
     if (load) {
         loadShiftRegister(spritenr);
@@ -470,13 +918,7 @@ PixelEngine::drawSpritePixel(unsigned spritenr, unsigned pixelnr, bool freeze, b
         }
     }
     
-    // Draw pixel
-    if (visibleColumn && vic->drawSprites) {
-        if (multicol)
-            setMultiColorSpritePixel(spritenr, pixelnr, sprite_sr[spritenr].col_bits & 0x03);
-        else
-            setSingleColorSpritePixel(spritenr, pixelnr, sprite_sr[spritenr].col_bits & 0x01);
-    }
+    return sprite_sr[spritenr].col_bits & (multicol ? 0x03 : 0x01);
 }
 
 // -----------------------------------------------------------------------------------------------
@@ -490,64 +932,64 @@ PixelEngine::loadColors(DisplayMode mode, uint8_t characterSpace, uint8_t colorS
             
         case STANDARD_TEXT:
             
-            col_rgba[0] = colors[cpipe.backgroundColor[0]];
-            col_rgba[1] = colors[colorSpace];
+            col[0] = cpipe.backgroundColor[0];
+            col[1] = colorSpace;
             multicol = false;
             break;
             
         case MULTICOLOR_TEXT:
             if (colorSpace & 0x8 /* MC flag */) {
-                col_rgba[0] = colors[cpipe.backgroundColor[0]];
-                col_rgba[1] = colors[cpipe.backgroundColor[1]];
-                col_rgba[2] = colors[cpipe.backgroundColor[2]];
-                col_rgba[3] = colors[colorSpace & 0x07];
+                col[0] = cpipe.backgroundColor[0];
+                col[1] = cpipe.backgroundColor[1];
+                col[2] = cpipe.backgroundColor[2];
+                col[3] = colorSpace & 0x07;
                 multicol = true;
             } else {
-                col_rgba[0] = colors[cpipe.backgroundColor[0]];
-                col_rgba[1] = colors[colorSpace];
+                col[0] = cpipe.backgroundColor[0];
+                col[1] = colorSpace;
                 multicol = false;
             }
             break;
             
         case STANDARD_BITMAP:
-            col_rgba[0] = colors[characterSpace & 0x0F]; // color of '0' pixels
-            col_rgba[1] = colors[characterSpace >> 4]; // color of '1' pixels
+            col[0] = characterSpace & 0x0F; // color of '0' pixels
+            col[1] = characterSpace >> 4; // color of '1' pixels
             multicol = false;
             break;
             
         case MULTICOLOR_BITMAP:
-            col_rgba[0] = colors[cpipe.backgroundColor[0]];
-            col_rgba[1] = colors[characterSpace >> 4];
-            col_rgba[2] = colors[characterSpace & 0x0F];
-            col_rgba[3] = colors[colorSpace];
+            col[0] = cpipe.backgroundColor[0];
+            col[1] = characterSpace >> 4;
+            col[2] = characterSpace & 0x0F;
+            col[3] = colorSpace;
             multicol = true;
             break;
             
         case EXTENDED_BACKGROUND_COLOR:
-            col_rgba[0] = colors[cpipe.backgroundColor[characterSpace >> 6]];
-            col_rgba[1] = colors[colorSpace];
+            col[0] = cpipe.backgroundColor[characterSpace >> 6];
+            col[1] = colorSpace;
             multicol = false;
             break;
             
         case INVALID_TEXT:
-            col_rgba[0] = colors[PixelEngine::BLACK];
-            col_rgba[1] = colors[PixelEngine::BLACK];
-            col_rgba[2] = colors[PixelEngine::BLACK];
-            col_rgba[3] = colors[PixelEngine::BLACK];
+            col[0] = PixelEngine::BLACK;
+            col[1] = PixelEngine::BLACK;
+            col[2] = PixelEngine::BLACK;
+            col[3] = PixelEngine::BLACK;
             multicol = (colorSpace & 0x8 /* MC flag */);
             break;
             
         case INVALID_STANDARD_BITMAP:
-            col_rgba[0] = colors[PixelEngine::BLACK];
-            col_rgba[1] = colors[PixelEngine::BLACK];
+            col[0] = PixelEngine::BLACK;
+            col[1] = PixelEngine::BLACK;
             multicol = false;
             break;
             
         case INVALID_MULTICOLOR_BITMAP:
-            col_rgba[0] = colors[PixelEngine::BLACK];
-            col_rgba[1] = colors[PixelEngine::BLACK];
-            col_rgba[2] = colors[PixelEngine::BLACK];
-            col_rgba[3] = colors[PixelEngine::BLACK];
+            col[0] = PixelEngine::BLACK;
+            col[1] = PixelEngine::BLACK;
+            col[2] = PixelEngine::BLACK;
+            col[3] = PixelEngine::BLACK;
             multicol = true;
             break;
             
@@ -560,99 +1002,42 @@ PixelEngine::loadColors(DisplayMode mode, uint8_t characterSpace, uint8_t colorS
 inline void
 PixelEngine::setSingleColorPixel(unsigned pixelnr, uint8_t bit /* valid: 0, 1 */)
 {
-    int rgba = col_rgba[bit];
+    uint8_t color = col[bit];
     
     if (bit)
-        setForegroundPixel(pixelnr, rgba);
+        setForegroundPixel(pixelnr, color);
     else
-        setBackgroundPixel(pixelnr, rgba);
+        setBackgroundPixel(pixelnr, color);
 }
 
 inline void
 PixelEngine::setMultiColorPixel(unsigned pixelnr, uint8_t two_bits /* valid: 00, 01, 10, 11 */)
 {
-    int rgba = col_rgba[two_bits];
+    uint8_t color = col[two_bits];
     
     if (two_bits & 0x02)
-        setForegroundPixel(pixelnr, rgba);
+        setForegroundPixel(pixelnr, color);
     else
-        setBackgroundPixel(pixelnr, rgba);
+        setBackgroundPixel(pixelnr, color);
 }
 
-inline void
-PixelEngine::setSingleColorSpritePixel(unsigned spritenr, unsigned pixelnr, uint8_t bit)
-{
-    if (bit) {
-        int rgba = colors[spipe.spriteColor[spritenr]];
-        setSpritePixel(pixelnr, rgba, spritenr);
-    }
-}
-
-inline void
-PixelEngine::setMultiColorSpritePixel(unsigned spritenr, unsigned pixelnr, uint8_t two_bits)
-{
-    int rgba;
-    
-    switch (two_bits) {
-        case 0x01:
-            rgba = colors[spipe.spriteExtraColor1];
-            setSpritePixel(pixelnr, rgba, spritenr);
-            break;
-            
-        case 0x02:
-            rgba = colors[spipe.spriteColor[spritenr]];
-            setSpritePixel(pixelnr, rgba, spritenr);
-            break;
-            
-        case 0x03:
-            rgba = colors[spipe.spriteExtraColor2];
-            setSpritePixel(pixelnr, rgba, spritenr);
-            break;
-    }
-}
-
-
-inline void
-PixelEngine::setSpritePixel(unsigned pixelnr, int color, int nr)
-{
-    uint8_t mask = (1 << nr);
-    
-    // Check sprite/sprite collision
-    if (vic->spriteSpriteCollisionEnabled && (pixelSource[pixelnr] & 0x7F)) {
-        vic->iomem[0x1E] |= ((pixelSource[pixelnr] & 0x7F) | mask);
-        vic->triggerIRQ(4);
-    }
-        
-    // Check sprite/background collision
-    if (vic->spriteBackgroundCollisionEnabled && (pixelSource[pixelnr] & 0x80)) {
-        vic->iomem[0x1F] |= mask;
-        vic->triggerIRQ(2);
-    }
-        
-    if (nr == 7)
-        mask = 0;
-        
-    setSpritePixel(pixelnr, color, vic->spriteDepth(nr), mask);
-}
-
-
 // -----------------------------------------------------------------------------------------------
 //                        Low level drawing (pixel buffer access)
 // -----------------------------------------------------------------------------------------------
 
 inline void
-PixelEngine::setFramePixel(unsigned pixelnr, int rgba)
+PixelEngine::setFramePixel(unsigned pixelnr, uint8_t color)
 {
     unsigned offset = bufferoffset + pixelnr;
     assert(offset < NTSC_PIXELS);
     
-    pixelBuffer[offset] = rgba;
+    pixelBuffer[offset] = color;
     zBuffer[pixelnr] = BORDER_LAYER_DEPTH;
     pixelSource[pixelnr] &= (~0x80); // disable sprite/foreground collision detection in border
 }
 
 inline void
-PixelEngine::setForegroundPixel(unsigned pixelnr, int rgba)
+PixelEngine::setForegroundPixel(unsigned pixelnr, uint8_t color)
 {
     unsigned offset = bufferoffset + pixelnr;
     assert(offset < NTSC_PIXELS);
@@ -660,14 +1045,14 @@ PixelEngine::setForegroundPixel(unsigned pixelnr, int rgba)
     // The zBuffer check is not necessary as the canvas pixels are the first to draw
     // if (FOREGROUND_LAYER_DEPTH <= zBuffer[offset])
     {
-        pixelBuffer[offset] = rgba;
+        pixelBuffer[offset] = color;
         zBuffer[pixelnr] = FOREGROUND_LAYER_DEPTH;
         pixelSource[pixelnr] = 0x80;
     }
 }
 
 inline void
-PixelEngine::setBackgroundPixel(unsigned pixelnr, int rgba)
+PixelEngine::setBackgroundPixel(unsigned pixelnr, uint8_t color)
 {
     unsigned offset = bufferoffset + pixelnr;
     assert(offset < NTSC_PIXELS);
@@ -675,31 +1060,30 @@ PixelEngine::setBackgroundPixel(unsigned pixelnr, int rgba)
     // The zBuffer check is not necessary as the canvas pixels are the first to draw
     // if (BACKGROUD_LAYER_DEPTH <= zBuffer[offset])
     {
-        pixelBuffer[offset] = rgba;
+        pixelBuffer[offset] = color;
         zBuffer[pixelnr] = BACKGROUD_LAYER_DEPTH;
         pixelSource[pixelnr] = 0x00;
     }
 
 }
 
-void
-PixelEngine::setSpritePixel(unsigned pixelnr, int rgba, int depth, int source)
+inline void
+PixelEngine::setSpritePixel(unsigned pixelnr, uint8_t color, int depth)
 {
     unsigned offset = bufferoffset + pixelnr;
     assert(offset < NTSC_PIXELS);
     
     if (depth <= zBuffer[pixelnr]) {
-        pixelBuffer[offset] = rgba;
+        pixelBuffer[offset] = color;
         zBuffer[pixelnr] = depth;
     }
-    pixelSource[pixelnr] |= source;
-
 }
 
 void
 PixelEngine::expandBorders()
 {
-    int color, lastX;
+    uint8_t color;
+    int lastX;
     unsigned leftPixelPos;
     unsigned rightPixelPos;
     
@@ -714,24 +1098,20 @@ PixelEngine::expandBorders()
     }
     
     // Make picked pixels visible for debugging
-    // pixelBuffer[leftPixelPos + 1] = colors[5];
-    // pixelBuffer[rightPixelPos - 1] = colors[5];
+    // pixelBuffer[leftPixelPos + 1] = GREEN;
+    // pixelBuffer[rightPixelPos - 1] = GREEN;
     
     color = pixelBuffer[leftPixelPos];
-    for (unsigned i = 0; i < leftPixelPos; i++) {
-        pixelBuffer[i] = color;
-        // pixelBuffer[i] = colors[5]; // for debugging
-    }
+    memset(pixelBuffer, color, leftPixelPos);
+    // memset(pixelBuffer, GREEN, leftPixelPos); // for debugging
     color = pixelBuffer[rightPixelPos];
-    for (unsigned i = rightPixelPos+1; i < lastX; i++) {
-        pixelBuffer[i] = color;
-        // pixelBuffer[i] = colors[5]; // for debugging
-    }
+    memset(pixelBuffer + rightPixelPos + 1, color, lastX - (rightPixelPos + 1));
+    // memset(pixelBuffer + rightPixelPos + 1, GREEN, lastX - (rightPixelPos + 1)); // for debugging
 
     /*
     // Draw grid lines
     for (unsigned i = 0; i < NTSC_PIXELS; i += 10)
-    pixelBuffer[i] = 0xFFFFFFFF;
+    pixelBuffer[i] = WHITE;
     */
 }
 
@@ -740,8 +1120,7 @@ PixelEngine::markLine(uint8_t color, unsigned start, unsigned end)
 {
     assert (end <= NTSC_PIXELS);
     
-    int rgba = colors[color];
     for (unsigned i = start; i < end; i++) {
-        pixelBuffer[start + i] = rgba;
+        pixelBuffer[start + i] = color;
     }	
 }
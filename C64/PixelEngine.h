@@ -23,6 +23,7 @@
 
 #include "VirtualComponent.h"
 #include "VIC_globals.h"
+#include <atomic>
 
 // Forward declarations
 class VIC;
@@ -70,7 +71,7 @@ public:
     //! @brief    Restores the initial state
     void reset();
 
-    //! @brief    Initializes both screenBuffers
+    //! @brief    Initializes both index buffers
     /*! @details  This function is needed for debugging, only. It write some recognizable pattern 
      *            into both buffers 
      */
@@ -128,31 +129,79 @@ private:
         LO_LO_HI_HI(0xc0, 0xc0, 0xc0, 0xFF)
     };
     
-    /*! @brief    First screen buffer
-     *  @details  The VIC chip writes it output into this buffer. The contents of the array is 
-     *            later copied into to texture RAM of your graphic card by the drawRect method 
-     *            in the GPU related code. 
+    /*! @brief    Index buffers
+     *  @details  The VIC chip writes it output into these buffers. Each pixel is stored as a color
+     *            index (0 to 15). The RGBA representation is computed on demand by screenBuffer().
+     *            The buffers are triple buffered. At any time, one buffer is owned by the emulator
+     *            thread (backBuffer), one is owned by the consumer (frontBuffer) and one is
+     *            waiting to be handed over (middleBuffer). Neither side ever waits for the other.
      */
-    int screenBuffer1[PAL_RASTERLINES][NTSC_PIXELS];
+    uint8_t indexBuffer[3][PAL_RASTERLINES][NTSC_PIXELS];
+    
+    //! @brief    Sequence number of the frame stored in each index buffer
+    uint64_t indexBufferFrameNr[3];
     
-    /*! @brief    Second screen buffer
-     *  @details  The VIC chip uses double buffering. Once a frame is drawn, the VIC chip writes 
-     *            the next frame to the second buffer. 
+    /*! @brief    Hash value of each line in each index buffer
+     *  @details  A line hash is updated whenever the line is drawn. Two lines with the same hash
+     *            value are considered equal.
      */
-    int screenBuffer2[PAL_RASTERLINES][NTSC_PIXELS];
+    uint64_t lineHash[3][PAL_RASTERLINES];
     
-    /*! @brief    Target screen buffer for all rendering methods
-     *  @details  The variable points either to screenBuffer1 or screenBuffer2 
+    //! @brief    Index buffer the emulator thread draws into
+    uint8_t backBuffer;
+    
+    /*! @brief    Index buffer waiting to be handed over
+     *  @details  Bits 0 and 1 contain the buffer number. Bit 7 is set by the emulator thread
+     *            when a new frame is stored and cleared when the consumer picks it up.
      */
-    int *currentScreenBuffer;
+    std::atomic<uint8_t> middleBuffer;
+    
+    //! @brief    Index buffer owned by the consumer
+    uint8_t frontBuffer;
+    
+    //! @brief    Index buffer holding the most recently completed frame
+    uint8_t completedBuffer;
+    
+    //! @brief    Number of completed frames
+    uint64_t completedFrames;
     
     /*! @brief    Pointer to the beginning of the current rasterline
      *  @details  This pointer is used by all rendering methods to write pixels. It always points 
-     *            to the beginning of a rasterline, either in screenBuffer1 or screenBuffer2. 
+     *            to the beginning of a rasterline inside the back buffer.
      *            It is reset at the beginning of each frame and incremented at the beginning of 
      *            each rasterline. 
      */
-    int *pixelBuffer;
+    uint8_t *pixelBuffer;
+    
+    /*! @brief    Screen buffer in RGBA format
+     *  @details  Holds the front buffer translated to RGBA. The contents of the array is 
+     *            later copied into to texture RAM of your graphic card by the drawRect method 
+     *            in the GPU related code. 
+     */
+    uint32_t rgbaBuffer[PAL_RASTERLINES][NTSC_PIXELS];
+    
+    //! @brief    Frame number rgbaBuffer has been translated from (UINT64_MAX = needs translation)
+    uint64_t rgbaFrameNr;
+    
+    //! @brief    Line hashes of the frame rgbaBuffer has been translated from
+    uint64_t rgbaLineHash[PAL_RASTERLINES];
+    
+    /*! @brief    Generation of rgbaBuffer
+     *  @details  Incremented whenever screenBuffer() translates lines to RGBA.
+     */
+    uint64_t rgbaGeneration;
+    
+    /*! @brief    Generation in which each line of rgbaBuffer has been translated
+     *  @details  Each consumer remembers the generation it has seen last and transfers the lines
+     *            with a higher generation, only. Hence, consumers don't interfere with each other.
+     */
+    uint64_t rgbaLineGeneration[PAL_RASTERLINES];
+    
+    /*! @brief    Indicates whether the host CPU supports SSSE3
+     *  @details  Determined once in the constructor. If set, translateToRGBA() looks up 16 pixels
+     *            at a time with the SSSE3 variant.
+     */
+    bool ssse3;
         
     /*! @brief    Z buffer
      *  @details  Virtual VICII uses depth buffering to determine pixel priority. In the various
@@ -163,12 +212,17 @@ private:
     int zBuffer[8];
     
     /*! @brief    Indicates the source of a drawn pixel
-     *  @details  Whenever a foreground pixel or sprite pixel is drawn, a distinct bit in the 
-     *            pixelSource array is set. The information is utilized to detect sprite-sprite 
-     *            and sprite-background collisions. 
+     *  @details  Whenever a foreground pixel is drawn, bit 7 of the corresponding pixelSource
+     *            entry is set. The information is utilized to detect sprite-background
+     *            collisions. Sprite-sprite collisions are detected in drawSprites().
      */
     int pixelSource[8];
     
+    /*! @brief    Sprite pixel colors of the currently drawn 8 pixel chunk
+     *  @details  Written by drawSprites() for all opaque sprite pixels 
+     */
+    uint8_t spritePixelColor[8][8];
+    
     /*! @brief    Offset into pixelBuffer
      *  @details  Variable points to the first pixel of the currently drawn 8 pixel chunk 
      */
@@ -177,10 +231,106 @@ private:
 public:
     
     /*! @brief    Get screen buffer that is currently stable
-     *  @details  This method is called by the GPU code at the beginning of each frame. 
+     *  @details  This method is called by the GPU code at the beginning of each frame. The most
+     *            recent complete frame is picked up and translated to RGBA if it has not been
+     *            translated before. The returned buffer stays intact until the next call. All
+     *            consumer methods must be called from the same thread.
+     */
+    void *screenBuffer();
+    
+    /*! @brief    Get index buffer that is currently stable
+     *  @details  Each pixel is stored as a color index in the range 0 to 15. Consumers that
+     *            do their own color conversion can use this buffer instead of screenBuffer().
+     *            The most recent complete frame is picked up, if a new one is available.
+     */
+    uint8_t *indexScreenBuffer();
+    
+    //! @brief    Returns the sequence number of the frame in the stable buffer
+    inline uint64_t screenBufferFrameNr() { return indexBufferFrameNr[frontBuffer]; }
+    
+    //! @brief    Returns the generation of the buffer returned by screenBuffer()
+    inline uint64_t screenBufferGeneration() { return rgbaGeneration; }
+    
+    /*! @brief    Returns true iff a line has changed after the specified generation
+     *  @details  Consumers can use this information to transfer changed lines, only. A consumer
+     *            passes the value of screenBufferGeneration() at the time of its last transfer.
+     *            Passing 0 marks all lines as changed.
+     */
+    inline bool isDirtyLine(unsigned line, uint64_t generation) {
+        assert(line < PAL_RASTERLINES); return rgbaLineGeneration[line] > generation; }
+    
+    /*! @brief    Returns the line hashes of the stable buffer
+     *  @details  Consumers of indexScreenBuffer() can compare these values with the ones of an
+     *            earlier frame to detect changed lines.
+     */
+    inline const uint64_t *screenBufferLineHashes() { return lineHash[frontBuffer]; }
+    
+    //! @brief    Computes the hash value of a single line
+    static uint64_t hashLine(const uint8_t *line);
+    
+    /*! @brief    Get index buffer holding the most recently completed frame
+     *  @details  Unlike indexScreenBuffer(), this method does not hand over any buffers. It must
+     *            only be called from the emulator thread or while the emulator is suspended.
+     */
+    inline const uint8_t *completedIndexBuffer() { return indexBuffer[completedBuffer][0]; }
+    
+    //! @brief    Returns one of the sixteen C64 colors in RGBA format
+    inline uint32_t getColor(unsigned nr) { assert(nr < 16); return colors[nr]; }
+    
+    //! @brief    Sets one of the sixteen C64 colors in RGBA format
+    /*! @details  The stable frame is translated again with the new palette on the next call
+     *            to screenBuffer().
+     */
+    inline void setColor(unsigned nr, uint32_t rgba) { assert(nr < 16); colors[nr] = rgba; rgbaFrameNr = UINT64_MAX; }
+    
+    /*! @brief    Translates color indices into RGBA values
+     *  @param    src    Color indices (only the lower four bits are evaluated)
+     *  @param    dst    Target buffer for count RGBA values
+     *  @param    count  Number of pixels to translate
+     */
+    void translateToRGBA(const uint8_t *src, uint32_t *dst, size_t count);
+    
+    //! @brief    Scalar variant of translateToRGBA()
+    void translateToRGBAScalar(const uint8_t *src, uint32_t *dst, size_t count);
+    
+#if defined(__i386__) || defined(__x86_64__)
+    /*! @brief    SSSE3 variant of translateToRGBA()
+     *  @details  Must only be called if hasSSSE3() returns true.
      */
-    inline void *screenBuffer() {
-        return (currentScreenBuffer == screenBuffer1[0]) ? screenBuffer2[0] : screenBuffer1[0]; }
+    void translateToRGBASSSE3(const uint8_t *src, uint32_t *dst, size_t count);
+#endif
+    
+    //! @brief    Returns true iff translateToRGBA() uses the SSSE3 variant
+    inline bool hasSSSE3() { return ssse3; }
+
+    
+    // -----------------------------------------------------------------------------------------------
+    //                                         Frame skipping
+    // -----------------------------------------------------------------------------------------------
+
+private:
+    
+    /*! @brief    Frame skip interval in warp mode
+     *  @details  While the emulator runs in warp mode, only every n-th frame is synthesized. In all
+     *            other frames, the pixel engine runs its sequencers without writing any pixels and
+     *            the stable screen buffer keeps the last synthesized frame. VIC timing, sprite
+     *            sequencing and collision detection are unaffected. 1 synthesizes all frames
+     *            (default) and 0 synthesizes no frame at all.
+     */
+    unsigned warpFrameInterval;
+    
+    /*! @brief    Indicates whether pixels are written in the current frame
+     *  @details  Determined in beginFrame() 
+     */
+    bool renderFrame;
+    
+public:
+    
+    //! @brief    Returns the frame skip interval in warp mode
+    inline unsigned getWarpFrameInterval() { return warpFrameInterval; }
+    
+    //! @brief    Sets the frame skip interval in warp mode
+    inline void setWarpFrameInterval(unsigned n) { warpFrameInterval = n; }
 
     
     // -----------------------------------------------------------------------------------------------
@@ -311,7 +461,7 @@ public:
     
     
     // -----------------------------------------------------------------------------------------------
-    //              Shift register logic for sprite pixels (handled in drawSpritePixel)
+    //              Shift register logic for sprite pixels (handled in runSpriteSequencer)
     // -----------------------------------------------------------------------------------------------
     
     /*! @brief    Sprite shift registers
@@ -416,27 +566,63 @@ private:
      */
     void drawCanvasPixel(uint8_t pixelnr);
     
+    /*! @brief    Draws 8 canvas pixels in one go
+     *  @details  Invoked inside drawCanvas() if the shift register is loaded at pixel 0 and neither
+     *            the display mode nor the background colors change inside the 8 pixel window.
+     *            The whole g-access byte is expanded with the singleColorMask and multiColorMask
+     *            tables.
+     */
+    void drawEightCanvasPixels();
+
+    /*! @brief    Runs the canvas sequencer for 8 pixels without drawing
+     *  @details  Invoked inside draw() in skipped frames. Only the state that survives the current
+     *            cycle and the pixel sources needed for collision detection are computed.
+     */
+    void skipCanvas();
+    
+    /*! @brief    Runs the canvas sequencer for a single pixel without drawing
+     *  @param    pixelnr is the pixel number and must be in the range 0 to 7 
+     */
+    void skipCanvasPixel(uint8_t pixelnr);
+    
+    /*! @brief    Runs the border logic for 8 pixels without drawing
+     *  @details  Invoked inside draw() in skipped frames 
+     */
+    void skipBorder();
+    
+    //! @brief    Runs the border logic without drawing (cycle 17 version)
+    void skipBorder17();
+    
+    //! @brief    Runs the border logic without drawing (cycle 55 version)
+    void skipBorder55();
+    
+    
     /*! @brief    Draws 8 sprite pixels
-     *  @details  Invoked inside draw() 
+     *  @details  Invoked inside draw(). The sprite sequencers run first and record an 8 bit mask
+     *            of opaque pixels for each sprite. Collisions are derived from these masks and
+     *            the pixels are drawn afterwards.
      */
     void drawSprites();
 
-    /*! @brief    Draws a single sprite pixel for all sprites
-     *  @param    pixelnr  Pixel number (0 to 7)
-     *  @param    freeze   If the i-th bit is set to 1, the i-th shift register will freeze temporarily
-     *  @param    halt     If the i-th bit is set to 1, the i-th shift register will be deactivated
-     *  @param    load     If the i-th bit is set to 1, the i-th shift register will grab new data bits 
+    /*! @brief    Checks if a sprite sequencer has nothing to do in four consecutive pixels
+     *  @details  This is the case if the shift register waits for a horizontal trigger that is
+     *            outside the four pixels or if all data bits have been shifted out. In both cases,
+     *            only the halt and load signals have an effect.
+     *  @param    spritenr Sprite number (0 to 7)
+     *  @param    pixelnr  Number of the first of the four pixels (0 or 4)
      */
-    void drawSpritePixel(unsigned pixelnr, uint8_t freeze, uint8_t halt, uint8_t load);
+    bool spriteIsIdle(unsigned spritenr, unsigned pixelnr);
 
-    /*! @brief    Draws a single sprite pixel for a single sprite
+    /*! @brief    Runs the sprite sequencer of a single sprite for a single pixel
      *  @param    spritenr Sprite number (0 to 7)
      *  @param    pixelnr  Pixel number (0 to 7)
      *  @param    freeze   If set to true, the sprites shift register will freeze temporarily
      *  @param    halt     If set to true, the sprites shift shift register will be deactivated
      *  @param    load     If set to true, the sprites shift shift register will grab new data bits 
+     *  @param    multicol Indicates if the sprite is drawn in multicolor mode
+     *  @return   The color bits to draw (0 means transparent)
      */
-    void drawSpritePixel(unsigned spritenr, unsigned pixelnr, bool freeze, bool halt, bool load);
+    uint8_t runSpriteSequencer(unsigned spritenr, unsigned pixelnr, bool freeze, bool halt, bool load, bool multicol);
 
     /*! @brief    Draws all sprites into the pixelbuffer
      *  @details  A sprite is only drawn if it's enabled and if sprite drawing is not switched off for debugging 
@@ -455,16 +641,27 @@ private:
 
 private:
     
-    /*! @brief    This is where loadColors() stores all retrieved colors
+    /*! @brief    This is where loadColors() stores all retrieved color indices
      *  @details  [0] : color for '0' pixels in single color mode or '00' pixels in multicolor mode
      *            [1] : color for '1' pixels in single color mode or '01' pixels in multicolor mode
      *            [2] : color for '10' pixels in multicolor mode
      *            [3] : color for '11' pixels in multicolor mode 
      */
-    int col_rgba[4];
+    uint8_t col[4];
     
     //! @brief    loadColors() also determines if we are in single-color or multi-color mode
     bool multicol;
+    
+    /*! @brief    Expansion table for eight single-color pixels
+     *  @details  Byte i of singleColorMask[data] is 0xFF iff bit 7 - i of data is set.
+     */
+    uint64_t singleColorMask[256];
+    
+    /*! @brief    Expansion tables for eight multi-color pixels
+     *  @details  Byte i of multiColorMask[bits][data] is 0xFF iff pixel i is drawn with the
+     *            color that belongs to the two color bits 'bits'.
+     */
+    uint64_t multiColorMask[4][256];
 
 public:
     
@@ -482,22 +679,6 @@ public:
      *            Uses the drawing colors that are setup by loadColors(). 
      */
     void setMultiColorPixel(unsigned pixelnr, uint8_t two_bits);
-    
-    /*! @brief    Draws single sprite pixel in single-color mode
-     *  @details  Uses the drawing colors that are setup by updateSpriteColors 
-     */
-    void setSingleColorSpritePixel(unsigned spritenr, unsigned pixelnr, uint8_t bit);
-    
-    /*! @brief    Draws single sprite pixel in multi-color mode
-     *  @details  Uses the drawing colors that are setup by updateSpriteColors 
-     */
-    void setMultiColorSpritePixel(unsigned spritenr, unsigned pixelnr, uint8_t two_bits);
-
-    /*! @brief    Draws a single sprite pixel
-     *  @details  This function is invoked by setSingleColorPixel() and setMultiColorPixel().
-     *            It takes care of collison and invokes setSpritePixel(4) to actually render the pixel. 
-     */
-    void setSpritePixel(unsigned pixelnr, int color, int nr);
 
     
     // -----------------------------------------------------------------------------------------------
@@ -507,20 +688,20 @@ public:
 public:
 
     //! @brief    Draw a single frame pixel
-    void setFramePixel(unsigned pixelnr, int rgba);
+    void setFramePixel(unsigned pixelnr, uint8_t color);
     
     //! @brief    Draw a single foreground pixel
-    void setForegroundPixel(unsigned pixelnr, int rgba);
+    void setForegroundPixel(unsigned pixelnr, uint8_t color);
     
     //! @brief    Draw a single background pixel
-    void setBackgroundPixel(unsigned pixelnr, int rgba);
+    void setBackgroundPixel(unsigned pixelnr, uint8_t color);
 
     //! @brief    Draw eight background pixels in a row
-    inline void setEightBackgroundPixels(int rgba) {
-        for (unsigned i = 0; i < 8; i++) setBackgroundPixel(i, rgba); }
+    inline void setEightBackgroundPixels(uint8_t color) {
+        for (unsigned i = 0; i < 8; i++) setBackgroundPixel(i, color); }
 
     //! @brief    Draw a single sprite pixel
-    void setSpritePixel(unsigned pixelnr, int rgba, int depth, int source);
+    void setSpritePixel(unsigned pixelnr, uint8_t color, int depth);
 
     /*! @brief    Extend border to the left and right to look nice.
      *  @details  This functions replicates the color of the leftmost and rightmost pixel 
@@ -18,6 +18,17 @@
 
 #include "C64.h"
 
+// Maximum relative deviation from the nominal sample rate (adaptive rate control)
+static const double maxRateCorrection = 0.005;
+
+// Adaptive rate control: Time constant of the fill level filter in seconds
+static const double fillLevelSmoothing = 0.5;
+
+// Adaptive rate control: Proportional and integral gain (per second)
+static const double rateGainP = 0.01;
+static const double rateGainI = 0.001;
+static const double rateIntegralLimit = maxRateCorrection / rateGainI;
+
 ReSID::ReSID()
 {
 	setDescription("ReSID");
@@ -87,6 +98,15 @@ ReSID::ReSID()
     
     volume = 100000;
     targetVolume = 100000;
+    volumeDelta = 0;
+    lastSample = 0.0f;
+    readDataCnt = 0;
+    writeDataCnt = 0;
+    bufferUnderflows = bufferOverflows = 0;
+    adaptiveRate = true;
+    targetFill = 1536;
+    rateCorrection = 1.0;
+    clearRingbuffer();
 }
 
 ReSID::~ReSID()
@@ -151,6 +171,7 @@ ReSID::setSamplingMethod(sampling_method method)
     
     samplingMethod = method;
     sid->set_sampling_parameters(cpuFrequency, samplingMethod, sampleRate); 
+    rateCorrection = 1.0;
 }
 
 void
@@ -158,6 +179,7 @@ ReSID::setSampleRate(uint32_t sr)
 {
     sampleRate = sr;
     sid->set_sampling_parameters(cpuFrequency, samplingMethod, sampleRate);
+    rateCorrection = 1.0;
 }
 
 void 
@@ -165,6 +187,19 @@ ReSID::setClockFrequency(uint32_t frequency)
 { 
 	cpuFrequency = frequency;
     sid->set_sampling_parameters(cpuFrequency, samplingMethod, sampleRate);
+    rateCorrection = 1.0;
+}
+
+void
+ReSID::setAdaptiveRate(bool enable)
+{
+    adaptiveRate = enable;
+}
+
+void
+ReSID::setTargetFill(unsigned samples)
+{
+    targetFill = MIN(MAX(samples, 256), bufferSize / 2);
 }
 
 
@@ -219,22 +254,17 @@ ReSID::execute(int elapsedCycles)
     int delta_t = elapsedCycles;
     int bufindex = 0;
     
-    // TODO: Can't we write directly into Core Audios ringbuffer (for Speedup)?
-
     // Let reSID compute some sound samples
     while (delta_t) {
         bufindex += sid->clock(delta_t, buf + bufindex, buflength - bufindex);
-        // if (delta_t != 0) debug(2, "delta_t = %d\n", delta_t);
     }
     
-    // Write samples into ringbuffer (output is silenced in warp mode) 
-    
-    // float volume = c64->getWarp() ? 0.0f : 0.000005f;
-    for (int i = 0; i < bufindex; i++) {
-        writeData((float)buf[i]);
-    }
+    // Hand samples over to the recorder
+    if (c64->recorder.isRecording())
+        c64->recorder.addSamples(buf, bufindex);
 
-    // fprintf(stderr,"wrote %d samples\n", bufindex);
+    // Write samples into ringbuffer
+    writeSamples(buf, bufindex);
 }
 
 void 
@@ -260,78 +290,142 @@ ReSID::clearRingbuffer()
     }
     
     // Reset read pointer and put write pointer somewhat ahead
-    readPtr = 0;
+    readPtr.store(0, std::memory_order_release);
     alignWritePtr();
+    
+    // Start over with the nominal sample rate
+    fillLevel = targetFill;
+    fillError = 0.0;
 }
 
-float
-ReSID::readData()
+void
+ReSID::readSamples(float *dst, size_t n)
 {
-    readDataCnt++;
+    uint32_t r = readPtr.load(std::memory_order_relaxed);
+    uint32_t w = writePtr.load(std::memory_order_acquire);
+    size_t available = (w + bufferSize - r) % bufferSize;
+    size_t count = MIN(n, available);
     
-    // Check for buffer underflow
-    if (readPtr == writePtr)
-        debug(4, "SID RINGBUFFER UNDERFLOW (%ld)\n", readPtr);
+    // Copy samples (in up to two pieces)
+    size_t first = MIN(count, (size_t)(bufferSize - r));
+    memcpy(dst, ringBuffer + r, first * sizeof(float));
+    memcpy(dst + first, ringBuffer, (count - first) * sizeof(float));
+    readPtr.store((uint32_t)((r + count) % bufferSize), std::memory_order_release);
+    readDataCnt.store(readDataCnt.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
     
-    // Read sound sample
-    float value = ringBuffer[readPtr];
+    // Fill up missing samples
+    if (count < n) {
+        debug(4, "SID RINGBUFFER UNDERFLOW (%d)\n", r);
+        bufferUnderflows++;
+        float fill = count ? dst[count - 1] : lastSample;
+        for (size_t i = count; i < n; i++)
+            dst[i] = fill;
+    }
+    if (n)
+        lastSample = dst[n - 1];
     
-    // Adjust volume
-    if (volume != targetVolume) {
-        if (volume < targetVolume) {
-            volume += MIN(volumeDelta, targetVolume - volume);
-        } else {
-            volume -= MIN(volumeDelta, volume - targetVolume);
+    // Apply volume (ramping up or down first, if required)
+    size_t i = 0;
+    if (volume != targetVolume && volumeDelta > 0) {
+        
+        // The volume changes by volumeDelta per sample until it reaches the target volume
+        int32_t distance = targetVolume - volume;
+        int32_t step = distance > 0 ? volumeDelta : -volumeDelta;
+        size_t steps = (size_t)((abs(distance) + volumeDelta - 1) / volumeDelta);
+        size_t ramp = MIN(steps, n);
+        float start = (float)volume / 100000.0f;
+        float delta = (float)step / 100000.0f;
+        float limit = (float)targetVolume / 100000.0f;
+        
+        for (; i < ramp; i++) {
+            float scale = start + (float)(i + 1) * delta;
+            scale = step > 0 ? MIN(scale, limit) : MAX(scale, limit);
+            dst[i] *= MAX(scale, 0.0f);
         }
+        volume = (ramp == steps) ? targetVolume : volume + (int32_t)ramp * step;
+    }
+    float scale = (volume <= 0) ? 0.0f : (float)volume / 100000.0f;
+    for (; i < n; i++) {
+        dst[i] *= scale;
     }
-    value = (volume <= 0) ? 0.0f : value * (float)volume / 100000.0f;
-    
-    // Advance read pointer
-    readPtr++;
-    if (readPtr == bufferSize)
-        readPtr = 0;
-
-	return value;
 }
 
-inline void
-ReSID::writeData(float data)
+void
+ReSID::writeSamples(const short *src, size_t n)
 {
-    writeDataCnt++;
+    const float scale = 0.000005f;
+    
+    uint32_t w = writePtr.load(std::memory_order_relaxed);
+    uint32_t r = readPtr.load(std::memory_order_acquire);
+    size_t space = (r + bufferSize - w - 1) % bufferSize;
+    writeDataCnt += n;
+    
+    // Adjust the sample rate for the next batch of samples
+    if (adaptiveRate && !c64->getWarp() && !c64->getAudioPacing() && !c64->recorder.isRecording()) {
+        adjustSampleRate(n);
+    } else if (rateCorrection != 1.0) {
+        resetSampleRate();
+    }
     
     // Check for buffer overflow
-    if (readPtr == writePtr) {
-
-        debug(4, "SID RINGBUFFER OVERFLOW (%ld)\n", writePtr);
+    if (n > space) {
         
-        if (!c64->getWarp()) // In real-time mode, we put the write ptr somewhat ahead of the read ptr
+        debug(4, "SID RINGBUFFER OVERFLOW (%d)\n", w);
+        bufferOverflows++;
+        
+        if (!c64->getWarp()) {
+            // In real-time mode, we put the write ptr somewhat ahead of the read ptr
             alignWritePtr();
-        else
-            return; // In warp mode, we don't advance the write ptr to avoid crack noises
-    }
-    
-#if 0
-    // Adjust volume
-    if (volume != targetVolume) {
-        if (volume < targetVolume) {
-            volume += MIN(volumeDelta, targetVolume - volume);
-        } else {
-            volume -= MIN(volumeDelta, volume - targetVolume);
+            w = writePtr.load(std::memory_order_relaxed);
+            space = (r + bufferSize - w - 1) % bufferSize;
         }
+        // In warp mode, we don't advance the write ptr to avoid crack noises
+        n = MIN(n, space);
     }
-#endif 
     
-    // Write sound sample
-    // float scale = (volume <= 0) ? 0.0f : 0.000005f * (float)volume / 100000.0f;
-    float scale = 0.000005f;
-    ringBuffer[writePtr] = data * scale;
+    // Convert and copy samples (in up to two pieces)
+    size_t first = MIN(n, (size_t)(bufferSize - w));
+    for (size_t i = 0; i < first; i++)
+        ringBuffer[w + i] = (float)src[i] * scale;
+    for (size_t i = first; i < n; i++)
+        ringBuffer[i - first] = (float)src[i] * scale;
+    
+    writePtr.store((uint32_t)((w + n) % bufferSize), std::memory_order_release);
+}
+
+
+void
+ReSID::adjustSampleRate(size_t n)
+{
+    double dt = (double)n / sampleRate;
+    
+    // Smooth the fill level (samples are produced and consumed in bursts)
+    double fill = (double)samplesInBuffer();
+    fillLevel += (fill - fillLevel) * dt / (dt + fillLevelSmoothing);
+    
+    // Compute the relative deviation from the target (positive if the buffer runs low)
+    double error = (targetFill - fillLevel) / targetFill;
+    fillError = MIN(MAX(fillError + error * dt, -rateIntegralLimit), rateIntegralLimit);
     
-    // Advance write pointer
-    writePtr++;
-    if (writePtr == bufferSize)
-        writePtr = 0;
+    // Produce more samples if the buffer runs low and less samples if it fills up
+    double correction = rateGainP * error + rateGainI * fillError;
+    correction = 1.0 + MIN(MAX(correction, -maxRateCorrection), maxRateCorrection);
+    
+    // Only talk to reSID if the change is significant
+    if (fabs(correction - rateCorrection) > 0.00001) {
+        rateCorrection = correction;
+        sid->adjust_sampling_frequency(sampleRate * rateCorrection);
+    }
 }
 
+void
+ReSID::resetSampleRate()
+{
+    rateCorrection = 1.0;
+    fillLevel = targetFill;
+    fillError = 0.0;
+    sid->adjust_sampling_frequency(sampleRate);
+}
 
 void
 ReSID::dumpState()
@@ -341,6 +435,8 @@ ReSID::dumpState()
 	msg("   Sample rate : %d\n", sampleRate);
 	msg(" CPU frequency : %d\n", cpuFrequency);
 	msg("   Buffer size : %d\n", bufferSize);
+	msg("   Target fill : %d\n", targetFill);
+	msg("   Rate factor : %f\n", rateCorrection);
 	msg("\n");
 }
 
@@ -26,6 +26,7 @@
 
 #include "VirtualComponent.h"
 #include "sid.h"
+#include <atomic>
 
 class ReSID : public VirtualComponent {
 
@@ -71,22 +72,26 @@ private:
 	
 	/*! @brief   The audio sample ringbuffer.
      *  @details This ringbuffer serves as the data interface between the SID emulation code and 
-     *           computers audio API (CoreAudio on Mac OS X).
+     *           computers audio API (CoreAudio on Mac OS X). It is a single producer, single consumer
+     *           queue. Samples are written by the thread executing SID and read by the audio thread.
      */
     float ringBuffer[bufferSize];
 
     //! ReSID state
     SID::State st;
     
-public:
     /*! @brief   Ring buffer read pointer
+     *  @details Only modified by the consumer (except when the ringbuffer is cleared).
      */
-    unsigned readPtr;
+    std::atomic<uint32_t> readPtr;
 
     /*! @brief   Ring buffer write pointer
+     *  @details Only modified by the producer. The buffer is empty if both pointers are equal.
      */
-	unsigned writePtr;
+    std::atomic<uint32_t> writePtr;
  
+public:
+
     /*! @brief   Current volume
      *  @note    A value of 0 or below silences the audio playback.
      */
@@ -111,8 +116,49 @@ private:
      */
     int32_t volumeDelta;
 
+    //! @brief   Most recently read sample (used to fill up the output in case of an underflow)
+    float lastSample;
+
+    /*! @brief   Indicates if the sample rate is adjusted to the fill level of the ringbuffer
+     *  @details If the emulator runs slightly faster or slower than the audio hardware, the ringbuffer
+     *           would eventually over- or underflow. To prevent this, the sampling frequency of reSID
+     *           is continuously adjusted by a small amount (at most 0.5 percent) such that the
+     *           ringbuffer stays close to targetFill samples. Adjustments are only made in real-time
+     *           mode, if the emulator is not paced by the audio device, and while no recording is
+     *           in progress.
+     */
+    bool adaptiveRate;
+
+    //! @brief   Desired number of samples in the ringbuffer (determines the audio latency)
+    unsigned targetFill;
+
+    //! @brief   Smoothed fill level of the ringbuffer
+    double fillLevel;
+
+    //! @brief   Accumulated fill level error (integral part of the rate controller)
+    double fillError;
+
+    //! @brief   Currently applied sample rate correction factor
+    double rateCorrection;
+
+    //! @brief   Adjusts the sampling frequency to the current fill level of the ringbuffer
+    void adjustSampleRate(size_t n);
+
+    //! @brief   Resets the rate controller and restores the nominal sample rate
+    void resetSampleRate();
+
 public:
-    unsigned readDataCnt, writeDataCnt;
+    /*! @brief   Number of samples read by the audio device
+     *  @details Updated by the audio thread. The emulator thread watches this counter to find out
+     *           if the audio device is still consuming samples.
+     */
+    std::atomic<uint64_t> readDataCnt;
+
+    //! @brief   Number of samples written
+    uint64_t writeDataCnt;
+
+    //! @brief   Number of buffer underflows and overflows
+    unsigned bufferUnderflows, bufferOverflows;
     
 public:
 		
@@ -149,15 +195,24 @@ public:
 	//! Notifies the SID chip that the emulator has started
 	void halt();
 
-    /*! @brief  Reads audio sample from ringbuffer
-     *  @see    handleBufferUnderflow
+    /*! @brief   Reads a block of audio samples from the ringbuffer
+     *  @details The samples are scaled by the current volume. If less than n samples are available,
+     *           the missing samples are filled up with the last sample read (buffer underflow).
+     *  @note    Must only be called by the audio thread.
      */
-	float readData();
+    void readSamples(float *dst, size_t n);
 
-    /*! @brief  Reads audio sample from ringbuffer
-     *  @see    handleBufferOverflow
+    /*! @brief   Writes a block of audio samples into the ringbuffer
+     *  @details The samples are converted to floating point values. If the buffer is full, the write
+     *           pointer is put back to its initial distance from the read pointer (real-time mode) or
+     *           the remaining samples are dropped (warp mode).
+     *  @note    Must only be called by the thread executing SID.
      */
-    void writeData(float data);
+    void writeSamples(const short *src, size_t n);
+
+    //! @brief   Returns the number of samples stored in the ringbuffer
+    inline unsigned samplesInBuffer() {
+        return (writePtr.load(std::memory_order_acquire) + bufferSize - readPtr.load(std::memory_order_acquire)) % bufferSize; }
 
     /*! @brief  Clears the ringbuffer and resets the read and write pointer to its inital values
      */
@@ -222,9 +277,25 @@ public:
     void rampDown() { targetVolume = 0; volumeDelta = 50; }
 
     /*! @brief   Align write pointer
-     *  @details This function puts the write pointer somewhat ahead of the read pointer
+     *  @details This function puts the write pointer targetFill samples ahead of the read pointer
      */
-    void alignWritePtr() { writePtr = (readPtr + (8 * 735)) % bufferSize; }
+    void alignWritePtr() {
+        writePtr.store((readPtr.load(std::memory_order_acquire) + targetFill) % bufferSize, std::memory_order_release); }
+
+    //! @brief   Returns true iff the sample rate is adjusted to the fill level of the ringbuffer
+    inline bool getAdaptiveRate() { return adaptiveRate; }
+
+    //! @brief   Enables or disables adaptive sample rate control
+    void setAdaptiveRate(bool enable);
+
+    //! @brief   Returns the desired number of samples in the ringbuffer
+    inline unsigned getTargetFill() { return targetFill; }
+
+    //! @brief   Sets the desired number of samples in the ringbuffer
+    void setTargetFill(unsigned samples);
+
+    //! @brief   Returns the currently applied sample rate correction factor
+    inline double getRateCorrection() { return rateCorrection; }
 };
 
 #endif
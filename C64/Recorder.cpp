@@ -0,0 +1,413 @@
+/*
+ * (C) 2017 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "C64.h"
+
+Recorder::Recorder()
+{
+    setDescription("Recorder");
+    debug(3, "  Creating recorder at address %p...\n", this);
+
+    recording = false;
+    format = VIDEO_Y4M;
+    videoFile = syncFile = audioFile = NULL;
+    width = height = 0;
+    sampleRate = 0;
+    producedSamples = 0;
+    frameData = NULL;
+    audioData = NULL;
+    outputData = NULL;
+    frameRead = frameWrite = audioRead = audioWrite = 0;
+    frameAdded = 0;
+    stopRequest = false;
+    recordedFrames = droppedFrames = 0;
+    droppedSamples = writtenSamples = 0;
+    writeError = false;
+
+    pthread_mutex_init(&lock, NULL);
+    pthread_cond_init(&dataAvailable, NULL);
+}
+
+Recorder::~Recorder()
+{
+    debug(3, "  Releasing recorder...\n");
+
+    // The emulator thread has already been terminated at this point
+    if (recording)
+        finishRecording();
+
+    pthread_cond_destroy(&dataAvailable);
+    pthread_mutex_destroy(&lock);
+}
+
+void
+Recorder::dumpState()
+{
+    msg("Recorder:\n");
+    msg("---------\n\n");
+    msg("      Recording : %s\n", recording ? "yes" : "no");
+    msg("     Frame size : %d x %d\n", width, height);
+    msg("Recorded frames : %llu\n", recordedFrames);
+    msg(" Dropped frames : %llu\n", droppedFrames);
+    msg("Dropped samples : %llu\n", droppedSamples);
+    msg("\n");
+}
+
+bool
+Recorder::startRecording(const char *videoPath, VideoFormat fmt, const char *audioPath)
+{
+    bool success = true;
+
+    c64->suspend();
+
+    if (recording)
+        finishRecording();
+
+    // Make sure that the SID thread does not hand over any samples while we are setting up
+    c64->sid.synchronize();
+
+    format = fmt;
+    width = c64->isPAL() ? PAL_PIXELS : NTSC_PIXELS;
+    height = c64->isPAL() ? PAL_RASTERLINES : NTSC_RASTERLINES;
+    sampleRate = c64->sid.getSampleRate();
+    producedSamples = 0;
+    frameRead = frameWrite = audioRead = audioWrite = 0;
+    frameAdded = 0;
+    stopRequest = false;
+    recordedFrames = droppedFrames = 0;
+    droppedSamples = writtenSamples = 0;
+    writeError = false;
+
+    // Create output files
+    if (videoPath) {
+        if (!(videoFile = fopen(videoPath, "wb"))) {
+            warn("Cannot create video file %s\n", videoPath);
+            success = false;
+        }
+        if (success && format == VIDEO_RGBA) {
+            char syncPath[256];
+            snprintf(syncPath, sizeof(syncPath), "%s.sync", videoPath);
+            if (!(syncFile = fopen(syncPath, "w"))) {
+                warn("Cannot create sync file %s\n", syncPath);
+                success = false;
+            }
+        }
+    }
+    if (success && audioPath) {
+        if (!(audioFile = fopen(audioPath, "wb"))) {
+            warn("Cannot create audio file %s\n", audioPath);
+            success = false;
+        }
+    }
+    if (!success) {
+        cleanup();
+        c64->resume();
+        return false;
+    }
+
+    // Write file headers
+    if (videoFile && format == VIDEO_Y4M) {
+        uint32_t frequency = c64->isPAL() ? CPU::CLOCK_FREQUENCY_PAL : CPU::CLOCK_FREQUENCY_NTSC;
+        fprintf(videoFile, "YUV4MPEG2 W%u H%u F%u:%u Ip C444 XVIRTUALC64\n",
+                width, height, frequency, (unsigned)c64->vic.getCyclesPerFrame());
+    }
+    if (syncFile) {
+        fprintf(syncFile, "# frame cycle sample\n");
+    }
+    if (audioFile) {
+        writeWavHeader(0);
+    }
+
+    // Allocate queues
+    if (videoFile) {
+        frameData = new uint8_t[videoSlots * width * height];
+        outputData = new uint8_t[4 * width * height];
+    }
+    if (audioFile)
+        audioData = new int16_t[audioSlots];
+
+    pthread_create(&writer, NULL, writerThread, (void *)this);
+    recording = true;
+
+    debug(1, "Recording started (%d x %d pixels, %d Hz)\n", width, height, sampleRate);
+
+    c64->resume();
+    return true;
+}
+
+void
+Recorder::stopRecording()
+{
+    c64->suspend();
+    if (recording)
+        finishRecording();
+    c64->resume();
+}
+
+void
+Recorder::finishRecording()
+{
+    assert(recording);
+
+    // Record all samples up to the current cycle and stamp all queued frames
+    c64->sid.synchronize();
+    recording = false;
+
+    // Let the writer thread drain the queues and wait for it to terminate
+    pthread_mutex_lock(&lock);
+    stopRequest = true;
+    pthread_cond_signal(&dataAvailable);
+    pthread_mutex_unlock(&lock);
+    pthread_join(writer, NULL);
+
+    // Patch the WAV header with the final data size
+    if (audioFile) {
+        fseek(audioFile, 0, SEEK_SET);
+        writeWavHeader((uint32_t)writtenSamples);
+    }
+
+    if (writeError)
+        warn("Recording is incomplete due to a write error\n");
+    if (droppedFrames || droppedSamples)
+        msg("Recorder dropped %llu frames and %llu audio samples\n", droppedFrames, droppedSamples);
+
+    debug(1, "Recording stopped (%llu frames)\n", recordedFrames);
+    cleanup();
+}
+
+void
+Recorder::cleanup()
+{
+    if (videoFile) { fclose(videoFile); videoFile = NULL; }
+    if (syncFile) { fclose(syncFile); syncFile = NULL; }
+    if (audioFile) { fclose(audioFile); audioFile = NULL; }
+
+    delete[] frameData;
+    frameData = NULL;
+    delete[] audioData;
+    audioData = NULL;
+    delete[] outputData;
+    outputData = NULL;
+}
+
+// -----------------------------------------------------------------------------------------------
+//                                      Producer side
+// -----------------------------------------------------------------------------------------------
+
+void
+Recorder::addFrame(const uint8_t *indices, const uint32_t *palette, uint64_t cycle)
+{
+    if (!frameData)
+        return;
+
+    // Only the writer thread modifies frameRead
+    pthread_mutex_lock(&lock);
+    bool full = frameAdded - frameRead == videoSlots;
+    pthread_mutex_unlock(&lock);
+
+    if (full) {
+        droppedFrames++;
+        return;
+    }
+
+    // The slot is not visible to the writer thread until the frame has been stamped
+    unsigned slot = frameAdded % videoSlots;
+    uint8_t *dst = frameData + slot * width * height;
+    for (unsigned i = 0; i < height; i++) {
+        memcpy(dst + i * width, indices + i * NTSC_PIXELS, width);
+    }
+    frameInfo[slot].cycle = cycle;
+    memcpy(frameInfo[slot].palette, palette, sizeof(frameInfo[slot].palette));
+    frameAdded++;
+    recordedFrames++;
+
+    // Let SID stamp the frame once it has caught up
+    c64->sid.stampFrame(cycle, slot);
+}
+
+void
+Recorder::stampFrame(unsigned slot)
+{
+    // Frames are stamped in the order they have been added
+    assert(slot == frameWrite % videoSlots);
+    frameInfo[slot].sample = producedSamples;
+
+    pthread_mutex_lock(&lock);
+    frameWrite++;
+    pthread_cond_signal(&dataAvailable);
+    pthread_mutex_unlock(&lock);
+}
+
+void
+Recorder::addSamples(const int16_t *samples, unsigned count)
+{
+    producedSamples += count;
+
+    if (!audioData)
+        return;
+
+    pthread_mutex_lock(&lock);
+    unsigned space = audioSlots - (unsigned)(audioWrite - audioRead);
+    pthread_mutex_unlock(&lock);
+
+    if (count > space) {
+        droppedSamples += count - space;
+        count = space;
+    }
+
+    // Copy samples into the ring buffer (in up to two pieces)
+    unsigned start = audioWrite % audioSlots;
+    unsigned first = MIN(count, audioSlots - start);
+    memcpy(audioData + start, samples, first * sizeof(int16_t));
+    memcpy(audioData, samples + first, (count - first) * sizeof(int16_t));
+
+    pthread_mutex_lock(&lock);
+    audioWrite += count;
+    pthread_cond_signal(&dataAvailable);
+    pthread_mutex_unlock(&lock);
+}
+
+// -----------------------------------------------------------------------------------------------
+//                                      Consumer side
+// -----------------------------------------------------------------------------------------------
+
+void *
+Recorder::writerThread(void *recorder)
+{
+    ((Recorder *)recorder)->writeQueuedData();
+    return NULL;
+}
+
+void
+Recorder::writeQueuedData()
+{
+    pthread_mutex_lock(&lock);
+
+    while (1) {
+
+        while (!stopRequest && frameRead == frameWrite && audioRead == audioWrite)
+            pthread_cond_wait(&dataAvailable, &lock);
+
+        if (frameRead == frameWrite && audioRead == audioWrite)
+            break; // Stop requested and everything written
+
+        uint64_t frames = frameWrite;
+        uint64_t samples = audioWrite;
+        pthread_mutex_unlock(&lock);
+
+        // Write audio samples
+        for (uint64_t i = audioRead; i < samples; ) {
+            unsigned start = i % audioSlots;
+            unsigned count = (unsigned)MIN(samples - i, (uint64_t)(audioSlots - start));
+            if (!writeError && fwrite(audioData + start, sizeof(int16_t), count, audioFile) != count)
+                writeError = true;
+            writtenSamples += count;
+            i += count;
+        }
+
+        // Write frames and release each slot as soon as it has been written
+        for (uint64_t i = frameRead; i < frames; i++) {
+            unsigned slot = i % videoSlots;
+            writeFrame(frameData + slot * width * height, &frameInfo[slot]);
+            pthread_mutex_lock(&lock);
+            frameRead++;
+            pthread_mutex_unlock(&lock);
+        }
+
+        pthread_mutex_lock(&lock);
+        audioRead = samples;
+    }
+
+    pthread_mutex_unlock(&lock);
+}
+
+void
+Recorder::writeFrame(const uint8_t *indices, const FrameInfo *info)
+{
+    size_t size = width * height;
+    uint8_t *buffer = outputData;
+
+    if (format == VIDEO_Y4M) {
+
+        // Convert the palette to YCbCr (ITU-R BT.601, studio swing)
+        uint8_t y[16], cb[16], cr[16];
+        for (unsigned i = 0; i < 16; i++) {
+            double r = info->palette[i] & 0xFF;
+            double g = (info->palette[i] >> 8) & 0xFF;
+            double b = (info->palette[i] >> 16) & 0xFF;
+            y[i] = (uint8_t)(16.5 + (65.481 * r + 128.553 * g + 24.966 * b) / 255.0);
+            cb[i] = (uint8_t)(128.5 + (-37.797 * r - 74.203 * g + 112.0 * b) / 255.0);
+            cr[i] = (uint8_t)(128.5 + (112.0 * r - 93.786 * g - 18.214 * b) / 255.0);
+        }
+
+        // Write the three planes
+        for (size_t i = 0; i < size; i++) {
+            uint8_t index = indices[i] & 0x0F;
+            buffer[i] = y[index];
+            buffer[size + i] = cb[index];
+            buffer[2 * size + i] = cr[index];
+        }
+        size *= 3;
+        if (fprintf(videoFile, "FRAME XCYCLE=%llu XSAMPLE=%llu\n",
+                    (unsigned long long)info->cycle, (unsigned long long)info->sample) < 0)
+            writeError = true;
+
+    } else {
+
+        for (size_t i = 0; i < size; i++) {
+            uint32_t rgba = info->palette[indices[i] & 0x0F];
+            buffer[4 * i] = rgba & 0xFF;
+            buffer[4 * i + 1] = (rgba >> 8) & 0xFF;
+            buffer[4 * i + 2] = (rgba >> 16) & 0xFF;
+            buffer[4 * i + 3] = (rgba >> 24) & 0xFF;
+        }
+        size *= 4;
+        if (syncFile)
+            fprintf(syncFile, "%llu %llu %llu\n", (unsigned long long)(frameRead),
+                    (unsigned long long)info->cycle, (unsigned long long)info->sample);
+    }
+
+    if (!writeError && fwrite(buffer, 1, size, videoFile) != size)
+        writeError = true;
+}
+
+void
+Recorder::writeWavHeader(uint32_t numSamples)
+{
+    uint32_t dataSize = 2 * numSamples;
+    uint8_t header[44] = {
+        'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E',
+        'f', 'm', 't', ' ', 16, 0, 0, 0,
+        1, 0,                   // PCM
+        1, 0,                   // Mono
+        0, 0, 0, 0,             // Sample rate
+        0, 0, 0, 0,             // Byte rate
+        2, 0,                   // Block align
+        16, 0,                  // Bits per sample
+        'd', 'a', 't', 'a', 0, 0, 0, 0 };
+
+    uint32_t fields[4][2] = {
+        { 4, 36 + dataSize }, { 24, sampleRate }, { 28, 2 * sampleRate }, { 40, dataSize } };
+    for (unsigned i = 0; i < 4; i++) {
+        for (unsigned j = 0; j < 4; j++)
+            header[fields[i][0] + j] = (fields[i][1] >> (8 * j)) & 0xFF;
+    }
+
+    if (fwrite(header, 1, sizeof(header), audioFile) != sizeof(header))
+        writeError = true;
+}
@@ -0,0 +1,234 @@
+/*!
+ * @header      Recorder.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2017 Dirk W. Hoffmann
+ * @brief       Declares Recorder class
+ */
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _RECORDER_INC
+#define _RECORDER_INC
+
+#include "VirtualComponent.h"
+
+//! @brief    Video formats supported by the recorder
+enum VideoFormat {
+    VIDEO_Y4M,     //!< YUV4MPEG2 stream (4:4:4), one FRAME header per frame
+    VIDEO_RGBA     //!< Raw RGBA frames without any header
+};
+
+/*! @class    Recorder
+ *  @brief    Captures the emulator output into video and audio files.
+ *  @details  The recorder is fed by the emulator thread. The pixel engine hands over every rendered
+ *            frame in endFrame() and the reSID wrapper hands over every audio sample it produces.
+ *            Both are copied into bounded queues and written to disk by a background thread. The
+ *            emulator thread never waits for the writer. If a queue is full, the frame (or audio
+ *            chunk) is dropped and counted.
+ *
+ *            Each frame is stamped with the CPU cycle it was completed in and with the number of
+ *            audio samples produced up to that point. This allows tools to align video and audio,
+ *            even if frames have been dropped or skipped in warp mode. The sample stamp is the
+ *            actual number of samples SID has handed over. It is taken by the thread that
+ *            synthesizes the samples once SID has reached the frame's cycle (see
+ *            SIDWrapper::stampFrame). Hence, the emulator thread doesn't wait for the SID
+ *            thread. A queued frame is passed on to the writer thread after it has been stamped.
+ *            In Y4M files, the stamps are stored as FRAME header parameters (XCYCLE, XSAMPLE).
+ *            For raw RGBA files, they are written into a separate text file (video file name
+ *            plus ".sync").
+ */
+class Recorder : public VirtualComponent {
+
+    //! @brief    Number of frames the video queue can hold
+    static const unsigned videoSlots = 8;
+
+    //! @brief    Number of samples the audio queue can hold (about 3 seconds at 44.1 kHz)
+    static const unsigned audioSlots = 1 << 17;
+
+    //! @brief    Per frame information stored alongside the pixel data
+    typedef struct {
+        uint64_t cycle;
+        uint64_t sample;
+        uint32_t palette[16];
+    } FrameInfo;
+
+    //! @brief    Indicates if a recording is in progress
+    bool recording;
+
+    //! @brief    Selected video format
+    VideoFormat format;
+
+    //! @brief    Video, sync, and audio output files (NULL if not recorded)
+    FILE *videoFile, *syncFile, *audioFile;
+
+    //! @brief    Frame dimensions (fixed when the recording starts)
+    unsigned width, height;
+
+    //! @brief    Audio sample rate (fixed when the recording starts)
+    uint32_t sampleRate;
+
+    /*! @brief    Number of audio samples SID has produced since the recording started
+     *  @details  Counted in addSamples() and read in stampFrame(). Both are called by the thread
+     *            that synthesizes the samples.
+     */
+    uint64_t producedSamples;
+
+
+    //
+    // Queues (shared between the emulator thread and the writer thread)
+    //
+
+    //! @brief    Color indices of all queued frames (videoSlots * width * height bytes)
+    uint8_t *frameData;
+
+    //! @brief    Cycle stamps and palettes of all queued frames
+    FrameInfo frameInfo[videoSlots];
+
+    //! @brief    Audio sample ring buffer (audioSlots samples)
+    int16_t *audioData;
+
+    //! @brief    Conversion buffer of the writer thread (one frame in the output format)
+    uint8_t *outputData;
+
+    /*! @brief    Queue pointers
+     *  @details  The counters grow monotonically. The write pointers are advanced by the producers,
+     *            the read pointers by the writer thread. All accesses are guarded by lock.
+     */
+    uint64_t frameRead, frameWrite, audioRead, audioWrite;
+
+    /*! @brief    Number of frames copied into the video queue
+     *  @details  Only used by the emulator thread. Frames between frameWrite and frameAdded are
+     *            waiting for their sample stamp.
+     */
+    uint64_t frameAdded;
+
+    //! @brief    Tells the writer thread to drain the queues and terminate
+    bool stopRequest;
+
+    //! @brief    Mutex guarding the queue pointers
+    pthread_mutex_t lock;
+
+    //! @brief    Signals the writer thread that new data is available
+    pthread_cond_t dataAvailable;
+
+    //! @brief    The writer thread
+    pthread_t writer;
+
+
+    //
+    // Statistics
+    //
+
+    //! @brief    Number of frames written into the queue
+    uint64_t recordedFrames;
+
+    //! @brief    Number of frames dropped because the video queue was full
+    uint64_t droppedFrames;
+
+    //! @brief    Number of audio samples dropped because the audio queue was full
+    uint64_t droppedSamples;
+
+    //! @brief    Number of audio samples written to disk
+    uint64_t writtenSamples;
+
+    //! @brief    Indicates a write error in the writer thread
+    bool writeError;
+
+public:
+
+    //! @brief    Constructor
+    Recorder();
+
+    //! @brief    Destructor
+    ~Recorder();
+
+    //! @brief    Prints debug information
+    void dumpState();
+
+
+    //
+    //! @functiongroup Controlling a recording
+    //
+
+    /*! @brief    Starts recording
+     *  @param    videoPath  Video output file or NULL if no video should be recorded
+     *  @param    format     Video format to use
+     *  @param    audioPath  WAV output file or NULL if no audio should be recorded
+     *  @result   true, if all output files could be created
+     */
+    bool startRecording(const char *videoPath, VideoFormat format, const char *audioPath);
+
+    /*! @brief    Stops recording
+     *  @details  Writes out all queued data, finalizes the output files, and closes them.
+     */
+    void stopRecording();
+
+    //! @brief    Returns true if a recording is in progress
+    inline bool isRecording() { return recording; }
+
+    //! @brief    Returns the number of frames handed over to the writer thread
+    inline uint64_t getRecordedFrames() { return recordedFrames; }
+
+    //! @brief    Returns the number of frames that have been dropped
+    inline uint64_t getDroppedFrames() { return droppedFrames; }
+
+    //! @brief    Returns the number of audio samples that have been dropped
+    inline uint64_t getDroppedSamples() { return droppedSamples; }
+
+
+    //
+    //! @functiongroup Feeding the recorder
+    //
+
+    /*! @brief    Queues a completed frame
+     *  @param    indices  Color index buffer as written by the pixel engine
+     *  @param    palette  The sixteen C64 colors in RGBA format
+     *  @param    cycle    CPU cycle in which the frame was completed
+     */
+    void addFrame(const uint8_t *indices, const uint32_t *palette, uint64_t cycle);
+
+    /*! @brief    Queues a chunk of audio samples
+     *  @details  Called by the thread that synthesizes the samples.
+     */
+    void addSamples(const int16_t *samples, unsigned count);
+
+    /*! @brief    Stamps the oldest unstamped frame with the number of produced samples
+     *  @details  Called by the thread that synthesizes the samples, once SID has reached the
+     *            cycle the frame was completed in. Passes the frame on to the writer thread.
+     */
+    void stampFrame(unsigned slot);
+
+private:
+
+    //! @brief    Terminates the writer thread and finalizes all output files
+    void finishRecording();
+
+    //! @brief    Entry point of the writer thread
+    static void *writerThread(void *recorder);
+
+    //! @brief    Main loop of the writer thread
+    void writeQueuedData();
+
+    //! @brief    Writes a single frame in the selected video format
+    void writeFrame(const uint8_t *indices, const FrameInfo *info);
+
+    //! @brief    Writes a WAV header (called once at the beginning and once at the end)
+    void writeWavHeader(uint32_t numSamples);
+
+    //! @brief    Closes all files and releases the queues
+    void cleanup();
+};
+
+#endif
@@ -42,17 +42,58 @@ SIDWrapper::SIDWrapper()
     registerSnapshotItems(items, sizeof(items));
     
     useReSID = true;
+    cycles = 0;
+
+    threaded = false;
+    threadEnabled = true;
+    running = false;
+    queueHead = queueTail = 0;
+    threadCycles = 0;
+    stopThread = false;
+    pthread_mutex_init(&queueLock, NULL);
+    pthread_cond_init(&queueFilled, NULL);
+    pthread_cond_init(&queueDrained, NULL);
 }
 
 SIDWrapper::~SIDWrapper()
 {
+    joinThread();
+    pthread_cond_destroy(&queueDrained);
+    pthread_cond_destroy(&queueFilled);
+    pthread_mutex_destroy(&queueLock);
+
     delete oldsid;
     delete resid;
 }
 
+void
+SIDWrapper::reset()
+{
+    drain();
+    VirtualComponent::reset();
+    threadCycles = cycles;
+}
+
+void
+SIDWrapper::loadFromBuffer(uint8_t **buffer)
+{
+    drain();
+    VirtualComponent::loadFromBuffer(buffer);
+    threadCycles = cycles;
+}
+
+void
+SIDWrapper::saveToBuffer(uint8_t **buffer)
+{
+    drain();
+    VirtualComponent::saveToBuffer(buffer);
+}
+
 void 
 SIDWrapper::setReSID(bool enable)
 {
+    drain();
+
     if (enable)
         debug(2, "Using ReSID library\n");
     else
@@ -87,14 +128,23 @@ SIDWrapper::setNTSC()
 uint8_t 
 SIDWrapper::peek(uint16_t addr)
 {
-    // Get SID up to date
-    executeUntil(c64->getCycles());
-    
-    // Take care of possible side effects, but discard value
-    if (useReSID)
-        (void)resid->peek(addr);
-    else
-        (void)oldsid->peek(addr);
+    if (threaded) {
+        
+        // Let the SID thread take care of possible side effects
+        cycles = c64->getCycles();
+        push(SID_PEEK, cycles, addr);
+        
+    } else {
+        
+        // Get SID up to date
+        executeUntil(c64->getCycles());
+        
+        // Take care of possible side effects, but discard value
+        if (useReSID)
+            (void)resid->peek(addr);
+        else
+            (void)oldsid->peek(addr);
+    }
 
     if (addr == 0x19 || addr == 0x1A) {
         latchedDataBus = 0;
@@ -112,10 +162,17 @@ SIDWrapper::peek(uint16_t addr)
 void 
 SIDWrapper::poke(uint16_t addr, uint8_t value)
 {
+    latchedDataBus = value;
+
+    if (threaded) {
+        cycles = c64->getCycles();
+        push(SID_POKE, cycles, addr, value);
+        return;
+    }
+    
     // Get SID up to date
     executeUntil(c64->getCycles());
 
-    latchedDataBus = value;
     oldsid->poke(addr, value);
     resid->poke(addr, value);
 }
@@ -123,10 +180,48 @@ SIDWrapper::poke(uint16_t addr, uint8_t value)
 void
 SIDWrapper::executeUntil(uint64_t targetCycle)
 {
-    execute(targetCycle - cycles);
+    if (threaded) {
+        if (targetCycle != cycles) {
+            push(SID_EXECUTE, targetCycle);
+            wakeUp();
+        }
+    } else {
+        execute(targetCycle - cycles);
+    }
     cycles = targetCycle;
 }
 
+void
+SIDWrapper::synchronize()
+{
+    executeUntil(c64->getCycles());
+    drain();
+}
+
+unsigned
+SIDWrapper::pendingSamples()
+{
+    if (!threaded)
+        return 0;
+    
+    uint64_t done = threadCycles.load(std::memory_order_relaxed);
+    uint64_t pending = cycles > done ? cycles - done : 0;
+    return (unsigned)(pending * getSampleRate() / getClockFrequency());
+}
+
+void
+SIDWrapper::stampFrame(uint64_t cycle, uint8_t slot)
+{
+    if (threaded) {
+        cycles = cycle;
+        push(SID_STAMP, cycle, slot);
+        wakeUp();
+    } else {
+        executeUntil(cycle);
+        c64->recorder.stampFrame(slot);
+    }
+}
+
 inline void
 SIDWrapper::execute(uint64_t numCycles)
 {
@@ -143,29 +238,40 @@ SIDWrapper::execute(uint64_t numCycles)
 void 
 SIDWrapper::run()
 {   
+    drain();
     oldsid->run();
     resid->run();
+    
+    running = true;
+    if (threadEnabled)
+        createThread();
 }
 
 void 
 SIDWrapper::halt()
 {   
+    joinThread();
+    running = false;
+    
     oldsid->halt();
     resid->halt();
 }
 
-float 
-SIDWrapper::readData()
+void
+SIDWrapper::readSamples(float *dst, size_t n)
 {
-    if (useReSID)
-        return resid->readData();
-    else
-        return oldsid->readData();
+    if (useReSID) {
+        resid->readSamples(dst, n);
+    } else {
+        for (size_t i = 0; i < n; i++)
+            dst[i] = oldsid->readData();
+    }
 }
 
 void 
 SIDWrapper::setAudioFilter(bool enable)
 {
+    drain();
     if (enable)
         debug(2, "Enabling audio filters\n");
     else
@@ -179,31 +285,191 @@ SIDWrapper::setAudioFilter(bool enable)
 void
 SIDWrapper::setSamplingMethod(sampling_method value)
 {
+    drain();
      resid->setSamplingMethod(value);
 }
 
 void 
 SIDWrapper::setChipModel(chip_model value)
 {
+    drain();
     resid->setChipModel(value);
 }
 
 void 
 SIDWrapper::setSampleRate(uint32_t sr)
 {
+    drain();
     oldsid->setSampleRate(sr);
     resid->setSampleRate(sr);
 }
 
-uint32_t
-SIDWrapper::getClockFrequency()
-{
-    return resid->getClockFrequency();
-}
-
 void 
 SIDWrapper::setClockFrequency(uint32_t frequency)
 {
+    drain();
     oldsid->setClockFrequency(frequency);
     resid->setClockFrequency(frequency);
 }
+
+
+// -----------------------------------------------------------------------------------------------
+//                                          SID thread
+// -----------------------------------------------------------------------------------------------
+
+void
+SIDWrapper::setThreaded(bool enable)
+{
+    threadEnabled = enable;
+    
+    if (running) {
+        if (enable)
+            createThread();
+        else
+            joinThread();
+    }
+}
+
+void
+SIDWrapper::createThread()
+{
+    if (threaded)
+        return;
+    
+    debug(2, "Running sound synthesis on a separate thread\n");
+    threadCycles = cycles;
+    stopThread = false;
+    threaded = true;
+    pthread_create(&thread, NULL, threadMain, (void *)this);
+}
+
+void
+SIDWrapper::joinThread()
+{
+    if (!threaded)
+        return;
+    
+    debug(2, "Running sound synthesis on the emulator thread\n");
+    drain();
+    pthread_mutex_lock(&queueLock);
+    stopThread = true;
+    pthread_cond_signal(&queueFilled);
+    pthread_mutex_unlock(&queueLock);
+    pthread_join(thread, NULL);
+    threaded = false;
+    assert(threadCycles == cycles);
+}
+
+void
+SIDWrapper::push(uint8_t type, uint64_t cycle, uint8_t addr, uint8_t value)
+{
+    uint32_t head = queueHead.load(std::memory_order_relaxed);
+    
+    // Sleep until the SID thread has caught up if the queue is full
+    if (head - queueTail.load(std::memory_order_acquire) == queueSize) {
+        
+        // The emulator thread must not be cancelled while it holds the lock
+        int state;
+        pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+        pthread_mutex_lock(&queueLock);
+        pthread_cond_signal(&queueFilled);
+        while (head - queueTail.load(std::memory_order_acquire) == queueSize)
+            pthread_cond_wait(&queueDrained, &queueLock);
+        pthread_mutex_unlock(&queueLock);
+        pthread_setcancelstate(state, NULL);
+    }
+    
+    SIDRecord *record = &queue[head % queueSize];
+    record->cycle = cycle;
+    record->type = type;
+    record->addr = (uint8_t)addr;
+    record->value = value;
+    queueHead.store(head + 1, std::memory_order_release);
+}
+
+void
+SIDWrapper::wakeUp()
+{
+    pthread_mutex_lock(&queueLock);
+    pthread_cond_signal(&queueFilled);
+    pthread_mutex_unlock(&queueLock);
+}
+
+void
+SIDWrapper::drain()
+{
+    if (!threaded)
+        return;
+    
+    // The emulator thread must not be cancelled while it holds the lock
+    int state;
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+    pthread_mutex_lock(&queueLock);
+    pthread_cond_signal(&queueFilled);
+    while (queueTail.load(std::memory_order_acquire) != queueHead.load(std::memory_order_relaxed))
+        pthread_cond_wait(&queueDrained, &queueLock);
+    pthread_mutex_unlock(&queueLock);
+    pthread_setcancelstate(state, NULL);
+}
+
+void *
+SIDWrapper::threadMain(void *wrapper)
+{
+    ((SIDWrapper *)wrapper)->processQueue();
+    return NULL;
+}
+
+void
+SIDWrapper::processQueue()
+{
+    while (1) {
+        
+        // Process all available records
+        uint32_t tail = queueTail.load(std::memory_order_relaxed);
+        uint32_t head = queueHead.load(std::memory_order_acquire);
+        for (; tail != head; tail++) {
+            replay(&queue[tail % queueSize]);
+            queueTail.store(tail + 1, std::memory_order_release);
+        }
+        
+        // Report completion and sleep until new records arrive
+        pthread_mutex_lock(&queueLock);
+        if (queueHead.load(std::memory_order_acquire) == tail) {
+            pthread_cond_broadcast(&queueDrained);
+            while (!stopThread && queueHead.load(std::memory_order_acquire) == tail)
+                pthread_cond_wait(&queueFilled, &queueLock);
+        }
+        bool stop = stopThread && queueHead.load(std::memory_order_acquire) == tail;
+        pthread_mutex_unlock(&queueLock);
+        
+        if (stop)
+            break;
+    }
+}
+
+void
+SIDWrapper::replay(const SIDRecord *record)
+{
+    // Synthesize samples up to the cycle of the access
+    execute(record->cycle - threadCycles);
+    threadCycles = record->cycle;
+    
+    switch (record->type) {
+            
+        case SID_PEEK:
+            if (useReSID)
+                (void)resid->peek(record->addr);
+            else
+                (void)oldsid->peek(record->addr);
+            break;
+            
+        case SID_POKE:
+            oldsid->poke(record->addr, record->value);
+            resid->poke(record->addr, record->value);
+            break;
+            
+        case SID_STAMP:
+            c64->recorder.stampFrame(record->addr);
+            break;
+    }
+}
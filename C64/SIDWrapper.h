@@ -24,6 +24,23 @@
 #include "VirtualComponent.h"
 #include "OldSID.h"
 #include "ReSID.h"
+#include <atomic>
+
+//! @brief    Register access that is forwarded to the SID thread
+typedef struct {
+    uint64_t cycle;     //!< Cycle in which the access happened
+    uint8_t type;       //!< SID_EXECUTE, SID_PEEK, or SID_POKE
+    uint8_t addr;
+    uint8_t value;
+} SIDRecord;
+
+//! @brief    SID record types
+enum {
+    SID_EXECUTE,        //!< Synthesize samples up to the specified cycle
+    SID_PEEK,           //!< Read access (replayed for possible side effects)
+    SID_POKE,           //!< Write access
+    SID_STAMP           //!< Stamp a recorded frame (see Recorder::stampFrame)
+};
 
 class SIDWrapper : public VirtualComponent {
 
@@ -62,9 +79,18 @@ public:
 	//! @brief    Destructor
 	~SIDWrapper();
 			
+    //! @brief    Brings the SID chips back to their initial state
+    void reset();
+
 	//! @brief    Prints debug information
 	void dumpState();
 	
+    //! @brief    Restores the current state from a buffer
+    void loadFromBuffer(uint8_t **buffer);
+
+    //! @brief    Saves the current state into a buffer
+    void saveToBuffer(uint8_t **buffer);
+	
     
     // -----------------------------------------------------------------------------------------------
 	//                                         Configuring
@@ -107,7 +133,7 @@ public:
 	void setSampleRate(uint32_t sr);
     
     //! @brief    Returns the clock frequency.
-    inline uint32_t getClockFrequency();
+    inline uint32_t getClockFrequency() { return resid->getClockFrequency(); }
     
 	//! @brief    Sets the clock frequency.
 	void setClockFrequency(uint32_t frequency);	
@@ -139,7 +165,125 @@ private:
     //! @brief    Current clock cycle since power up
     uint64_t cycles;
 
+    
+    // -----------------------------------------------------------------------------------------------
+	//                                         SID thread
+	// -----------------------------------------------------------------------------------------------
+
+    /*! @brief    Indicates if sound synthesis runs on a separate thread
+     *  @details  In threaded mode, the emulator thread does not synthesize any samples. Instead, it
+     *            appends all SID accesses together with the current cycle to a lock-free queue. The
+     *            SID thread replays them in order, i.e., each access hits the SID chip at exactly the
+     *            same cycle as in non-threaded mode and the generated samples are identical.
+     *            Read accesses do not stall the emulator thread. The wrapper never forwards values
+     *            computed by the sound synthesis to the CPU (OSC3 and ENV3 read back pseudo-random
+     *            values and all other registers read back the latched data bus). Hence, reads are
+     *            queued like writes to replay possible side effects at the right cycle.
+     *            Everything that accesses the synthesis state directly (snapshots, reset,
+     *            reconfiguration) calls drain() first.
+     *            The SID thread only exists while the emulator is running, i.e., between run()
+     *            and halt(). At all other times, samples are synthesized on the calling thread.
+     */
+    bool threaded;
+
+    //! @brief    Indicates if threaded mode has been selected with setThreaded()
+    bool threadEnabled;
+
+    //! @brief    Indicates if the emulator is running (between run() and halt())
+    bool running;
+
+    //! @brief    Capacity of the record queue
+    static const unsigned queueSize = 8192;
+
+    //! @brief    Record queue (single producer, single consumer)
+    SIDRecord queue[queueSize];
+
+    /*! @brief    Queue pointers
+     *  @details  The head is advanced by the emulator thread, the tail by the SID thread.
+     */
+    std::atomic<uint32_t> queueHead, queueTail;
+
+    /*! @brief    Cycle up to which the SID thread has synthesized samples
+     *  @details  Written by the SID thread. The emulator thread reads it to estimate the number
+     *            of samples that are still queued.
+     */
+    std::atomic<uint64_t> threadCycles;
+
+    //! @brief    The SID thread
+    pthread_t thread;
+
+    //! @brief    Tells the SID thread to terminate
+    bool stopThread;
+
+    //! @brief    Mutex used by the condition variables below
+    pthread_mutex_t queueLock;
+
+    //! @brief    Signals the SID thread that new records are available
+    pthread_cond_t queueFilled;
+
+    //! @brief    Signals waiting threads that all records have been processed
+    pthread_cond_t queueDrained;
+
+    /*! @brief    Appends a record to the queue
+     *  @details  If the queue is full, the emulator thread sleeps until the SID thread has
+     *            processed all records.
+     */
+    void push(uint8_t type, uint64_t cycle, uint8_t addr = 0, uint8_t value = 0);
+
+    //! @brief    Creates the SID thread and enters threaded mode
+    void createThread();
+
+    //! @brief    Processes all queued records, terminates the SID thread and leaves threaded mode
+    void joinThread();
+
+    //! @brief    Wakes up the SID thread
+    void wakeUp();
+
+    //! @brief    Waits until the SID thread has processed all queued records
+    void drain();
+
+    //! @brief    Entry point of the SID thread
+    static void *threadMain(void *wrapper);
+
+    //! @brief    Main loop of the SID thread
+    void processQueue();
+
+    //! @brief    Replays a single record
+    void replay(const SIDRecord *record);
+
 public:
+
+    //! @brief    Returns true if sound synthesis is supposed to run on a separate thread
+    inline bool getThreaded() { return threadEnabled; }
+
+    /*! @brief    Moves sound synthesis to a separate thread or back onto the emulator thread
+     *  @details  The SID thread is created in run() and terminated in halt(). If the emulator is
+     *            running, the thread is created or terminated immediately. In that case, the
+     *            function must be called from the emulator thread or while the emulator is
+     *            suspended.
+     */
+    void setThreaded(bool enable);
+
+    /*! @brief    Executes SID until the current CPU cycle and waits until all samples are computed
+     *  @details  In non-threaded mode, this function is equivalent to executeUntil(c64->getCycles()).
+     */
+    void synchronize();
+
+    /*! @brief    Returns the number of samples the SID thread still has to synthesize
+     *  @details  The value is estimated from the cycles between the queued records and the progress
+     *            of the SID thread. In non-threaded mode, no samples are pending.
+     */
+    unsigned pendingSamples();
+
+    /*! @brief    Stamps a recorded frame with the number of samples produced up to a cycle
+     *  @details  In threaded mode, the request is queued and the SID thread calls back the
+     *            recorder once it has reached the specified cycle. Otherwise, SID is executed up
+     *            to the cycle and the recorder is called back immediately.
+     *  @param    cycle  CPU cycle the frame was completed in (the current cycle)
+     *  @param    slot   Video queue slot of the frame
+     */
+    void stampFrame(uint64_t cycle, uint8_t slot);
+
     
     /*! @brief    Executes SID until a certain cycle is reached
      *  @param    cycle The target cycle
@@ -168,8 +312,10 @@ public:
 	//! @brief    Special poke function for the I/O memory range.
 	void poke(uint16_t addr, uint8_t value);
 	
-    //! @brief    Reads next audio sample from the ringbuffer
-	float readData();
+    /*! @brief    Reads a block of audio samples from the ringbuffer
+     *  @details  Called by the audio thread. The samples are already scaled by the current volume.
+     */
+	void readSamples(float *dst, size_t n);
 };
 
 #endif
@@ -164,7 +164,7 @@ Snapshot::writeToBuffer(uint8_t *buffer)
 }
 
 void
-Snapshot::takeScreenshot(uint32_t *buf, bool pal)
+Snapshot::takeScreenshot(const uint8_t *buf, const uint32_t *palette, bool pal)
 {
     unsigned x_start, y_start;
        
@@ -183,7 +183,8 @@ Snapshot::takeScreenshot(uint32_t *buf, bool pal)
     uint32_t *target = header.screenshot.screen;
     buf += x_start + y_start * NTSC_PIXELS;
     for (unsigned i = 0; i < header.screenshot.height; i++) {
-        memcpy(target, buf, header.screenshot.width * 4);
+        for (unsigned j = 0; j < header.screenshot.width; j++)
+            target[j] = palette[buf[j] & 0x0F];
         target += header.screenshot.width;
         buf += NTSC_PIXELS;
     }
@@ -26,7 +26,7 @@
 // Snapshot version number of this release
 #define V_MAJOR 1
 #define V_MINOR 4
-#define V_SUBMINOR 2
+#define V_SUBMINOR 5
 
 // Forward declarations
 class C64;
@@ -143,7 +143,10 @@ public:
     unsigned getImageHeight() { return header.screenshot.height; }
 
     //! Take screenshot
-    void takeScreenshot(uint32_t *buf, bool pal);
+    /*! @param buf     Screen buffer (one color index per pixel)
+     *  @param palette RGBA values of all sixteen colors
+     */
+    void takeScreenshot(const uint8_t *buf, const uint32_t *palette, bool pal);
 
 };
 
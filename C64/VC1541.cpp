@@ -27,6 +27,12 @@ VC1541::VC1541()
 	cpu.setDescription("1541CPU");
     cpu.chipModel = CPU::MOS6502;
     
+    // Establish bindings
+    cpu.floppy = this;
+    mem.floppy = this;
+    via1.floppy = this;
+    via2.floppy = this;
+    
     // Register sub components
     VirtualComponent *subcomponents[] = { &mem, &cpu, &via1, &via2, &disk, NULL };
     registerSubComponents(subcomponents, sizeof(subcomponents)); 
@@ -58,12 +64,33 @@ VC1541::VC1541()
     registerSnapshotItems(items, sizeof(items));
     
     sendSoundMessages = true;
+    deviceNr = 8;
+    fastRotation = false;
+    fastRotationEnabled = true;
     resetDisk();
+    
+    threaded = false;
+    detached = false;
+    stopThread = false;
+    threadRunning = false;
+    threadWaiting = false;
+    attachRequested = false;
+    numCheckpoints = 0;
+    lockstepClock = NULL;
+    pthread_mutex_init(&threadLock, NULL);
+    pthread_cond_init(&threadCond, NULL);
 }
 
 VC1541::~VC1541()
 {
 	debug(3, "Releasing VC1541...\n");
+    
+    // The C64 has taken back the drive when it was halted
+    assert(!detached);
+    if (threaded)
+        stopDriveThread();
+    pthread_cond_destroy(&threadCond);
+    pthread_mutex_destroy(&threadLock);
 }
 
 void
@@ -77,6 +104,34 @@ VC1541::reset()
     cpu.mem = &mem;
     cpu.setPC(0xEAA0);
     halftrack = 41;
+    
+    sleeping = false;
+    wakeUpCycle = 0;
+    sleepCycle = 0;
+    fastRotation = false;
+    invalidateSyncMap();
+}
+
+void
+VC1541::loadFromBuffer(uint8_t **buffer)
+{
+    VirtualComponent::loadFromBuffer(buffer);
+    
+    // Sleep state and fast rotation state are not part of the snapshot
+    sleeping = false;
+    wakeUpCycle = 0;
+    sleepCycle = 0;
+    fastRotation = false;
+    invalidateSyncMap();
+    iec->scheduleDrives();
+}
+
+void
+VC1541::saveToBuffer(uint8_t **buffer)
+{
+    wakeUp();
+    syncRotation();
+    VirtualComponent::saveToBuffer(buffer);
 }
 
 void
@@ -84,19 +139,29 @@ VC1541::resetDisk()
 {
     debug (3, "Resetting disk in VC1541...\n");
     
+    syncRotation();
+    invalidateSyncMap();
+    
     // Disk properties
     disk.clearDisk();
     diskInserted = false;
     diskPartiallyInserted = false;
 }
 
+void
+VC1541::putMessage(int id, int i)
+{
+    if (deviceNr == 8)
+        c64->putMessage(id, i);
+}
+
 void
 VC1541::ping()
 {
     debug(3, "Pinging VC1541...\n");
-    c64->putMessage(MSG_VC1541_LED, redLED ? 1 : 0);
-    c64->putMessage(MSG_VC1541_MOTOR, rotating ? 1 : 0);
-    c64->putMessage(MSG_VC1541_DISK, diskInserted ? 1 : 0);
+    putMessage(MSG_VC1541_LED, redLED ? 1 : 0);
+    putMessage(MSG_VC1541_MOTOR, rotating ? 1 : 0);
+    putMessage(MSG_VC1541_DISK, diskInserted ? 1 : 0);
 
     // TODO: Replace manual pinging of sub components by a call to super::ping()
     cpu.ping();
@@ -109,6 +174,9 @@ VC1541::ping()
 void 
 VC1541::dumpState()
 {
+    wakeUp();
+    syncRotation();
+    
 	msg("VC1541\n");
 	msg("------\n\n");
 	msg(" Bit ready timer : %d\n", bitReadyTimer);
@@ -119,6 +187,585 @@ VC1541::dumpState()
     disk.dumpState();
 }
 
+bool
+VC1541::sleep()
+{
+    // Only park in front of an instruction
+    if (!cpu.atBeginningOfNewCommand())
+        return false;
+    
+    // Don't park if an interrupt is pending or the C64 is talking to the drive
+    if (cpu.getIRQLine(0xFF) || !iec->getAtnLine())
+        return false;
+    
+    // Make sure we are really inside the idle loop of a compatible ROM
+    if (mem.mem[idleJumpAddr] != 0x4C ||
+        mem.mem[idleJumpAddr + 1] != LO_BYTE(idleLoopAddr) ||
+        mem.mem[idleJumpAddr + 2] != HI_BYTE(idleLoopAddr))
+        return false;
+    
+    // Wake up when the next timer underflow is processed
+    uint64_t idle1 = via1.idleCyclesUntilUnderflow();
+    uint64_t idle2 = via2.idleCyclesUntilUnderflow();
+    uint64_t idle = (idle1 < idle2) ? idle1 : idle2;
+    if (idle == 0)
+        return false;
+    
+    // The CPU is skipped in this cycle, the VIAs starting with the next one
+    uint64_t now = *cpu.clock;
+    wakeUpCycle = (idle == UINT64_MAX) ? UINT64_MAX : now + idle + 1;
+    sleepCycle = now + 1;
+    sleeping = true;
+    return true;
+}
+
+void
+VC1541::_wakeUp(uint64_t cycle)
+{
+    assert(sleeping);
+    assert(cycle >= sleepCycle);
+    
+    // Catch up with the skipped cycles
+    via1.skipCycles(cycle - sleepCycle);
+    via2.skipCycles(cycle - sleepCycle);
+    
+    sleeping = false;
+    wakeUpCycle = 0;
+    
+    // Make sure the drive is executed in the next cycle (the drive thread schedules itself)
+    if (!detached)
+        iec->scheduleDrives();
+}
+
+// ---------------------------------------------------------------------------------------------
+//                                         Drive thread
+// ---------------------------------------------------------------------------------------------
+
+void
+VC1541::setThreaded(bool enable)
+{
+    if (enable == threaded)
+        return;
+    
+    c64->suspend();
+    
+    if (enable) {
+        
+        debug(2, "Running the drive on a separate thread\n");
+        stopThread = false;
+        threaded = true;
+        pthread_create(&thread, NULL, threadMain, (void *)this);
+        
+    } else {
+        
+        debug(2, "Running the drive in lockstep with the C64\n");
+        attach();
+        stopDriveThread();
+    }
+    
+    c64->resume();
+}
+
+void
+VC1541::stopDriveThread()
+{
+    assert(threaded && !detached);
+    
+    pthread_mutex_lock(&threadLock);
+    stopThread = true;
+    pthread_cond_signal(&threadCond);
+    pthread_mutex_unlock(&threadLock);
+    pthread_join(thread, NULL);
+    threaded = false;
+}
+
+void
+VC1541::detach()
+{
+    assert(threaded && !detached && !threadRunning);
+    
+    // From now on, the CPU is clocked by the drive thread
+    clock = c64->getCycles();
+    lockstepClock = cpu.clock;
+    cpu.clock = &clock;
+    
+    inputsPosted = inputsSeen = inputsReleased = 0;
+    nextInput = 0;
+    lastInputCycle = clock;
+    busLogWritten = busLogRead = 0;
+    busLogFloor = 0;
+    journalBegin = journalEnd = 0;
+    numCheckpoints = 0;
+    attachRequested = false;
+    errorCycle = UINT64_MAX;
+    driveCycle = clock;
+    c64Cycle = clock;
+    syncedCycle = clock;
+    lastCiaBits = iec->getPackedCiaPins();
+    iec->resetCiaView();
+    detached = true;
+    
+    pthread_mutex_lock(&threadLock);
+    threadRunning = true;
+    pthread_cond_signal(&threadCond);
+    pthread_mutex_unlock(&threadLock);
+}
+
+bool
+VC1541::attach()
+{
+    if (!detached)
+        return false;
+    
+    // Let the drive thread execute the drive up to the current cycle
+    uint64_t now = c64->getCycles();
+    attachCycle = now;
+    attachRequested = true;
+    notifyThread();
+    while (threadRunning) {
+        readBusLog(stableCycle(now));
+        sched_yield();
+    }
+    readBusLog(now);
+    assert(clock == now);
+    assert(busLogRead == busLogWritten);
+    
+    cpu.clock = lockstepClock;
+    detached = false;
+    iec->scheduleDrives();
+    return true;
+}
+
+void
+VC1541::publishProgress(uint64_t cycle)
+{
+    if (cycle > c64Cycle.load(std::memory_order_relaxed)) {
+        c64Cycle = cycle;
+        notifyThread();
+    }
+}
+
+void
+VC1541::postCiaPins(uint8_t data, uint8_t direction)
+{
+    // Writes that don't change the IEC pins have no effect
+    uint8_t bits = IEC::packCiaPins(data, direction);
+    if (bits == lastCiaBits)
+        return;
+    lastCiaBits = bits;
+    
+    uint64_t now = c64->getCycles();
+    uint32_t posted = inputsPosted.load(std::memory_order_relaxed);
+    
+    // Wait for the drive thread if the queue is full
+    if (posted - inputsReleased.load(std::memory_order_acquire) == inputQueueSize) {
+        synchronize(now);
+        while (posted - inputsReleased.load(std::memory_order_acquire) == inputQueueSize)
+            sched_yield();
+    }
+    
+    BusInput *input = &inputs[posted % inputQueueSize];
+    input->cycle = now;
+    input->data = data;
+    input->direction = direction;
+    inputsPosted = posted + 1;
+    notifyThread();
+}
+
+uint64_t
+VC1541::stableCycle(uint64_t cycle)
+{
+    // Bus changes after the first input the drive thread hasn't seen yet may be rolled back
+    uint32_t seen = inputsSeen.load(std::memory_order_acquire);
+    if (seen != inputsPosted.load(std::memory_order_relaxed) && inputs[seen % inputQueueSize].cycle < cycle)
+        return inputs[seen % inputQueueSize].cycle;
+    return cycle;
+}
+
+void
+VC1541::synchronize(uint64_t cycle)
+{
+    if (cycle <= syncedCycle)
+        return;
+    
+    publishProgress(cycle);
+    
+    while (inputsSeen.load(std::memory_order_acquire) != inputsPosted.load(std::memory_order_relaxed) ||
+           driveCycle.load(std::memory_order_acquire) < cycle) {
+        readBusLog(stableCycle(cycle));
+        sched_yield();
+    }
+    
+    readBusLog(cycle);
+    syncedCycle = cycle;
+}
+
+bool
+VC1541::errorIsFinal(uint64_t cycle)
+{
+    // The error vanishes if the drive thread rolls back
+    synchronize(cycle + 1);
+    return errorCycle <= cycle;
+}
+
+void
+VC1541::readBusLog(uint64_t cycle)
+{
+    BusChange last = { 0, false, false };
+    
+    pthread_mutex_lock(&threadLock);
+    uint32_t first = busLogRead.load(std::memory_order_relaxed);
+    uint32_t read = first;
+    for (; read != busLogWritten && busLog[read % busLogSize].cycle < cycle; read++)
+        last = busLog[read % busLogSize];
+    busLogRead = read;
+    pthread_mutex_unlock(&threadLock);
+    
+    // Only the latest change is visible. Don't hold the lock here, because messages may be sent
+    if (read != first)
+        iec->updateCiaView(last.clock, last.data);
+}
+
+void
+VC1541::logBusChange(bool clockLine, bool dataLine)
+{
+    // When the drive thread executes cycles again, earlier changes are already in the log
+    if (clock < busLogFloor)
+        return;
+    
+    pthread_mutex_lock(&threadLock);
+    assert(busLogWritten - busLogRead.load(std::memory_order_relaxed) < busLogSize);
+    BusChange *change = &busLog[busLogWritten++ % busLogSize];
+    change->cycle = clock;
+    change->clock = clockLine;
+    change->data = dataLine;
+    pthread_mutex_unlock(&threadLock);
+}
+
+void
+VC1541::notifyThread()
+{
+    if (threadWaiting) {
+        pthread_mutex_lock(&threadLock);
+        pthread_cond_signal(&threadCond);
+        pthread_mutex_unlock(&threadLock);
+    }
+}
+
+void *
+VC1541::threadMain(void *drive)
+{
+    ((VC1541 *)drive)->threadLoop();
+    return NULL;
+}
+
+void
+VC1541::threadLoop()
+{
+    pthread_mutex_lock(&threadLock);
+    
+    while (1) {
+        
+        // Sleep until the C64 hands over the drive
+        while (!stopThread && !threadRunning)
+            pthread_cond_wait(&threadCond, &threadLock);
+        if (stopThread)
+            break;
+        
+        pthread_mutex_unlock(&threadLock);
+        runDetached();
+        pthread_mutex_lock(&threadLock);
+    }
+    
+    pthread_mutex_unlock(&threadLock);
+}
+
+void
+VC1541::runDetached()
+{
+    while (1) {
+        
+        // All inputs before the final cycle have been posted
+        bool attaching = attachRequested;
+        uint64_t final = attaching ? attachCycle : c64Cycle.load();
+        uint32_t logRead = busLogRead;
+        
+        examineInputs();
+        retireCheckpoints(final);
+        
+        if (attaching) {
+            
+            if (clock > attachCycle)
+                rollback(attachCycle);
+            
+            if (clock == attachCycle) {
+                
+                // Hand the drive back to the C64
+                applyInputs();
+                numCheckpoints = 0;
+                journalBegin = journalEnd;
+                threadRunning = false;
+                return;
+            }
+            
+            if (!executeUntil(attachCycle, final))
+                sched_yield();
+            continue;
+        }
+        
+        // Run ahead if the C64 hasn't touched the bus for a while
+        uint64_t limit = final;
+        if (final >= lastInputCycle + quietPeriod)
+            limit += maxLead;
+        
+        if (clock < limit && executeUntil(limit, final))
+            continue;
+        
+        waitForC64(final, logRead);
+    }
+}
+
+bool
+VC1541::executeUntil(uint64_t limit, uint64_t final)
+{
+    uint64_t start = clock;
+    
+    while (clock < limit) {
+        
+        applyInputs();
+        
+        // Stop if new inputs have arrived
+        if (inputsPosted.load(std::memory_order_relaxed) != inputsSeen.load(std::memory_order_relaxed))
+            break;
+        
+        // Stop if the bus log or the write journal is about to overflow
+        if (busLogWritten - busLogRead.load(std::memory_order_relaxed) > busLogSize - 16 ||
+            journalEnd - journalBegin > journalSize - 16)
+            break;
+        
+        // Take a checkpoint once in a while
+        if (cpu.atBeginningOfNewCommand() && numCheckpoints < maxCheckpoints &&
+            (numCheckpoints == 0 || clock - checkpoint[numCheckpoints - 1].cycle >= checkpointInterval))
+            takeCheckpoint();
+        
+        // Only run ahead if we are able to go back
+        if (clock >= final && (numCheckpoints == 0 || checkpoint[0].cycle > final))
+            break;
+        
+        if (clock < wakeUpCycle) {
+            
+            // Skip all cycles in which the drive is parked
+            uint64_t until = wakeUpCycle < limit ? wakeUpCycle : limit;
+            if (nextInput != inputsSeen.load(std::memory_order_relaxed) &&
+                inputs[nextInput % inputQueueSize].cycle < until)
+                until = inputs[nextInput % inputQueueSize].cycle;
+            clock = until;
+            
+        } else {
+            
+            if (!executeOrSkipCycle(clock) && errorCycle.load(std::memory_order_relaxed) == UINT64_MAX)
+                errorCycle = clock;
+            clock++;
+        }
+        
+        driveCycle.store(clock, std::memory_order_release);
+    }
+    
+    return clock != start;
+}
+
+void
+VC1541::waitForC64(uint64_t final, uint32_t logRead)
+{
+    for (unsigned i = 0; i < 64; i++) {
+        if (c64HasNews(final, logRead))
+            return;
+        sched_yield();
+    }
+    
+    pthread_mutex_lock(&threadLock);
+    threadWaiting = true;
+    while (!c64HasNews(final, logRead))
+        pthread_cond_wait(&threadCond, &threadLock);
+    threadWaiting = false;
+    pthread_mutex_unlock(&threadLock);
+}
+
+bool
+VC1541::c64HasNews(uint64_t final, uint32_t logRead)
+{
+    return
+    attachRequested ||
+    c64Cycle != final ||
+    inputsPosted != inputsSeen.load(std::memory_order_relaxed) ||
+    busLogRead != logRead;
+}
+
+void
+VC1541::examineInputs()
+{
+    uint32_t posted = inputsPosted.load(std::memory_order_acquire);
+    uint32_t seen = inputsSeen.load(std::memory_order_relaxed);
+    
+    if (posted == seen)
+        return;
+    
+    // Inputs arrive in cycle order. Go back in time if the first new one is overdue
+    uint64_t cycle = inputs[seen % inputQueueSize].cycle;
+    if (cycle < clock)
+        rollback(cycle);
+    
+    lastInputCycle = inputs[(posted - 1) % inputQueueSize].cycle;
+    inputsSeen.store(posted, std::memory_order_release);
+}
+
+void
+VC1541::applyInputs()
+{
+    uint32_t seen = inputsSeen.load(std::memory_order_relaxed);
+    
+    for (; nextInput != seen && inputs[nextInput % inputQueueSize].cycle == clock; nextInput++) {
+        BusInput *input = &inputs[nextInput % inputQueueSize];
+        iec->applyCiaPins(input->data, input->direction);
+    }
+    assert(nextInput == seen || inputs[nextInput % inputQueueSize].cycle > clock);
+}
+
+void
+VC1541::takeCheckpoint()
+{
+    assert(numCheckpoints < maxCheckpoints);
+    assert(cpu.atBeginningOfNewCommand());
+    
+    syncRotation();
+    
+    Checkpoint *cp = &checkpoint[numCheckpoints++];
+    cp->cycle = clock;
+    cp->input = nextInput;
+    cp->journal = journalEnd;
+    
+    uint8_t *ptr = cp->data;
+    writeBlock(&ptr, mem.mem, 0x800);
+    cpu.saveToBuffer(&ptr);
+    via1.saveToBuffer(&ptr);
+    via2.saveToBuffer(&ptr);
+    iec->saveBusState(&ptr);
+    write16(&ptr, (uint16_t)bitReadyTimer);
+    write8(&ptr, byteReadyCounter);
+    write8(&ptr, rotating);
+    write8(&ptr, redLED);
+    write8(&ptr, (uint8_t)halftrack);
+    write16(&ptr, bitoffset);
+    write8(&ptr, zone);
+    write16(&ptr, read_shiftreg);
+    write8(&ptr, write_shiftreg);
+    write8(&ptr, sync);
+    write8(&ptr, freshBits);
+    write8(&ptr, sleeping);
+    write64(&ptr, wakeUpCycle);
+    write64(&ptr, sleepCycle);
+    write8(&ptr, disk.isModified());
+    assert(ptr - cp->data <= (long)sizeof(cp->data));
+}
+
+void
+VC1541::retireCheckpoints(uint64_t final)
+{
+    // Nothing before the final cycle is rolled back. Hence, older checkpoints are not needed anymore
+    unsigned obsolete = 0;
+    while (obsolete + 1 < numCheckpoints && checkpoint[obsolete + 1].cycle <= final)
+        obsolete++;
+    
+    if (obsolete) {
+        numCheckpoints -= obsolete;
+        memmove(checkpoint, checkpoint + obsolete, numCheckpoints * sizeof(Checkpoint));
+    }
+    
+    journalBegin = numCheckpoints ? checkpoint[0].journal : journalEnd;
+    inputsReleased.store(numCheckpoints ? checkpoint[0].input : nextInput, std::memory_order_release);
+}
+
+void
+VC1541::rollback(uint64_t cycle)
+{
+    debug(3, "Rolling back from cycle %llu to cycle %llu\n", clock, cycle);
+    
+    // Find the last checkpoint before the specified cycle
+    unsigned i = numCheckpoints;
+    while (i > 0 && checkpoint[i - 1].cycle > cycle)
+        i--;
+    assert(i > 0);
+    Checkpoint *cp = &checkpoint[i - 1];
+    numCheckpoints = i;
+    
+    bool led = redLED;
+    bool motor = rotating;
+    
+    // Undo all disk writes
+    bool diskChanged = (journalEnd != cp->journal);
+    while (journalEnd != cp->journal) {
+        DiskWrite *w = &journal[--journalEnd % journalSize];
+        disk.data.halftrack[w->halftrack][w->offset] = w->value;
+    }
+    
+    uint8_t *ptr = cp->data;
+    readBlock(&ptr, mem.mem, 0x800);
+    cpu.loadFromBuffer(&ptr);
+    via1.loadFromBuffer(&ptr);
+    via2.loadFromBuffer(&ptr);
+    iec->loadBusState(&ptr);
+    bitReadyTimer = (int16_t)read16(&ptr);
+    byteReadyCounter = read8(&ptr);
+    rotating = read8(&ptr);
+    redLED = read8(&ptr);
+    halftrack = read8(&ptr);
+    bitoffset = read16(&ptr);
+    zone = read8(&ptr);
+    read_shiftreg = read16(&ptr);
+    write_shiftreg = read8(&ptr);
+    sync = read8(&ptr);
+    freshBits = read8(&ptr);
+    sleeping = read8(&ptr);
+    wakeUpCycle = read64(&ptr);
+    sleepCycle = read64(&ptr);
+    disk.setModified(read8(&ptr));
+    fastRotation = false;
+    if (diskChanged)
+        invalidateSyncMap();
+    
+    clock = cp->cycle;
+    nextInput = cp->input;
+    
+    // Remove all bus changes from the specified cycle on. Earlier ones are logged already
+    pthread_mutex_lock(&threadLock);
+    while (busLogWritten != busLogRead.load(std::memory_order_relaxed) &&
+           busLog[(busLogWritten - 1) % busLogSize].cycle >= cycle)
+        busLogWritten--;
+    pthread_mutex_unlock(&threadLock);
+    busLogFloor = cycle;
+    
+    if (errorCycle >= cycle)
+        errorCycle = UINT64_MAX;
+    driveCycle.store(clock, std::memory_order_release);
+    
+    // Keep the GUI up to date
+    if (led != redLED)
+        putMessage(MSG_VC1541_LED, redLED ? 1 : 0);
+    if (motor != rotating)
+        putMessage(MSG_VC1541_MOTOR, rotating ? 1 : 0);
+}
+
+void
+VC1541::journalDiskWrite()
+{
+    assert(journalEnd - journalBegin < journalSize);
+    
+    DiskWrite *w = &journal[journalEnd++ % journalSize];
+    w->halftrack = (uint8_t)halftrack;
+    w->offset = (uint16_t)((bitoffset % disk.length.halftrack[halftrack]) / 8);
+    w->value = disk.data.halftrack[halftrack][w->offset];
+}
+
 void
 VC1541::executeBitReady()
 {
@@ -128,6 +775,8 @@ VC1541::executeBitReady()
         
         // Read mode
         read_shiftreg |= readBitFromHead();
+        if (freshBits < 16)
+            freshBits++;
 
         // Set SYNC signal
         if ((read_shiftreg & 0x3FF) == 0x3FF) {
@@ -146,6 +795,7 @@ VC1541::executeBitReady()
         // Write mode
         writeBitToHead(write_shiftreg & 0x80);
         disk.setModified(true); 
+        invalidateSyncMap();
         sync = false;
     }
     write_shiftreg <<= 1;
@@ -175,6 +825,190 @@ VC1541::executeByteReady()
     }
 }
 
+void
+VC1541::computeSyncMap()
+{
+    uint8_t *data = disk.data.halftrack[halftrack];
+    unsigned length = disk.length.halftrack[halftrack];
+    unsigned ones = 0;
+    bool prevSync;
+    
+    memset(syncMap, 0, sizeof(syncMap));
+    numSyncEnds = 0;
+    
+    // The track is a ring. Hence, the SYNC signal in front of bit 0 depends on the last bits
+    for (unsigned i = length - 16; i < length; i++)
+        ones = disk.readBit(data, i) ? ones + 1 : 0;
+    prevSync = (ones >= 10);
+    
+    for (unsigned i = 0; i < length; i++) {
+        
+        ones = disk.readBit(data, i) ? ones + 1 : 0;
+        if (ones >= 10) {
+            disk.setBit(syncMap, i);
+        } else if (prevSync) {
+            assert(numSyncEnds < sizeof(syncEnd) / sizeof(syncEnd[0]));
+            syncEnd[numSyncEnds++] = i;
+        }
+        prevSync = (ones >= 10);
+    }
+    
+    syncMapHalftrack = halftrack;
+}
+
+unsigned
+VC1541::distanceToSyncEnd(unsigned pos)
+{
+    if (numSyncEnds == 0)
+        return 0;
+    
+    // Find the first entry greater than pos
+    unsigned lo = 0, hi = numSyncEnds;
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+        if (syncEnd[mid] <= pos) lo = mid + 1; else hi = mid;
+    }
+    
+    if (lo < numSyncEnds)
+        return syncEnd[lo] - pos;
+    return syncEnd[0] + disk.length.halftrack[halftrack] - pos;
+}
+
+uint16_t
+VC1541::bitsEndingAt(unsigned pos)
+{
+    uint8_t *data = disk.data.halftrack[halftrack];
+    unsigned length = disk.length.halftrack[halftrack];
+    uint16_t result = 0;
+    
+    if (pos >= 15) {
+        
+        // Fast path: Collect the (at most three) bytes containing the requested bits
+        unsigned first = pos - 15;
+        uint32_t window = 0;
+        for (unsigned i = first / 8; i <= pos / 8; i++)
+            window = (window << 8) | data[i];
+        return (uint16_t)(window >> (7 - pos % 8));
+    }
+    
+    for (unsigned i = pos + length - 15; i <= pos + length; i++)
+        result = (result << 1) | disk.readBit(data, i % length);
+    return result;
+}
+
+void
+VC1541::startFastRotation()
+{
+    assert(!fastRotation);
+    assert(freshBits == 16);
+    
+    unsigned length = disk.length.halftrack[halftrack];
+    if (!readMode() || length < 64)
+        return;
+    
+    if (syncMapHalftrack != halftrack)
+        computeSyncMap();
+    
+    // Position of the last bit that has been read
+    unsigned pos = (bitoffset + length - 1) % length;
+    assert(read_shiftreg == bitsEndingAt(pos));
+    assert(sync == syncAt(pos));
+    
+    // Determine the next bit that completes a byte outside a SYNC mark.
+    // If SYNC drops, the byte ready counter restarts and a byte is complete seven bits later. SYNC
+    // requires ten 1s in a row. Hence, it can neither drop nor rise again within these seven bits.
+    unsigned bits = 8 - byteReadyCounter;
+    unsigned end = distanceToSyncEnd(pos);
+    eventIsByteReady = true;
+    
+    if (end && end <= bits) {
+        bits = end + 7;
+    } else if (syncAt((pos + bits) % length)) {
+        end = distanceToSyncEnd((pos + bits) % length);
+        bits = end ? bits + end + 7 : UINT_MAX;
+    }
+    
+    // Don't skip too far (SYNC marks may be very long on copy protected disks)
+    if (bits > maxSkippedBits) {
+        bits = maxSkippedBits;
+        eventIsByteReady = false;
+    }
+    
+    // Convert the number of bits into cycles
+    int32_t timer = bitReadyTimer;
+    uint32_t cycles = 0;
+    for (unsigned i = 0; i < bits; i++) {
+        uint32_t wait = timer > 0 ? (timer + 15) / 16 : 0;
+        cycles += wait + 1;
+        timer += cyclesPerBit[zone] - 16 * wait;
+    }
+    
+    bitsToNextEvent = bits;
+    cyclesToNextEvent = cycles;
+    skippedCycles = 0;
+    fastRotation = true;
+}
+
+unsigned
+VC1541::catchUpRotation()
+{
+    assert(fastRotation);
+    
+    unsigned length = disk.length.halftrack[halftrack];
+    unsigned pos = (bitoffset + length - 1) % length;
+    
+    // Replay the bit ready timer
+    int32_t timer = bitReadyTimer;
+    uint32_t cycles = skippedCycles;
+    unsigned bits = 0;
+    for (;;) {
+        uint32_t wait = timer > 0 ? (timer + 15) / 16 : 0;
+        if (wait + 1 > cycles) {
+            timer -= 16 * cycles;
+            break;
+        }
+        cycles -= wait + 1;
+        timer += cyclesPerBit[zone] - 16 * wait;
+        bits++;
+    }
+    assert(bits <= bitsToNextEvent);
+    bitReadyTimer = (int16_t)timer;
+    
+    if (bits) {
+        
+        // Find the last position in which the SYNC signal has dropped
+        unsigned lastEnd = 0, end;
+        while ((end = distanceToSyncEnd((pos + lastEnd) % length)) && lastEnd + end <= bits)
+            lastEnd += end;
+        
+        // Update the byte ready counter
+        if (lastEnd)
+            byteReadyCounter = (bits - lastEnd + 1) % 8;
+        else
+            byteReadyCounter = (byteReadyCounter + bits) % 8;
+        
+        // Move the head
+        pos = (pos + bits) % length;
+        bitoffset = (pos + 1) % length;
+        read_shiftreg = bitsEndingAt(pos);
+        write_shiftreg <<= (bits < 8 ? bits : 8);
+        sync = syncAt(pos);
+    }
+    
+    fastRotation = false;
+    return bits;
+}
+
+void
+VC1541::finishFastRotation()
+{
+    if (catchUpRotation() == bitsToNextEvent && eventIsByteReady) {
+        assert(byteReadyCounter == 0 && !sync);
+        executeByteReady();
+    }
+    startFastRotation();
+}
+
 inline void
 VC1541::byteReady(uint8_t byte)
 {
@@ -212,6 +1046,7 @@ VC1541::setZone(uint8_t z)
 {
     assert (z <= 3);
     
+    syncRotation();
     if (z != zone) {
         debug(3, "Switching from disk zone %d to disk zone %d\n", zone, z);
         zone = z;
@@ -223,28 +1058,32 @@ VC1541::setRedLED(bool b)
 {
     if (!redLED && b) {
         redLED = true;
-        c64->putMessage(MSG_VC1541_LED, 1);
+        putMessage(MSG_VC1541_LED, 1);
     } else if (redLED && !b) {
         redLED = false;
-        c64->putMessage(MSG_VC1541_LED, 0);
+        putMessage(MSG_VC1541_LED, 0);
     }
 }
 
 void
 VC1541::setRotating(bool b)
 {
+    syncRotation();
+    
     if (!rotating && b) {
         rotating = true;
-        c64->putMessage(MSG_VC1541_MOTOR, 1);
+        putMessage(MSG_VC1541_MOTOR, 1);
     } else if (rotating && !b) {
         rotating = false;
-        c64->putMessage(MSG_VC1541_MOTOR, 0);
+        putMessage(MSG_VC1541_MOTOR, 0);
     }
 }
 
 void
 VC1541::moveHeadUp()
 {
+    syncRotation();
+    
     if (halftrack < 84) {
 
         float position = (float)bitoffset / (float)disk.length.halftrack[halftrack];
@@ -260,14 +1099,16 @@ VC1541::moveHeadUp()
    
     assert(disk.isValidDiskPositon(halftrack, bitoffset));
     
-    c64->putMessage(MSG_VC1541_HEAD, 1);
+    putMessage(MSG_VC1541_HEAD, 1);
     if (halftrack % 2 && sendSoundMessages)
-        c64->putMessage(MSG_VC1541_HEAD_SOUND, 1); // play sound for full tracks, only
+        putMessage(MSG_VC1541_HEAD_SOUND, 1); // play sound for full tracks, only
 }
 
 void
 VC1541::moveHeadDown()
 {
+    syncRotation();
+    
     if (halftrack > 1) {
         float position = (float)bitoffset / (float)disk.length.halftrack[halftrack];
         halftrack--;
@@ -282,14 +1123,15 @@ VC1541::moveHeadDown()
     
     assert(disk.isValidDiskPositon(halftrack, bitoffset));
     
-    c64->putMessage(MSG_VC1541_HEAD, 0);
+    putMessage(MSG_VC1541_HEAD, 0);
     if (halftrack % 2 && sendSoundMessages)
-        c64->putMessage(MSG_VC1541_HEAD_SOUND, 0); // play sound for full tracks, only
+        putMessage(MSG_VC1541_HEAD_SOUND, 0); // play sound for full tracks, only
 }
 
 void
 VC1541::setBitAccuracy(bool b)
 {
+    syncRotation();
     bitAccuracy = b;
     
     if (!b) { // If bit accuracy is disabled, ...
@@ -302,11 +1144,22 @@ VC1541::setBitAccuracy(bool b)
     }
 }
 
+void
+VC1541::setDeviceNr(unsigned nr)
+{
+    assert(nr >= 8 && nr < 8 + IEC::maxDrives);
+    deviceNr = nr;
+}
+
 void
 VC1541::insertDisk(Archive *a)
 {
     assert(a != NULL);
     
+    // The drive thread takes care of the rotation itself
+    if (!detached)
+        syncRotation();
+    
     D64Archive *d64 = (D64Archive *)a;
     G64Archive *g64 = (G64Archive *)a;
     NIBArchive *nib = (NIBArchive *)a;
@@ -316,18 +1169,23 @@ VC1541::insertDisk(Archive *a)
         case D64_CONTAINER:
             
             ejectDisk();
+            c64->suspend();
             disk.encodeArchive(d64);
+            if (deviceNr == 8)
+                c64->iec.setVirtualDisk(D64Archive::archiveFromD64Archive(d64));
             break;
             
         case G64_CONTAINER:
             
             ejectDisk();
+            c64->suspend();
             disk.encodeArchive(g64);
             break;
 
         case NIB_CONTAINER:
             
             ejectDisk();
+            c64->suspend();
             disk.encodeArchive(nib);
             break;
 
@@ -337,13 +1195,27 @@ VC1541::insertDisk(Archive *a)
             return;
     }
     
+    invalidateSyncMap();
     diskInserted = true;
-    c64->putMessage(MSG_VC1541_DISK, 1);
+    putMessage(MSG_VC1541_DISK, 1);
     if (sendSoundMessages)
-        c64->putMessage(MSG_VC1541_DISK_SOUND, 1);
+        putMessage(MSG_VC1541_DISK_SOUND, 1);
 
     // If bit accuracy is disabled, we write-protect the disk
     disk.setWriteProtection(true);
+    c64->resume();
+}
+
+void
+VC1541::updateDisk(D64Archive *a)
+{
+    assert(a != NULL);
+    assert(!detached);
+    
+    // Let the head pass over the old data first
+    syncRotation();
+    disk.encodeArchive(a);
+    invalidateSyncMap();
 }
 
 void 
@@ -359,15 +1231,19 @@ VC1541::ejectDisk()
 	sleepMicrosec((uint64_t)200000);
 
     // Erase disk data and reset write protection flag
+    c64->suspend();
     resetDisk();
+    if (deviceNr == 8)
+        c64->iec.setVirtualDisk(NULL);
+    c64->resume();
 
 	// Remove disk (this unblocks the light barrier)
 	setDiskPartiallyInserted(false);
 		
     // Notify listener
-	c64->putMessage(MSG_VC1541_DISK, 0);
+	putMessage(MSG_VC1541_DISK, 0);
     if (sendSoundMessages)
-        c64->putMessage(MSG_VC1541_DISK_SOUND, 0);
+        putMessage(MSG_VC1541_DISK_SOUND, 0);
 }
 
 D64Archive *
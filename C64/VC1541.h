@@ -25,6 +25,7 @@
 #include "VIA6522.h"
 #include "Disk525.h"
 #include "D64Archive.h"
+#include <atomic>
 
 // Forward declarations
 class IEC;
@@ -119,6 +120,15 @@ public:
     //! @brief    Enables or disables bit accurate drive emulation.
     void setBitAccuracy(bool b);
 
+    //! @brief    Returns the device number of this drive (8 to 11).
+    inline unsigned getDeviceNr() { return deviceNr; }
+
+    /*! @brief    Sets the device number of this drive
+     *  @details  The number is read by the drive firmware from the two address jumpers (PB5 and PB6 of VIA 1).
+     *            It also determines the slot of the drive on the IEC bus.
+     */
+    void setDeviceNr(unsigned nr);
+
     
     //
     //! @functiongroup Accessing drive properties
@@ -149,6 +159,12 @@ public:
      */
     void insertDisk(Archive *a);
     
+    /*! @brief    Replaces the data of the inserted disk by the contents of a D64 archive
+     *  @details  Used by the IEC fast loader to write back changed files. Unlike insertDisk, the
+     *            disk stays inserted and the read/write logic continues on the new data.
+     */
+    void updateDisk(D64Archive *a);
+    
     //! @brief    Returns true if a disk is partially inserted.
     inline bool isDiskPartiallyInserted() { return diskPartiallyInserted; }
 
@@ -189,8 +205,20 @@ public:
 
         via1.execute();
         via2.execute();
+        
+        // Park the drive if the firmware has nothing to do
+        if (cpu.getPC() == idleLoopAddr && !rotating && sleep())
+            return true;
+        
         uint8_t result = cpu.executeOneCycle();
         
+        // Skip ahead to the next byte ready event if possible
+        if (fastRotation) {
+            if (++skippedCycles >= cyclesToNextEvent)
+                finishFastRotation();
+            return result;
+        }
+        
         // Only proceed if drive is active
         if (!rotating)
             return result;
@@ -209,10 +237,66 @@ public:
         // Bit is ready
         executeBitReady();
         
+        // Skip ahead if the drive is reading a known bit stream
+        if (freshBits == 16 && fastRotationEnabled)
+            startFastRotation();
+        
         return result;
     }
 
+    /*! @brief    Executes the drive for one cycle or skips it if the drive is parked
+     *  @details  This function is called by the C64 in each cycle. It replaces the unconditional call to
+     *            executeOneCycle to avoid emulating the drive while its firmware waits for ATN.
+     *            If the drive runs on its own thread, the function only checks for a CPU error.
+     */
+    inline bool executeOrSkip(uint64_t cycle) {
+        if (detached)
+            return cycle < errorCycle.load(std::memory_order_relaxed) || !errorIsFinal(cycle);
+        return executeOrSkipCycle(cycle);
+    }
+    
+    /*! @brief    Puts the drive back in sync
+     *  @details  The function needs to be called whenever the drive state is accessed from outside or the
+     *            IEC bus changes while the drive might be parked. It catches up with the skipped cycles.
+     */
+    inline void wakeUp() { if (sleeping) _wakeUp(*cpu.clock); }
+
+    /*! @brief    Puts the drive back in sync
+     *  @param    cycle  Next cycle the drive is going to execute. This is the cycle after the current one
+     *            if the drive has already been skipped in the current cycle.
+     */
+    inline void wakeUp(uint64_t cycle) { if (sleeping) _wakeUp(cycle); }
+
+    /*! @brief    Returns the cycle in which the drive needs to be executed next
+     *  @details  Drives that are not parked need to be executed in each cycle (0 is returned).
+     */
+    inline uint64_t getWakeUpCycle() { return wakeUpCycle; }
+    
+    //! @brief    Custom implementation of loadFromBuffer (the drive always wakes up after loading)
+    void loadFromBuffer(uint8_t **buffer);
+    
+    //! @brief    Custom implementation of saveToBuffer (puts a parked drive back in sync first)
+    void saveToBuffer(uint8_t **buffer);
+
 private:
+
+    //! @brief    Helper function for executeOrSkip (used in lockstep mode and by the drive thread)
+    inline bool executeOrSkipCycle(uint64_t cycle) {
+        if (cycle < wakeUpCycle) return true;
+        wakeUp(cycle);
+        return executeOneCycle();
+    }
+
+    /*! @brief    Parks the drive until the next VIA timer underflow
+     *  @details  Parking is only possible if the CPU is about to enter the idle loop of the drive firmware,
+     *            no interrupt is pending, and ATN is not asserted. The CPU and both VIAs are skipped
+     *            until the wake up cycle is reached or the IEC bus changes.
+     *  @result   true, if the drive has been parked
+     */
+    bool sleep();
+    
+    //! @brief    Helper function for wakeUp
+    void _wakeUp(uint64_t cycle);
     
     /*! @brief    Helper method for executeOneCycle
      *  @details  Method is executed whenever a single bit is ready
@@ -258,6 +342,300 @@ private:
     //! @brief    Indicates whether the VC1541 shall provide sound notification messages to the GUI
     bool sendSoundMessages;
 
+    //! @brief    Device number of this drive (8 to 11)
+    unsigned deviceNr;
+
+    /*! @brief    Sends a message to the GUI
+     *  @details  The GUI displays the state of drive 8 only. Messages of other drives are dropped.
+     */
+    void putMessage(int id, int i);
+
+
+    // ---------------------------------------------------------------------------------------------
+    //                                     Idle detection
+    // ---------------------------------------------------------------------------------------------
+
+private:
+    
+    /*! @brief    Entry point of the idle loop of the VC1541 DOS
+     *  @details  The firmware waits for ATN in a loop starting at this address. The loop is closed by a
+     *            JMP instruction at idleJumpAddr which is checked to make sure a compatible ROM is used.
+     */
+    static const uint16_t idleLoopAddr = 0xEBFF;
+    
+    //! @brief    Location of the JMP instruction closing the idle loop
+    static const uint16_t idleJumpAddr = 0xEC9B;
+    
+    //! @brief    Indicates whether the drive is currently parked
+    bool sleeping;
+    
+    /*! @brief    Cycle in which the drive needs to be executed again
+     *  @details  While the drive is parked, IEC::executeDrives skips it until this cycle is reached.
+     *            If the IEC bus doesn't change in the meantime, this is the cycle in which the next
+     *            VIA timer underflow is processed.
+     */
+    uint64_t wakeUpCycle;
+    
+    /*! @brief    First cycle in which the VIAs have been skipped
+     *  @details  Skipped cycles are not counted one by one, because all parked drives are skipped at once.
+     */
+    uint64_t sleepCycle;
+
+
+    // ---------------------------------------------------------------------------------------------
+    //                                   Drive thread
+    // ---------------------------------------------------------------------------------------------
+
+    /*! @brief    A write access of CIA 2 to the IEC pins
+     *  @details  Posted by the C64 and applied by the drive thread at the start of the same cycle.
+     */
+    typedef struct {
+        uint64_t cycle;
+        uint8_t data;
+        uint8_t direction;
+    } BusInput;
+
+    //! @brief    A change of the IEC bus lines (the ATN line is not visible to the C64)
+    typedef struct {
+        uint64_t cycle;
+        bool clock;
+        bool data;
+    } BusChange;
+
+    //! @brief    Old contents of a disk byte that has been overwritten while checkpoints exist
+    typedef struct {
+        uint8_t halftrack;
+        uint8_t value;
+        uint16_t offset;
+    } DiskWrite;
+
+    /*! @brief    Saved drive state
+     *  @details  Contains everything the drive thread needs to go back in time: RAM, CPU, both VIAs,
+     *            the IEC bus and the read/write logic. Disk data is restored from the write journal.
+     */
+    typedef struct {
+        uint64_t cycle;
+        uint32_t input;
+        uint32_t journal;
+        uint8_t data[4096];
+    } Checkpoint;
+
+    //! @brief    Capacity of the input queue, the bus log and the write journal
+    static const unsigned inputQueueSize = 4096;
+    static const unsigned busLogSize = 4096;
+    static const unsigned journalSize = 16384;
+
+    //! @brief    Maximum number of checkpoints kept at the same time
+    static const unsigned maxCheckpoints = 8;
+
+    //! @brief    Minimum distance between two checkpoints in cycles
+    static const uint64_t checkpointInterval = 4096;
+
+    //! @brief    Maximum number of cycles the drive thread may run ahead of the C64
+    static const uint64_t maxLead = 16384;
+
+    /*! @brief    Number of cycles without CIA accesses to the bus before the drive runs ahead
+     *  @details  While the C64 is talking to the drive, running ahead is pointless because each access
+     *            would roll the drive back. In this phase, the drive thread only executes cycles that
+     *            the C64 has already passed.
+     */
+    static const uint64_t quietPeriod = 2048;
+
+    /*! @brief    Indicates if the drive is executed on its own thread
+     *  @details  In threaded mode, the drive thread takes over as soon as the C64 runs a rasterline.
+     *            The C64 never waits for the drive as long as it doesn't look at the bus. All CIA
+     *            writes to the bus are posted with their cycle and applied by the drive thread at exactly
+     *            the same cycle as in lockstep mode. When CIA 2 reads the bus, the C64 waits until
+     *            the drive has reached the current cycle and looks up the line values in the bus
+     *            log of the drive. If the C64 has been quiet for a while, the drive thread runs ahead
+     *            speculatively, taking checkpoints. If a CIA write arrives for a cycle the drive has
+     *            already executed, the drive goes back to the last checkpoint before that cycle and
+     *            executes the cycles again. Hence, the emulation result is identical to lockstep mode.
+     */
+    bool threaded;
+
+    /*! @brief    Indicates if the drive is currently owned by the drive thread
+     *  @details  Only the C64 thread changes this variable (see detach and attach).
+     */
+    bool detached;
+
+    //! @brief    The drive thread
+    pthread_t thread;
+
+    //! @brief    Mutex protecting the bus log and the condition variable below
+    pthread_mutex_t threadLock;
+
+    //! @brief    Wakes up the drive thread
+    pthread_cond_t threadCond;
+
+    //! @brief    Tells the drive thread to terminate
+    bool stopThread;
+
+    //! @brief    Indicates if the drive thread owns the drive
+    std::atomic<bool> threadRunning;
+
+    //! @brief    Indicates if the drive thread sleeps on threadCond
+    std::atomic<bool> threadWaiting;
+
+    //! @brief    Indicates that the C64 wants the drive back
+    std::atomic<bool> attachRequested;
+
+    //! @brief    Cycle in which the C64 wants the drive back
+    uint64_t attachCycle;
+
+    //! @brief    Cycle counter of the drive thread (next cycle to execute)
+    uint64_t clock;
+
+    //! @brief    Clock of the drive CPU in lockstep mode
+    uint64_t *lockstepClock;
+
+    //! @brief    Published value of clock (written by the drive thread)
+    std::atomic<uint64_t> driveCycle;
+
+    /*! @brief    Progress of the C64 (written by the C64 thread)
+     *  @details  All CIA writes to the bus that happen before this cycle have been posted.
+     */
+    std::atomic<uint64_t> c64Cycle;
+
+    //! @brief    Cycle in which the drive CPU entered an error state (UINT64_MAX if none)
+    std::atomic<uint64_t> errorCycle;
+
+    //! @brief    Cycle up to which the C64 has synchronized with the drive (C64 thread)
+    uint64_t syncedCycle;
+
+    //! @brief    Last posted value of the IEC relevant CIA bits (C64 thread)
+    uint8_t lastCiaBits;
+
+    //! @brief    Posted CIA writes
+    BusInput inputs[inputQueueSize];
+
+    //! @brief    Number of posted inputs (written by the C64 thread)
+    std::atomic<uint32_t> inputsPosted;
+
+    //! @brief    Number of inputs the drive thread has taken into account (written by the drive thread)
+    std::atomic<uint32_t> inputsSeen;
+
+    //! @brief    Number of inputs that are no longer needed (written by the drive thread)
+    std::atomic<uint32_t> inputsReleased;
+
+    //! @brief    Next input to apply (drive thread)
+    uint32_t nextInput;
+
+    //! @brief    Cycle of the last input the drive thread has seen
+    uint64_t lastInputCycle;
+
+    //! @brief    Changes of the bus lines, ordered by cycle (protected by threadLock)
+    BusChange busLog[busLogSize];
+
+    //! @brief    Number of logged changes (drive thread)
+    uint32_t busLogWritten;
+
+    //! @brief    Number of changes the C64 has processed (written by the C64 thread)
+    std::atomic<uint32_t> busLogRead;
+
+    //! @brief    Changes before this cycle are already logged (used while executing cycles again)
+    uint64_t busLogFloor;
+
+    //! @brief    Disk write journal
+    DiskWrite journal[journalSize];
+
+    //! @brief    Journal pointers
+    uint32_t journalBegin, journalEnd;
+
+    //! @brief    Checkpoints (the oldest one comes first)
+    Checkpoint checkpoint[maxCheckpoints];
+
+    //! @brief    Number of checkpoints
+    unsigned numCheckpoints;
+
+    //! @brief    Entry point of the drive thread
+    static void *threadMain(void *drive);
+
+    //! @brief    Main loop of the drive thread
+    void threadLoop();
+
+    //! @brief    Executes the drive until the C64 calls attach
+    void runDetached();
+
+    /*! @brief    Executes the drive up to the specified cycle at the latest
+     *  @details  Cycles beyond the final cycle are only executed if they can be rolled back.
+     *  @return   true if at least one cycle has been executed
+     */
+    bool executeUntil(uint64_t limit, uint64_t final);
+
+    //! @brief    Waits until the C64 has something to say
+    void waitForC64(uint64_t final, uint32_t logRead);
+
+    //! @brief    Checks if the C64 has made progress since the drive thread has looked last
+    bool c64HasNews(uint64_t final, uint32_t logRead);
+
+    //! @brief    Terminates the drive thread
+    void stopDriveThread();
+
+    //! @brief    Wakes up the drive thread if it sleeps
+    void notifyThread();
+
+    //! @brief    Takes all newly posted inputs into account (rolls back if necessary)
+    void examineInputs();
+
+    //! @brief    Applies all inputs belonging to the current cycle
+    void applyInputs();
+
+    //! @brief    Saves the drive state
+    void takeCheckpoint();
+
+    //! @brief    Deletes all checkpoints that are no longer needed
+    void retireCheckpoints(uint64_t final);
+
+    //! @brief    Goes back to the last checkpoint before the specified cycle
+    void rollback(uint64_t cycle);
+
+    //! @brief    Processes all logged bus changes before the specified cycle (C64 thread)
+    void readBusLog(uint64_t cycle);
+
+    //! @brief    Returns the cycle up to which logged bus changes are final (C64 thread)
+    uint64_t stableCycle(uint64_t cycle);
+
+    //! @brief    Publishes the progress of the C64 (C64 thread)
+    void publishProgress(uint64_t cycle);
+
+    //! @brief    Checks if a CPU error of the drive thread is final (C64 thread)
+    bool errorIsFinal(uint64_t cycle);
+
+public:
+
+    //! @brief    Returns true if the drive is executed on its own thread
+    inline bool getThreaded() { return threaded; }
+
+    //! @brief    Moves the drive to its own thread or back into lockstep with the C64
+    void setThreaded(bool enable);
+
+    //! @brief    Returns true if the drive is currently owned by the drive thread
+    inline bool isDetached() { return detached; }
+
+    //! @brief    Hands the drive over to the drive thread (C64 thread, threaded mode only)
+    void detach();
+
+    /*! @brief    Brings the drive back into lockstep with the C64 (C64 thread)
+     *  @details  The drive thread executes the drive up to the current cycle of the C64 and stops.
+     *  @result   true, if the drive has been detached
+     */
+    bool attach();
+
+    //! @brief    Reports the progress of the C64 to the drive thread
+    inline void reportProgress(uint64_t cycle) { if (detached) publishProgress(cycle); }
+
+    //! @brief    Posts a CIA write to the bus (C64 thread)
+    void postCiaPins(uint8_t data, uint8_t direction);
+
+    /*! @brief    Waits until the drive has reached the specified cycle (C64 thread)
+     *  @details  Afterwards, all bus changes before this cycle are visible to the C64.
+     */
+    void synchronize(uint64_t cycle);
+
+    //! @brief    Records a change of the bus lines (drive thread)
+    void logBusChange(bool clockLine, bool dataLine);
+
 
     // ---------------------------------------------------------------------------------------------
     //                                  Read/Write logic
@@ -312,8 +690,104 @@ private:
      */
     bool sync;
             
+    
+    // ---------------------------------------------------------------------------------------------
+    //                                  Fast disk rotation
+    // ---------------------------------------------------------------------------------------------
+    
+    /*! @brief    Number of consecutive bits the head has read from the current halftrack
+     *  @details  Counts up to 16. Once the read shift register holds 16 bits from the current halftrack,
+     *            its contents and the SYNC signal are fully determined by the head position and the
+     *            drive may skip ahead with the help of the SYNC map.
+     */
+    uint8_t freshBits;
+    
+    /*! @brief    SYNC map of the halftrack under the head
+     *  @details  Bit i is set iff the SYNC signal is true after bit i has been read. The map is computed
+     *            when the drive starts skipping on a halftrack and is reused until the head is moved to
+     *            another halftrack or the disk data changes.
+     */
+    uint8_t syncMap[7928];
+    
+    //! @brief    Positions in which the SYNC signal drops (sorted, ascending)
+    uint16_t syncEnd[7928 * 8 / 11 + 1];
+    
+    //! @brief    Number of valid entries in syncEnd
+    unsigned numSyncEnds;
+    
+    //! @brief    Halftrack the SYNC map belongs to (0 if the map is invalid)
+    Halftrack syncMapHalftrack;
+    
+    /*! @brief    Indicates whether the drive skips ahead to the next byte ready event
+     *  @details  While skipping, executeOneCycle only counts cycles. Head position, shift registers,
+     *            SYNC signal and byte ready counter are updated in one step when the next byte ready
+     *            event is due or when somebody looks at the drive (see syncRotation).
+     */
+    bool fastRotation;
+    
+    /*! @brief    Indicates whether the drive may skip ahead at all
+     *  @details  If disabled, the read/write logic always runs bit by bit. This reference mode is
+     *            used to verify the skipping logic.
+     */
+    bool fastRotationEnabled;
+    
+    //! @brief    Maximum number of bits to skip in one go
+    static const unsigned maxSkippedBits = 256;
+    
+    //! @brief    Number of cycles that have been skipped
+    uint32_t skippedCycles;
+    
+    //! @brief    Number of cycles until the next byte ready event
+    uint32_t cyclesToNextEvent;
+    
+    //! @brief    Number of bits until the next byte ready event
+    unsigned bitsToNextEvent;
+    
+    //! @brief    Indicates whether the next event delivers a byte (false, if it is a plain checkpoint)
+    bool eventIsByteReady;
+    
+    //! @brief    Recomputes the SYNC map for the current halftrack
+    void computeSyncMap();
+    
+    //! @brief    Invalidates the SYNC map (called whenever the disk data changes)
+    inline void invalidateSyncMap() { syncMapHalftrack = 0; freshBits = 0; }
+    
+    //! @brief    Returns the SYNC signal after the bit at the specified position has been read
+    inline bool syncAt(unsigned pos) { return disk.readBit(syncMap, pos); }
+    
+    /*! @brief    Returns the distance to the next SYNC drop behind the specified position
+     *  @result   Distance in bits (1 ... track length) or 0, if the signal never drops
+     */
+    unsigned distanceToSyncEnd(unsigned pos);
+    
+    //! @brief    Returns the 16 bits on the current halftrack ending at the specified position
+    uint16_t bitsEndingAt(unsigned pos);
+    
+    //! @brief    Starts skipping to the next byte ready event if the drive state permits
+    void startFastRotation();
+    
+    //! @brief    Brings all skipped cycles up to date and handles the byte ready event
+    void finishFastRotation();
+    
+    /*! @brief    Brings all skipped cycles up to date
+     *  @result   Number of bits that have passed the drive head
+     */
+    unsigned catchUpRotation();
+    
 public:
-
+    
+    /*! @brief    Puts the read/write logic back in sync
+     *  @details  The function needs to be called before the read/write logic or anything affecting it
+     *            (head position, disk zone, read/write mode, motor) is accessed from outside.
+     */
+    inline void syncRotation() { if (fastRotation) catchUpRotation(); }
+    
+    //! @brief    Returns true, iff the drive may skip ahead to the next byte ready event.
+    inline bool getFastRotation() { return fastRotationEnabled; }
+    
+    //! @brief    Enables or disables skipping ahead to byte ready events.
+    void setFastRotation(bool enable) { syncRotation(); fastRotationEnabled = enable; }
+    
     //! @brief    Returns true iff drive is currently in read mode
     bool readMode() { return (via2.io[0x0C] & 0x20); }
 
@@ -327,7 +801,7 @@ public:
     void moveHeadDown();
 
     //! @brief    Returns the current value of the sync signal
-    inline bool getSync() { return sync; }
+    inline bool getSync() { syncRotation(); return sync; }
 
     //! @brief    Returns the current track zone (0 to 3)
     inline bool getZone() { return zone; }
@@ -355,7 +829,12 @@ private:
     inline uint8_t readByteFromHead() { return disk.readByteFromHalftrack(halftrack, bitoffset); }
 
     //! @brief Writes a single bit to the disk head
-    inline void writeBitToHead(uint8_t bit) { disk.writeBitToHalftrack(halftrack, bitoffset, bit); }
+    inline void writeBitToHead(uint8_t bit) {
+        if (numCheckpoints) journalDiskWrite();
+        disk.writeBitToHalftrack(halftrack, bitoffset, bit); }
+
+    //! @brief Saves the disk byte under the head in the write journal
+    void journalDiskWrite();
     
     //! @brief Writes a single byte to the disk head
     inline void writeByteToHead(uint8_t byte) { disk.writeByteToHalftrack(halftrack, bitoffset, byte); }
@@ -373,7 +852,7 @@ private:
     inline void rotateBackByOneByte() { for (unsigned i = 0; i < 8; i++) rotateBack(); }
 
     //! @brief  Align drive head to the beginning of a byte
-    inline void alignHead() { bitoffset &= 0xFFF8; byteReadyCounter = 0; }
+    inline void alignHead() { bitoffset &= 0xFFF8; byteReadyCounter = 0; freshBits = 0; }
 
     //! @brief Signals the CPU that a byte has been processed
     inline void byteReady();
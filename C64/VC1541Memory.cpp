@@ -33,6 +33,14 @@ VC1541Memory::VC1541Memory()
     registerSnapshotItems(items, sizeof(items));
 
 	romFile = NULL;
+    
+    // Only RAM and ROM are free of side effects (RAM repeats multiple times)
+    for (unsigned page = 0x00; page < 0x10; page++) {
+        plainPeekPage[page] = plainPokePage[page] = &mem[(page & 0x07) << 8];
+        physicalPage[page] = page & 0x07;
+    }
+    for (unsigned page = 0xC0; page <= 0xFF; page++)
+        plainPeekPage[page] = &mem[page << 8];
 }
 
 VC1541Memory::~VC1541Memory()
@@ -48,7 +56,6 @@ VC1541Memory::reset()
     // Establish bindings
     cpu = &c64->cpu;
     iec = &c64->iec;
-    floppy = &c64->floppy;
 }
 
 bool 
@@ -159,12 +166,14 @@ VC1541Memory::peek(uint16_t addr)
 void 
 VC1541Memory::pokeRam(uint16_t addr, uint8_t value)
 {
+	codeModified(addr);
 	mem[addr] = value;
 }
 
 void 
 VC1541Memory::pokeRom(uint16_t addr, uint8_t value)
 {
+	codeModified(addr);
 	mem[addr] = value;
 }
              
@@ -185,6 +194,7 @@ VC1541Memory::poke(uint16_t addr, uint8_t value)
 {
 	if (addr < 0x1000) {
 		// RAM (repeats multiply times, hence we apply a bitmask)
+		codeModified(addr);
 		mem[addr & 0x7ff] = value;
 	} else if (addr >= 0xc000) { 
 		// ROM (poking to ROM has no effect)
@@ -34,10 +34,11 @@ private:
 	//! @brief    Reference to the connected IEC bus
 	IEC *iec;
 
-	//! @brief    Reference to the connected disk drive
+public:		
+
+	//! @brief    Reference to the connected disk drive (set up by the drive)
 	VC1541 *floppy;
 	
-public:		
 	//! @brief    The VC1541s memory space
 	uint8_t mem[65536];
 	
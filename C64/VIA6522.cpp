@@ -56,9 +56,6 @@ VIA6522::~VIA6522()
 void VIA6522::reset()
 {
     VirtualComponent::reset();
-
-    // Establish bindings
-    floppy = &c64->floppy;
 }
 
 void 
@@ -146,6 +143,39 @@ VIA6522::executeTimer2()
     }
 }
 
+uint64_t
+VIA6522::idleCyclesUntilUnderflow()
+{
+    if (t1_underflow || t2_underflow)
+        return 0;
+
+    uint64_t result = UINT64_MAX;
+    if (t1) result = t1;
+    if (t2 && t2 < result) result = t2;
+    return result;
+}
+
+void
+VIA6522::skipCycles(uint64_t cycles)
+{
+    if (cycles == 0)
+        return;
+
+    assert(!t1_underflow && !t2_underflow);
+
+    // Stopped timers stay at zero. Running timers count down and hit zero at most once.
+    if (t1) {
+        assert(t1 >= cycles);
+        t1 -= cycles;
+        t1_underflow = (t1 == 0);
+    }
+    if (t2) {
+        assert(t2 >= cycles);
+        t2 -= cycles;
+        t2_underflow = (t2 == 0);
+    }
+}
+
 bool
 VIA6522::IRQ() {
     if (io[0xD] /* IFR */ & io[0xE] /* IER */) {
@@ -411,9 +441,9 @@ uint8_t VIA1::peek(uint16_t addr)
             (ddrb & orb) |      // Values of bits configured as outputs
             (~ddrb & external); // Values of bits configured as inputs
             
-            // Set device address to zero
-            // TODO: Device address is "hard-wired". Set it in "external", above
+            // Bits 5 and 6 are connected to the device address jumpers
             result &= 0x9F;
+            result |= (floppy->getDeviceNr() - 8) << 5;
             
             return result;
         }
@@ -452,7 +482,7 @@ void VIA1::poke(uint16_t addr, uint8_t value)
             // |  in   |               |  out  |  out  |  in   |  out  |  in   |
 
 			orb = value;
-			floppy->iec->updateDevicePins(orb, ddrb);
+			floppy->iec->updateDevicePins(floppy->getDeviceNr(), orb, ddrb);
 			return;
 
 		case 0x1: // ORA - Output register A
@@ -473,7 +503,7 @@ void VIA1::poke(uint16_t addr, uint8_t value)
 		
 		case 0x2:
 			ddrb = value;
-			floppy->iec->updateDevicePins(orb, ddrb);
+			floppy->iec->updateDevicePins(floppy->getDeviceNr(), orb, ddrb);
 			return; 
 						
 		default:
@@ -560,6 +590,9 @@ uint8_t VIA2::peek(uint16_t addr)
 
 void VIA2::poke(uint16_t addr, uint8_t value)
 {
+    // Bring the read/write logic up to date before anything changes
+    floppy->syncRotation();
+    
 	switch(addr) {
 
         case 0x0: { // ORB - Output register B
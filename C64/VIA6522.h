@@ -35,7 +35,7 @@ class VIA6522 : public VirtualComponent {
 	
 public:
 	
-	//! @brief    Reference to the connected disk drive.
+	//! @brief    Reference to the connected disk drive (set up by the drive).
 	VC1541 *floppy;
 
 public:
@@ -126,7 +126,17 @@ public:
 
     //! @brief    Executes timer 2 for one cycle.
     void executeTimer2();
-	
+
+    /*! @brief    Returns the number of cycles that can be skipped without missing a timer underflow
+     *  @details  0, if an underflow is about to be processed. UINT64_MAX, if both timers are stopped.
+     */
+    uint64_t idleCyclesUntilUnderflow();
+
+    /*! @brief    Catches up with cycles that have been skipped while the drive was parked
+     *  @param    cycles  Number of skipped cycles (must not exceed idleCyclesUntilUnderflow())
+     */
+    void skipCycles(uint64_t cycles);
+
 	/*! @brief    Special peek function for the I/O memory range
 	 *  @details  The peek function only handles those registers that are treated similarily by both VIA chips
      */
@@ -441,6 +441,24 @@ public:
 	//! @brief    Returns the screen buffer that is currently stable.
     inline void *screenBuffer() { return pixelEngine.screenBuffer(); }
 
+	//! @brief    Returns the index buffer that is currently stable (one color index per pixel).
+    inline uint8_t *indexScreenBuffer() { return pixelEngine.indexScreenBuffer(); }
+
+	//! @brief    Returns the sequence number of the frame in the stable buffer.
+    inline uint64_t screenBufferFrameNr() { return pixelEngine.screenBufferFrameNr(); }
+
+	//! @brief    Returns the generation of the screen buffer.
+    inline uint64_t screenBufferGeneration() { return pixelEngine.screenBufferGeneration(); }
+
+	//! @brief    Returns true iff a line has changed after the specified generation.
+    inline bool isDirtyLine(unsigned line, uint64_t generation) { return pixelEngine.isDirtyLine(line, generation); }
+
+	//! @brief    Returns the line hashes of the stable buffer.
+    inline const uint64_t *screenBufferLineHashes() { return pixelEngine.screenBufferLineHashes(); }
+
+	//! @brief    Returns the most recently completed frame (emulator thread only).
+    inline const uint8_t *completedIndexBuffer() { return pixelEngine.completedIndexBuffer(); }
+
 	//! @brief    Restores the initial state.
 	void reset();
 		
@@ -467,10 +485,18 @@ public:
     void setChipModel(VICChipModel model);
 	
     //! @brief    Returns one of the sixteen C64 colors in RGBA format.
-    inline uint32_t getColor(unsigned nr) { assert(nr < 16); return pixelEngine.colors[nr]; }
+    inline uint32_t getColor(unsigned nr) { return pixelEngine.getColor(nr); }
 
     //! @brief    Sets one of the sixteen C64 colors in RGBA format.
-    inline void setColor(unsigned nr, int rgba) { assert(nr < 16); pixelEngine.colors[nr] = rgba; }
+    inline void setColor(unsigned nr, int rgba) { pixelEngine.setColor(nr, rgba); }
+
+    /*! @brief    Returns the frame skip interval in warp mode.
+     *  @details  Only every n-th frame is synthesized while warping, 0 means no frame at all.
+     */
+    inline unsigned getWarpFrameInterval() { return pixelEngine.getWarpFrameInterval(); }
+
+    //! @brief    Sets the frame skip interval in warp mode.
+    inline void setWarpFrameInterval(unsigned n) { pixelEngine.setWarpFrameInterval(n); }
 
     // @brief    Returns the number of frames per second.
     inline unsigned getFramesPerSecond() { return isPAL() ? (unsigned)PAL_REFRESH_RATE : (unsigned)NTSC_REFRESH_RATE; }
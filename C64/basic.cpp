@@ -288,23 +288,77 @@ sleepMicrosec(uint64_t usec)
 	}
 }
 
+#ifdef __APPLE__
+
+//! Returns the conversion factor between kernel time and nanoseconds
+static mach_timebase_info_data_t
+timebase()
+{
+    static mach_timebase_info_data_t tb;
+    
+    if (tb.denom == 0) {
+        mach_timebase_info(&tb);
+    }
+    return tb;
+}
+
+uint64_t
+monotonicNanos()
+{
+    mach_timebase_info_data_t tb = timebase();
+    return mach_absolute_time() * tb.numer / tb.denom;
+}
+
+//! Puts the calling thread to sleep until the monotonic clock reaches the specified time
+static void
+waitUntil(uint64_t nanoTargetTime)
+{
+    mach_timebase_info_data_t tb = timebase();
+    mach_wait_until(nanoTargetTime * tb.denom / tb.numer);
+}
+
+#else
+
+uint64_t
+monotonicNanos()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+//! Puts the calling thread to sleep until the monotonic clock reaches the specified time
+static void
+waitUntil(uint64_t nanoTargetTime)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(nanoTargetTime / 1000000000ULL);
+    ts.tv_nsec = (long)(nanoTargetTime % 1000000000ULL);
+    
+    // Restart the sleep if it gets interrupted by a signal
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) { };
+}
+
+#endif
+
 int64_t
-sleepUntil(uint64_t kernelTargetTime, uint64_t kernelEarlyWakeup)
+sleepUntil(uint64_t nanoTargetTime, uint64_t nanoEarlyWakeup)
 {
-    uint64_t now = mach_absolute_time();
+    uint64_t now = monotonicNanos();
     int64_t jitter;
     
-    if (now > kernelTargetTime)
+    if (now > nanoTargetTime)
         return 0;
     
     // Sleep
-    // printf("Sleeping for %d\n", kernelTargetTime - now);
-    mach_wait_until(kernelTargetTime - kernelEarlyWakeup);
+    // printf("Sleeping for %d\n", nanoTargetTime - now);
+    if (nanoTargetTime - now > nanoEarlyWakeup)
+        waitUntil(nanoTargetTime - nanoEarlyWakeup);
     
     // Count some sheep to increase precision
     unsigned sheep = 0;
     do {
-        jitter = mach_absolute_time() - kernelTargetTime;
+        jitter = monotonicNanos() - nanoTargetTime;
         sheep++;
     } while (jitter < 0);
     
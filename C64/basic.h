@@ -32,8 +32,10 @@
 #include <sys/stat.h>
 #include <sys/param.h>
 #include <time.h>
+#ifdef __APPLE__
 #include <mach/mach.h>
 #include <mach/mach_time.h>
+#endif
 #include <unistd.h>
 #include <pthread.h>
 #include <errno.h>
@@ -219,12 +221,18 @@ uint8_t localTimeHour();
 //! @brief    Put the current thread to sleep for a certain amount of time.
 void sleepMicrosec(uint64_t usec);
 
-/*! @brief    Sleeps until kernel timer reaches kernelTargetTime
- *  @param    kernelEarlyWakeup To increase timing precision, the function wakes up the thread earlier
+/*! @brief    Reads the monotonic system clock
+ *  @details  On macOS, the value is derived from mach_absolute_time. On all other systems, CLOCK_MONOTONIC is used.
+ *  @result   Elapsed time in nanoseconds since an arbitrary, but fixed point in the past.
+ */
+uint64_t monotonicNanos();
+
+/*! @brief    Sleeps until the monotonic system clock reaches nanoTargetTime
+ *  @param    nanoEarlyWakeup To increase timing precision, the function wakes up the thread earlier
  *            by this amount and waits actively in a delay loop until the deadline is reached.
- *  @result   Overshoot time (jitter), measured in kernel time. Smaller values are better, 0 is best.
+ *  @result   Overshoot time (jitter) in nanoseconds. Smaller values are better, 0 is best.
  */
-int64_t sleepUntil(uint64_t kernelTargetTime, uint64_t kernelEarlyWakeup = 0);
+int64_t sleepUntil(uint64_t nanoTargetTime, uint64_t nanoEarlyWakeup = 0);
 
 
 //
@@ -0,0 +1,299 @@
+/*
+ * (C) 2017 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Headless front end for the emulator core. Runs a virtual C64 for a given
+// number of frames without any GUI and reports the achieved emulation speed.
+
+#include "C64.h"
+#include <getopt.h>
+
+static void
+usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [options] [file] [disk ...]\n"
+            "\n"
+            "Options:\n"
+            "  -r, --rom FILE      Load a ROM image (Basic, Kernel, Character, or VC1541)\n"
+            "  -f, --frames N      Number of frames to emulate (default: 500)\n"
+            "  -b, --boot N        Frames to run before a PRG, P00 or T64 file is flushed (default: 150)\n"
+            "  -n, --ntsc          Emulate an NTSC machine (default: PAL)\n"
+            "  -t, --realtime      Synchronize with the real-time clock (default: run at maximum speed)\n"
+            "  -x, --translate     Execute guest code in translated blocks (faster, but not cycle exact)\n"
+            "  -s, --skip N        Draw only every N-th frame while warping, 0 draws none (default: 1)\n"
+            "  -o, --video FILE    Record video (YUV4MPEG2, or raw RGBA if FILE ends with .rgba)\n"
+            "  -a, --audio FILE    Record audio into a WAV file\n"
+            "  -l, --fast-loader   Serve KERNAL disk accesses to drive 8 without emulating the drive\n"
+            "  -d, --drive-thread  Execute the VC1541 on a separate thread\n"
+            "  -S, --sid-thread    Synthesize sound on a separate thread\n"
+            "  -D, --drives N      Number of drives connected to the IEC bus, 1 to 4 (default: 1)\n"
+            "  -h, --help          Print this message\n"
+            "\n"
+            "D64 and G64 files are inserted into the floppy drive. PRG, P00 and T64 files\n"
+            "are written into memory once the boot frames have been emulated. Additional\n"
+            "D64 and G64 files are inserted into drive 9, 10, and 11, which are connected\n"
+            "to the bus automatically.\n", prog);
+}
+
+//! Empties the message queue (there is no GUI that would consume the messages)
+static void
+drainMessages(C64 *c64)
+{
+    Message *msg;
+
+    while ((msg = c64->getMessage()) != NULL) {
+        if (msg->id == MSG_ROM_MISSING) {
+            fprintf(stderr, "Missing ROM images (mask %02X)\n", msg->i);
+        }
+    }
+}
+
+//! Runs the emulator until the frame counter reaches the specified value
+static bool
+runUntilFrame(C64 *c64, uint64_t frame)
+{
+    while (c64->getFrame() < frame) {
+        if (!c64->executeOneLine()) {
+            fprintf(stderr, "Execution stopped (CPU error state %d)\n", c64->cpu.getErrorState());
+            return false;
+        }
+        if (c64->getRasterline() == 0) {
+            drainMessages(c64);
+        }
+    }
+    return true;
+}
+
+int
+main(int argc, char *argv[])
+{
+    static struct option options[] = {
+        { "rom",      required_argument, NULL, 'r' },
+        { "frames",   required_argument, NULL, 'f' },
+        { "boot",     required_argument, NULL, 'b' },
+        { "ntsc",     no_argument,       NULL, 'n' },
+        { "realtime", no_argument,       NULL, 't' },
+        { "translate", no_argument,      NULL, 'x' },
+        { "skip",     required_argument, NULL, 's' },
+        { "video",    required_argument, NULL, 'o' },
+        { "audio",    required_argument, NULL, 'a' },
+        { "fast-loader", no_argument,    NULL, 'l' },
+        { "drive-thread", no_argument,   NULL, 'd' },
+        { "sid-thread", no_argument,     NULL, 'S' },
+        { "drives",   required_argument, NULL, 'D' },
+        { "help",     no_argument,       NULL, 'h' },
+        { NULL,       0,                 NULL, 0 }
+    };
+
+    uint64_t frames = 500;
+    uint64_t bootFrames = 150;
+    bool ntsc = false;
+    bool realtime = false;
+    bool translate = false;
+    bool fastLoader = false;
+    bool driveThread = false;
+    bool sidThread = false;
+    unsigned drives = 1;
+    unsigned frameInterval = 1;
+    const char *videoFile = NULL;
+    const char *audioFile = NULL;
+    const char *roms[8];
+    unsigned numRoms = 0;
+    int c;
+
+    while ((c = getopt_long(argc, argv, "r:f:b:ntxs:o:a:ldSD:h", options, NULL)) != -1) {
+        switch (c) {
+            case 'r':
+                if (numRoms < 8) roms[numRoms++] = optarg;
+                break;
+            case 'f':
+                frames = strtoull(optarg, NULL, 10);
+                break;
+            case 'b':
+                bootFrames = strtoull(optarg, NULL, 10);
+                break;
+            case 'n':
+                ntsc = true;
+                break;
+            case 't':
+                realtime = true;
+                break;
+            case 'x':
+                translate = true;
+                break;
+            case 's':
+                frameInterval = (unsigned)strtoul(optarg, NULL, 10);
+                break;
+            case 'o':
+                videoFile = optarg;
+                break;
+            case 'a':
+                audioFile = optarg;
+                break;
+            case 'l':
+                fastLoader = true;
+                break;
+            case 'd':
+                driveThread = true;
+                break;
+            case 'S':
+                sidThread = true;
+                break;
+            case 'D':
+                drives = (unsigned)strtoul(optarg, NULL, 10);
+                if (drives < 1 || drives > IEC::maxDrives) {
+                    fprintf(stderr, "Number of drives must be between 1 and %u\n", IEC::maxDrives);
+                    return 1;
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return c == 'h' ? 0 : 1;
+        }
+    }
+    const char *file = optind < argc ? argv[optind] : NULL;
+
+    C64 *c64 = new C64();
+
+    if (ntsc)
+        c64->setNTSC();
+
+    for (unsigned i = 0; i < numRoms; i++) {
+        if (!c64->loadRom(roms[i])) {
+            fprintf(stderr, "Cannot load ROM image %s\n", roms[i]);
+            return 1;
+        }
+    }
+    if (!c64->isRunnable()) {
+        fprintf(stderr, "Missing ROM images (mask %02X)\n", c64->getMissingRoms());
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Insert disk, if a disk image is given
+    Archive *prg = NULL;
+    if (file) {
+        Archive *disk = NULL;
+        if (D64Archive::isD64File(file)) {
+            disk = D64Archive::archiveFromD64File(file);
+        } else if (G64Archive::isG64File(file)) {
+            disk = G64Archive::archiveFromG64File(file);
+        } else if (PRGArchive::isPRGFile(file)) {
+            prg = PRGArchive::archiveFromPRGFile(file);
+        } else if (P00Archive::isP00File(file)) {
+            prg = P00Archive::archiveFromP00File(file);
+        } else if (T64Archive::isT64File(file)) {
+            prg = T64Archive::archiveFromT64File(file);
+        }
+        if (disk != NULL) {
+            c64->mountArchive(disk);
+            delete disk;
+        }
+        if (!prg && !c64->floppy[0].hasDisk()) {
+            fprintf(stderr, "Cannot load %s\n", file);
+            return 1;
+        }
+    }
+
+    // Insert additional disks into drive 9, 10, ...
+    for (unsigned i = 1; optind + i < (unsigned)argc; i++) {
+        const char *disk = argv[optind + i];
+        Archive *a = NULL;
+        if (i >= IEC::maxDrives) {
+            fprintf(stderr, "Too many disk images (at most %u drives are supported)\n", IEC::maxDrives);
+            return 1;
+        }
+        if (D64Archive::isD64File(disk)) {
+            a = D64Archive::archiveFromD64File(disk);
+        } else if (G64Archive::isG64File(disk)) {
+            a = G64Archive::archiveFromG64File(disk);
+        }
+        if (a == NULL) {
+            fprintf(stderr, "Cannot load %s\n", disk);
+            return 1;
+        }
+        c64->floppy[i].insertDisk(a);
+        delete a;
+        if (drives < i + 1)
+            drives = i + 1;
+    }
+
+    c64->reset();
+    for (unsigned i = 1; i < drives; i++)
+        c64->iec.connectDrive(8 + i);
+    c64->setWarp(!realtime);
+    c64->vic.setWarpFrameInterval(frameInterval);
+    c64->cpu.setTranslation(translate);
+    for (unsigned i = 0; i < IEC::maxDrives; i++)
+        c64->floppy[i].cpu.setTranslation(translate);
+    c64->iec.setFastLoader(fastLoader);
+    c64->floppy[0].setThreaded(driveThread);
+    c64->sid.setThreaded(sidThread);
+    c64->cpu.clearErrorState();
+    for (unsigned i = 0; i < IEC::maxDrives; i++)
+        c64->floppy[i].cpu.clearErrorState();
+    c64->restartTimer();
+
+    // Start recording, if requested
+    if (videoFile || audioFile) {
+        size_t len = videoFile ? strlen(videoFile) : 0;
+        VideoFormat format = (len >= 5 && strcmp(videoFile + len - 5, ".rgba") == 0) ? VIDEO_RGBA : VIDEO_Y4M;
+        if (!c64->recorder.startRecording(videoFile, format, audioFile)) {
+            fprintf(stderr, "Cannot start recording\n");
+            return 1;
+        }
+    }
+
+    uint64_t start = usec();
+    bool success = true;
+
+    // The SID thread (if any) runs while the emulator runs
+    c64->sid.run();
+
+    if (prg) {
+        success = runUntilFrame(c64, bootFrames);
+        c64->flushArchive(prg, 0);
+    }
+    if (success) {
+        success = runUntilFrame(c64, frames);
+    }
+    c64->sid.halt();
+
+    uint64_t elapsed = usec() - start;
+
+    if (c64->recorder.isRecording()) {
+        c64->recorder.stopRecording();
+        printf("Recorded: %llu frames (%llu dropped, %llu audio samples dropped)\n",
+               (unsigned long long)c64->recorder.getRecordedFrames(),
+               (unsigned long long)c64->recorder.getDroppedFrames(),
+               (unsigned long long)c64->recorder.getDroppedSamples());
+    }
+    double seconds = elapsed / 1000000.0;
+
+    printf("Frames:  %llu\n", (unsigned long long)c64->getFrame());
+    printf("Cycles:  %llu\n", (unsigned long long)c64->getCycles());
+    printf("Time:    %.3f sec\n", seconds);
+    if (elapsed > 0) {
+        printf("Speed:   %.2f MHz (%.1f frames/sec)\n",
+               c64->getCycles() / seconds / 1000000.0, c64->getFrame() / seconds);
+    }
+
+    delete prg;
+    delete c64;
+    return success ? 0 : 1;
+}
@@ -18,7 +18,7 @@
 
 #import "C64GUI.h"
 
-#define BUFFERSIZE 2048
+#define BUFFERSIZE 512
 
 #define CHECK_ERROR(ERRNO, RESULT) \
 	if (RESULT != kAudioHardwareNoError) \
@@ -56,15 +56,13 @@ static OSStatus OSX_AudioIOProc16Bit(AudioDeviceID inDevice,
     C64 *c64 = reinterpret_cast<C64*>(inClientData);
     
 	// get samples from SID
-    if (mono) {        
-        for (unsigned i = 0; i < size; i++) {
-            myOutBuffer[i] = c64->sid.readData();
-        }
-    } else {
-        for (unsigned i = 0; i < size; i++) {
-            float value = c64->sid.readData();
-            myOutBuffer[i*2] = value;		// left channel	
-            myOutBuffer[i*2+1] = value;		// right channel
+    c64->sid.readSamples(myOutBuffer, size);
+    
+    // duplicate samples in stereo mode (backwards, so we can do it in place)
+    if (!mono) {
+        for (unsigned i = size; i-- > 0;) {
+            myOutBuffer[i*2+1] = myOutBuffer[i];	// right channel
+            myOutBuffer[i*2] = myOutBuffer[i];		// left channel
         }
     }
 
@@ -120,6 +120,8 @@ class JoystickManager;
 - (void) dump;
 
 - (void *) screenBuffer;
+- (uint64_t) screenBufferGeneration;
+- (BOOL) isDirtyLine:(NSInteger)line since:(uint64_t)generation;
 - (NSColor *) color:(int)nr;
 
 - (uint16_t) memoryBankAddr;
@@ -361,6 +363,8 @@ class JoystickManager;
 - (bool) isDriveConnected;
 - (void) connectDrive;
 - (void) disconnectDrive;
+- (bool) fastLoader;
+- (void) setFastLoader:(bool)b;
 
 @end
 
@@ -451,6 +455,8 @@ class JoystickManager;
 - (void) setDiskModified:(bool)b;
 - (bool) bitAccuracy;
 - (void) setBitAccuracy:(bool)b;
+- (bool) threaded;
+- (void) setThreaded:(bool)b;
 - (bool) soundMessagesEnabled;
 - (void) setSendSoundMessages:(bool)b;
 - (D64ArchiveProxy *) convertToD64;
@@ -612,6 +618,8 @@ class JoystickManager;
 - (void) setAlwaysWarp:(bool)b;
 - (bool) warpLoad;
 - (void) setWarpLoad:(bool)b;
+- (bool) audioPacing;
+- (void) setAudioPacing:(bool)b;
 - (long) cycles;
 - (long) frames;
 
@@ -120,6 +120,9 @@
 - (void) dump { vic->dumpState(); }
 
 - (void *) screenBuffer { return vic->screenBuffer(); }
+- (uint64_t) screenBufferGeneration { return vic->screenBufferGeneration(); }
+- (BOOL) isDirtyLine:(NSInteger)line since:(uint64_t)generation {
+    return vic->isDirtyLine((unsigned)line, generation); }
 
 - (NSColor *) color:(int)nr
 {
@@ -443,6 +446,8 @@
 - (void) connectDrive { iec->connectDrive(); }
 - (void) disconnectDrive { iec->disconnectDrive(); }
 - (bool) isDriveConnected { return iec->driveIsConnected(); }
+- (bool) fastLoader { return iec->getFastLoader(); }
+- (void) setFastLoader:(bool)b { iec->setFastLoader(b); }
 
 @end
 
@@ -552,6 +557,8 @@
 - (void) setDiskModified:(bool)b { vc1541->disk.setModified(b); }
 - (bool) bitAccuracy { return vc1541->getBitAccuracy(); }
 - (void) setBitAccuracy:(bool)b { vc1541->setBitAccuracy(b); }
+- (bool) threaded { return vc1541->getThreaded(); }
+- (void) setThreaded:(bool)b { vc1541->setThreaded(b); }
 - (bool) soundMessagesEnabled { return vc1541->soundMessagesEnabled(); }
 - (void) setSendSoundMessages:(bool)b { vc1541->setSendSoundMessages(b); }
 - (bool) exportToD64:(NSString *)path { return vc1541->exportToD64([path UTF8String]); }
@@ -633,7 +640,7 @@
     joystickB = [[JoystickProxy alloc] initWithJoystick:&c64->joystickB];
     iec = [[IECProxy alloc] initWithIEC:&c64->iec];
     expansionport = [[ExpansionPortProxy alloc] initWithExpansionPort:&c64->expansionport];
-	vc1541 = [[VC1541Proxy alloc] initWithVC1541:&c64->floppy];
+	vc1541 = [[VC1541Proxy alloc] initWithVC1541:&c64->floppy[0]];
     datasette = [[DatasetteProxy alloc] initWithDatasette:&c64->datasette];
 
     // Initialize Joystick HID interface
@@ -737,7 +744,7 @@
 - (bool) loadCharRom:(NSString *)filename { return [self isCharRom:filename] && c64->loadRom([filename UTF8String]); }
 - (bool) isKernelRom:(NSString *)filename { return c64->mem.isKernelRom([filename UTF8String]); }
 - (bool) loadKernelRom:(NSString *)filename { return [self isKernelRom:filename] && c64->loadRom([filename UTF8String]); }
-- (bool) isVC1541Rom:(NSString *)filename { return c64->floppy.mem.is1541Rom([filename UTF8String]); }
+- (bool) isVC1541Rom:(NSString *)filename { return c64->floppy[0].mem.is1541Rom([filename UTF8String]); }
 - (bool) loadVC1541Rom:(NSString *)filename { return [self isVC1541Rom:filename] && c64->loadRom([filename UTF8String]); }
 - (bool) isRom:(NSString *)filename { return [self isBasicRom:filename] || [self isCharRom:filename] || [self isKernelRom:filename] || [self isVC1541Rom:filename]; }
 - (bool) loadRom:(NSString *)filename { return [self loadBasicRom:filename] || [self loadCharRom:filename] || [self loadKernelRom:filename] || [self loadVC1541Rom:filename]; }
@@ -757,6 +764,8 @@
 - (void) setAlwaysWarp:(bool)b { c64->setAlwaysWarp(b); }
 - (bool) warpLoad { return c64->getWarpLoad(); }
 - (void) setWarpLoad:(bool)b { c64->setWarpLoad(b); }
+- (bool) audioPacing { return c64->getAudioPacing(); }
+- (void) setAudioPacing:(bool)b { c64->setAudioPacing(b); }
 
 - (long) cycles { return (long)c64->getCycles(); }
 - (long) frames { return (long)c64->getFrame(); }
@@ -82,6 +82,7 @@ enum TextureFilterType {
     // Textures
     id <MTLTexture> bgTexture; // background image
     id <MTLTexture> textureFromEmulator; // plain C64 screen (as provided by the emulator)
+    uint64_t textureGeneration; // screen buffer generation stored in textureFromEmulator
     id <MTLTexture> filteredTexture; // post-processes C64 screen
     id <MTLTexture> framebufferTexture; // drawing target (GPU buffer)
     id <MTLTexture> depthTexture; // depth buffering
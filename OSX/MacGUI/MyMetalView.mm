@@ -206,18 +206,30 @@
         return;
     }
     
-    void *buf = [[c64proxy vic] screenBuffer]; //    c64->vic.screenBuffer();
+    VICProxy *vic = [c64proxy vic];
+    uint8_t *buf = (uint8_t *)[vic screenBuffer]; //    c64->vic.screenBuffer();
     assert(buf != NULL);
 
     NSUInteger pixelSize = 4;
     NSUInteger width = NTSC_PIXELS;
     NSUInteger height = PAL_RASTERLINES;
     NSUInteger rowBytes = width * pixelSize;
-    NSUInteger imageBytes = rowBytes * height;
     
-    [textureFromEmulator replaceRegion:MTLRegionMake2D(0,0,width,height)
-                           mipmapLevel:0 slice:0 withBytes:buf
-                           bytesPerRow:rowBytes bytesPerImage:imageBytes];
+    // Upload changed lines, only
+    for (NSUInteger first = 0, last; first < height; first = last) {
+        
+        last = first + 1;
+        if (![vic isDirtyLine:first since:textureGeneration])
+            continue;
+        
+        while (last < height && [vic isDirtyLine:last since:textureGeneration])
+            last++;
+        
+        [textureFromEmulator replaceRegion:MTLRegionMake2D(0,first,width,last - first)
+                               mipmapLevel:0 slice:0 withBytes:buf + first * rowBytes
+                               bytesPerRow:rowBytes bytesPerImage:rowBytes * (last - first)];
+    }
+    textureGeneration = [vic screenBufferGeneration];
 }
 
 - (void)setFrame:(CGRect)frame
@@ -88,6 +88,7 @@
     textureFromEmulator = [device newTextureWithDescriptor:textureDescriptor];
     NSAssert(textureFromEmulator != nil, @"Failed to create texture");
     if (textureFromEmulator == nil) { exit(0); }
+    textureGeneration = 0;
     
     // C64 screen (post-processed)
     MTLTextureDescriptor *textureDescriptorPP =
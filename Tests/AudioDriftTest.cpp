@@ -0,0 +1,112 @@
+/*
+ * (C) 2017 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Checks that the adaptive sample rate control of ReSID absorbs clock drift between the emulator
+// and the audio device. The test simulates both clocks: SID produces the samples of one frame at
+// the beginning of each frame and the audio device consumes blocks of samples at a slightly
+// different rate. After the controller has settled, the ringbuffer must neither under- nor
+// overflow, SID must produce samples at the consumer's rate, and the fill level must stay close
+// to the target.
+
+#include "TestMachine.h"
+
+//! Simulated time in seconds
+static const double duration = 120.0;
+
+//! Time the controller gets to settle in seconds
+static const double settleTime = 60.0;
+
+//! Number of samples the audio device reads at once
+static const size_t blockSize = 512;
+
+static void
+testDrift(C64 *c64, double drift)
+{
+    ReSID *resid = c64->sid.resid;
+    double sampleRate = resid->getSampleRate();
+    unsigned cyclesPerFrame = (unsigned)c64->vic.getCyclesPerFrame();
+    double frameTime = (double)cyclesPerFrame / resid->getClockFrequency();
+    double blockTime = blockSize / (sampleRate * (1.0 + drift));
+
+    resid->clearRingbuffer();
+    resid->bufferUnderflows = resid->bufferOverflows = 0;
+
+    float block[blockSize];
+    double nextFrame = 0.0, nextBlock = 0.0;
+    uint64_t written = 0, read = 0;
+    unsigned minFill = UINT_MAX, maxFill = 0;
+    bool settled = false;
+
+    while (nextFrame < duration) {
+
+        if (!settled && nextFrame >= settleTime) {
+            settled = true;
+            resid->bufferUnderflows = resid->bufferOverflows = 0;
+            written = resid->writeDataCnt;
+            read = resid->readDataCnt;
+        }
+
+        if (nextFrame <= nextBlock) {
+            resid->execute(cyclesPerFrame);
+            nextFrame += frameTime;
+        } else {
+            resid->readSamples(block, blockSize);
+            nextBlock += blockTime;
+        }
+
+        if (settled) {
+            minFill = MIN(minFill, resid->samplesInBuffer());
+            maxFill = MAX(maxFill, resid->samplesInBuffer());
+        }
+    }
+
+    written = resid->writeDataCnt - written;
+    read = resid->readDataCnt - read;
+    double ratio = (double)written / (double)read;
+    unsigned target = resid->getTargetFill();
+
+    printf("Drift %+.2f%%: produced/consumed = %.5f, fill level %u - %u (target %u)\n",
+           drift * 100.0, ratio, minFill, maxFill, target);
+
+    CHECK(resid->bufferUnderflows == 0, "%u buffer underflows", resid->bufferUnderflows);
+    CHECK(resid->bufferOverflows == 0, "%u buffer overflows", resid->bufferOverflows);
+    CHECK(fabs(ratio - 1.0) < 0.001, "Producer runs at %.5f times the consumer's rate", ratio);
+    CHECK(minFill + blockSize >= target / 2 && maxFill <= 2 * target + blockSize,
+          "Fill level not held (%u - %u)", minFill, maxFill);
+}
+
+int
+main(int argc, char *argv[])
+{
+    TestRoms roms;
+    C64 *c64 = createTestMachine(&roms, "AudioDriftTest");
+
+    // The controller only runs in real-time mode. SID is clocked directly on this thread.
+    c64->setWarp(false);
+    c64->sid.setThreaded(false);
+    CHECK(c64->sid.resid->getAdaptiveRate(), "Adaptive rate control is disabled");
+
+    testDrift(c64, 0.0);
+    testDrift(c64, 0.003);
+    testDrift(c64, -0.003);
+
+    delete c64;
+
+    printf("AudioDriftTest passed\n");
+    return 0;
+}
@@ -0,0 +1,185 @@
+/*
+ * (C) 2017 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Checks that running the drive on its own thread doesn't change the emulation results. Each
+// scenario is run with the drive in lockstep with the C64 and with the drive on a separate thread.
+// In the first scenario, the drive runs a timer interrupt driven program and the C64 samples the
+// bus. In the second scenario, the C64 drives the IEC lines with CIA 2 and the drive echoes them
+// with VIA 1 after a varying delay. As the C64 writes to the bus all the time, the drive thread
+// has to roll back frequently. Snapshots are taken and restored in between. The machine states
+// must match at all checkpoints.
+
+#include "TestMachine.h"
+
+//! C64 program of the first scenario: Samples the bus
+static const uint8_t samplerProgram[] = {
+    0x78,                           // $FCE2: SEI
+    0xA0, 0x00,                     // $FCE3: LDY #$00
+    0xAD, 0x00, 0xDD,               // $FCE5: LDA $DD00
+    0x99, 0x00, 0x40,               // $FCE8: STA $4000,Y
+    0xC8,                           // $FCEB: INY
+    0x4C, 0xE5, 0xFC                // $FCEC: JMP $FCE5
+};
+
+//! Drive program of the first scenario: Counts VIA 1 timer interrupts
+static const uint8_t timerProgram[] = {
+    0x78,                           // $EAA0: SEI
+    0xA2, 0xFF, 0x9A,               // $EAA1: LDX #$FF, TXS
+    0xA9, 0x40, 0x8D, 0x0B, 0x18,   // $EAA4: VIA 1: Timer 1 free running
+    0xA9, 0xC0, 0x8D, 0x0E, 0x18,   // $EAA9: VIA 1: Enable timer 1 interrupt
+    0xA9, 0x37, 0x8D, 0x04, 0x18,   // $EAAE: VIA 1: Start timer 1
+    0xA9, 0x01, 0x8D, 0x05, 0x18,   // $EAB3:
+    0x58,                           // $EAB8: CLI
+    0xA2, 0x00,                     // $EAB9: LDX #$00
+    0xFE, 0x00, 0x02,               // $EABB: INC $0200,X
+    0xE8,                           // $EABE: INX
+    0xA5, 0x10,                     // $EABF: LDA $10
+    0x9D, 0x00, 0x03,               // $EAC1: STA $0300,X
+    0x4C, 0xBB, 0xEA                // $EAC4: JMP $EABB
+};
+
+//! Interrupt handler of the first scenario
+static const uint8_t timerHandler[] = {
+    0x48,                           // $EB00: PHA
+    0xAD, 0x04, 0x18,               // $EB01: LDA $1804 (acknowledge interrupt)
+    0xE6, 0x10,                     // $EB04: INC $10
+    0x68,                           // $EB06: PLA
+    0x40                            // $EB07: RTI
+};
+
+//! C64 program of the second scenario: Drives the bus and logs the drive's answers to $4000 - $7FFF
+static const uint8_t handshakeProgram[] = {
+    0x78,                           // $FCE2: SEI
+    0xA9, 0x3F, 0x8D, 0x02, 0xDD,   // $FCE3: CIA 2: DDRA = $3F
+    0xA9, 0x00, 0x85, 0xFB,         // $FCE8: Pointer = $4000
+    0xA9, 0x40, 0x85, 0xFC,         // $FCEC:
+    0xA0, 0x00,                     // $FCF0: LDY #$00
+    0x98, 0x29, 0x38, 0x09, 0x03,   // $FCF2: Drive ATN, CLK, and DATA with bits 3 - 5 of Y
+    0x8D, 0x00, 0xDD,               // $FCF7: STA $DD00
+    0xAD, 0x00, 0xDD,               // $FCFA: LDA $DD00
+    0x91, 0xFB,                     // $FCFD: STA ($FB),Y
+    0x98, 0x29, 0x07, 0xAA,         // $FCFF: Wait Y & 7 loop iterations
+    0xCA,                           // $FD03: DEX
+    0x10, 0xFD,                     // $FD04: BPL $FD03
+    0xAD, 0x00, 0xDD,               // $FD06: LDA $DD00
+    0x0A,                           // $FD09: ASL
+    0x51, 0xFB,                     // $FD0A: EOR ($FB),Y
+    0x91, 0xFB,                     // $FD0C: STA ($FB),Y
+    0x98, 0x29, 0x3F,               // $FD0E: Every 64 iterations, keep the bus quiet for a while
+    0xD0, 0x0C,                     // $FD11: BNE $FD1F
+    0xA9, 0x04, 0xA2, 0x00,         // $FD13: LDA #$04, LDX #$00
+    0xCA,                           // $FD17: DEX
+    0xD0, 0xFD,                     // $FD18: BNE $FD17
+    0x38, 0xE9, 0x01,               // $FD1A: SEC, SBC #$01
+    0xD0, 0xF8,                     // $FD1D: BNE $FD17
+    0xC8,                           // $FD1F: INY
+    0xD0, 0xD0,                     // $FD20: BNE $FCF2
+    0xE6, 0xFC,                     // $FD22: INC $FC
+    0xA5, 0xFC, 0xC9, 0x80,         // $FD24: LDA $FC, CMP #$80
+    0xD0, 0xC8,                     // $FD28: BNE $FCF2
+    0xA9, 0x40, 0x85, 0xFC,         // $FD2A: Pointer = $4000
+    0x4C, 0xF2, 0xFC                // $FD2E: JMP $FCF2
+};
+
+//! Drive program of the second scenario: Echoes DATA IN and CLOCK IN on DATA OUT and CLOCK OUT
+static const uint8_t echoProgram[] = {
+    0x78,                           // $EAA0: SEI
+    0xA9, 0x1A, 0x8D, 0x02, 0x18,   // $EAA1: VIA 1: DDRB = $1A
+    0xAD, 0x00, 0x18,               // $EAA6: LDA $1800
+    0x9D, 0x00, 0x03,               // $EAA9: STA $0300,X
+    0x29, 0x05, 0x0A,               // $EAAC: AND #$05, ASL
+    0x8D, 0x00, 0x18,               // $EAAF: STA $1800
+    0xE8, 0x8A, 0x29, 0x03, 0xA8,   // $EAB2: Wait X & 3 loop iterations
+    0x88,                           // $EAB7: DEY
+    0x10, 0xFD,                     // $EAB8: BPL $EAB7
+    0x4C, 0xA6, 0xEA                // $EABA: JMP $EAA6
+};
+
+//! Number of checkpoints per run
+static const unsigned checkpoints = 10;
+
+//! Number of frames between two checkpoints
+static const unsigned framesPerCheckpoint = 20;
+
+//! Saves the machine state into a snapshot and restores it
+static void
+roundTrip(C64 *c64)
+{
+    Snapshot *snapshot = new Snapshot();
+    c64->saveToSnapshot(snapshot);
+    c64->loadFromSnapshot(snapshot);
+    delete snapshot;
+}
+
+//! Runs a scenario and records the machine state at each checkpoint
+static void
+run(TestRoms *roms, const char *name, bool threaded, uint64_t *hashes)
+{
+    C64 *c64 = createTestMachine(roms, name);
+    c64->floppy[0].setThreaded(threaded);
+
+    for (unsigned i = 0; i < checkpoints; i++) {
+
+        uint64_t frame = framesPerCheckpoint * (i + 1);
+
+        // Take a snapshot in the middle of a frame
+        CHECK(runUntilFrame(c64, frame - framesPerCheckpoint / 2), "Machine stopped unexpectedly");
+        for (unsigned line = 0; line < 37 + 13 * i; line++)
+            CHECK(c64->executeOneLine(), "Machine stopped unexpectedly");
+        roundTrip(c64);
+
+        CHECK(runUntilFrame(c64, frame), "Machine stopped unexpectedly");
+        CHECK(c64->floppy[0].isDetached() == threaded, "Drive is not running on its own thread");
+        c64->floppy[0].attach();
+        hashes[i] = stateHash(c64);
+    }
+
+    delete c64;
+}
+
+//! Runs a scenario in both modes and compares the results
+static void
+testScenario(TestRoms *roms, const char *name)
+{
+    uint64_t lockstep[checkpoints], threaded[checkpoints];
+
+    run(roms, name, false, lockstep);
+    run(roms, name, true, threaded);
+
+    for (unsigned i = 0; i < checkpoints; i++)
+        CHECK(lockstep[i] == threaded[i], "%s: Machine states differ in frame %d", name, framesPerCheckpoint * (i + 1));
+}
+
+int
+main(int argc, char *argv[])
+{
+    TestRoms timerRoms;
+    timerRoms.kernalCode(TestRoms::kernalEntry, samplerProgram, sizeof(samplerProgram));
+    timerRoms.driveCode(TestRoms::driveEntry, timerProgram, sizeof(timerProgram));
+    timerRoms.driveCode(0xEB00, timerHandler, sizeof(timerHandler));
+    timerRoms.driveVectors(0xFF00, 0xEB00);
+    testScenario(&timerRoms, "DriveTimer");
+
+    TestRoms handshakeRoms;
+    handshakeRoms.kernalCode(TestRoms::kernalEntry, handshakeProgram, sizeof(handshakeProgram));
+    handshakeRoms.driveCode(TestRoms::driveEntry, echoProgram, sizeof(echoProgram));
+    testScenario(&handshakeRoms, "Handshake");
+
+    printf("DriveThreadTest passed\n");
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * (C) 2017 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Checks that skipping ahead to the next byte ready event doesn't change what the drive reads.
+// The drive program waits for each byte ready event, logs the byte together with the value of a
+// free running VIA timer, and moves the head and changes the speed zone after each 256 bytes. It
+// reads from a G64 image with short and long SYNC marks on every halftrack. The program is run
+// with fast rotation enabled and disabled. The machine states must match at all checkpoints.
+
+#include "TestMachine.h"
+
+//! Drive program
+static const uint8_t driveProgram[] = {
+    0x78,                           // $EAA0: SEI
+    0xA2, 0xFF, 0x9A,               // $EAA1: LDX #$FF, TXS
+    0xA9, 0x6F, 0x8D, 0x02, 0x1C,   // $EAA4: VIA 2: DDRB = $6F
+    0xA9, 0x00, 0x8D, 0x03, 0x1C,   // $EAA9: VIA 2: DDRA = $00
+    0xA9, 0xEE, 0x8D, 0x0C, 0x1C,   // $EAAE: VIA 2: Read mode, byte ready enabled
+    0xA9, 0x41, 0x8D, 0x0B, 0x1C,   // $EAB3: VIA 2: Timer 1 free running, port A latched
+    0xA9, 0xFF, 0x8D, 0x04, 0x1C,   // $EAB8: VIA 2: Start timer 1
+    0x8D, 0x05, 0x1C,               // $EABD:
+    0xA9, 0x64, 0x8D, 0x00, 0x1C,   // $EAC0: Motor on, zone 3
+    0xA9, 0x00, 0x85, 0x11,         // $EAC5: Pass counter = 0
+    0xA0, 0x00,                     // $EAC9: LDY #$00
+    0x50, 0xFE,                     // $EACB: BVC $EACB
+    0xB8,                           // $EACD: CLV
+    0xAD, 0x01, 0x1C,               // $EACE: LDA $1C01
+    0x99, 0x00, 0x03,               // $EAD1: STA $0300,Y
+    0xAD, 0x04, 0x1C,               // $EAD4: LDA $1C04
+    0x99, 0x00, 0x04,               // $EAD7: STA $0400,Y
+    0xC8,                           // $EADA: INY
+    0xD0, 0xEE,                     // $EADB: BNE $EACB
+    0xE6, 0x11,                     // $EADD: INC $11
+    0xA5, 0x11, 0x29, 0x07, 0xAA,   // $EADF: X = pass counter & 7
+    0xAD, 0x00, 0x1C,               // $EAE4: LDA $1C00
+    0x29, 0x9C,                     // $EAE7: AND #$9C (clear zone and stepper bits)
+    0x1D, 0x00, 0xEB,               // $EAE9: ORA $EB00,X
+    0x8D, 0x00, 0x1C,               // $EAEC: STA $1C00
+    0x4C, 0xC9, 0xEA                // $EAEF: JMP $EAC9
+};
+
+//! Speed zone (bits 5 and 6) and stepper phase (bits 0 and 1) of each pass
+static const uint8_t driveTable[] = { 0x20, 0x41, 0x62, 0x23, 0x40, 0x63, 0x22, 0x41 };
+
+//! G64 header size (signature, version, number of halftracks, maximum track size, offsets, speeds)
+static const unsigned g64Header = 12 + 84 * 4 + 84 * 4;
+
+//! Maximum number of bytes on a halftrack
+static const unsigned maxTrackSize = 7928;
+
+//! Simple pseudo random number generator
+static uint32_t seed = 1;
+static uint8_t random8() { seed = seed * 1103515245 + 12345; return (uint8_t)(seed >> 16); }
+
+//! Appends count copies of a byte to a track
+static void
+fill(uint8_t *track, unsigned *size, unsigned count, uint8_t byte)
+{
+    for (unsigned i = 0; i < count && *size < maxTrackSize; i++)
+        track[(*size)++] = byte;
+}
+
+//! Appends count random bytes to a track
+static void
+fillRandom(uint8_t *track, unsigned *size, unsigned count)
+{
+    for (unsigned i = 0; i < count && *size < maxTrackSize; i++)
+        track[(*size)++] = random8();
+}
+
+//! Creates a G64 image with sector like structures on all halftracks
+static G64Archive *
+createG64()
+{
+    static uint8_t image[g64Header + 84 * (2 + maxTrackSize)];
+    memset(image, 0, sizeof(image));
+    memcpy(image, "GCR-1541", 8);
+    image[9] = 84;
+    image[10] = LO_BYTE(maxTrackSize);
+    image[11] = HI_BYTE(maxTrackSize);
+
+    unsigned offset = g64Header;
+    for (unsigned ht = 0; ht < 84; ht++) {
+
+        uint8_t *track = image + offset + 2;
+        unsigned length = 7000 + (ht * 37) % 900, size = 0;
+
+        for (unsigned sector = 0; size < length; sector++) {
+
+            // Header block (every seventh SYNC mark is longer than a skip)
+            fill(track, &size, sector % 7 == 3 ? 40 : 5, 0xFF);
+            fillRandom(track, &size, 10);
+            fill(track, &size, 9, 0x55);
+
+            // Data block
+            fill(track, &size, 5, 0xFF);
+            fillRandom(track, &size, 325);
+            fill(track, &size, 8, 0x55);
+        }
+
+        image[12 + 4 * ht] = LO_BYTE(offset);
+        image[13 + 4 * ht] = HI_BYTE(offset);
+        image[14 + 4 * ht] = (uint8_t)(offset >> 16);
+        image[offset] = LO_BYTE(size);
+        image[offset + 1] = HI_BYTE(size);
+        offset += 2 + size;
+    }
+
+    G64Archive *archive = new G64Archive();
+    CHECK(archive->readFromBuffer(image, offset), "Cannot create G64 archive");
+    return archive;
+}
+
+//! Runs the drive program and records the machine state every ten frames
+static void
+run(bool fastRotation, uint64_t *hashes, unsigned count)
+{
+    TestRoms roms;
+    roms.driveCode(TestRoms::driveEntry, driveProgram, sizeof(driveProgram));
+    roms.driveCode(0xEB00, driveTable, sizeof(driveTable));
+
+    C64 *c64 = createTestMachine(&roms, fastRotation ? "FastRotationOn" : "FastRotationOff");
+    G64Archive *archive = createG64();
+    c64->floppy[0].insertDisk(archive);
+
+    // Skipping is part of the bit accurate read/write logic
+    c64->floppy[0].setBitAccuracy(true);
+    c64->floppy[0].setFastRotation(fastRotation);
+
+    for (unsigned i = 0; i < count; i++) {
+        CHECK(runUntilFrame(c64, 10 * (i + 1)), "Machine stopped unexpectedly");
+        hashes[i] = stateHash(c64);
+
+        // Make sure that the drive is reading
+        if (i == 0)
+            CHECK(c64->floppy[0].mem.mem[0x11] >= 10, "Drive read %d blocks only", c64->floppy[0].mem.mem[0x11]);
+    }
+
+    delete c64;
+    delete archive;
+}
+
+int
+main(int argc, char *argv[])
+{
+    const unsigned checkpoints = 8;
+    uint64_t reference[checkpoints], fast[checkpoints];
+
+    seed = 1;
+    run(false, reference, checkpoints);
+    seed = 1;
+    run(true, fast, checkpoints);
+
+    for (unsigned i = 0; i < checkpoints; i++)
+        CHECK(reference[i] == fast[i], "Drive states differ in frame %d", 10 * (i + 1));
+
+    printf("FastRotationTest passed\n");
+    return 0;
+}
@@ -0,0 +1,336 @@
+/*
+ * (C) 2017 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Checks that skipping interrupt checks until nextInterruptCycle doesn't change the interrupt
+// timing. Each scenario runs a program that triggers interrupts in many different cycles. The
+// handlers log the interrupted instruction and a timer or raster value into RAM. The scenarios are
+// run once with interrupt gating and once with checks in every instruction. Both runs must end up
+// in the same state.
+
+#include "TestMachine.h"
+
+//! Number of frames each scenario runs
+static const uint64_t frames = 40;
+
+//! Zero page locations holding the log indices of the NMI and IRQ handler
+static const uint8_t nmiIndex = 0x02;
+static const uint8_t irqIndex = 0x05;
+
+//! First pages of the NMI and IRQ logs (interrupted PC low, PC high, timer value)
+static const uint16_t nmiLog = 0x1000;
+static const uint16_t irqLog = 0x1300;
+
+//! Common machine setup: stack, processor port, log indices
+static const uint8_t setupCode[] = {
+    0x78,                   // SEI
+    0xA2, 0xFF, 0x9A,       // LDX #$FF, TXS
+    0xA9, 0x2F, 0x85, 0x00, // LDA #$2F, STA $00
+    0xA9, 0x37, 0x85, 0x01, // LDA #$37, STA $01
+    0xA9, 0x00,             // LDA #$00
+    0x85, nmiIndex,         // STA nmiIndex
+    0x85, irqIndex,         // STA irqIndex
+    0x85, 0x03,             // STA $03
+    0x85, 0x06,             // STA $06
+};
+
+//! Copies code into the KERNAL ROM and returns the address behind it
+static uint16_t
+put(TestRoms *roms, uint16_t addr, const uint8_t *code, size_t size)
+{
+    roms->kernalCode(addr, code, size);
+    return (uint16_t)(addr + size);
+}
+
+//! Writes a handler that logs the interrupted PC and the value of source
+static void
+putHandler(TestRoms *roms, uint16_t addr, uint8_t index, uint16_t log, uint16_t source,
+           const uint8_t *ack, size_t ackSize)
+{
+    const uint8_t enter[] = {
+        0x48, 0x8A, 0x48,                           // PHA, TXA, PHA
+        0xBA, 0xBD, 0x04, 0x01,                     // TSX, LDA $0104,X
+        0xA6, index, 0x9D, 0x00, HI_BYTE(log),      // LDX index, STA log,X
+        0xBA, 0xBD, 0x05, 0x01,                     // TSX, LDA $0105,X
+        0xA6, index, 0x9D, 0x00, HI_BYTE(log + 0x100), // LDX index, STA log+$100,X
+        0xAD, LO_BYTE(source), HI_BYTE(source),     // LDA source
+        0x9D, 0x00, HI_BYTE(log + 0x200),           // STA log+$200,X
+        0xE6, index };                              // INC index
+    const uint8_t leave[] = {
+        0x68, 0xAA, 0x68, 0x40 };                   // PLA, TAX, PLA, RTI
+
+    addr = put(roms, addr, enter, sizeof(enter));
+    addr = put(roms, addr, ack, ackSize);
+    put(roms, addr, leave, sizeof(leave));
+}
+
+//! Writes a main loop that runs instructions of various lengths
+static void
+putMixedLoop(TestRoms *roms, uint16_t addr)
+{
+    const uint8_t loop[] = {
+        0xE6, 0x03,             // INC $03
+        0xA5, 0x04,             // LDA $04
+        0xEA,                   // NOP
+        0xA2, 0x05,             // LDX #$05
+        0xCA, 0xD0, 0xFD,       // DEX, BNE *-1
+        0x0E, 0x00, 0x16,       // ASL $1600
+        0xBD, 0xFF, 0x16,       // LDA $16FF,X
+        0x4C, LO_BYTE(addr), HI_BYTE(addr) };
+    put(roms, addr, loop, sizeof(loop));
+}
+
+static const uint16_t nmiHandler = 0xF000;
+static const uint16_t irqHandler = 0xF100;
+
+static const uint8_t ackCia1[] = { 0xAD, 0x0D, 0xDC }; // LDA $DC0D
+
+//
+// Scenarios
+//
+
+//! CIA 1 timer A triggers IRQs while the CPU runs a mixed instruction stream
+static void
+ciaIrq(TestRoms *roms)
+{
+    const uint8_t setup[] = {
+        0xA9, 0x23, 0x8D, 0x04, 0xDC, // Timer A = $0123
+        0xA9, 0x01, 0x8D, 0x05, 0xDC,
+        0xA9, 0x81, 0x8D, 0x0D, 0xDC, // Enable timer A interrupt
+        0xA9, 0x11, 0x8D, 0x0E, 0xDC, // Start timer A (continuous)
+        0x58 };                       // CLI
+
+    uint16_t addr = put(roms, TestRoms::kernalEntry, setupCode, sizeof(setupCode));
+    putMixedLoop(roms, put(roms, addr, setup, sizeof(setup)));
+    putHandler(roms, irqHandler, irqIndex, irqLog, 0xDC04, ackCia1, sizeof(ackCia1));
+}
+
+//! The VIC triggers raster IRQs on a moving rasterline with bad lines and sprites enabled
+static void
+rasterIrq(TestRoms *roms)
+{
+    const uint8_t setup[] = {
+        0xA9, 0x1B, 0x8D, 0x11, 0xD0, // Display on (bad lines)
+        0xA9, 0x0F, 0x8D, 0x15, 0xD0, // Sprites 0 - 3 on
+        0xA9, 0x50, 0x8D, 0x01, 0xD0,
+        0xA9, 0x62, 0x8D, 0x03, 0xD0,
+        0xA9, 0x74, 0x8D, 0x05, 0xD0,
+        0xA9, 0x96, 0x8D, 0x07, 0xD0,
+        0xA9, 0x30, 0x8D, 0x12, 0xD0, // Raster IRQ in line $30
+        0xA9, 0x01, 0x8D, 0x1A, 0xD0, // Enable raster IRQ
+        0x58 };                       // CLI
+    const uint8_t ack[] = {
+        0xA9, 0x01, 0x8D, 0x19, 0xD0, // Acknowledge
+        0xAD, 0x12, 0xD0, 0x18,       // Trigger again seven lines later
+        0x69, 0x07, 0x8D, 0x12, 0xD0 };
+
+    uint16_t addr = put(roms, TestRoms::kernalEntry, setupCode, sizeof(setupCode));
+    putMixedLoop(roms, put(roms, addr, setup, sizeof(setup)));
+    putHandler(roms, irqHandler, irqIndex, irqLog, 0xD012, ack, sizeof(ack));
+}
+
+//! CIA 2 triggers NMIs on top of CIA 1 IRQs. The NMI handler only acknowledges every other
+//! NMI. Until the main loop reads the interrupt control register, the NMI line stays low and
+//! no new edge occurs.
+static void
+nmiEdges(TestRoms *roms)
+{
+    const uint8_t setup[] = {
+        0xA9, 0x35, 0x8D, 0x04, 0xDD, // CIA 2 timer A = $0135
+        0xA9, 0x01, 0x8D, 0x05, 0xDD,
+        0xA9, 0x81, 0x8D, 0x0D, 0xDD, // Enable timer A interrupt (NMI)
+        0xA9, 0x11, 0x8D, 0x0E, 0xDD, // Start timer A (continuous)
+        0xA9, 0xF1, 0x8D, 0x04, 0xDC, // CIA 1 timer A = $00F1
+        0xA9, 0x00, 0x8D, 0x05, 0xDC,
+        0xA9, 0x81, 0x8D, 0x0D, 0xDC, // Enable timer A interrupt (IRQ)
+        0xA9, 0x11, 0x8D, 0x0E, 0xDC, // Start timer A (continuous)
+        0x58 };                       // CLI
+    const uint8_t ack[] = {
+        0xA5, nmiIndex, 0x29, 0x01,   // Acknowledge every other NMI
+        0xD0, 0x03, 0xAD, 0x0D, 0xDD };
+
+    uint16_t loop = put(roms, TestRoms::kernalEntry, setupCode, sizeof(setupCode));
+    loop = put(roms, loop, setup, sizeof(setup));
+    const uint8_t main[] = {
+        0xE6, 0x03, 0xA5, 0x03,       // INC $03, LDA $03
+        0x29, 0x0F, 0xD0, 0x03,       // Every 16th iteration: LDA $DD0D
+        0xAD, 0x0D, 0xDD,
+        0xEA, 0xA2, 0x03,             // NOP, LDX #$03
+        0xCA, 0xD0, 0xFD,             // DEX, BNE *-1
+        0x4C, LO_BYTE(loop), HI_BYTE(loop) };
+    put(roms, loop, main, sizeof(main));
+
+    putHandler(roms, nmiHandler, nmiIndex, nmiLog, 0xDD04, ack, sizeof(ack));
+    putHandler(roms, irqHandler, irqIndex, irqLog, 0xDC04, ackCia1, sizeof(ackCia1));
+}
+
+//! Address of the instruction following the CLI in cliSeiLatency
+static uint16_t afterCli;
+
+//! Address of the instruction following the CLI, SEI pair in cliSeiLatency
+static uint16_t afterSei;
+
+//! IRQs arrive while interrupts are disabled. CLI releases a pending IRQ one instruction
+//! late. A pending IRQ is still triggered after SEI if it directly follows a CLI.
+static void
+cliSeiLatency(TestRoms *roms)
+{
+    const uint8_t setup[] = {
+        0xA9, 0xB3, 0x8D, 0x04, 0xDC, // Timer A = $00B3
+        0xA9, 0x00, 0x8D, 0x05, 0xDC,
+        0xA9, 0x81, 0x8D, 0x0D, 0xDC, // Enable timer A interrupt
+        0xA9, 0x11, 0x8D, 0x0E, 0xDC }; // Start timer A (continuous)
+
+    uint16_t loop = put(roms, TestRoms::kernalEntry, setupCode, sizeof(setupCode));
+    loop = put(roms, loop, setup, sizeof(setup));
+    const uint8_t main[] = {
+        0x78,                         // SEI
+        0xE6, 0x06, 0xA5, 0x06,       // INC $06, LDA $06
+        0x29, 0x0F, 0xAA,             // AND #$0F, TAX
+        0xCA, 0x10, 0xFD,             // DEX, BPL *-1 (varying delay)
+        0x58,                         // CLI
+        0xEA,                         // NOP
+        0xE6, 0x07,                   // INC $07
+        0x58, 0x78,                   // CLI, SEI
+        0xEA,                         // NOP
+        0x4C, LO_BYTE(loop), HI_BYTE(loop) };
+    put(roms, loop, main, sizeof(main));
+    afterCli = loop + 12;
+    afterSei = loop + 17;
+
+    putHandler(roms, irqHandler, irqIndex, irqLog, 0xDC04, ackCia1, sizeof(ackCia1));
+}
+
+//! IRQs arrive while the CPU executes taken branches with and without page crossings
+static void
+branchDelay(TestRoms *roms)
+{
+    const uint8_t setup[] = {
+        0xA9, 0xC5, 0x8D, 0x04, 0xDC, // Timer A = $00C5
+        0xA9, 0x00, 0x8D, 0x05, 0xDC,
+        0xA9, 0x81, 0x8D, 0x0D, 0xDC, // Enable timer A interrupt
+        0xA9, 0x11, 0x8D, 0x0E, 0xDC, // Start timer A (continuous)
+        0x58,                         // CLI
+        0x4C, 0xF0, 0xE0 };           // JMP $E0F0
+
+    put(roms, TestRoms::kernalEntry, setupCode, sizeof(setupCode));
+    put(roms, TestRoms::kernalEntry + sizeof(setupCode), setup, sizeof(setup));
+
+    const uint8_t branches[] = {
+        0xA2, 0x08,                   // $E0F0: LDX #$08
+        0xCA, 0xD0, 0xFD,             // $E0F2: DEX, BNE $E0F2 (no page crossing)
+        0x18,                         // $E0F5: CLC
+        0xEA, 0xEA, 0xEA,             // $E0F6: NOPs
+        0xEA, 0xEA, 0xEA,
+        0x90, 0x10 };                 // $E0FC: BCC $E10E (page crossing)
+    const uint8_t target[] = {
+        0xB0, 0x00,                   // $E10E: BCS $E110 (not taken)
+        0xF0, 0x00,                   // $E110: BEQ $E112 (taken, no page crossing)
+        0x4C, 0xF0, 0xE0 };           // $E112: JMP $E0F0
+    put(roms, 0xE0F0, branches, sizeof(branches));
+    put(roms, 0xE10E, target, sizeof(target));
+
+    putHandler(roms, irqHandler, irqIndex, irqLog, 0xDC04, ackCia1, sizeof(ackCia1));
+}
+
+//
+// Test driver
+//
+
+//! Runs a scenario and returns the machine for further inspection
+static C64 *
+run(void (*scenario)(TestRoms *), const char *name, bool ntsc, bool gating)
+{
+    TestRoms roms;
+    scenario(&roms);
+    roms.kernalVectors(nmiHandler, irqHandler);
+
+    C64 *c64 = createTestMachine(&roms, name, ntsc);
+    c64->cpu.setInterruptGating(gating);
+    memset(c64->mem.ram + nmiLog, 0, 0x600);
+    CHECK(runUntilFrame(c64, frames), "%s: Machine stopped unexpectedly", name);
+    return c64;
+}
+
+//! Returns the number of log entries in use (the logs are written cyclically)
+static unsigned
+logged(C64 *c64, uint16_t log)
+{
+    unsigned count = 0;
+    for (unsigned i = 0; i < 0x100; i++)
+        if (c64->mem.ram[log + 0x100 + i] != 0)
+            count++;
+    return count;
+}
+
+//! Runs a scenario with and without interrupt gating and compares the results
+static void
+compare(void (*scenario)(TestRoms *), const char *name, unsigned minNmis, unsigned minIrqs,
+        void (*inspect)(C64 *) = NULL)
+{
+    for (unsigned ntsc = 0; ntsc < 2; ntsc++) {
+
+        C64 *reference = run(scenario, name, ntsc, false);
+        C64 *gated = run(scenario, name, ntsc, true);
+
+        // Make sure that enough interrupts have been logged
+        unsigned nmis = logged(reference, nmiLog), irqs = logged(reference, irqLog);
+        CHECK(nmis >= minNmis, "%s: Only %d NMIs", name, nmis);
+        CHECK(irqs >= minIrqs, "%s: Only %d IRQs", name, irqs);
+        if (inspect)
+            inspect(reference);
+
+        for (unsigned i = 0; i < 0x300; i++) {
+            CHECK(reference->mem.ram[nmiLog + i] == gated->mem.ram[nmiLog + i],
+                  "%s (%s): NMI log differs at offset %d", name, ntsc ? "NTSC" : "PAL", i);
+            CHECK(reference->mem.ram[irqLog + i] == gated->mem.ram[irqLog + i],
+                  "%s (%s): IRQ log differs at offset %d", name, ntsc ? "NTSC" : "PAL", i);
+        }
+        CHECK(stateHash(reference) == stateHash(gated),
+              "%s (%s): Machine states differ", name, ntsc ? "NTSC" : "PAL");
+
+        delete reference;
+        delete gated;
+    }
+}
+
+//! Checks the interrupted instructions of the CLI/SEI scenario
+static void
+inspectCliSei(C64 *c64)
+{
+    unsigned delayedBySei = 0;
+    for (unsigned i = 0; i < 0x100; i++) {
+        uint16_t pc = LO_HI(c64->mem.ram[irqLog + i], c64->mem.ram[irqLog + 0x100 + i]);
+        CHECK(pc != afterCli, "IRQ triggered directly after CLI");
+        if (pc == afterSei)
+            delayedBySei++;
+    }
+    CHECK(delayedBySei > 0, "No IRQ triggered directly after SEI");
+}
+
+int
+main(int argc, char *argv[])
+{
+    compare(ciaIrq, "CiaIrq", 0, 100);
+    compare(rasterIrq, "RasterIrq", 0, 100);
+    compare(nmiEdges, "NmiEdges", 50, 100);
+    compare(cliSeiLatency, "CliSeiLatency", 0, 100, inspectCliSei);
+    compare(branchDelay, "BranchDelay", 0, 100);
+
+    printf("InterruptTest passed\n");
+    return 0;
+}
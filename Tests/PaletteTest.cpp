@@ -0,0 +1,94 @@
+/*
+ * (C) 2017 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Checks that all variants of the RGBA translation produce the same output. The variants are
+// fed with random color indices of varying length (to cover the tail handling of the SIMD
+// variant) and with a frame drawn by the emulator. The upper four bits of the color indices
+// must be ignored. If the host CPU doesn't support SSSE3, the scalar variant is checked
+// against the dispatching one, only.
+
+#include "TestMachine.h"
+
+//! C64 program: Cycles through the border colors
+static const uint8_t borderProgram[] = {
+    0x78,                           // $FCE2: SEI
+    0xEE, 0x20, 0xD0,               // $FCE3: INC $D020
+    0x4C, 0xE3, 0xFC                // $FCE6: JMP $FCE3
+};
+
+//! Number of pixels in a frame
+static const size_t framePixels = PAL_RASTERLINES * NTSC_PIXELS;
+
+static uint32_t expected[framePixels];
+static uint32_t translated[framePixels];
+
+//! Translates count pixels with all variants and compares the results
+static void
+compare(PixelEngine *pe, const uint8_t *src, size_t count, const char *what)
+{
+    memset(expected, 0, sizeof(expected));
+    pe->translateToRGBAScalar(src, expected, count);
+
+    for (size_t i = 0; i < count; i++)
+        CHECK(expected[i] == pe->getColor(src[i] & 0x0F), "%s: Scalar variant differs at pixel %zu", what, i);
+
+    memset(translated, 0, sizeof(translated));
+    pe->translateToRGBA(src, translated, count);
+    CHECK(memcmp(expected, translated, sizeof(translated)) == 0, "%s: translateToRGBA() differs (%zu pixels)", what, count);
+
+#if defined(__i386__) || defined(__x86_64__)
+    if (pe->hasSSSE3()) {
+        memset(translated, 0, sizeof(translated));
+        pe->translateToRGBASSSE3(src, translated, count);
+        CHECK(memcmp(expected, translated, sizeof(translated)) == 0, "%s: SSSE3 variant differs (%zu pixels)", what, count);
+    }
+#endif
+}
+
+int
+main(int argc, char *argv[])
+{
+    TestRoms roms;
+    roms.kernalCode(TestRoms::kernalEntry, borderProgram, sizeof(borderProgram));
+    C64 *c64 = createTestMachine(&roms, "Palette");
+    PixelEngine *pe = new PixelEngine();
+
+    // Use a palette with distinct values in all four byte planes
+    for (unsigned i = 0; i < 16; i++)
+        pe->setColor(i, (uint32_t)rand() ^ ((uint32_t)rand() << 16));
+
+    // Random color indices
+    static uint8_t indices[framePixels];
+    for (size_t i = 0; i < framePixels; i++)
+        indices[i] = (uint8_t)rand();
+
+    for (size_t count = 0; count <= 64; count++) {
+        compare(pe, indices, count, "Random");
+        compare(pe, indices + 1, count, "Random (unaligned)");
+    }
+    compare(pe, indices, framePixels, "Random (frame)");
+
+    // A frame drawn by the emulator
+    CHECK(runUntilFrame(c64, 10), "Machine stopped unexpectedly");
+    compare(pe, c64->vic.completedIndexBuffer(), framePixels, "Frame");
+
+    printf("PaletteTest passed (SSSE3 variant %s)\n", pe->hasSSSE3() ? "checked" : "not supported");
+    delete pe;
+    delete c64;
+    return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * (C) 2017 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Checks that the rasterline sequencer stops cleanly if the CPU hits a breakpoint in the last
+// cycle of a rasterline. The CPU executes a NOP sled. First, the test finds an instruction that
+// is fetched in the last cycle of a rasterline by stopping at each instruction. Afterwards, it
+// replays the same rasterline on a second machine with a single breakpoint on that instruction.
+// As the rasterline starts in its first cycle, it is run by the rasterline sequencer.
+
+#include "TestMachine.h"
+
+static const uint16_t sledStart = TestRoms::kernalEntry + 6;
+static const uint16_t sledEnd = sledStart + 100;
+
+static C64 *
+createSledMachine(bool ntsc)
+{
+    TestRoms roms;
+
+    // SEI, disable the display to avoid bad lines, run the sled
+    const uint8_t setup[] = { 0x78, 0xA9, 0x0B, 0x8D, 0x11, 0xD0 };
+    const uint8_t jump[] = { 0x4C, LO_BYTE(sledStart), HI_BYTE(sledStart) };
+    roms.kernalCode(TestRoms::kernalEntry, setup, sizeof(setup));
+    roms.kernalCode(sledEnd, jump, sizeof(jump));
+
+    C64 *c64 = createTestMachine(&roms, ntsc ? "RasterlineTestNTSC" : "RasterlineTestPAL", ntsc);
+    CHECK(runUntilFrame(c64, 2), "Machine stopped unexpectedly");
+    return c64;
+}
+
+static void
+testModel(bool ntsc)
+{
+    C64 *c64 = createSledMachine(ntsc);
+    unsigned cyclesPerLine = c64->vic.getCyclesPerRasterline();
+    unsigned linesPerFrame = c64->vic.getRasterlinesPerFrame();
+
+    // Stop at each instruction until one is fetched in the last cycle of a rasterline
+    for (uint16_t addr = sledStart; addr < sledEnd; addr++)
+        c64->cpu.setBreakpoint(addr, CPU::HARD_BREAKPOINT);
+
+    uint16_t addr = 0;
+    uint64_t lineEnd = 0;
+    for (unsigned calls = 0; calls < 8 * cyclesPerLine && addr == 0; calls++) {
+        if (c64->executeOneLine())
+            continue;
+        if (c64->getCycles() % cyclesPerLine == 0) {
+            addr = c64->cpu.getPC_at_cycle_0();
+            lineEnd = c64->getCycles();
+        }
+        c64->cpu.clearErrorState();
+        while (c64->getMessage() != NULL);
+    }
+    CHECK(addr != 0, "No instruction is fetched in the last cycle");
+    delete c64;
+
+    // Replay the rasterline with a single breakpoint
+    c64 = createSledMachine(ntsc);
+    while (c64->getCycles() < lineEnd - cyclesPerLine)
+        CHECK(c64->executeOneLine(), "Machine stopped unexpectedly");
+    CHECK(c64->getCycles() == lineEnd - cyclesPerLine && c64->getRasterlineCycle() == 1, "Rasterline not found");
+    c64->cpu.setBreakpoint(addr, CPU::HARD_BREAKPOINT);
+
+    uint16_t rasterline = c64->getRasterline();
+    CHECK(!c64->executeOneLine(), "Breakpoint missed");
+    CHECK(c64->cpu.getErrorState() == CPU::HARD_BREAKPOINT_REACHED, "Unexpected error state");
+    CHECK(c64->getCycles() == lineEnd, "Stopped %d cycles early", (int)(lineEnd - c64->getCycles()));
+
+    // The rasterline must have been completed
+    CHECK(c64->getRasterlineCycle() == 1, "Stopped in cycle %d", c64->getRasterlineCycle());
+    CHECK(c64->getRasterline() == (rasterline + 1) % linesPerFrame, "Rasterline not completed");
+
+    // The next rasterline must run as a whole
+    c64->cpu.setBreakpoint(addr, CPU::NO_BREAKPOINT);
+    c64->cpu.clearErrorState();
+    CHECK(c64->executeOneLine(), "Machine stopped unexpectedly");
+    CHECK(c64->getCycles() == lineEnd + cyclesPerLine,
+          "Executed %d cycles instead of %d", (int)(c64->getCycles() - lineEnd), cyclesPerLine);
+    CHECK(c64->getRasterline() == (rasterline + 2) % linesPerFrame, "Rasterline not completed");
+
+    delete c64;
+}
+
+int
+main(int argc, char *argv[])
+{
+    testModel(false);
+    testModel(true);
+
+    printf("RasterlineTest passed\n");
+    return 0;
+}
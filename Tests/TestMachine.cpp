@@ -0,0 +1,173 @@
+/*
+ * (C) 2017 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TestMachine.h"
+
+TestRoms::TestRoms()
+{
+    // Magic bytes
+    memset(basic, 0x00, sizeof(basic));
+    basic[0] = 0x94; basic[1] = 0xE3; basic[2] = 0x7B;
+    for (unsigned i = 0; i < sizeof(character); i++)
+        character[i] = (uint8_t)(i * 37);
+    character[0] = 0x3C; character[1] = 0x66; character[2] = 0x6E;
+    memset(kernal, 0xEA, sizeof(kernal));
+    kernal[0] = 0x85; kernal[1] = 0x56; kernal[2] = 0x20;
+    memset(drive, 0xEA, sizeof(drive));
+    drive[0] = 0x97; drive[1] = 0xAA; drive[2] = 0xAA;
+
+    // Entry point: SEI, JMP *
+    const uint8_t loop[] = { 0x78, 0x4C, LO_BYTE(kernalEntry + 1), HI_BYTE(kernalEntry + 1) };
+    kernalCode(kernalEntry, loop, sizeof(loop));
+    const uint8_t driveLoop[] = { 0x78, 0x4C, LO_BYTE(driveEntry + 1), HI_BYTE(driveEntry + 1) };
+    driveCode(driveEntry, driveLoop, sizeof(driveLoop));
+
+    // Interrupts: RTI
+    const uint8_t rti[] = { 0x40 };
+    kernalCode(0xFF00, rti, sizeof(rti));
+    kernalVectors(0xFF00, 0xFF00);
+    driveCode(0xFF00, rti, sizeof(rti));
+    driveVectors(0xFF00, 0xFF00);
+}
+
+void
+TestRoms::kernalCode(uint16_t addr, const uint8_t *code, size_t size)
+{
+    assert(addr >= 0xE000 && addr + size <= 0x10000);
+    memcpy(kernal + (addr - 0xE000), code, size);
+}
+
+void
+TestRoms::driveCode(uint16_t addr, const uint8_t *code, size_t size)
+{
+    assert(addr >= 0xC000 && addr + size <= 0x10000);
+    memcpy(drive + (addr - 0xC000), code, size);
+}
+
+void
+TestRoms::kernalVectors(uint16_t nmi, uint16_t irq)
+{
+    uint8_t vectors[] = {
+        LO_BYTE(nmi), HI_BYTE(nmi), LO_BYTE(kernalEntry), HI_BYTE(kernalEntry), LO_BYTE(irq), HI_BYTE(irq) };
+    kernalCode(0xFFFA, vectors, sizeof(vectors));
+}
+
+void
+TestRoms::driveVectors(uint16_t nmi, uint16_t irq)
+{
+    uint8_t vectors[] = {
+        LO_BYTE(nmi), HI_BYTE(nmi), LO_BYTE(driveEntry), HI_BYTE(driveEntry), LO_BYTE(irq), HI_BYTE(irq) };
+    driveCode(0xFFFA, vectors, sizeof(vectors));
+}
+
+//! Writes a ROM image into a file and loads it
+static void
+loadTestRom(C64 *c64, const char *name, const char *type, const uint8_t *data, size_t size)
+{
+    char filename[256];
+    snprintf(filename, sizeof(filename), "%s-%s.rom", name, type);
+
+    FILE *file = fopen(filename, "wb");
+    CHECK(file != NULL, "Cannot create %s", filename);
+    CHECK(fwrite(data, 1, size, file) == size, "Cannot write %s", filename);
+    fclose(file);
+
+    CHECK(c64->loadRom(filename), "Cannot load %s", filename);
+    remove(filename);
+}
+
+C64 *
+createTestMachine(TestRoms *roms, const char *name, bool ntsc)
+{
+    C64 *c64 = new C64();
+
+    if (ntsc)
+        c64->setNTSC();
+
+    loadTestRom(c64, name, "basic", roms->basic, sizeof(roms->basic));
+    loadTestRom(c64, name, "char", roms->character, sizeof(roms->character));
+    loadTestRom(c64, name, "kernal", roms->kernal, sizeof(roms->kernal));
+    loadTestRom(c64, name, "1541", roms->drive, sizeof(roms->drive));
+    CHECK(c64->isRunnable(), "Missing ROM images");
+
+    // Color RAM is initialized with random values
+    srand(0);
+    c64->reset();
+    c64->setWarp(true);
+    c64->cpu.clearErrorState();
+    for (unsigned i = 0; i < IEC::maxDrives; i++)
+        c64->floppy[i].cpu.clearErrorState();
+
+    return c64;
+}
+
+bool
+runUntilFrame(C64 *c64, uint64_t frame)
+{
+    while (c64->getFrame() < frame) {
+        if (!c64->executeOneLine())
+            return false;
+        if (c64->getRasterline() == 0) {
+            // There is no GUI that would consume the messages
+            while (c64->getMessage() != NULL);
+        }
+    }
+    return true;
+}
+
+//! FNV-1a hash
+static void
+mix(uint64_t *hash, const uint8_t *data, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        *hash ^= data[i];
+        *hash *= 1099511628211ULL;
+    }
+}
+
+uint64_t
+stateHash(C64 *c64)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    // Bring sleeping components up to date
+    c64->cia1.wakeUp();
+    c64->cia2.wakeUp();
+    c64->floppy[0].wakeUp();
+
+    mix(&hash, c64->mem.ram, sizeof(c64->mem.ram));
+    // The upper four bits of color RAM are random
+    for (unsigned i = 0; i < sizeof(c64->mem.colorRam); i++) {
+        uint8_t color = c64->mem.colorRam[i] & 0x0F;
+        mix(&hash, &color, 1);
+    }
+    mix(&hash, c64->floppy[0].mem.mem, 0x800);
+
+    CPU *cpus[] = { &c64->cpu, &c64->floppy[0].cpu };
+    for (unsigned i = 0; i < 2; i++) {
+        uint8_t regs[] = {
+            cpus[i]->getA(), cpus[i]->getX(), cpus[i]->getY(), cpus[i]->getSP(), cpus[i]->getP(),
+            LO_BYTE(cpus[i]->getPC_at_cycle_0()), HI_BYTE(cpus[i]->getPC_at_cycle_0()) };
+        mix(&hash, regs, sizeof(regs));
+    }
+
+    uint64_t cycles = c64->getCycles();
+    mix(&hash, (uint8_t *)&cycles, sizeof(cycles));
+
+    return hash;
+}
@@ -0,0 +1,80 @@
+/*
+ * (C) 2017 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Helpers shared by the regression tests. The original Commodore ROMs can't be shipped with
+// the sources. Hence, the tests run their own machine code from synthetic ROM images.
+
+#ifndef _TESTMACHINE_INC
+#define _TESTMACHINE_INC
+
+#include "C64.h"
+
+//! Reports a failed check and terminates the test
+#define CHECK(cond, ...) \
+do { if (!(cond)) { \
+    fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+    fprintf(stderr, "    " __VA_ARGS__); fprintf(stderr, "\n"); \
+    exit(1); } } while (0)
+
+//! Synthetic ROM images
+struct TestRoms {
+
+    uint8_t basic[0x2000];
+    uint8_t character[0x1000];
+    uint8_t kernal[0x2000];
+    uint8_t drive[0x4000];
+
+    //! Address the C64 CPU starts at after a reset
+    static const uint16_t kernalEntry = 0xFCE2;
+
+    //! Address the drive CPU starts at after a reset
+    static const uint16_t driveEntry = 0xEAA0;
+
+    /*! @brief    Creates a minimal set of ROM images
+     *  @details  The images carry the magic bytes checked by the ROM loaders. Both CPUs enter
+     *            an endless loop at their entry points and return from all interrupts immediately.
+     */
+    TestRoms();
+
+    //! Copies machine code into the KERNAL ROM ($E000 - $FFFF)
+    void kernalCode(uint16_t addr, const uint8_t *code, size_t size);
+
+    //! Copies machine code into the drive ROM ($C000 - $FFFF)
+    void driveCode(uint16_t addr, const uint8_t *code, size_t size);
+
+    //! Sets the NMI and IRQ vectors of the C64
+    void kernalVectors(uint16_t nmi, uint16_t irq);
+
+    //! Sets the NMI and IRQ vectors of the drive
+    void driveVectors(uint16_t nmi, uint16_t irq);
+};
+
+/*! @brief    Creates a virtual C64 running the specified ROM images
+ *  @details  The images are stored in files prefixed by name in the current directory.
+ *            The returned machine has been reset and runs in warp mode. The random number
+ *            generator is seeded to make the initial machine state reproducible.
+ */
+C64 *createTestMachine(TestRoms *roms, const char *name, bool ntsc = false);
+
+//! Runs the machine until the frame counter reaches the specified value
+bool runUntilFrame(C64 *c64, uint64_t frame);
+
+//! Computes a fingerprint of the machine state (RAM, CPU, CIAs and drive 8)
+uint64_t stateHash(C64 *c64);
+
+#endif